@@ -0,0 +1,223 @@
+/* Copyright (C) 1997 - 2021 Astrodienst AG, Switzerland.  All rights reserved.
+
+  License conditions
+  ------------------
+
+  This file is part of Swiss Ephemeris.
+
+  Swiss Ephemeris is distributed with NO WARRANTY OF ANY KIND.  No author
+  or distributor accepts any responsibility for the consequences of using it,
+  or for whether it serves any particular purpose or works at all, unless he
+  or she says so in writing.  
+
+  Swiss Ephemeris is made available by its authors under a dual licensing
+  system. The software developer, who uses any part of Swiss Ephemeris
+  in his or her software, must choose between one of the two license models,
+  which are
+  a) GNU Affero General Public License (AGPL)
+  b) Swiss Ephemeris Professional License
+
+  The choice must be made before the software developer distributes software
+  containing parts of Swiss Ephemeris to others, and before any public
+  service using the developed software is activated.
+
+  If the developer choses the AGPL software license, he or she must fulfill
+  the conditions of that license, which includes the obligation to place his
+  or her whole software project under the AGPL or a compatible license.
+  See https://www.gnu.org/licenses/agpl-3.0.html
+
+  If the developer choses the Swiss Ephemeris Professional license,
+  he must follow the instructions as found in http://www.astro.com/swisseph/ 
+  and purchase the Swiss Ephemeris Professional Edition from Astrodienst
+  and sign the corresponding license contract.
+
+  The License grants you the right to use, copy, modify and redistribute
+  Swiss Ephemeris, but only under certain conditions described in the License.
+  Among other things, the License requires that the copyright notices and
+  this notice be preserved on all copies.
+
+  Authors of the Swiss Ephemeris: Dieter Koch and Alois Treindl
+
+  The authors of Swiss Ephemeris have no control or influence over any of
+  the derived works, i.e. over software or services created by other
+  programmers which use Swiss Ephemeris functions.
+
+  The names of the authors or of the copyright holder (Astrodienst) must not
+  be used for promoting any software, product or service which uses or contains
+  the Swiss Ephemeris. This copyright notice is the ONLY place where the
+  names of the authors can legally appear, except in cases where they have
+  given special permission in writing.
+
+  The trademarks 'Swiss Ephemeris' and 'Swiss Ephemeris inside' may be used
+  for promoting such software, products or services.
+*/
+
+/* Aspect matrix: one chart against many.
+ *
+ * swe_aspect_matrix() compares the points of a reference chart with the
+ * points of many charts: for every pair of points the angular distance
+ * is tested against a list of aspects with orbs, and every aspect within
+ * its orb scores weight * (1 - deviation / orb). The longitudes of the
+ * charts are packed by point (structure of arrays), so that the inner
+ * loop runs over consecutive charts; with GCC and Clang it is written
+ * with vector extensions of 4 floats, which compile to SSE, NEON or
+ * WebAssembly SIMD instructions. Other compilers use the scalar loop.
+ * The function is pure and works on a range of charts, so that callers
+ * can split a large comparison between threads.
+ */
+
+#include <string.h>
+#include <math.h>
+#include "swephexp.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ASPM_VECTOR 1
+typedef float aspm_vf __attribute__((vector_size(16)));
+typedef int aspm_vi __attribute__((vector_size(16)));
+#define ASPM_LANES	4
+#endif
+
+#define ASPM_MAXASP	32
+
+/* angular distance of two longitudes in [0, 360), 0..180 */
+static float aspm_dist(float a, float b)
+{
+  float d = (float) fabs(a - b);
+  return d > 180 ? 360 - d : d;
+}
+
+#ifdef ASPM_VECTOR
+static aspm_vf aspm_splat(float x)
+{
+  aspm_vf v = {x, x, x, x};
+  return v;
+}
+
+/* a where the mask is set, else b */
+static aspm_vf aspm_select(aspm_vi mask, aspm_vf a, aspm_vf b)
+{
+  return (aspm_vf) ((mask & (aspm_vi) a) | (~mask & (aspm_vi) b));
+}
+
+static aspm_vf aspm_abs(aspm_vf x)
+{
+  return (aspm_vf) ((aspm_vi) x & 0x7fffffff);
+}
+#endif
+
+/* Aspects between the nref points ref[] of a reference chart and the
+ * npoint points of the charts c0 <= c < c1 of ncharts charts, whose
+ * longitudes (0 <= lon < 360) are packed by point: lon[p * ncharts + c].
+ * asp[] holds naspect (at most 32) triples of aspect angle, orb and
+ * weight. score[c] receives the sum of weight * (1 - deviation / orb)
+ * of all aspects within their orbs. For the charts with a score of at
+ * least minscore, the first nmax aspects are listed:
+ *   match[2 * i]      chart
+ *   match[2 * i + 1]  ref point << 16 | point << 8 | aspect
+ *   dev[i]            deviation from the exact aspect in degrees
+ * (match and dev may be NULL). Returns the total number of aspects
+ * found, of which at most nmax are listed, or ERR. Longitudes outside
+ * [0, 360) still score, but are not listed reliably.
+ */
+int32 CALL_CONV swe_aspect_matrix(const double *ref, int32 nref, const float *lon, int32 npoint, int32 ncharts, int32 c0, int32 c1, const double *asp, int32 naspect, double minscore, float *score, int32 *match, float *dev, int32 nmax, char *serr)
+{
+  float fref[256], angle[ASPM_MAXASP], orb[ASPM_MAXASP], weight[ASPM_MAXASP];
+  float d, e;
+  const float *col;
+  uint32 cand[181], mask;
+  int32 c, i, j, k, b, n = 0;
+  if (serr != NULL)
+    *serr = '\0';
+  if (nref < 0 || nref > 255 || npoint < 0 || npoint > 255
+      || naspect < 0 || naspect > ASPM_MAXASP || nmax < 0
+      || c0 < 0 || c0 > c1 || c1 > ncharts) {
+    if (serr != NULL)
+      strcpy(serr, "aspect matrix: point, aspect or chart counts out of range");
+    return ERR;
+  }
+  for (i = 0; i < nref; i++)
+    fref[i] = (float) ref[i];
+  for (k = 0; k < naspect; k++) {
+    if (asp[3 * k + 1] <= 0) {
+      if (serr != NULL)
+	strcpy(serr, "aspect matrix: orb must be positive");
+      return ERR;
+    }
+    angle[k] = (float) asp[3 * k];
+    orb[k] = (float) asp[3 * k + 1];
+    weight[k] = (float) (asp[3 * k + 2] / asp[3 * k + 1]);
+  }
+  for (c = c0; c < c1; c++)
+    score[c] = 0;
+  /* scores */
+  for (i = 0; i < nref; i++) {
+    for (j = 0; j < npoint; j++) {
+      col = lon + (size_t) j * ncharts;
+      c = c0;
+#ifdef ASPM_VECTOR
+      {
+	aspm_vf r = aspm_splat(fref[i]), v, dv, ev, sv;
+	for (; c + ASPM_LANES <= c1; c += ASPM_LANES) {
+	  memcpy(&v, col + c, sizeof(v));
+	  dv = aspm_abs(r - v);
+	  dv = aspm_select(dv > aspm_splat(180), aspm_splat(360) - dv, dv);
+	  memcpy(&sv, score + c, sizeof(sv));
+	  for (k = 0; k < naspect; k++) {
+	    ev = aspm_abs(dv - aspm_splat(angle[k]));
+	    sv += aspm_select(ev <= aspm_splat(orb[k]), aspm_splat(weight[k]) * (aspm_splat(orb[k]) - ev), aspm_splat(0));
+	  }
+	  memcpy(score + c, &sv, sizeof(sv));
+	}
+      }
+#endif
+      for (; c < c1; c++) {
+	d = aspm_dist(fref[i], col[c]);
+	for (k = 0; k < naspect; k++) {
+	  e = (float) fabs(d - angle[k]);
+	  if (e <= orb[k])
+	    score[c] += weight[k] * (orb[k] - e);
+	}
+      }
+    }
+  }
+  /* aspects of the charts that score; per degree of distance, the
+   * aspects whose orbs reach into it */
+  for (b = 0; b <= 180; b++) {
+    cand[b] = 0;
+    for (k = 0; k < naspect; k++) {
+      if (angle[k] - orb[k] <= b + 1 && angle[k] + orb[k] >= b)
+	cand[b] |= (uint32) 1 << k;
+    }
+  }
+  for (c = c0; c < c1; c++) {
+    if (score[c] < minscore)
+      continue;
+    for (i = 0; i < nref; i++) {
+      for (j = 0; j < npoint; j++) {
+	d = aspm_dist(fref[i], lon[(size_t) j * ncharts + c]);
+	/* out of range (or NaN) for longitudes outside [0, 360) */
+	if (d >= 0 && d <= 180)
+	  b = (int) d;
+	else
+	  b = d > 180 ? 180 : 0;
+	for (k = 0, mask = cand[b]; mask != 0; k++, mask >>= 1) {
+	  if (!(mask & 1))
+	    continue;
+	  e = (float) fabs(d - angle[k]);
+	  if (e > orb[k])
+	    continue;
+	  if (n < nmax) {
+	    if (match != NULL) {
+	      match[2 * n] = c;
+	      match[2 * n + 1] = i << 16 | j << 8 | k;
+	    }
+	    if (dev != NULL)
+	      dev[n] = e;
+	  }
+	  n++;
+	}
+      }
+    }
+  }
+  return n;
+}
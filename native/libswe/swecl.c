@@ -62,15 +62,46 @@
 #include "swephexp.h"
 #include "sweph.h"
 #include "swephlib.h"
+#include "swememo.h"
+#include "sweidx.h"
 #include <time.h>
 
 #define SEFLG_EPHMASK	(SEFLG_JPLEPH|SEFLG_SWIEPH|SEFLG_MOSEPH)
+
+/* refraction tables, see swe_set_refrac_table() */
+#define REFR_TAB_HMIN	-2.5
+#define REFR_TAB_HBRK	17.904104638432	/* see calc_astronomical_refr() */
+#define REFR_TAB_NLO	256	/* intervals from REFR_TAB_HMIN to REFR_TAB_HBRK */
+#define REFR_TAB_NHI	128	/* intervals from REFR_TAB_HBRK to 90 */
+#define REFR_TAB_NPT	(REFR_TAB_NLO + REFR_TAB_NHI + 2)
+#define REFR_TAB_NCACHE	4
+
+struct refr_seg {
+  double x0, step;
+  int n;
+  double *y, *dy;	/* n + 1 values and derivatives */
+};
+
+struct refr_table {
+  int valid;
+  double geoalt, atpress, attemp, lapse_rate;
+  double dip;
+  struct refr_seg app[2], tru[2];	/* below and above the branch point */
+  double yapp[REFR_TAB_NPT], dyapp[REFR_TAB_NPT];
+  double ytru[REFR_TAB_NPT], dytru[REFR_TAB_NPT];
+};
+
 static int find_maximum(double y00, double y11, double y2, double dx, 
 			double *dxret, double *yret);
 static int find_zero(double y00, double y11, double y2, double dx, 
 			double *dxret, double *dxret2);
 static double calc_dip(double geoalt, double atpress, double attemp, double lapse_rate);
 static double calc_astronomical_refr(double geoalt,double atpress, double attemp);
+static double refrac_true_to_app(double inalt, double atpress, double attemp, double dip, struct refr_table *tab, double *dret);
+static struct refr_table *refr_table_get(double geoalt, double atpress, double attemp, double lapse_rate);
+static double refr_table_app(const struct refr_table *tab, double inalt);
+static int refr_table_true(const struct refr_table *tab, double inalt, double *refr);
+static void cotrans_sc(double *xp, double sineps, double coseps);
 static TLS double const_lapse_rate = SE_LAPSE_RATE;  /* for refraction */
 
 #if 0
@@ -96,6 +127,16 @@ static int32 occult_when_loc(double tjd_start, int32 ipl, char *starname, int32
         double *geopos, double *tret, double *attr, AS_BOOL backward, char *serr);
 static int32 lun_eclipse_how(double tjd_ut, int32 ifl, double *attr, 
         double *dcore, char *serr);
+static int32 sol_eclipse_when_loc(double tjd_start, int32 ifl,
+        double *geopos, double *tret, double *attr, int32 backward, char *serr);
+static int32 lun_occult_when_glob(double tjd_start, int32 ipl, char *starname, int32 ifl,
+        int32 ifltype, double *tret, int32 backward, char *serr);
+static int32 lun_occult_when_loc(double tjd_start, int32 ipl, char *starname, int32 ifl,
+        double *geopos, double *tret, double *attr, int32 backward, char *serr);
+static int32 lun_eclipse_when_loc(double tjd_start, int32 ifl,
+        double *geopos, double *tret, double *attr, int32 backward, char *serr);
+static int32 gauquelin_sector(double t_ut, int32 ipl, char *starname, int32 iflag, int32 imeth,
+        double *geopos, double atpress, double attemp, double *dgsect, char *serr);
 static int32 calc_mer_trans(
                double tjd_ut, int32 ipl, int32 epheflag, int32 rsmi,
                double *geopos,
@@ -104,6 +145,35 @@ static int32 calc_mer_trans(
                char *serr); 
 static int32 calc_planet_star(double tjd_et, int32 ipl, char *starname, int32 iflag, double *x, char *serr);
 
+/* tret[10] and attr[20] of the local eclipse functions as one cached result */
+static AS_BOOL memo_get_local(struct swi_memo *m, int32 *retflag, double *tret, double *attr, char *starname)
+{
+  double res[30];
+  if (swi_memo_get(m, retflag, res, 30, starname)) {
+    memcpy(tret, res, 10 * sizeof(double));
+    memcpy(attr, res + 10, 20 * sizeof(double));
+    return TRUE;
+  }
+  memset(tret, 0, 10 * sizeof(double));
+  memset(attr, 0, 20 * sizeof(double));
+  return FALSE;
+}
+
+static void memo_put_local(struct swi_memo *m, int32 retflag, double *tret, double *attr, char *starname)
+{
+  double res[30];
+  memcpy(res, tret, 10 * sizeof(double));
+  memcpy(res + 10, attr, 20 * sizeof(double));
+  swi_memo_put(m, retflag, res, 30, starname);
+}
+
+static void memo_add_refrac(struct swi_memo *m);
+
+static char *memo_star(char *starname)
+{
+  return (starname != NULL && *starname != '\0') ? starname : NULL;
+}
+
 struct saros_data {int series_no; double tstart;};
 
 // Saros cycle numbers of solar eclipses with date of initial 
@@ -1184,6 +1254,25 @@ static int32 eclipse_how( double tjd_ut, int32 ipl, char *starname, int32 ifl,
  */
 int32 CALL_CONV swe_sol_eclipse_when_glob(double tjd_start, int32 ifl, int32 ifltype,
      double *tret, int32 backward, char *serr)
+{
+  struct swi_memo m;
+  int32 retflag;
+  if (swi_eclidx_when(SE_ECLIDX_SOLAR, tjd_start, ifl, ifltype, backward, tret, &retflag))
+    return retflag;
+  if (!swi_memo_begin(&m, SEI_MEMO_SOL_ECLIPSE_GLOB, ifl, serr))
+    return swi_sol_eclipse_when_glob(tjd_start, ifl, ifltype, tret, backward, serr);
+  swi_memo_add(&m, &tjd_start, sizeof(tjd_start));
+  swi_memo_add(&m, &ifltype, sizeof(ifltype));
+  swi_memo_add(&m, &backward, sizeof(backward));
+  if (swi_memo_get(&m, &retflag, tret, 10, NULL))
+    return retflag;
+  retflag = swi_sol_eclipse_when_glob(tjd_start, ifl, ifltype, tret, backward, m.serr);
+  swi_memo_put(&m, retflag, tret, 10, NULL);
+  return retflag;
+}
+
+int32 swi_sol_eclipse_when_glob(double tjd_start, int32 ifl, int32 ifltype,
+     double *tret, int32 backward, char *serr)
 {
   int i, j, k, m, n, o, i1 = 0, i2 = 0;
   int32 retflag = 0, retflag2 = 0;
@@ -1572,6 +1661,26 @@ end_search_global:
 int32 CALL_CONV swe_lun_occult_when_glob(
      double tjd_start, int32 ipl, char *starname, int32 ifl, int32 ifltype,
      double *tret, int32 backward, char *serr)
+{
+  struct swi_memo m;
+  int32 retflag;
+  if (!swi_memo_begin(&m, SEI_MEMO_LUN_OCCULT_GLOB, ifl, serr))
+    return lun_occult_when_glob(tjd_start, ipl, starname, ifl, ifltype, tret, backward, serr);
+  swi_memo_add(&m, &tjd_start, sizeof(tjd_start));
+  swi_memo_add(&m, &ipl, sizeof(ipl));
+  swi_memo_add_str(&m, starname);
+  swi_memo_add(&m, &ifltype, sizeof(ifltype));
+  swi_memo_add(&m, &backward, sizeof(backward));
+  if (swi_memo_get(&m, &retflag, tret, 10, memo_star(starname)))
+    return retflag;
+  retflag = lun_occult_when_glob(tjd_start, ipl, starname, ifl, ifltype, tret, backward, m.serr);
+  swi_memo_put(&m, retflag, tret, 10, memo_star(starname));
+  return retflag;
+}
+
+static int32 lun_occult_when_glob(
+     double tjd_start, int32 ipl, char *starname, int32 ifl, int32 ifltype,
+     double *tret, int32 backward, char *serr)
 {
   int i, j, k, m, n, o, i1, i2;
   int32 retflag = 0, retflag2 = 0;
@@ -2018,6 +2127,24 @@ end_search_global:
  */
 int32 CALL_CONV swe_sol_eclipse_when_loc(double tjd_start, int32 ifl,
      double *geopos, double *tret, double *attr, int32 backward, char *serr)
+{
+  struct swi_memo m;
+  int32 retflag;
+  if (!swi_memo_begin(&m, SEI_MEMO_SOL_ECLIPSE_LOC, ifl, serr))
+    return sol_eclipse_when_loc(tjd_start, ifl, geopos, tret, attr, backward, serr);
+  swi_memo_add(&m, &tjd_start, sizeof(tjd_start));
+  swi_memo_add(&m, geopos, 3 * sizeof(double));
+  swi_memo_add(&m, &backward, sizeof(backward));
+  memo_add_refrac(&m);
+  if (memo_get_local(&m, &retflag, tret, attr, NULL))
+    return retflag;
+  retflag = sol_eclipse_when_loc(tjd_start, ifl, geopos, tret, attr, backward, m.serr);
+  memo_put_local(&m, retflag, tret, attr, NULL);
+  return retflag;
+}
+
+static int32 sol_eclipse_when_loc(double tjd_start, int32 ifl,
+     double *geopos, double *tret, double *attr, int32 backward, char *serr)
 {
   int32 retflag = 0, retflag2 = 0;
   double geopos2[20], dcore[10];
@@ -2070,6 +2197,26 @@ int32 CALL_CONV swe_sol_eclipse_when_loc(double tjd_start, int32 ifl,
  */
 int32 CALL_CONV swe_lun_occult_when_loc(double tjd_start, int32 ipl, char *starname, int32 ifl,
      double *geopos, double *tret, double *attr, int32 backward, char *serr)
+{
+  struct swi_memo m;
+  int32 retflag;
+  if (!swi_memo_begin(&m, SEI_MEMO_LUN_OCCULT_LOC, ifl, serr))
+    return lun_occult_when_loc(tjd_start, ipl, starname, ifl, geopos, tret, attr, backward, serr);
+  swi_memo_add(&m, &tjd_start, sizeof(tjd_start));
+  swi_memo_add(&m, &ipl, sizeof(ipl));
+  swi_memo_add_str(&m, starname);
+  swi_memo_add(&m, geopos, 3 * sizeof(double));
+  swi_memo_add(&m, &backward, sizeof(backward));
+  memo_add_refrac(&m);
+  if (memo_get_local(&m, &retflag, tret, attr, memo_star(starname)))
+    return retflag;
+  retflag = lun_occult_when_loc(tjd_start, ipl, starname, ifl, geopos, tret, attr, backward, m.serr);
+  memo_put_local(&m, retflag, tret, attr, memo_star(starname));
+  return retflag;
+}
+
+static int32 lun_occult_when_loc(double tjd_start, int32 ipl, char *starname, int32 ifl,
+     double *geopos, double *tret, double *attr, int32 backward, char *serr)
 {
   int32 retflag = 0, retflag2 = 0;
   double geopos2[20], dcore[10];
@@ -2874,6 +3021,121 @@ void CALL_CONV swe_azalt_rev(
   }
 }
 
+/* same as swe_cotrans() for polar coordinates in degrees (xp[0], xp[1]),
+ * with sine and cosine of the rotation angle precomputed */
+static void cotrans_sc(double *xp, double sineps, double coseps)
+{
+  double x[3];
+  x[0] = xp[0] * DEGTORAD;
+  x[1] = xp[1] * DEGTORAD;
+  x[2] = 1;
+  swi_polcart(x, x);
+  swi_coortrf2(x, x, sineps, coseps);
+  swi_cartpol(x, x);
+  xp[0] = x[0] * RADTODEG;
+  xp[1] = x[1] * RADTODEG;
+}
+
+/* 
+ * swe_azalt_batch()
+ * Same as swe_azalt() for n objects at the same time and place.
+ * Sidereal time, obliquity, pressure estimate and dip of the horizon
+ * are computed once; the loop over the objects only does the
+ * two rotations and the refraction.
+ *
+ * input:
+ *   xin[2*n]     lon/lat or ra/dec of every object, in degrees
+ * output:
+ *   xaz[3*n]     azimuth, true altitude, apparent altitude of every object
+ */
+void CALL_CONV swe_azalt_batch(
+      double tjd_ut,
+      int32  calc_flag,
+      double *geopos,
+      double atpress,
+      double attemp,
+      const double *xin, 
+      int32  n,
+      double *xaz) 
+{
+  int32 k;
+  double x[6], xra[2];
+  double armc = swe_degnorm(swe_sidtime(tjd_ut) * 15 + geopos[0]);
+  double sineps = 0, coseps = 1, sinlat, coslat, dip;
+  struct refr_table *tab;
+  if (calc_flag == SE_ECL2HOR) {
+    swe_calc(tjd_ut + swe_deltat_ex(tjd_ut, -1, NULL), SE_ECL_NUT, 0, x, NULL);
+    sineps = sin(-x[0] * DEGTORAD);
+    coseps = cos(-x[0] * DEGTORAD);
+  }
+  sinlat = sin((90 - geopos[1]) * DEGTORAD);
+  coslat = cos((90 - geopos[1]) * DEGTORAD);
+  if (atpress == 0) {
+    /* estimate atmospheric pressure */
+    atpress = 1013.25 * pow(1 - 0.0065 * geopos[2] / 288, 5.255);
+  } 
+  tab = refr_table_get(geopos[2], atpress, attemp, const_lapse_rate);
+  dip = (tab != NULL) ? tab->dip : calc_dip(geopos[2], atpress, attemp, const_lapse_rate);
+  for (k = 0; k < n; k++) {
+    xra[0] = xin[2 * k];
+    xra[1] = xin[2 * k + 1];
+    if (calc_flag == SE_ECL2HOR)
+      cotrans_sc(xra, sineps, coseps);
+    x[0] = swe_degnorm(swe_degnorm(xra[0] - armc) - 90);
+    x[1] = xra[1];
+    /* azimuth from east, counterclock */
+    cotrans_sc(x, sinlat, coslat);
+    /* azimuth from south to west */
+    xaz[3 * k] = 360 - swe_degnorm(x[0] + 90);
+    xaz[3 * k + 1] = x[1];	/* true height */
+    xaz[3 * k + 2] = refrac_true_to_app(x[1], atpress, attemp, dip, tab, NULL);
+  }
+}
+
+/* 
+ * swe_azalt_rev_batch()
+ * Same as swe_azalt_rev() for n objects at the same time and place.
+ *
+ * input:
+ *   xin[2*n]     azimuth and true altitude of every object, in degrees
+ * output:
+ *   xout[2*n]    lon/lat or ra/dec of every object
+ */
+void CALL_CONV swe_azalt_rev_batch(
+      double tjd_ut,
+      int32  calc_flag,
+      double *geopos,
+      const double *xin, 
+      int32  n,
+      double *xout) 
+{
+  int32 k;
+  double x[6], xaz[2];
+  double armc = swe_degnorm(swe_sidtime(tjd_ut) * 15 + geopos[0]);
+  double sinlat = sin((geopos[1] - 90) * DEGTORAD);
+  double coslat = cos((geopos[1] - 90) * DEGTORAD);
+  double sineps = 0, coseps = 1;
+  if (calc_flag == SE_HOR2ECL) {
+    swe_calc(tjd_ut + swe_deltat_ex(tjd_ut, -1, NULL), SE_ECL_NUT, 0, x, NULL);
+    sineps = sin(x[0] * DEGTORAD);
+    coseps = cos(x[0] * DEGTORAD);
+  }
+  for (k = 0; k < n; k++) {
+    /* azimuth is from south, clockwise. 
+     * we need it from east, counterclock */
+    xaz[0] = swe_degnorm(360 - xin[2 * k] - 90);
+    xaz[1] = xin[2 * k + 1];
+    /* equatorial positions */
+    cotrans_sc(xaz, sinlat, coslat);
+    xaz[0] = swe_degnorm(xaz[0] + armc + 90);
+    /* ecliptic positions */
+    if (calc_flag == SE_HOR2ECL)
+      cotrans_sc(xaz, sineps, coseps);
+    xout[2 * k] = xaz[0];
+    xout[2 * k + 1] = xaz[1];
+  }
+}
+
 /* swe_refrac()
  * Transforms apparent to true altitude and vice-versa.
  * These formulae do not handle the case when the
@@ -3038,58 +3300,18 @@ double CALL_CONV swe_refrac_extended(double inalt, double geoalt, double atpress
 {
   double refr;
   double trualt;
-  double dip = calc_dip(geoalt, atpress, attemp, lapse_rate);
-  double D, D0, N, y, yy0;
-  int i;
+  struct refr_table *tab = refr_table_get(geoalt, atpress, attemp, lapse_rate);
+  double dip = (tab != NULL) ? tab->dip : calc_dip(geoalt, atpress, attemp, lapse_rate);
   /* make sure that inalt <=90 */
   if( (inalt>90) )
     inalt=180-inalt;
   if (calc_flag == SE_TRUE_TO_APP) {
-    if (inalt < -10) {
-      if (dret != NULL) {
-	dret[0]=inalt;
-	dret[1]=inalt;
-	dret[2]=0;
-	dret[3]=dip;
-      }
-      return inalt;
-    }
-    /* by iteration */
-    y = inalt;
-    D = 0.0;
-    yy0 = 0;
-    D0 = D;
-    for(i=0; i<5; i++) {
-      D = calc_astronomical_refr(y,atpress,attemp);
-      N = y - yy0;
-      yy0 = D - D0 - N; /* denominator of derivative */
-      if (N != 0.0 && yy0 != 0.0) /* sic !!! code by Moshier */
-        N = y - N*(inalt + D - y)/yy0; /* Newton iteration with numerically estimated derivative */
-      else /* Can't do it on first pass */
-        N = inalt + D;
-      yy0 = y;
-      D0 = D;
-      y = N;
-    }
-    refr = D;
-    if (inalt + refr < dip) {
-      if (dret != NULL) {
-	dret[0]=inalt;
-	dret[1]=inalt;
-	dret[2]=0;
-	dret[3]=dip;
-      }
-      return inalt;
-    }
-    if (dret != NULL) {
-      dret[0]=inalt;
-      dret[1]=inalt+refr;
-      dret[2]=refr;
-      dret[3]=dip;
-    }
-    return inalt+refr;
+    return refrac_true_to_app(inalt, atpress, attemp, dip, tab, dret);
   } else {
-    refr = calc_astronomical_refr(inalt,atpress,attemp);
+    if (tab != NULL)
+      refr = refr_table_app(tab, inalt);
+    else
+      refr = calc_astronomical_refr(inalt,atpress,attemp);
     trualt=inalt-refr;
     //printf("inalt=%f, dip=%f\n", inalt, dip);
     if (dret != NULL) {
@@ -3116,6 +3338,64 @@ double CALL_CONV swe_refrac_extended(double inalt, double geoalt, double atpress
   }
 }
 
+/* conversion from true to apparent altitude for swe_refrac_extended(),
+ * with the dip of the horizon precomputed; tab may be NULL */
+static double refrac_true_to_app(double inalt, double atpress, double attemp, double dip, struct refr_table *tab, double *dret)
+{
+  double refr;
+  double D, D0, N, y, yy0;
+  int i;
+  /* make sure that inalt <=90 */
+  if( (inalt>90) )
+    inalt=180-inalt;
+  if (inalt < -10) {
+    if (dret != NULL) {
+      dret[0]=inalt;
+      dret[1]=inalt;
+      dret[2]=0;
+      dret[3]=dip;
+    }
+    return inalt;
+  }
+  if (tab != NULL && refr_table_true(tab, inalt, &refr) == OK)
+    goto found;
+  /* by iteration */
+  y = inalt;
+  D = 0.0;
+  yy0 = 0;
+  D0 = D;
+  for(i=0; i<5; i++) {
+    D = calc_astronomical_refr(y,atpress,attemp);
+    N = y - yy0;
+    yy0 = D - D0 - N; /* denominator of derivative */
+    if (N != 0.0 && yy0 != 0.0) /* sic !!! code by Moshier */
+      N = y - N*(inalt + D - y)/yy0; /* Newton iteration with numerically estimated derivative */
+    else /* Can't do it on first pass */
+      N = inalt + D;
+    yy0 = y;
+    D0 = D;
+    y = N;
+  }
+  refr = D;
+found:
+  if (inalt + refr < dip) {
+    if (dret != NULL) {
+      dret[0]=inalt;
+      dret[1]=inalt;
+      dret[2]=0;
+      dret[3]=dip;
+    }
+    return inalt;
+  }
+  if (dret != NULL) {
+    dret[0]=inalt;
+    dret[1]=inalt+refr;
+    dret[2]=refr;
+    dret[3]=dip;
+  }
+  return inalt+refr;
+}
+
 /* calculate the astronomical refraction
  * input parameters:
  * double inalt        * apparent altitude of object
@@ -3170,6 +3450,200 @@ static double calc_dip(double geoalt, double atpress, double attemp, double laps
   return -180.0/PI * acos(1 / (1 + geoalt / EARTH_RADIUS)) * sqrt(d);
 }
 
+/* Table-driven refraction, see swe_set_refrac_table().
+ *
+ * For every parameter set (geoalt, atpress, attemp, lapse_rate) two tables
+ * are built: the refraction as a function of the apparent altitude and as
+ * a function of the true altitude. Both are piecewise cubic Hermite
+ * interpolations with exact derivatives on a uniform grid, split at the
+ * altitude where Sinclair's formula switches branches (the function is
+ * not smooth there). The inverse table is built by solving
+ * app - refr(app) = true with Newton's method, so neither direction
+ * iterates at lookup time.
+ *
+ * The apparent altitude range is REFR_TAB_HMIN .. 90 degrees; below
+ * REFR_TAB_HMIN Sinclair's formula has a maximum and app -> true is no
+ * longer invertible. Outside the range the exact formulae are used.
+ * With REFR_TAB_NLO/REFR_TAB_NHI intervals, the maximum interpolation
+ * error is 3e-8 degrees (0.0001") for pressures 0..1100 hPa and
+ * temperatures -40..+50 C.
+ * For true -> apparent, this is the error against the converged solution;
+ * the 5-step iteration of the exact path itself deviates from it by up
+ * to 1.2e-4 degrees at low altitudes, high pressure and low temperature.
+ */
+static TLS int32 refr_table_mode = SE_REFRAC_EXACT;
+static TLS struct refr_table refr_tables[REFR_TAB_NCACHE];
+static TLS int refr_table_next = 0;
+
+/* swe_set_refrac_table()
+ * mode = SE_REFRAC_TABLE: swe_refrac_extended(), swe_azalt() and
+ *        swe_azalt_batch() interpolate the refraction in tables; the
+ *        tables for the last REFR_TAB_NCACHE parameter sets are kept.
+ * mode = SE_REFRAC_EXACT: evaluate the formulae (default).
+ */
+void CALL_CONV swe_set_refrac_table(int32 mode)
+{
+  refr_table_mode = mode;
+}
+
+/* the refraction settings of this thread as part of a cache key */
+static void memo_add_refrac(struct swi_memo *m)
+{
+  swi_memo_add(m, &const_lapse_rate, sizeof(const_lapse_rate));
+  swi_memo_add(m, &refr_table_mode, sizeof(refr_table_mode));
+}
+
+/* refraction for apparent altitude h and its derivative d(refr)/dh,
+ * on the branch of calc_astronomical_refr() selected by ihi */
+static double refr_exact_deriv(double h, int ihi, double atpress, double attemp, double *dr)
+{
+  double r0, dr0, num, den, s, k, c, q;
+  if (ihi) {
+    s = sin(h * DEGTORAD);
+    r0 = 0.97 / tan(h * DEGTORAD);
+    dr0 = -0.97 * DEGTORAD / (s * s);
+  } else {
+    num = 34.46 + 4.23 * h + 0.004 * h * h;
+    den = 1 + 0.505 * h + 0.0845 * h * h;
+    r0 = num / den;
+    dr0 = ((4.23 + 0.008 * h) * den - num * (0.505 + 0.169 * h)) / (den * den);
+  }
+  c = (atpress - 80) / 930;
+  k = 0.00008 * (attemp - 10);
+  q = 1 + k * (r0 + 39);
+  *dr = c * (1 + 39 * k) / (q * q) * dr0 / 60.0;
+  return c / q * r0 / 60.0;
+}
+
+static void refr_seg_init(struct refr_seg *sg, double x0, double x1, int n, double *y, double *dy)
+{
+  sg->x0 = x0;
+  sg->step = (x1 - x0) / n;
+  sg->n = n;
+  sg->y = y;
+  sg->dy = dy;
+}
+
+static double refr_seg_eval(const struct refr_seg *sg, double x)
+{
+  double u = (x - sg->x0) / sg->step, t, t1;
+  int i = (int) u;
+  if (i < 0) i = 0;
+  if (i >= sg->n) i = sg->n - 1;
+  t = u - i;
+  t1 = 1 - t;
+  return t1 * t1 * ((1 + 2 * t) * sg->y[i] + t * sg->step * sg->dy[i])
+       + t * t * ((3 - 2 * t) * sg->y[i + 1] - t1 * sg->step * sg->dy[i + 1]);
+}
+
+/* fills the tables of tab; returns ERR if app -> true is not monotonic
+ * for this parameter set */
+static int refr_table_build(struct refr_table *tab)
+{
+  int iseg, i, j, n;
+  double h, r, dr, t, tlo, thi, tbrk;
+  double *y, *dy;
+  struct refr_seg *sg;
+  tab->dip = calc_dip(tab->geoalt, tab->atpress, tab->attemp, tab->lapse_rate);
+  /* refraction as a function of apparent altitude */
+  y = tab->yapp;
+  dy = tab->dyapp;
+  for (iseg = 0; iseg < 2; iseg++) {
+    sg = &tab->app[iseg];
+    n = iseg ? REFR_TAB_NHI : REFR_TAB_NLO;
+    if (iseg == 0)
+      refr_seg_init(sg, REFR_TAB_HMIN, REFR_TAB_HBRK, n, y, dy);
+    else
+      refr_seg_init(sg, REFR_TAB_HBRK, 90, n, y, dy);
+    for (i = 0; i <= n; i++) {
+      h = sg->x0 + i * sg->step;
+      y[i] = refr_exact_deriv(h, iseg, tab->atpress, tab->attemp, &dy[i]);
+      if (dy[i] >= 1)
+	return ERR;
+    }
+    y += n + 1;
+    dy += n + 1;
+  }
+  /* refraction as a function of true altitude */
+  tlo = REFR_TAB_HMIN - tab->app[0].y[0];
+  tbrk = REFR_TAB_HBRK - tab->app[1].y[0];
+  thi = 90 - tab->app[1].y[tab->app[1].n];
+  y = tab->ytru;
+  dy = tab->dytru;
+  for (iseg = 0; iseg < 2; iseg++) {
+    sg = &tab->tru[iseg];
+    n = iseg ? REFR_TAB_NHI : REFR_TAB_NLO;
+    if (iseg == 0)
+      refr_seg_init(sg, tlo, tbrk, n, y, dy);
+    else
+      refr_seg_init(sg, tbrk, thi, n, y, dy);
+    h = iseg ? REFR_TAB_HBRK : REFR_TAB_HMIN;
+    for (i = 0; i <= n; i++) {
+      t = sg->x0 + i * sg->step;
+      for (j = 0; j < 30; j++) {
+	r = refr_exact_deriv(h, iseg, tab->atpress, tab->attemp, &dr);
+	if (fabs(h - r - t) < 1e-13)
+	  break;
+	h -= (h - r - t) / (1 - dr);
+      }
+      if (j == 30)
+	return ERR;
+      y[i] = r;
+      dy[i] = dr / (1 - dr);	/* d(refr)/d(true) */
+    }
+    y += n + 1;
+    dy += n + 1;
+  }
+  return OK;
+}
+
+/* returns the refraction table for the parameter set, or NULL if tables
+ * are switched off or cannot be used for these parameters */
+static struct refr_table *refr_table_get(double geoalt, double atpress, double attemp, double lapse_rate)
+{
+  int i;
+  struct refr_table *tab;
+  if (refr_table_mode != SE_REFRAC_TABLE)
+    return NULL;
+  for (i = 0; i < REFR_TAB_NCACHE; i++) {
+    tab = &refr_tables[i];
+    if (tab->valid != 0 && tab->geoalt == geoalt && tab->atpress == atpress
+	&& tab->attemp == attemp && tab->lapse_rate == lapse_rate)
+      return tab->valid > 0 ? tab : NULL;
+  }
+  tab = &refr_tables[refr_table_next];
+  refr_table_next = (refr_table_next + 1) % REFR_TAB_NCACHE;
+  tab->geoalt = geoalt;
+  tab->atpress = atpress;
+  tab->attemp = attemp;
+  tab->lapse_rate = lapse_rate;
+  /* remember failures too, so that they are not rebuilt on every call */
+  tab->valid = (refr_table_build(tab) == OK) ? 1 : -1;
+  return tab->valid > 0 ? tab : NULL;
+}
+
+/* refraction for apparent altitude inalt */
+static double refr_table_app(const struct refr_table *tab, double inalt)
+{
+  if (inalt >= REFR_TAB_HBRK && inalt <= 90)
+    return refr_seg_eval(&tab->app[1], inalt);
+  if (inalt >= REFR_TAB_HMIN && inalt < REFR_TAB_HBRK)
+    return refr_seg_eval(&tab->app[0], inalt);
+  return calc_astronomical_refr(inalt, tab->atpress, tab->attemp);
+}
+
+/* refraction for true altitude inalt; returns ERR outside the table */
+static int refr_table_true(const struct refr_table *tab, double inalt, double *refr)
+{
+  if (inalt >= tab->tru[1].x0 && inalt <= tab->tru[1].x0 + tab->tru[1].n * tab->tru[1].step)
+    *refr = refr_seg_eval(&tab->tru[1], inalt);
+  else if (inalt >= tab->tru[0].x0 && inalt < tab->tru[1].x0)
+    *refr = refr_seg_eval(&tab->tru[0], inalt);
+  else
+    return ERR;
+  return OK;
+}
+
 
 /* Computes attributes of a lunar eclipse for given tjd and geopos
  * 
@@ -3379,6 +3853,25 @@ static int32 lun_eclipse_how(
  */
 int32 CALL_CONV swe_lun_eclipse_when(double tjd_start, int32 ifl, int32 ifltype,
      double *tret, int32 backward, char *serr)
+{
+  struct swi_memo m;
+  int32 retflag;
+  if (swi_eclidx_when(SE_ECLIDX_LUNAR, tjd_start, ifl, ifltype, backward, tret, &retflag))
+    return retflag;
+  if (!swi_memo_begin(&m, SEI_MEMO_LUN_ECLIPSE, ifl, serr))
+    return swi_lun_eclipse_when(tjd_start, ifl, ifltype, tret, backward, serr);
+  swi_memo_add(&m, &tjd_start, sizeof(tjd_start));
+  swi_memo_add(&m, &ifltype, sizeof(ifltype));
+  swi_memo_add(&m, &backward, sizeof(backward));
+  if (swi_memo_get(&m, &retflag, tret, 10, NULL))
+    return retflag;
+  retflag = swi_lun_eclipse_when(tjd_start, ifl, ifltype, tret, backward, m.serr);
+  swi_memo_put(&m, retflag, tret, 10, NULL);
+  return retflag;
+}
+
+int32 swi_lun_eclipse_when(double tjd_start, int32 ifl, int32 ifltype,
+     double *tret, int32 backward, char *serr)
 {
   int i, j, m, n, o, i1 = 0, i2 = 0;
   int32 retflag = 0, retflag2 = 0;
@@ -3634,6 +4127,24 @@ next_try:
  */
 int32 CALL_CONV swe_lun_eclipse_when_loc(double tjd_start, int32 ifl, 
      double *geopos, double *tret, double *attr, int32 backward, char *serr)
+{
+  struct swi_memo m;
+  int32 retflag;
+  if (geopos == NULL || !swi_memo_begin(&m, SEI_MEMO_LUN_ECLIPSE_LOC, ifl, serr))
+    return lun_eclipse_when_loc(tjd_start, ifl, geopos, tret, attr, backward, serr);
+  swi_memo_add(&m, &tjd_start, sizeof(tjd_start));
+  swi_memo_add(&m, geopos, 3 * sizeof(double));
+  swi_memo_add(&m, &backward, sizeof(backward));
+  memo_add_refrac(&m);
+  if (memo_get_local(&m, &retflag, tret, attr, NULL))
+    return retflag;
+  retflag = lun_eclipse_when_loc(tjd_start, ifl, geopos, tret, attr, backward, m.serr);
+  memo_put_local(&m, retflag, tret, attr, NULL);
+  return retflag;
+}
+
+static int32 lun_eclipse_when_loc(double tjd_start, int32 ifl, 
+     double *geopos, double *tret, double *attr, int32 backward, char *serr)
 {
   int32 retflag = 0, retflag2 = 0, retc;
   double tjdr, tjds, tjd_max = 0;
@@ -3645,7 +4156,7 @@ int32 CALL_CONV swe_lun_eclipse_when_loc(double tjd_start, int32 ifl,
   }
   ifl &= ~(SEFLG_JPLHOR | SEFLG_JPLHOR_APPROX);
 next_lun_ecl:
-  if ((retflag = swe_lun_eclipse_when(tjd_start, ifl, 0, tret, backward, serr)) == ERR) {
+  if ((retflag = swi_lun_eclipse_when(tjd_start, ifl, 0, tret, backward, serr)) == ERR) {
     return ERR;
   }
   /*  
@@ -3790,85 +4301,55 @@ static const double mag_elem[NMAG_ELEM][4] = {
                 {5.33, 0.32, 0, 0},     /* Juno */
                 {3.20, 0.32, 0, 0},     /* Vesta */
                 };
-int32 CALL_CONV swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char *serr)
+/* flags and body numbers as swe_pheno() uses them */
+static int32 pheno_flags(int32 *ipl, int32 iflag)
 {
-  int i;
-  double xx[6], xx2[6], xxs[6], lbr[6], lbr2[6], dt = 0, dd;
-  double fac;
-  double T, in, om, sinB;
-  double ph1, ph2, me[2];
-  int32 iflagp, epheflag, retflag, epheflag2;
-  char serr2[AS_MAXCH];
-  *serr2 = '\0';
   iflag &= ~(SEFLG_JPLHOR | SEFLG_JPLHOR_APPROX);
   /* function calls for Pluto with asteroid number 134340
    * are treated as calls for Pluto as main body SE_PLUTO */
-  if (ipl == SE_AST_OFFSET + 134340)
-    ipl = SE_PLUTO;
-  for (i = 0; i < 20; i++)
-    attr[i] = 0;
+  if (*ipl == SE_AST_OFFSET + 134340)
+    *ipl = SE_PLUTO;
   /* Ceres - Vesta must be SE_CERES etc., not 10001 etc. */
-  if (ipl > SE_AST_OFFSET && ipl <= SE_AST_OFFSET + 4)
-        ipl = ipl - SE_AST_OFFSET - 1 + SE_CERES;
-  iflag = iflag & (SEFLG_EPHMASK | 
+  if (*ipl > SE_AST_OFFSET && *ipl <= SE_AST_OFFSET + 4)
+        *ipl = *ipl - SE_AST_OFFSET - 1 + SE_CERES;
+  return iflag & (SEFLG_EPHMASK | 
                    SEFLG_TRUEPOS | 
                    SEFLG_J2000 | 
                    SEFLG_NONUT |
                    SEFLG_NOGDEFL |
                    SEFLG_NOABERR |
                    SEFLG_TOPOCTR);
-  iflagp = iflag & (SEFLG_EPHMASK | 
-                   SEFLG_TRUEPOS | 
-                   SEFLG_J2000 | 
-                   SEFLG_NONUT |
-                   SEFLG_NOABERR);
-  iflagp |= SEFLG_HELCTR;                
-  epheflag = iflag & SEFLG_EPHMASK;
-  /*  
-   * geocentric planet
-   */
-  if ((retflag = swe_calc(tjd, (int) ipl, iflag | SEFLG_XYZ, xx, serr)) == ERR)
-    /* int cast can be removed when swe_calc() gets int32 ipl definition */
-    return ERR;
-  // check epheflag and adjust iflag
-  epheflag2 = retflag & SEFLG_EPHMASK;
-  if (epheflag != epheflag2) {
-    iflag &= ~epheflag;
-    iflagp &= ~epheflag;
-    iflag |= epheflag2;
-    iflagp |= epheflag2;
-    epheflag = epheflag2;
-  }
-  if (swe_calc(tjd, (int) ipl, iflag, lbr, serr) == ERR)
-    /* int cast can be removed when swe_calc() gets int32 ipl definition */
-    return ERR;
-  /* if moon, we need sun as well, for magnitude */
-  if (ipl == SE_MOON) {
-    if (swe_calc(tjd, SE_SUN, iflag | SEFLG_XYZ, xxs, serr) == ERR)
-      return ERR;
-  }
-  if (ipl != SE_SUN && ipl != SE_EARTH &&
+}
+
+/* bodies with a phase, i.e. with a heliocentric position */
+static AS_BOOL pheno_has_phase(int32 ipl)
+{
+  return ipl != SE_SUN && ipl != SE_EARTH &&
     ipl != SE_MEAN_NODE && ipl != SE_TRUE_NODE &&
-    ipl != SE_MEAN_APOG && ipl != SE_OSCU_APOG) {
-    /*
-     * light time planet - earth
-     */
-    dt = lbr[2] * AUNIT / CLIGHT / 86400.0;     
-        if (iflag & SEFLG_TRUEPOS)
-      dt = 0;
-    /* 
-     * heliocentric planet at tjd - dt
-     */
-    if (swe_calc(tjd - dt, (int) ipl, iflagp | SEFLG_XYZ, xx2, serr) == ERR)
-    /* int cast can be removed when swe_calc() gets int32 ipl definition */
-      return ERR;
-    if (swe_calc(tjd - dt, (int) ipl, iflagp, lbr2, serr) == ERR)
-    /* int cast can be removed when swe_calc() gets int32 ipl definition */
-      return ERR;
+    ipl != SE_MEAN_APOG && ipl != SE_OSCU_APOG;
+}
+
+/* 
+ * attributes of swe_pheno() from positions:
+ * xx, lbr	geocentric body, cartesian and polar
+ * xh, lbrh	heliocentric body at tjd - dt (light-time), 
+ *		NULL if the body has no phase
+ * xs		geocentric Sun, cartesian; NULL for Sun and Earth
+ */
+static int32 pheno_attr(double tjd, int32 ipl, int32 iflag, double *xx, double *lbr, 
+	double *xh, double *lbrh, double dt, double *xs, double *attr, char *serr)
+{
+  double fac, dd;
+  double T, in, om, sinB;
+  double ph1, ph2, me[2];
+  int32 epheflag = iflag & SEFLG_EPHMASK;
+  char serr2[AS_MAXCH];
+  *serr2 = '\0';
+  if (xh != NULL) {
     /*
      * phase angle
      */
-    attr[0] = acos(swi_dot_prod_unit(xx, xx2)) * RADTODEG;
+    attr[0] = acos(swi_dot_prod_unit(xx, xh)) * RADTODEG;
     /*
      * phase
      */
@@ -3903,7 +4384,7 @@ int32 CALL_CONV swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char
      if (a<=147.1385465) {
        /* formula according to Allen, C.W., 1976, Astrophysical Quantities */
        attr[4] = -21.62 + 0.026 * fabs(a) + 0.000000004 * pow(a, 4);
-       attr[4]+=5 * log10(lbr[2] * lbr2[2] * AUNIT / EARTH_RADIUS);
+       attr[4]+=5 * log10(lbr[2] * lbrh[2] * AUNIT / EARTH_RADIUS);
      } else {
        /* using the cube phase angle proposed by Samaha (Samaha, A.E.; Asaad,
 	A. S. and Mikhail, J. S. (1969).
@@ -3912,11 +4393,11 @@ int32 CALL_CONV swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char
 	of 147.14degrees.
        */
        attr[4] = -4.5444 - (2.5 * log10(pow(180 - a, 3)));
-       attr[4]+=5 * log10(lbr[2] * lbr2[2] * AUNIT / EARTH_RADIUS);
+       attr[4]+=5 * log10(lbr[2] * lbrh[2] * AUNIT / EARTH_RADIUS);
      } 
 #else
       /* formula according to Allen, C.W., 1976, Astrophysical Quantities */
-      attr[4] = -21.62 + 5 * log10(lbr[2] * lbr2[2] * AUNIT / EARTH_RADIUS) + 0.026 * fabs(attr[0]) + 0.000000004 * pow(attr[0], 4);
+      attr[4] = -21.62 + 5 * log10(lbr[2] * lbrh[2] * AUNIT / EARTH_RADIUS) + 0.026 * fabs(attr[0]) + 0.000000004 * pow(attr[0], 4);
 #endif      
 #if MAG_MALLAMA_2018
     // see: A. Mallama, J.Hilton,
@@ -3926,7 +4407,7 @@ int32 CALL_CONV swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char
       double a = attr[0];
       double a2 = a * a; double a3 = a2 * a; double a4 = a3 * a; double a5 = a4 * a; double a6 = a5 * a; 
       attr[4] = -0.613 + a * 6.3280E-02 - a2 * 1.6336E-03 + a3 * 3.3644E-05 - a4 * 3.4265E-07 + a5 * 1.6893E-09 - a6 * 3.0334E-12;
-      attr[4] += 5 * log10(lbr2[2] * lbr[2]);
+      attr[4] += 5 * log10(lbrh[2] * lbr[2]);
     } else if (ipl == SE_VENUS) {
       double a = attr[0];
       double a2 = a * a; double a3 = a2 * a; double a4 = a3 * a; 
@@ -3934,7 +4415,7 @@ int32 CALL_CONV swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char
 	attr[4] = -4.384 - a * 1.044E-03 + a2 * 3.687E-04 - a3 * 2.814E-06 + a4 * 8.938E-09;
       else 
 	attr[4] = 236.05828 - a * 2.81914E+00 + a2 * 8.39034E-03;
-      attr[4] += 5 * log10(lbr2[2] * lbr[2]);
+      attr[4] += 5 * log10(lbrh[2] * lbr[2]);
       if (attr[0] > 179.0)
         sprintf(serr2, "magnitude value for Venus at phase angle i=%.1f is bad; formula is valid only for i < 179.0", attr[0]);
     } else if (ipl == SE_MARS) {
@@ -3955,13 +4436,13 @@ int32 CALL_CONV swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char
 	attr[4] = -1.601 + a * 0.02267 - a2 * 0.0001302; 
       else  // irrelevant to earth-centered observation
 	attr[4] = -0.367 - a * 0.02573 + a2 * 0.0003445;
-      attr[4] += 5 * log10(lbr2[2] * lbr[2]);
+      attr[4] += 5 * log10(lbrh[2] * lbr[2]);
     } else if (ipl == SE_JUPITER) {
       /* the phase angle of Jupiter never exceeds 12°. */
       double a = attr[0];
       double a2 = a * a; 
       attr[4] = -9.395 - a * 3.7E-04 + a2 * 6.16E-04;
-      attr[4] += 5 * log10(lbr2[2] * lbr[2]);
+      attr[4] += 5 * log10(lbrh[2] * lbr[2]);
     } else if (ipl == SE_SATURN) {
       double a = attr[0];
       double sinB2;
@@ -3977,12 +4458,12 @@ int32 CALL_CONV swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char
       sinB = (sin(in) * cos(lbr[1] * DEGTORAD) 
                     * sin(lbr[0] * DEGTORAD - om)
                     - cos(in) * sin(lbr[1] * DEGTORAD));
-      sinB2 = (sin(in) * cos(lbr2[1] * DEGTORAD) 
-                    * sin(lbr2[0] * DEGTORAD - om)
-                    - cos(in) * sin(lbr2[1] * DEGTORAD));
+      sinB2 = (sin(in) * cos(lbrh[1] * DEGTORAD) 
+                    * sin(lbrh[0] * DEGTORAD - om)
+                    - cos(in) * sin(lbrh[1] * DEGTORAD));
       sinB = fabs(sin((asin(sinB) + asin(sinB2)) / 2.0));/**/
       attr[4] = -8.914 - 1.825 * sinB + 0.026 * a - 0.378 * sinB * pow(2.7182818,-2.25 * a);
-      attr[4] += 5 * log10(lbr2[2] * lbr[2]);
+      attr[4] += 5 * log10(lbrh[2] * lbr[2]);
     } else if (ipl == SE_URANUS) { 
       // This is a simplified solution ignoring the term depending on
       // sub-Earth latitude. The difference from Horizons is +-0.03m.
@@ -3990,7 +4471,7 @@ int32 CALL_CONV swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char
       double a2 = a * a; 
       double fi_ = 0; // sub-Earth latitude in deg; ignored here
       attr[4] = -7.110 - 8.4E-04 * fi_ + a * 6.587E-3 + a2 * 1.045E-4;
-      attr[4] += 5 * log10(lbr2[2] * lbr[2]);
+      attr[4] += 5 * log10(lbrh[2] * lbr[2]);
       // instead of the term with fi_, we do subtract the 0.05m.
       // the remaining error is +-0.03m
       attr[4] -= 0.05; 
@@ -4004,7 +4485,7 @@ int32 CALL_CONV swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char
       } else {
 	attr[4] = -7.00;
       }
-      attr[4] += 5 * log10(lbr2[2] * lbr[2]);
+      attr[4] += 5 * log10(lbrh[2] * lbr[2]);
 #else
     } else if (ipl == SE_SATURN) {
       double u1, u2, du;
@@ -4015,23 +4496,23 @@ int32 CALL_CONV swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char
       sinB = fabs(sin(in) * cos(lbr[1] * DEGTORAD) 
                     * sin(lbr[0] * DEGTORAD - om)
                     - cos(in) * sin(lbr[1] * DEGTORAD));
-      u1 = atan2(sin(in) * tan(lbr2[1] * DEGTORAD) 
-                             + cos(in) * sin(lbr2[0] * DEGTORAD - om), 
-                        cos(lbr2[0] * DEGTORAD - om)) * RADTODEG;
+      u1 = atan2(sin(in) * tan(lbrh[1] * DEGTORAD) 
+                             + cos(in) * sin(lbrh[0] * DEGTORAD - om), 
+                        cos(lbrh[0] * DEGTORAD - om)) * RADTODEG;
       u2 = atan2(sin(in) * tan(lbr[1] * DEGTORAD) 
                              + cos(in) * sin(lbr[0] * DEGTORAD - om), 
                         cos(lbr[0] * DEGTORAD - om)) * RADTODEG;
       du = swe_degnorm(u1 - u2);
       if (du > 10) 
         du = 360 - du;
-      attr[4] = 5 * log10(lbr2[2] * lbr[2])
+      attr[4] = 5 * log10(lbrh[2] * lbr[2])
                   + mag_elem[ipl][1] * sinB
                   + mag_elem[ipl][2] * sinB * sinB
                   + mag_elem[ipl][3] * du
                   + mag_elem[ipl][0];
 #endif
     } else if (ipl < SE_CHIRON) {
-      attr[4] = 5 * log10(lbr2[2] * lbr[2])
+      attr[4] = 5 * log10(lbrh[2] * lbr[2])
                   + mag_elem[ipl][1] * attr[0] /100.0
                   + mag_elem[ipl][2] * attr[0] * attr[0] / 10000.0
                   + mag_elem[ipl][3] * attr[0] * attr[0] * attr[0] / 1000000.0
@@ -4050,22 +4531,18 @@ int32 CALL_CONV swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char
         me[0] = swed.ast_H;
         me[1] = swed.ast_G;
       }
-      attr[4] = 5 * log10(lbr2[2] * lbr[2])
+      attr[4] = 5 * log10(lbrh[2] * lbr[2])
           + me[0]
           - 2.5 * log10((1 - me[1]) * ph1 + me[1] * ph2);
     } else { /* ficticious bodies */
       attr[4] = 0;
     }
   }
-  if (ipl != SE_SUN && ipl != SE_EARTH) {
+  if (xs != NULL) {
     /* 
      * elongation of planet
      */
-    if (swe_calc(tjd, SE_SUN, iflag | SEFLG_XYZ, xx2, serr) == ERR)
-      return ERR;
-    if (swe_calc(tjd, SE_SUN, iflag, lbr2, serr) == ERR)
-      return ERR;
-    attr[2] = acos(swi_dot_prod_unit(xx, xx2)) * RADTODEG;
+    attr[2] = acos(swi_dot_prod_unit(xx, xs)) * RADTODEG;
   }
   /* horizontal parallax */
   if (ipl == SE_MOON) {
@@ -4113,6 +4590,68 @@ int32 CALL_CONV swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char
   return iflag;
 }
 
+int32 CALL_CONV swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char *serr)
+{
+  int i;
+  double xx[6], lbr[6], xh[6], lbrh[6], xs[6], dt = 0;
+  int32 iflagp, epheflag, retflag, epheflag2;
+  for (i = 0; i < 20; i++)
+    attr[i] = 0;
+  iflag = pheno_flags(&ipl, iflag);
+  iflagp = iflag & (SEFLG_EPHMASK | 
+                   SEFLG_TRUEPOS | 
+                   SEFLG_J2000 | 
+                   SEFLG_NONUT |
+                   SEFLG_NOABERR);
+  iflagp |= SEFLG_HELCTR;                
+  epheflag = iflag & SEFLG_EPHMASK;
+  /*  
+   * geocentric planet
+   */
+  if ((retflag = swe_calc(tjd, (int) ipl, iflag | SEFLG_XYZ, xx, serr)) == ERR)
+    /* int cast can be removed when swe_calc() gets int32 ipl definition */
+    return ERR;
+  // check epheflag and adjust iflag
+  epheflag2 = retflag & SEFLG_EPHMASK;
+  if (epheflag != epheflag2) {
+    iflag &= ~epheflag;
+    iflagp &= ~epheflag;
+    iflag |= epheflag2;
+    iflagp |= epheflag2;
+    epheflag = epheflag2;
+  }
+  if (swe_calc(tjd, (int) ipl, iflag, lbr, serr) == ERR)
+    /* int cast can be removed when swe_calc() gets int32 ipl definition */
+    return ERR;
+  if (pheno_has_phase(ipl)) {
+    /*
+     * light time planet - earth
+     */
+    dt = lbr[2] * AUNIT / CLIGHT / 86400.0;     
+    if (iflag & SEFLG_TRUEPOS)
+      dt = 0;
+    /* 
+     * heliocentric planet at tjd - dt
+     */
+    if (swe_calc(tjd - dt, (int) ipl, iflagp | SEFLG_XYZ, xh, serr) == ERR)
+    /* int cast can be removed when swe_calc() gets int32 ipl definition */
+      return ERR;
+    if (swe_calc(tjd - dt, (int) ipl, iflagp, lbrh, serr) == ERR)
+    /* int cast can be removed when swe_calc() gets int32 ipl definition */
+      return ERR;
+  }
+  /* 
+   * Sun, for elongation
+   */
+  if (ipl != SE_SUN && ipl != SE_EARTH) {
+    if (swe_calc(tjd, SE_SUN, iflag | SEFLG_XYZ, xs, serr) == ERR)
+      return ERR;
+  }
+  return pheno_attr(tjd, ipl, iflag, xx, lbr, 
+      pheno_has_phase(ipl) ? xh : NULL, lbrh, dt,
+      (ipl != SE_SUN && ipl != SE_EARTH) ? xs : NULL, attr, serr);
+}
+
 int32 CALL_CONV swe_pheno_ut(double tjd_ut, int32 ipl, int32 iflag, double *attr, char *serr)
 {
   double deltat;
@@ -4132,6 +4671,215 @@ int32 CALL_CONV swe_pheno_ut(double tjd_ut, int32 ipl, int32 iflag, double *attr
   return retflag;
 }
 
+/* 
+ * swe_pheno() for batch calls: flags are already normalised, and
+ * the polar coordinates are derived from the cartesian ones instead 
+ * of being calculated a second time.
+ * xsun		geocentric Sun, cartesian, if already known; otherwise NULL
+ */
+static int32 pheno_calc(double tjd, int32 ipl, int32 iflag, double *xsun, double *attr, char *serr)
+{
+  int i;
+  double xx[6], lbr[6], xh[6], lbrh[6], xs[6], dt = 0;
+  int32 iflagp, epheflag, retflag, epheflag2;
+  for (i = 0; i < 20; i++)
+    attr[i] = 0;
+  iflagp = iflag & (SEFLG_EPHMASK | 
+                   SEFLG_TRUEPOS | 
+                   SEFLG_J2000 | 
+                   SEFLG_NONUT |
+                   SEFLG_NOABERR);
+  iflagp |= SEFLG_HELCTR;                
+  epheflag = iflag & SEFLG_EPHMASK;
+  if ((retflag = swe_calc(tjd, (int) ipl, iflag | SEFLG_XYZ, xx, serr)) == ERR)
+    return ERR;
+  epheflag2 = retflag & SEFLG_EPHMASK;
+  if (epheflag != epheflag2) {
+    iflag = (iflag & ~epheflag) | epheflag2;
+    iflagp = (iflagp & ~epheflag) | epheflag2;
+    xsun = NULL;	/* was calculated with another ephemeris */
+  }
+  swi_cartpol(xx, lbr);
+  lbr[0] *= RADTODEG;
+  lbr[1] *= RADTODEG;
+  if (pheno_has_phase(ipl)) {
+    dt = lbr[2] * AUNIT / CLIGHT / 86400.0;     
+    if (iflag & SEFLG_TRUEPOS)
+      dt = 0;
+    if (swe_calc(tjd - dt, (int) ipl, iflagp | SEFLG_XYZ, xh, serr) == ERR)
+      return ERR;
+    swi_cartpol(xh, lbrh);
+    lbrh[0] *= RADTODEG;
+    lbrh[1] *= RADTODEG;
+  }
+  if (ipl != SE_SUN && ipl != SE_EARTH && xsun == NULL) {
+    if (swe_calc(tjd, SE_SUN, iflag | SEFLG_XYZ, xs, serr) == ERR)
+      return ERR;
+    xsun = xs;
+  }
+  return pheno_attr(tjd, ipl, iflag, xx, lbr, 
+      pheno_has_phase(ipl) ? xh : NULL, lbrh, dt,
+      (ipl != SE_SUN && ipl != SE_EARTH) ? xsun : NULL, attr, serr);
+}
+
+/* pheno_calc() for UT; if the ephemeris falls back to another one, 
+ * *iflag is changed, so that further calls use it right away */
+static int32 pheno_calc_ut(double tjd_ut, int32 ipl, int32 *iflag, double *attr, char *serr)
+{
+  int32 retflag;
+  double deltat = swe_deltat_ex(tjd_ut, *iflag, serr);
+  if ((retflag = pheno_calc(tjd_ut + deltat, ipl, *iflag, NULL, attr, serr)) == ERR)
+    return ERR;
+  if ((retflag & SEFLG_EPHMASK) != (*iflag & SEFLG_EPHMASK)) {
+    *iflag = (*iflag & ~SEFLG_EPHMASK) | (retflag & SEFLG_EPHMASK);
+    deltat = swe_deltat_ex(tjd_ut, *iflag, serr);
+    retflag = pheno_calc(tjd_ut + deltat, ipl, *iflag, NULL, attr, serr);
+  }
+  return retflag;
+}
+
+/* 
+ * swe_pheno_ut() for n equidistant times tjd_ut, tjd_ut + step, ...
+ * attr		20 * n doubles, the attributes of swe_pheno() for each time
+ */
+int32 CALL_CONV swe_pheno_ut_series(double tjd_ut, double step, int32 n, int32 ipl, int32 iflag, double *attr, char *serr)
+{
+  int32 k, retflag = OK;
+  if (serr != NULL)
+    *serr = '\0';
+  iflag = pheno_flags(&ipl, iflag);
+  if ((iflag & SEFLG_EPHMASK) == 0)
+    iflag |= SEFLG_SWIEPH;
+  for (k = 0; k < n; k++) {
+    if ((retflag = pheno_calc_ut(tjd_ut + k * step, ipl, &iflag, attr + 20 * k, serr)) == ERR)
+      return ERR;
+  }
+  return retflag;
+}
+
+/* 
+ * swe_pheno_ut() for n bodies ipl[0..n-1] at the same time; 
+ * the Sun is calculated only once for all of them.
+ * attr		20 * n doubles, the attributes of swe_pheno() for each body
+ */
+int32 CALL_CONV swe_pheno_ut_planets(double tjd_ut, const int32 *ipl, int32 n, int32 iflag, double *attr, char *serr)
+{
+  int32 k, ip, retflag = OK, iflagk;
+  double deltat, tjd, xs[6];
+  if (serr != NULL)
+    *serr = '\0';
+  ip = SE_SUN;
+  iflag = pheno_flags(&ip, iflag);
+  if ((iflag & SEFLG_EPHMASK) == 0)
+    iflag |= SEFLG_SWIEPH;
+  deltat = swe_deltat_ex(tjd_ut, iflag, serr);
+  tjd = tjd_ut + deltat;
+  if ((retflag = swe_calc(tjd, SE_SUN, iflag | SEFLG_XYZ, xs, serr)) == ERR)
+    return ERR;
+  if ((retflag & SEFLG_EPHMASK) != (iflag & SEFLG_EPHMASK)) {
+    iflag = (iflag & ~SEFLG_EPHMASK) | (retflag & SEFLG_EPHMASK);
+    deltat = swe_deltat_ex(tjd_ut, iflag, serr);
+    tjd = tjd_ut + deltat;
+    if (swe_calc(tjd, SE_SUN, iflag | SEFLG_XYZ, xs, serr) == ERR)
+      return ERR;
+  }
+  for (k = 0; k < n; k++) {
+    ip = ipl[k];
+    pheno_flags(&ip, 0);
+    if ((retflag = pheno_calc(tjd, ip, iflag, xs, attr + 20 * k, serr)) == ERR)
+      return ERR;
+    /* body not available with this ephemeris; recalculate with 
+     * the ephemeris and delta t it falls back to */
+    if ((retflag & SEFLG_EPHMASK) != (iflag & SEFLG_EPHMASK)) {
+      iflagk = iflag;
+      if ((retflag = pheno_calc_ut(tjd_ut, ip, &iflagk, attr + 20 * k, serr)) == ERR)
+	return ERR;
+    }
+  }
+  return retflag;
+}
+
+#define PHENO_EXTR_PREC	0.00001	/* days */
+
+/* 
+ * Searches the maxima (sign > 0) or minima (sign < 0) of the attribute 
+ * attr[iattr] of swe_pheno_ut() between tjd_ut and tjd_ut + (n - 1) * step,
+ * e.g. greatest elongation (iattr = 2, sign = 1) or greatest 
+ * brilliancy (iattr = 4, sign = -1).
+ * The attribute is sampled at the n times; each extremum of the samples
+ * is refined by parabolic interpolation.
+ * step must be small enough that there is no more than one extremum
+ * within 2 steps.
+ * tret		times of the extrema, UT
+ * xret		values of the attribute at these times; may be NULL
+ * nmax		size of tret and xret
+ * returns the number of extrema found (no more than nmax), or ERR
+ */
+int32 CALL_CONV swe_pheno_ut_extrema(double tjd_ut, double step, int32 n, int32 ipl, int32 iflag, int32 iattr, int32 sign, double *tret, double *xret, int32 nmax, char *serr)
+{
+  int32 i, j, nret = 0;
+  double *y, attr[20], dc[3], t, dt, dtint, dy;
+  if (serr != NULL)
+    *serr = '\0';
+  if (iattr < 0 || iattr > 5) {
+    if (serr != NULL)
+      sprintf(serr, "invalid attribute index %d; must be 0 - 5", iattr);
+    return ERR;
+  }
+  if (n < 3 || step <= 0) {
+    if (serr != NULL)
+      strcpy(serr, "at least 3 samples with a positive step are required");
+    return ERR;
+  }
+  iflag = pheno_flags(&ipl, iflag);
+  if ((iflag & SEFLG_EPHMASK) == 0)
+    iflag |= SEFLG_SWIEPH;
+  if ((y = (double *) malloc(n * sizeof(double))) == NULL) {
+    if (serr != NULL)
+      strcpy(serr, "error in malloc()");
+    return ERR;
+  }
+  for (i = 0; i < n; i++) {
+    if (pheno_calc_ut(tjd_ut + i * step, ipl, &iflag, attr, serr) == ERR) {
+      free(y);
+      return ERR;
+    }
+    y[i] = (sign < 0) ? -attr[iattr] : attr[iattr];
+  }
+  for (i = 1; i < n - 1 && nret < nmax; i++) {
+    if (!(y[i] > y[i-1] && y[i] >= y[i+1]))
+      continue;
+    t = tjd_ut + i * step;
+    find_maximum(y[i-1], y[i], y[i+1], step, &dtint, &dy);
+    t += dtint + step;
+    for (dt = step / 3; dt > PHENO_EXTR_PREC; dt /= 3) {
+      for (j = 0; j < 3; j++) {
+	if (pheno_calc_ut(t + (j - 1) * dt, ipl, &iflag, attr, serr) == ERR) {
+	  free(y);
+	  return ERR;
+	}
+	dc[j] = attr[iattr];
+      }
+      /* flat: no better estimate possible */
+      if (dc[0] + dc[2] - 2 * dc[1] == 0)
+	break;
+      find_maximum(dc[0], dc[1], dc[2], dt, &dtint, &dy);
+      t += dtint + dt;
+    }
+    if (xret != NULL) {
+      if (pheno_calc_ut(t, ipl, &iflag, attr, serr) == ERR) {
+	free(y);
+	return ERR;
+      }
+      xret[nret] = attr[iattr];
+    }
+    tret[nret] = t;
+    nret++;
+  }
+  free(y);
+  return nret;
+}
+
 static int find_maximum(double y00, double y11, double y2, double dx, 
                         double *dxret, double *yret)
 {
@@ -5654,6 +6402,37 @@ int32 CALL_CONV swe_nod_aps_ut(double tjd_ut, int32 ipl, int32 iflag,
                       serr);
 }
 
+/* 
+ * swe_nod_aps_ut() for n times tjd_ut[0..n-1] and nipl bodies 
+ * ipl[0..nipl-1]. The bodies are calculated date by date, with delta t
+ * computed once per date.
+ * xnasc, xndsc, xperi, xaphe	6 values per date and body, those of body k
+ *		at date i start at [(i * nipl + k) * 6]; each may be NULL
+ */
+int32 CALL_CONV swe_nod_aps_ut_batch(const double *tjd_ut, int32 n, 
+                      const int32 *ipl, int32 nipl, int32 iflag, 
+                      int32  method,
+                      double *xnasc, double *xndsc, 
+                      double *xperi, double *xaphe, 
+                      char *serr)
+{
+  int32 i, k, j;
+  double tjd_et;
+  for (i = 0; i < n; i++) {
+    tjd_et = tjd_ut[i] + swe_deltat_ex(tjd_ut[i], iflag, serr);
+    for (k = 0; k < nipl; k++) {
+      j = (i * nipl + k) * 6;
+      if (swe_nod_aps(tjd_et, ipl[k], iflag, method, 
+		       xnasc != NULL ? xnasc + j : NULL, 
+		       xndsc != NULL ? xndsc + j : NULL, 
+		       xperi != NULL ? xperi + j : NULL, 
+		       xaphe != NULL ? xaphe + j : NULL, serr) == ERR)
+	return ERR;
+    }
+  }
+  return OK;
+}
+
 #ifdef TEST_ORBEL_AA
 /* Corrections to Gmsm to make orbital elements agree with AA 2011-2013
  * using DE406, or AA 2016 using DE431. Example:
@@ -5731,76 +6510,28 @@ static int32 get_gmsm(double tjd_et, int32 ipl, int32 iflag, double r, double *g
   return OK;
 }
 
-/* Function calculates osculating orbital elements (Kepler elements) of a planet 
- * or asteroid or the Earth-Moon barycentre. 
- * The function returns error if called for the Sun, the lunar nodes, or the apsides.
- * Input parameters:
- * tjd_et	Julian day number, in TT (ET)
- * ipl		object number
- * iflag	can contain 
- *              - ephemeris flag: SEFLG_JPLEPH, SEFLG_SWIEPH, SEFLG_MOSEPH
- * 		- center: 
- * 		  Sun:            SEFLG_HELCTR (assumed as default) or
- * 		  SS Barycentre:  SEFLG_BARYCTR (rel. to solar system barycentre)
- * 		                  (only possible for planets beyond Jupiter)
- *                For elements of the Moon, the calculation is geocentric.
- *              - sum all masses inside the orbit to be computed (method
- *                of Astronomical Almanac):
- *                                SEFLG_ORBEL_AA
- *              - reference ecliptic: SEFLG_J2000;
- * 		  if missing, mean ecliptic of date is chosen (still not implemented)
- * output parameters:
- * dret[]       array of return values, declare as dret[50]
- * dret[0]      semimajor axis (a)
- * dret[1]      eccentricity (e)
- * dret[2]      inclination (in)
- * dret[3]      longitude of ascending node (upper case omega OM)
- * dret[4]      argument of periapsis (lower case omega om)
- * dret[5]      longitude of periapsis (peri) 
- * dret[6]      mean anomaly at epoch (M0) 
- * dret[7]      true anomaly at epoch (N0) 
- * dret[8]      eccentric anomaly at epoch (E0) 
- * dret[9]      mean longitude at epoch (LM) 
- * dret[10]     sidereal orbital period in tropical years
- * dret[11]     mean daily motion
- * dret[12]     tropical period in years
- * dret[13]     synodic period in days,
- *              negative, if inner planet (Venus, Mercury, Aten asteroids) or Moon
- * dret[14]     time of perihelion passage
- * dret[15]     perihelion distance
- * dret[16]     aphelion distance
-*/
-int32 CALL_CONV swe_get_orbital_elements(
-  double tjd_et, 
-  int32 ipl, int32 iflag, 
-  double *dret,
-  char *serr) 
+/* state vector J2000 (heliocentric, barycentric or, for the Moon, 
+ * geocentric) and gravitational parameter for swe_get_orbital_elements() */
+static int32 orbel_state(double tjd_et, int32 ipl, int32 iflag, double *xpos, double *gmsm, char *serr)
 {
   int j;
-  double x[6], xpos[6], xposm[6], xn[6], xs[6], xnorm[6], xq[6], xa[6] ;
+  double x[6], xposm[6];
   //int32 iflJ2000 = (iflag & SEFLG_EPHMASK)|SEFLG_J2000|SEFLG_EQUATORIAL|SEFLG_XYZ|SEFLG_TRUEPOS|SEFLG_NONUT|SEFLG_SPEED;
   int32 iflJ2000 = (iflag & SEFLG_EPHMASK)|SEFLG_J2000|SEFLG_XYZ|SEFLG_TRUEPOS|SEFLG_NONUT|SEFLG_SPEED;
   int32 iflJ2000p = (iflag & SEFLG_EPHMASK)|SEFLG_J2000|SEFLG_TRUEPOS|SEFLG_NONUT|SEFLG_SPEED;
-  double Gmsm;
-  int32 iflg0 = 0;
-  double fac, sgn, rxy, rxyz, c2, cosnode, sinnode;
-  double incl, node, parg, peri, mlon;
-  double csid, ctro, csyn, dmot, pa;
-  double ytrop, ysid, T, T2, T3, T4, T5;
-  double sinincl, cosincl, cosu, sinu, uu, eanom, tanom, manom;
-  double v2, sema, pp, ecce, cosE, sinE, ny, ny2, rn, rn2, ro, ro2, cosE2;
-  double r, ecce2;
+  double r = 0;
   if (ipl <= 0 || ipl == SE_MEAN_NODE || ipl == SE_TRUE_NODE || ipl == SE_MEAN_APOG || ipl == SE_OSCU_APOG || ipl == SE_INTP_APOG || ipl == SE_INTP_PERG) {
     if (serr != NULL)
       sprintf(serr, "error in swe_get_orbital_elements(): object %d not valid\n", ipl);
     return ERR;
   }
-  if (ipl != SE_MOON)
-    iflg0 |= SEFLG_HELCTR;
-  /* first, we need a heliocentric distance of the planet */
-  if (swe_calc(tjd_et, ipl, iflJ2000p, x, serr) == ERR)
-    return ERR;
-  r =  x[2];
+  /* first, we need a heliocentric distance of the planet;
+   * it is only used for barycentric elements and with SEFLG_ORBEL_AA */
+  if (iflag & (SEFLG_BARYCTR | SEFLG_ORBEL_AA)) {
+    if (swe_calc(tjd_et, ipl, iflJ2000p, x, serr) == ERR)
+      return ERR;
+    r =  x[2];
+  }
   if (ipl != SE_MOON) {
     if ((iflag & SEFLG_BARYCTR) && r > 6) {
       iflJ2000 |= SEFLG_BARYCTR; /* only planets beyond Jupiter */
@@ -5808,7 +6539,7 @@ int32 CALL_CONV swe_get_orbital_elements(
       iflJ2000 |= SEFLG_HELCTR;
     }
   }
-  if (get_gmsm(tjd_et, ipl, iflag, r, &Gmsm, serr))
+  if (get_gmsm(tjd_et, ipl, iflag, r, gmsm, serr))
     return ERR;
   if (swe_calc(tjd_et, ipl, iflJ2000, xpos, serr) == ERR)
     return ERR;
@@ -5819,6 +6550,21 @@ int32 CALL_CONV swe_get_orbital_elements(
     for (j = 0; j <= 5; j++)
       xpos[j] += xposm[j] / (EARTH_MOON_MRAT + 1.0);
   }
+  return OK;
+}
+
+/* orbital elements from the state vector xpos, see swe_get_orbital_elements() */
+static void orbel_from_state(double tjd_et, int32 ipl, double *xpos, double Gmsm, double *dret)
+{
+  int j;
+  double xn[6], xs[6], xnorm[6], xq[6], xa[6] ;
+  double fac, sgn, rxy, rxyz, c2, cosnode, sinnode;
+  double incl, node, parg, peri, mlon;
+  double csid, ctro, csyn, dmot, pa;
+  double ytrop, ysid, T, T2, T3, T4, T5;
+  double sinincl, cosincl, cosu, sinu, uu, eanom, tanom, manom;
+  double v2, sema, pp, ecce, cosE, sinE, ny, ny2, rn, rn2, ro, ro2, cosE2;
+  double ecce2;
   fac = xpos[2] / xpos[5];
   sgn = xpos[5] / fabs(xpos[5]);
   for (j = 0; j <= 2; j++) {
@@ -5958,6 +6704,98 @@ int32 CALL_CONV swe_get_orbital_elements(
 //  printf("tan=%f, ean=%f, man=%f, mlon=%f\n", dret[7], dret[8], dret[6], dret[9]);
 //  printf("cyc=%f, dmot=%f, cyct=%f, cycs=%f\n", dret[10], dret[11], dret[12], dret[13]);
 //  printf("tperi=%f, rperi=%f, raph=%f\n", dret[14], dret[15], dret[16]);
+}
+
+/* Function calculates osculating orbital elements (Kepler elements) of a planet 
+ * or asteroid or the Earth-Moon barycentre. 
+ * The function returns error if called for the Sun, the lunar nodes, or the apsides.
+ * Input parameters:
+ * tjd_et	Julian day number, in TT (ET)
+ * ipl		object number
+ * iflag	can contain 
+ *              - ephemeris flag: SEFLG_JPLEPH, SEFLG_SWIEPH, SEFLG_MOSEPH
+ * 		- center: 
+ * 		  Sun:            SEFLG_HELCTR (assumed as default) or
+ * 		  SS Barycentre:  SEFLG_BARYCTR (rel. to solar system barycentre)
+ * 		                  (only possible for planets beyond Jupiter)
+ *                For elements of the Moon, the calculation is geocentric.
+ *              - sum all masses inside the orbit to be computed (method
+ *                of Astronomical Almanac):
+ *                                SEFLG_ORBEL_AA
+ *              - reference ecliptic: SEFLG_J2000;
+ * 		  if missing, mean ecliptic of date is chosen (still not implemented)
+ * output parameters:
+ * dret[]       array of return values, declare as dret[50]
+ * dret[0]      semimajor axis (a)
+ * dret[1]      eccentricity (e)
+ * dret[2]      inclination (in)
+ * dret[3]      longitude of ascending node (upper case omega OM)
+ * dret[4]      argument of periapsis (lower case omega om)
+ * dret[5]      longitude of periapsis (peri) 
+ * dret[6]      mean anomaly at epoch (M0) 
+ * dret[7]      true anomaly at epoch (N0) 
+ * dret[8]      eccentric anomaly at epoch (E0) 
+ * dret[9]      mean longitude at epoch (LM) 
+ * dret[10]     sidereal orbital period in tropical years
+ * dret[11]     mean daily motion
+ * dret[12]     tropical period in years
+ * dret[13]     synodic period in days,
+ *              negative, if inner planet (Venus, Mercury, Aten asteroids) or Moon
+ * dret[14]     time of perihelion passage
+ * dret[15]     perihelion distance
+ * dret[16]     aphelion distance
+*/
+int32 CALL_CONV swe_get_orbital_elements(
+  double tjd_et, 
+  int32 ipl, int32 iflag, 
+  double *dret,
+  char *serr) 
+{
+  double xpos[6], Gmsm;
+  if (orbel_state(tjd_et, ipl, iflag, xpos, &Gmsm, serr) == ERR)
+    return ERR;
+  orbel_from_state(tjd_et, ipl, xpos, Gmsm, dret);
+  return OK;
+}
+
+#define ORBEL_NRET	17	/* values per body in swe_get_orbital_elements_ut_batch() */
+
+/* 
+ * swe_get_orbital_elements() for n times tjd_ut[0..n-1] (UT) and nipl 
+ * bodies ipl[0..nipl-1].
+ * The state vectors of all bodies are gathered for each date, so that
+ * the Earth, Sun and nutation are evaluated once per date, and are then
+ * converted to elements in one pass.
+ * dret		ORBEL_NRET (17) values per date and body, in the order of 
+ *		swe_get_orbital_elements(); those of body k at date i start
+ *		at dret[(i * nipl + k) * 17]
+ */
+int32 CALL_CONV swe_get_orbital_elements_ut_batch(const double *tjd_ut, int32 n, const int32 *ipl, int32 nipl, int32 iflag, double *dret, char *serr)
+{
+  int32 i, k;
+  double tjd_et, *xpos, *gmsm, de[50];
+  if (n <= 0 || nipl <= 0)
+    return OK;
+  if ((xpos = (double *) malloc(nipl * 7 * sizeof(double))) == NULL) {
+    if (serr != NULL)
+      strcpy(serr, "error in malloc()");
+    return ERR;
+  }
+  gmsm = xpos + nipl * 6;
+  for (i = 0; i < n; i++) {
+    tjd_et = tjd_ut[i] + swe_deltat_ex(tjd_ut[i], iflag, serr);
+    for (k = 0; k < nipl; k++) {
+      if (orbel_state(tjd_et, ipl[k], iflag, xpos + 6 * k, gmsm + k, serr) == ERR) {
+	free(xpos);
+	return ERR;
+      }
+    }
+    for (k = 0; k < nipl; k++) {
+      orbel_from_state(tjd_et, ipl[k], xpos + 6 * k, gmsm[k], de);
+      memcpy(dret + (i * nipl + k) * ORBEL_NRET, de, ORBEL_NRET * sizeof(double));
+    }
+  }
+  free(xpos);
   return OK;
 }
 
@@ -6020,7 +6858,6 @@ static void osc_iterate_max_dist(double ean, double *pqr, double *xa, double *xb
   double r, rmax, eansv = 0, dstep, dstep_min = 1;
   if (high_prec)
     dstep_min = 0.000001;
-  ean = 0;
   osc_get_ecl_pos(ean, pqr, xa);
   r = get_dist_from_2_vectors(xb, xa);
   rmax = r;
@@ -6056,7 +6893,6 @@ static void osc_iterate_min_dist(double ean, double *pqr, double *xa, double *xb
   double r, rmin, eansv = 0, dstep, dstep_min = 1;
   if (high_prec)
     dstep_min = 0.000001;
-  ean = 0;
   osc_get_ecl_pos(ean, pqr, xa);
   r = get_dist_from_2_vectors(xb, xa);
   rmin = r;
@@ -6118,52 +6954,72 @@ static int32 orbit_max_min_true_distance_helio(double tjd_et, int ipl, int32 ifl
   return retval;
 }
 
-/* This function calculates calculates the maximum possible distance, the
- * minimum possible distance, and the current true distance of planet, the EMB,
- * or an asteroid. The calculation can be done either heliocentrically or
- * geocentrically. With heliocentric calculations, it is based on the momentary
- * Kepler ellipse of the planet. With geocentric calculations, it is based on
- * the Kepler ellipses of the planet and the EMB. The geocentric calculation is
- * rather expensive. 
- *
- * The problem is a bit tricky. The maximum and minimum possible distance of
- * an object from the earth can only be calculated over a limited time range,
- * not over the whole time the solar system exists. Since a scan of the whole
- * available time range is very costly, we should not do that. Alternatively, 
- * one could create a database that provides the minimal and maximal distances
- * for each object. However, the creation and maintenance of such a database 
- * would be expensive, too. In addition, since planetary orbits change over 
- * time, a limited period won't provide a meaningful value.
- *
- * Instead, we determine the maximal and minimal distance from the osculating
- * ellipses of the planet and the Earth-Moon barycentre, assuming that both
- * the planet and the EMB could have any position on its respective ellipse.
- * 
- * Note that instead of the position of the Earth, the position of the EMB
- * is used. Using the true position of the Earth would make the problem 
- * considerably more complicated. Even if this were done, the Swiss Ephemeris
- * still is not able provide the true planets, but ony their barycentres. E.g. 
- * it cannot provide the true position of Jupiter, but only the position of 
- * the barycentre of the Jupiter system. The geocentric difference between 
- * the two is below 0.2 arcsec for all planets.
- *
- * Input:
- * tjd_et       epoch
- * ipl		planet number
- * iflag 	ephemeris flag and optional heliocentrif flag (SEFLG_HELCTR)
- *
- * output:
- * dmax		maximum distance (pointer to double)
- * dmin		minimum distance (pointer to double)
- * dtrue	true distance (pointer to double)
- * serr	        error string
+/* Cache of the eccentric anomalies of maximum and minimum distance,
+ * see swe_set_orbit_distance_cache(). An entry holds the result of the
+ * last call for a body; its grid search was done at tjd_grid. */
+struct orbit_dist_cache {
+  int32 ipl;
+  int32 iflag;
+  AS_BOOL planet_outer;
+  double tjd_grid;
+  double max_eani, max_eano, min_eani, min_eano;
+};
+#define ORBIT_DIST_NCACHE	32
+static TLS double orbit_dist_window = 0;
+static TLS struct orbit_dist_cache orbit_dist_caches[ORBIT_DIST_NCACHE];
+static TLS int orbit_dist_ncache = 0;
+static TLS int orbit_dist_next = 0;
+
+/* swe_set_orbit_distance_cache()
+ * window = 0: swe_orbit_max_min_true_distance() searches the maximum
+ *             and minimum distance from scratch with every call (default).
+ * window > 0: the eccentric anomalies found for a body are kept. A call
+ *             within window days of the last full search for the same
+ *             body and flags skips the grid search and starts the
+ *             iterations from the anomalies of the previous call. The
+ *             iterations stop where a step gains less than 1e-8 AU, which
+ *             in a shallow valley is not yet the extremum; the cached and
+ *             the full search therefore stop at slightly different points.
+ *             They differ by up to 1e-4 AU (minimum distance of Venus), 
+ *             as much as each of them differs from the true minimum.
+ * Any call resets the cache.
  */
-int32 CALL_CONV swe_orbit_max_min_true_distance(double tjd_et, int32 ipl, int32 iflag, double *dmax, double *dmin, double *dtrue, char *serr)
+void CALL_CONV swe_set_orbit_distance_cache(double window)
+{
+  orbit_dist_window = window;
+  orbit_dist_ncache = 0;
+  orbit_dist_next = 0;
+}
+
+static struct orbit_dist_cache *orbit_dist_cache_get(int32 ipl, int32 iflag)
+{
+  int i;
+  for (i = 0; i < orbit_dist_ncache; i++) {
+    if (orbit_dist_caches[i].ipl == ipl && orbit_dist_caches[i].iflag == iflag)
+      return &orbit_dist_caches[i];
+  }
+  return NULL;
+}
+
+static struct orbit_dist_cache *orbit_dist_cache_new(int32 ipl, int32 iflag)
+{
+  struct orbit_dist_cache *oc = &orbit_dist_caches[orbit_dist_next];
+  orbit_dist_next = (orbit_dist_next + 1) % ORBIT_DIST_NCACHE;
+  if (orbit_dist_ncache < ORBIT_DIST_NCACHE)
+    orbit_dist_ncache++;
+  oc->ipl = ipl;
+  oc->iflag = iflag;
+  return oc;
+}
+
+/* geocentric part of swe_orbit_max_min_true_distance(); 
+ * de are the Kepler elements of the EMB for tjd_et and iflagi */
+static int32 orbit_max_min_true_distance_geo(double tjd_et, int32 ipl, int32 iflagi, double *de, double *dmax, double *dmin, double *dtrue, char *serr)
 {
   int i, j, k, retval;
-  int32 iflagi = (iflag & (SEFLG_EPHMASK | SEFLG_HELCTR | SEFLG_BARYCTR));
-  double dp[50], de[50];
-  double xouter[3], xinner[3], max_xouter[3], max_xinner[3], min_xouter[3], min_xinner[3], pqro[20], pqri[20];
+  double dp[50];
+  double xouter[3], xinner[3], max_xouter[3], min_xouter[3], pqro[20], pqri[20];
+  double xgrid[182][3];
   double eano, eani;
   double *douter, *dinner;
   double r, rtrue, rmax = 0, rmin = 100000000, rminsv = 0, rmaxsv = 0;
@@ -6171,21 +7027,18 @@ int32 CALL_CONV swe_orbit_max_min_true_distance(double tjd_et, int32 ipl, int32
   int ncnt;
   double dstep;
   double nitermax = 300;
-  /* separate handling for the Sun, Moon and heliocentric calculation */
-  if (ipl == SE_SUN || ipl == SE_MOON || (iflagi & (SEFLG_HELCTR | SEFLG_BARYCTR))) {
-    retval = orbit_max_min_true_distance_helio(tjd_et, ipl, iflagi, dmax, dmin, dtrue, serr);
-    return retval;
-  }
+  AS_BOOL planet_outer, warm = FALSE;
+  struct orbit_dist_cache *oc = NULL;
   if ((retval = swe_get_orbital_elements(tjd_et, ipl, iflagi, dp, serr)) == ERR)
     return ERR;
-  if ((retval = swe_get_orbital_elements(tjd_et, SE_EARTH, iflagi, de, serr)) == ERR)
-    return ERR;
   if (de[0] > dp[0]) {
     douter = de;
     dinner = dp;
+    planet_outer = FALSE;
   } else {
     douter = dp;
     dinner = de;
+    planet_outer = TRUE;
   }
   osc_get_orbit_constants(douter, pqro);
   osc_get_orbit_constants(dinner, pqri);
@@ -6195,6 +7048,25 @@ int32 CALL_CONV swe_orbit_max_min_true_distance(double tjd_et, int32 ipl, int32
   osc_get_ecl_pos(eani, pqri, xinner); // coordinates inner planet J2000
   rtrue = get_dist_from_2_vectors(xouter, xinner); // true distance between them
 //  printf("rtrue=%.17f\n", rtrue);
+  if (orbit_dist_window > 0) {
+    oc = orbit_dist_cache_get(ipl, iflagi);
+    if (oc != NULL && oc->planet_outer == planet_outer 
+      && fabs(tjd_et - oc->tjd_grid) <= orbit_dist_window) {
+      /* start from the anomalies of the previous call */
+      max_eanisv = oc->max_eani;
+      max_eanosv = oc->max_eano;
+      min_eanisv = oc->min_eani;
+      min_eanosv = oc->min_eano;
+      osc_get_ecl_pos(max_eanosv, pqro, max_xouter);
+      osc_get_ecl_pos(min_eanosv, pqro, min_xouter);
+      warm = TRUE;
+      goto iterate;
+    }
+    if (oc == NULL)
+      oc = orbit_dist_cache_new(ipl, iflagi);
+    oc->planet_outer = planet_outer;
+    oc->tjd_grid = tjd_et;
+  }
   /* search rough maximum and minimum distance for objects on the two ellipses.
    * Attention, there may be two minima or maxima, and we need the smaller 
    * minimum and the greate maximum. 
@@ -6205,78 +7077,173 @@ int32 CALL_CONV swe_orbit_max_min_true_distance(double tjd_et, int32 ipl, int32
    * have to make smaller steps, but that would considerably reduce 
    * performance. A faster algorithm without this problem would require 
    * considerably higher sophistication.
+   * The positions of the inner planet are the same for every step of the
+   * outer one and are computed once.
    * */
   ncnt = 182;
   dstep = 2;
   for (i = 0; i < 3; i++) { /* initialisation */
     max_xouter[i] = 0;
-    max_xinner[i] = 0;
     min_xouter[i] = 0;
-    min_xinner[i] = 0;
   }
+  for (i = 0; i < ncnt; i++)
+    osc_get_ecl_pos((double) i, pqri, xgrid[i]);
   for (j = 0; j < ncnt; j++) {
     eano = (double) j * dstep;
     osc_get_ecl_pos(eano, pqro, xouter);
     for (i = 0; i < ncnt; i++) {
       eani = (double) i;
-      osc_get_ecl_pos(eani, pqri, xinner);
-      r = get_dist_from_2_vectors(xouter, xinner);
+      r = get_dist_from_2_vectors(xouter, xgrid[i]);
       /* maximum/minimum found; save positions and ecc. anomalies */
       if (r > rmax) {
         rmax = r;
         max_eanisv = eani;
         max_eanosv = eano;
-	for (k = 0; k < 3; k++) {
+	for (k = 0; k < 3; k++)
 	  max_xouter[k] = xouter[k];
-	  max_xinner[k] = xinner[k];
-	}
       }
       if (r < rmin) {
         rmin = r;
         min_eanisv = eani;
         min_eanosv = eano;
-	for (k = 0; k < 3; k++) {
+	for (k = 0; k < 3; k++)
 	  min_xouter[k] = xouter[k];
-	  min_xinner[k] = xinner[k];
-	}
       }
     }
   }
+  /* The iterations move one planet at a time along its orbit, with the
+   * other one fixed. After a grid search, each move starts at ean = 0;
+   * with the cache, it starts at the anomaly of the previous call. */
+iterate:
   /* find accurate values, starting iterations from above-calculated rough values; 
    * maximum distance: */
   eani = max_eanisv;
   eano = max_eanosv;
-  for (k = 0; k < 3; k++) {
+  for (k = 0; k < 3; k++)
     xouter[k] = max_xouter[k];
-    xinner[k] = max_xinner[k];
-  }
   for (k = 0; k <= nitermax; k++) {
-    osc_iterate_max_dist(eani, pqri, xinner, xouter, &eani, &rmax, TRUE);
-    osc_iterate_max_dist(eano, pqro, xouter, xinner, &eano, &rmax, TRUE);
+    osc_iterate_max_dist(warm ? eani : 0, pqri, xinner, xouter, &eani, &rmax, TRUE);
+    osc_iterate_max_dist(warm ? eano : 0, pqro, xouter, xinner, &eano, &rmax, TRUE);
     if (k > 0 && fabs(rmax - rmaxsv) < 0.00000001)
       break;
     rmaxsv = rmax;
   }
+  if (oc != NULL) {
+    oc->max_eani = eani;
+    oc->max_eano = eano;
+  }
   /* minimum distance: */
   eani = min_eanisv;
   eano = min_eanosv;
-  for (k = 0; k < 3; k++) {
+  for (k = 0; k < 3; k++)
     xouter[k] = min_xouter[k];
-    xinner[k] = min_xinner[k];
-  }
   for (k = 0; k <= nitermax; k++) {
-    osc_iterate_min_dist(eani, pqri, xinner, xouter, &eani, &rmin, TRUE);
-    osc_iterate_min_dist(eano, pqro, xouter, xinner, &eano, &rmin, TRUE);
+    osc_iterate_min_dist(warm ? eani : 0, pqri, xinner, xouter, &eani, &rmin, TRUE);
+    osc_iterate_min_dist(warm ? eano : 0, pqro, xouter, xinner, &eano, &rmin, TRUE);
     if (k > 0 && fabs(rmin - rminsv) < 0.00000001)
       break;
     rminsv = rmin;
   }
+  if (oc != NULL) {
+    oc->min_eani = eani;
+    oc->min_eano = eano;
+  }
   *dmax = rmax;
   *dmin = rmin;
   *dtrue = rtrue;
   return retval;
 }
 
+/* This function calculates calculates the maximum possible distance, the
+ * minimum possible distance, and the current true distance of planet, the EMB,
+ * or an asteroid. The calculation can be done either heliocentrically or
+ * geocentrically. With heliocentric calculations, it is based on the momentary
+ * Kepler ellipse of the planet. With geocentric calculations, it is based on
+ * the Kepler ellipses of the planet and the EMB. The geocentric calculation is
+ * rather expensive. 
+ *
+ * The problem is a bit tricky. The maximum and minimum possible distance of
+ * an object from the earth can only be calculated over a limited time range,
+ * not over the whole time the solar system exists. Since a scan of the whole
+ * available time range is very costly, we should not do that. Alternatively, 
+ * one could create a database that provides the minimal and maximal distances
+ * for each object. However, the creation and maintenance of such a database 
+ * would be expensive, too. In addition, since planetary orbits change over 
+ * time, a limited period won't provide a meaningful value.
+ *
+ * Instead, we determine the maximal and minimal distance from the osculating
+ * ellipses of the planet and the Earth-Moon barycentre, assuming that both
+ * the planet and the EMB could have any position on its respective ellipse.
+ * 
+ * Note that instead of the position of the Earth, the position of the EMB
+ * is used. Using the true position of the Earth would make the problem 
+ * considerably more complicated. Even if this were done, the Swiss Ephemeris
+ * still is not able provide the true planets, but ony their barycentres. E.g. 
+ * it cannot provide the true position of Jupiter, but only the position of 
+ * the barycentre of the Jupiter system. The geocentric difference between 
+ * the two is below 0.2 arcsec for all planets.
+ *
+ * Input:
+ * tjd_et       epoch
+ * ipl		planet number
+ * iflag 	ephemeris flag and optional heliocentrif flag (SEFLG_HELCTR)
+ *
+ * output:
+ * dmax		maximum distance (pointer to double)
+ * dmin		minimum distance (pointer to double)
+ * dtrue	true distance (pointer to double)
+ * serr	        error string
+ */
+int32 CALL_CONV swe_orbit_max_min_true_distance(double tjd_et, int32 ipl, int32 iflag, double *dmax, double *dmin, double *dtrue, char *serr)
+{
+  int32 iflagi = (iflag & (SEFLG_EPHMASK | SEFLG_HELCTR | SEFLG_BARYCTR));
+  double de[50];
+  /* separate handling for the Sun, Moon and heliocentric calculation */
+  if (ipl == SE_SUN || ipl == SE_MOON || (iflagi & (SEFLG_HELCTR | SEFLG_BARYCTR)))
+    return orbit_max_min_true_distance_helio(tjd_et, ipl, iflagi, dmax, dmin, dtrue, serr);
+  if (swe_get_orbital_elements(tjd_et, SE_EARTH, iflagi, de, serr) == ERR)
+    return ERR;
+  return orbit_max_min_true_distance_geo(tjd_et, ipl, iflagi, de, dmax, dmin, dtrue, serr);
+}
+
+/* 
+ * swe_orbit_max_min_true_distance() for n times tjd_ut[0..n-1] (UT) and
+ * nipl bodies ipl[0..nipl-1]. The Kepler elements of the EMB are 
+ * computed once per date. With swe_set_orbit_distance_cache(), 
+ * consecutive dates of a body start from the anomalies of the previous 
+ * one.
+ * dret		3 values per date and body (maximum, minimum and true 
+ *		distance); those of body k at date i start at 
+ *		dret[(i * nipl + k) * 3]
+ */
+int32 CALL_CONV swe_orbit_max_min_true_distance_ut_batch(const double *tjd_ut, int32 n, const int32 *ipl, int32 nipl, int32 iflag, double *dret, char *serr)
+{
+  int32 i, k;
+  int32 iflagi = (iflag & (SEFLG_EPHMASK | SEFLG_HELCTR | SEFLG_BARYCTR));
+  double tjd_et, de[50], *d;
+  AS_BOOL have_de;
+  for (i = 0; i < n; i++) {
+    tjd_et = tjd_ut[i] + swe_deltat_ex(tjd_ut[i], iflag, serr);
+    have_de = FALSE;
+    for (k = 0; k < nipl; k++) {
+      d = dret + (i * nipl + k) * 3;
+      if (ipl[k] == SE_SUN || ipl[k] == SE_MOON || (iflagi & (SEFLG_HELCTR | SEFLG_BARYCTR))) {
+	if (orbit_max_min_true_distance_helio(tjd_et, ipl[k], iflagi, d, d + 1, d + 2, serr) == ERR)
+	  return ERR;
+	continue;
+      }
+      if (!have_de) {
+	if (swe_get_orbital_elements(tjd_et, SE_EARTH, iflagi, de, serr) == ERR)
+	  return ERR;
+	have_de = TRUE;
+      }
+      if (orbit_max_min_true_distance_geo(tjd_et, ipl[k], iflagi, de, d, d + 1, d + 2, serr) == ERR)
+	return ERR;
+    }
+  }
+  return OK;
+}
+
 /* function finds the gauquelin sector position of a planet or fixed star
  * 
  * if starname != NULL then a star is computed.
@@ -6313,6 +7280,29 @@ int32 CALL_CONV swe_gauquelin_sector(
                    *only useful with imeth=3 */
   double *dgsect, /* return address for gauquelin sector position */
   char *serr)     /* return address for error message */
+{
+  struct swi_memo m;
+  int32 retval;
+  /* methods 0 and 1 are a single position, not worth a lookup */
+  if (imeth < 2 || imeth > 5 || !swi_memo_begin(&m, SEI_MEMO_GAUQUELIN, iflag, serr))
+    return gauquelin_sector(t_ut, ipl, starname, iflag, imeth, geopos, atpress, attemp, dgsect, serr);
+  swi_memo_add(&m, &t_ut, sizeof(t_ut));
+  swi_memo_add(&m, &ipl, sizeof(ipl));
+  swi_memo_add_str(&m, starname);
+  swi_memo_add(&m, &imeth, sizeof(imeth));
+  swi_memo_add(&m, geopos, 3 * sizeof(double));
+  swi_memo_add(&m, &atpress, sizeof(atpress));
+  swi_memo_add(&m, &attemp, sizeof(attemp));
+  memo_add_refrac(&m);
+  if (swi_memo_get(&m, &retval, dgsect, 1, memo_star(starname)))
+    return retval;
+  retval = gauquelin_sector(t_ut, ipl, starname, iflag, imeth, geopos, atpress, attemp, dgsect, m.serr);
+  swi_memo_put(&m, retval, dgsect, 1, memo_star(starname));
+  return retval;
+}
+
+static int32 gauquelin_sector(double t_ut, int32 ipl, char *starname, int32 iflag, int32 imeth,
+  double *geopos, double atpress, double attemp, double *dgsect, char *serr)
 {
   AS_BOOL rise_found = TRUE;
   AS_BOOL set_found = TRUE;
@@ -0,0 +1,369 @@
+/* Copyright (C) 1997 - 2021 Astrodienst AG, Switzerland.  All rights reserved.
+
+  License conditions
+  ------------------
+
+  This file is part of Swiss Ephemeris.
+
+  Swiss Ephemeris is distributed with NO WARRANTY OF ANY KIND.  No author
+  or distributor accepts any responsibility for the consequences of using it,
+  or for whether it serves any particular purpose or works at all, unless he
+  or she says so in writing.  
+
+  Swiss Ephemeris is made available by its authors under a dual licensing
+  system. The software developer, who uses any part of Swiss Ephemeris
+  in his or her software, must choose between one of the two license models,
+  which are
+  a) GNU Affero General Public License (AGPL)
+  b) Swiss Ephemeris Professional License
+
+  The choice must be made before the software developer distributes software
+  containing parts of Swiss Ephemeris to others, and before any public
+  service using the developed software is activated.
+
+  If the developer choses the AGPL software license, he or she must fulfill
+  the conditions of that license, which includes the obligation to place his
+  or her whole software project under the AGPL or a compatible license.
+  See https://www.gnu.org/licenses/agpl-3.0.html
+
+  If the developer choses the Swiss Ephemeris Professional license,
+  he must follow the instructions as found in http://www.astro.com/swisseph/ 
+  and purchase the Swiss Ephemeris Professional Edition from Astrodienst
+  and sign the corresponding license contract.
+
+  The License grants you the right to use, copy, modify and redistribute
+  Swiss Ephemeris, but only under certain conditions described in the License.
+  Among other things, the License requires that the copyright notices and
+  this notice be preserved on all copies.
+
+  Authors of the Swiss Ephemeris: Dieter Koch and Alois Treindl
+
+  The authors of Swiss Ephemeris have no control or influence over any of
+  the derived works, i.e. over software or services created by other
+  programmers which use Swiss Ephemeris functions.
+
+  The names of the authors or of the copyright holder (Astrodienst) must not
+  be used for promoting any software, product or service which uses or contains
+  the Swiss Ephemeris. This copyright notice is the ONLY place where the
+  names of the authors can legally appear, except in cases where they have
+  given special permission in writing.
+
+  The trademarks 'Swiss Ephemeris' and 'Swiss Ephemeris inside' may be used
+  for promoting such software, products or services.
+*/
+
+/* Primary directions.
+ *
+ * swe_speculum() computes the speculum of a chart: for every body (and
+ * the ascendant and MC) right ascension, declination, hour angle,
+ * semi-arcs and the mundane position in the systems of Placidus,
+ * Regiomontanus and Campanus. swe_directions() then computes the arcs
+ * of mundane directions of all pairs of promissors and significators,
+ * for a list of aspects, from the speculum alone: the hour angle at which
+ * a body reaches a mundane position is solved in closed form, so no
+ * house positions are computed per pair.
+ *
+ * The mundane position m is measured in degrees from the upper meridian
+ * towards the west: 0 at the MC, 90 at the descendant, 180 at the IC and
+ * 270 at the ascendant, i.e. house position 10 - m / 30 (mod 12), as in
+ * swe_house_pos(). Placidus divides the semi-arcs of the body
+ * proportionally; Regiomontanus and Campanus use the circles of position
+ * through the north and south points of the horizon and measure them on
+ * the equator and on the prime vertical.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <math.h>
+#include "swephexp.h"
+#include "sweph.h"
+#include "swephlib.h"
+
+#define SEFLG_EPHMASK	(SEFLG_JPLEPH|SEFLG_SWIEPH|SEFLG_MOSEPH)
+
+/* layout of a row of the speculum */
+#define SP_RA		0
+#define SP_DEC		1
+#define SP_LON		2
+#define SP_LAT		3
+#define SP_RASPEED	4	/* degrees per day */
+#define SP_HA		5	/* hour angle, west positive, -180..180 */
+#define SP_MD		6	/* distance from the nearer meridian */
+#define SP_AD		7	/* ascensional difference */
+#define SP_DSA		8	/* diurnal semi-arc, 0 or 180 if circumpolar */
+#define SP_NSA		9	/* nocturnal semi-arc */
+#define SP_PLAC		10	/* mundane position, Placidus */
+#define SP_REGIO	11	/* mundane position, Regiomontanus */
+#define SP_CAMP		12	/* mundane position, Campanus */
+#define SP_BODY		13	/* body number, SE_SPEC_ASC or SE_SPEC_MC */
+#define SP_ABOVE	14	/* 1 if above the horizon */
+
+/* layout of the chart data */
+#define CH_ARMC		0
+#define CH_EPS		1
+#define CH_GEOLAT	2
+#define CH_SUNSPEED	3	/* right ascension speed of the Sun */
+
+struct dir_arc {
+  double arc;
+  int32 id[4];
+};
+
+static double dir_placidus(double ha, double dec, double geolat)
+{
+  double x = tan(geolat * DEGTORAD) * tan(dec * DEGTORAD), dsa, nsa;
+  if (x <= -1 || x >= 1)
+    return -1;	/* circumpolar */
+  dsa = 90 + asin(x) * RADTODEG;
+  nsa = 180 - dsa;
+  if (fabs(ha) <= dsa)
+    return swe_degnorm(90 * ha / dsa);
+  return swe_degnorm(180 + 90 * swe_difdeg2n(ha, 180) / nsa);
+}
+
+static double dir_regio(double ha, double dec, double geolat)
+{
+  double sd = sin(dec * DEGTORAD), cd = cos(dec * DEGTORAD);
+  double sl = sin(geolat * DEGTORAD), cl = cos(geolat * DEGTORAD);
+  double sh = sin(ha * DEGTORAD), ch = cos(ha * DEGTORAD);
+  return swe_degnorm(atan2(cl * cd * sh, sd * sl + cl * cd * ch) * RADTODEG);
+}
+
+static double dir_campanus(double ha, double dec, double geolat)
+{
+  double sd = sin(dec * DEGTORAD), cd = cos(dec * DEGTORAD);
+  double sl = sin(geolat * DEGTORAD), cl = cos(geolat * DEGTORAD);
+  double sh = sin(ha * DEGTORAD), ch = cos(ha * DEGTORAD);
+  return swe_degnorm(atan2(cd * sh, cl * cd * ch + sl * sd) * RADTODEG);
+}
+
+static double dir_position(int32 hsys, double ha, double dec, double geolat)
+{
+  switch (hsys) {
+  case 'R':
+    return dir_regio(ha, dec, geolat);
+  case 'C':
+    return dir_campanus(ha, dec, geolat);
+  default:
+    return dir_placidus(ha, dec, geolat);
+  }
+}
+
+/* Hour angle at which a body of declination dec has the mundane
+ * position m; FALSE if it never reaches it. */
+static AS_BOOL dir_hour_angle(int32 hsys, double m, double dec, double geolat, double *ha)
+{
+  double x, w, k, h[2];
+  int i;
+  if (hsys == 'P') {
+    x = tan(geolat * DEGTORAD) * tan(dec * DEGTORAD);
+    if (x <= -1 || x >= 1)
+      return FALSE;
+    if (m <= 90 || m >= 270)
+      *ha = swe_difdeg2n(m, 0) * (90 + asin(x) * RADTODEG) / 90;
+    else
+      *ha = 180 + (m - 180) * (90 - asin(x) * RADTODEG) / 90;
+    return TRUE;
+  }
+  /* the circles of position of Campanus are those of Regiomontanus */
+  w = m;
+  if (hsys == 'C')
+    w = swe_degnorm(atan2(cos(geolat * DEGTORAD) * sin(m * DEGTORAD), cos(m * DEGTORAD)) * RADTODEG);
+  /* sin(ha - w) = tan(dec) tan(geolat) sin(w); of the two solutions,
+   * one lies on the semicircle of w, the other on the opposite one */
+  k = tan(dec * DEGTORAD) * tan(geolat * DEGTORAD) * sin(w * DEGTORAD);
+  if (k < -1 || k > 1)
+    return FALSE;
+  x = asin(k) * RADTODEG;
+  h[0] = w + x;
+  h[1] = w + 180 - x;
+  for (i = 0; i < 2; i++) {
+    if (fabs(swe_difdeg2n(dir_position(hsys, h[i], dec, geolat), m)) < 1e-6) {
+      *ha = swe_difdeg2n(h[i], 0);
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+static void dir_fill_row(double *row, double armc, double geolat)
+{
+  double x = tan(geolat * DEGTORAD) * tan(row[SP_DEC] * DEGTORAD);
+  double ha = swe_difdeg2n(armc, row[SP_RA]);
+  row[SP_HA] = ha;
+  if (x <= -1 || x >= 1) {
+    row[SP_AD] = 0;
+    row[SP_DSA] = x >= 1 ? 180 : 0;
+  } else {
+    row[SP_AD] = asin(x) * RADTODEG;
+    row[SP_DSA] = 90 + row[SP_AD];
+  }
+  row[SP_NSA] = 180 - row[SP_DSA];
+  row[SP_ABOVE] = fabs(ha) < row[SP_DSA];
+  row[SP_MD] = fabs(ha) <= 90 ? fabs(ha) : 180 - fabs(ha);
+  row[SP_PLAC] = dir_placidus(ha, row[SP_DEC], geolat);
+  row[SP_REGIO] = dir_regio(ha, row[SP_DEC], geolat);
+  row[SP_CAMP] = dir_campanus(ha, row[SP_DEC], geolat);
+}
+
+/* Speculum of a chart for tjd_ut at geographic longitude geolon and
+ * latitude geolat, for the nbody bodies ipl[] and (options
+ * SE_SPEC_ANGLES) the ascendant and MC after them. iflag is a
+ * calculation flag (ecliptic). spec must have room for
+ * SE_SPECULUM_SIZE doubles per row; chart receives SE_SPECULUM_CHART
+ * doubles: ARMC, true obliquity, geolat and the speed of the Sun in
+ * right ascension (degrees per day), for the keys of directions.
+ * Returns the number of rows or ERR.
+ */
+int32 CALL_CONV swe_speculum(double tjd_ut, double geolon, double geolat, const int32 *ipl, int32 nbody, int32 iflag, int32 options, double *chart, double *spec, char *serr)
+{
+  double x[6], xeq[6], cusp[13], ascmc[10], armc, eps, *row;
+  int32 i, n = 0;
+  iflag = (iflag & ~(SEFLG_EQUATORIAL | SEFLG_XYZ | SEFLG_RADIANS)) | SEFLG_SPEED;
+  if (serr != NULL)
+    *serr = '\0';
+  if (swe_calc_ut(tjd_ut, SE_ECL_NUT, iflag & SEFLG_EPHMASK, x, serr) == ERR)
+    return ERR;
+  eps = x[0];
+  armc = swe_degnorm(swe_sidtime(tjd_ut) * 15 + geolon);
+  chart[CH_ARMC] = armc;
+  chart[CH_EPS] = eps;
+  chart[CH_GEOLAT] = geolat;
+  if (swe_calc_ut(tjd_ut, SE_SUN, iflag | SEFLG_EQUATORIAL, xeq, serr) == ERR)
+    return ERR;
+  chart[CH_SUNSPEED] = xeq[3];
+  for (i = 0; i < nbody; i++, n++) {
+    row = spec + n * SE_SPECULUM_SIZE;
+    memset(row, 0, SE_SPECULUM_SIZE * sizeof(double));
+    if (swe_calc_ut(tjd_ut, ipl[i], iflag, x, serr) == ERR
+	|| swe_calc_ut(tjd_ut, ipl[i], iflag | SEFLG_EQUATORIAL, xeq, serr) == ERR)
+      return ERR;
+    row[SP_RA] = xeq[0];
+    row[SP_DEC] = xeq[1];
+    row[SP_LON] = x[0];
+    row[SP_LAT] = x[1];
+    row[SP_RASPEED] = xeq[3];
+    row[SP_BODY] = ipl[i];
+    dir_fill_row(row, armc, geolat);
+  }
+  if (options & SE_SPEC_ANGLES) {
+    swe_houses_armc(armc, geolat, eps, 'P', cusp, ascmc);
+    for (i = 0; i < 2; i++, n++) {
+      row = spec + n * SE_SPECULUM_SIZE;
+      memset(row, 0, SE_SPECULUM_SIZE * sizeof(double));
+      x[0] = ascmc[i == 0 ? SE_ASC : SE_MC];
+      x[1] = 0;
+      x[2] = 1;
+      swe_cotrans(x, xeq, -eps);
+      row[SP_RA] = xeq[0];
+      row[SP_DEC] = xeq[1];
+      row[SP_LON] = x[0];
+      row[SP_RASPEED] = 360.98564736629;
+      row[SP_BODY] = i == 0 ? SE_SPEC_ASC : SE_SPEC_MC;
+      dir_fill_row(row, armc, geolat);
+      /* exactly on the angle */
+      row[SP_PLAC] = row[SP_REGIO] = row[SP_CAMP] = i == 0 ? 270 : 0;
+    }
+  }
+  return n;
+}
+
+static int dir_arc_cmp(const void *a, const void *b)
+{
+  double d = ((const struct dir_arc *) a)->arc - ((const struct dir_arc *) b)->arc;
+  return d < 0 ? -1 : d > 0 ? 1 : 0;
+}
+
+/* Arcs of mundane directions in the system hsys ('P' Placidus,
+ * 'R' Regiomontanus, 'C' Campanus) of all pairs of rows of a speculum
+ * from swe_speculum(), for the naspect aspects (degrees of mundane
+ * position, e.g. 0, 60, 90, 120, 180). With SE_DIR_DIRECT in options,
+ * the promissor is carried by the diurnal motion to the aspect point
+ * of the significator; with SE_DIR_CONVERSE, the significator to the
+ * aspect point of the promissor. The angles are significators only.
+ * For the first nmax arcs up to maxarc degrees, by increasing arc:
+ *   arcs[i]          arc of direction in degrees of right ascension
+ *   ids[4 * i ...]   row of the promissor, row of the significator,
+ *                    index of the aspect, flags: SE_DIR_DIRECT or
+ *                    SE_DIR_CONVERSE, with SE_DIR_WEST if the aspect
+ *                    point lies west of the body that stays
+ * Returns the number of arcs or ERR. Thread-safe.
+ */
+int32 CALL_CONV swe_directions(const double *chart, const double *spec, int32 nspec, int32 hsys, const double *aspects, int32 naspect, int32 options, double maxarc, double *arcs, int32 *ids, int32 nmax, char *serr)
+{
+  struct dir_arc *res = NULL, *r;
+  int32 n = 0, nalloc = 0, ip, is, ia, iw, idir, flags;
+  int isp;
+  double geolat = chart[CH_GEOLAT], m, ha, arc;
+  const double *mov, *fix;
+  if (serr != NULL)
+    *serr = '\0';
+  hsys = toupper(hsys);
+  switch (hsys) {
+  case 'P': isp = SP_PLAC; break;
+  case 'R': isp = SP_REGIO; break;
+  case 'C': isp = SP_CAMP; break;
+  default:
+    if (serr != NULL)
+      sprintf(serr, "directions: house system %c not supported", (char) hsys);
+    return ERR;
+  }
+  for (ip = 0; ip < nspec; ip++) {
+    if (spec[ip * SE_SPECULUM_SIZE + SP_BODY] < 0)
+      continue;
+    for (is = 0; is < nspec; is++) {
+      if (ip == is)
+	continue;
+      for (idir = 0; idir < 2; idir++) {
+	flags = idir == 0 ? SE_DIR_DIRECT : SE_DIR_CONVERSE;
+	if (!(options & flags))
+	  continue;
+	/* the body carried by the diurnal motion and the one that stays */
+	mov = spec + (idir == 0 ? ip : is) * SE_SPECULUM_SIZE;
+	fix = spec + (idir == 0 ? is : ip) * SE_SPECULUM_SIZE;
+	if (mov[SP_BODY] < 0 || mov[isp] < 0 || fix[isp] < 0)
+	  continue;
+	for (ia = 0; ia < naspect; ia++) {
+	  for (iw = 0; iw < 2; iw++) {
+	    if (iw == 1 && (swe_degnorm(aspects[ia]) == 0 || swe_degnorm(aspects[ia]) == 180))
+	      continue;
+	    m = swe_degnorm(fix[isp] + (iw ? aspects[ia] : -aspects[ia]));
+	    if (!dir_hour_angle(hsys, m, mov[SP_DEC], geolat, &ha))
+	      continue;
+	    arc = swe_degnorm(ha - mov[SP_HA]);
+	    if (arc > maxarc)
+	      continue;
+	    if (n >= nalloc) {
+	      nalloc = nalloc ? 2 * nalloc : 256;
+	      if ((r = (struct dir_arc *) realloc(res, nalloc * sizeof(struct dir_arc))) == NULL) {
+		free(res);
+		if (serr != NULL)
+		  strcpy(serr, "directions: out of memory");
+		return ERR;
+	      }
+	      res = r;
+	    }
+	    res[n].arc = arc;
+	    res[n].id[0] = ip;
+	    res[n].id[1] = is;
+	    res[n].id[2] = ia;
+	    res[n].id[3] = flags | (iw ? SE_DIR_WEST : 0);
+	    n++;
+	  }
+	}
+      }
+    }
+  }
+  if (n > 0)
+    qsort(res, (size_t) n, sizeof(struct dir_arc), dir_arc_cmp);
+  for (ip = 0; ip < n && ip < nmax; ip++) {
+    if (arcs != NULL)
+      arcs[ip] = res[ip].arc;
+    if (ids != NULL)
+      memcpy(ids + 4 * ip, res[ip].id, 4 * sizeof(int32));
+  }
+  free(res);
+  return n;
+}
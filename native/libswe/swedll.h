@@ -110,11 +110,28 @@ DllImport int32 CALL_CONV_IMP  swe_calc_pctr(
 	double *xxret,
 	char *serr);
 
+DllImport int32 CALL_CONV_IMP  swe_calc_pctr_multi(
+        double tjd, int32 iplctr, const int32 *ipl, int32 n, int32 iflag,
+	double *xxret,
+	char *serr);
+
 DllImport int32 CALL_CONV_IMP swe_calc_ut(
         double tjd_ut, int32 ipl, int32 iflag,
         double *xx,
         char *serr);
 
+DllImport int32 CALL_CONV_IMP swe_calc_ut_multi_sid(
+        double tjd_ut, int32 ipl, int32 iflag,
+        const int32 *sid_modes, int32 n,
+        double *xx,
+        char *serr);
+
+DllImport int32 CALL_CONV_IMP swe_calc_topo_batch(
+        double tjd_ut, int32 ipl, int32 iflag,
+        const double *geopos, int32 n,
+        double *xx,
+        char *serr);
+
 DllImport double CALL_CONV_IMP swe_solcross(
 	double x2cross, double jd_et, int32 flag, char *serr);
 DllImport double CALL_CONV_IMP swe_solcross_ut(
@@ -160,6 +177,7 @@ DllImport int32 CALL_CONV_IMP swe_fixstar2_mag(
 
 DllImport double CALL_CONV_IMP swe_sidtime0(double tjd_ut, double ecl, double nut);
 DllImport double CALL_CONV_IMP swe_sidtime(double tjd_ut);
+DllImport void CALL_CONV_IMP swe_sidtime_batch(const double *tjd_ut, int32 n, double *tsid);
 
 DllImport double CALL_CONV_IMP swe_deltat_ex(double tjd, int32 iflag, char *serr);
 DllImport double CALL_CONV_IMP swe_deltat(double tjd);
@@ -203,6 +221,28 @@ DllImport double  CALL_CONV_IMP swe_get_ayanamsa_ut(double tjd_ut);
 
 DllImport char * CALL_CONV_IMP swe_get_ayanamsa_name(int32 isidmode);
 DllImport char * CALL_CONV_IMP swe_get_current_file_data(int ifno, double *tfstart, double *tfend, int *denum);
+DllImport int32 CALL_CONV_IMP swe_set_shared_cache(const char *name, int32 size_mb, char *serr);
+DllImport int32 CALL_CONV_IMP swe_remove_shared_cache(const char *name, char *serr);
+DllImport int32 CALL_CONV_IMP swe_get_shared_cache_stats(int32 *stats);
+DllImport int32 CALL_CONV_IMP swe_set_result_cache(const char *path, int32 size_mb, int32 mode, char *serr);
+DllImport int32 CALL_CONV_IMP swe_get_result_cache_stats(int32 *stats);
+DllImport int32 CALL_CONV_IMP swe_eclipse_index_build(const char *path, double tjd_start, double tjd_end, int32 ifl, char *serr);
+DllImport int32 CALL_CONV_IMP swe_eclipse_index_open(const char *path, char *serr);
+DllImport int32 CALL_CONV_IMP swe_eclipse_index_find(int32 kind, double tjd_start, int32 ifl, int32 ifltype, int32 backward, double *tret, double *geopos, double *attr, char *serr);
+DllImport int32 CALL_CONV_IMP swe_eclipse_index_range(int32 kind, double tjd1, double tjd2, int32 ifl, int32 ifltype, double *tmax, int32 *types, int32 nmax, char *serr);
+DllImport int32 CALL_CONV_IMP swe_lunation_index_build(const char *path, double tjd_start, double tjd_end, int32 ifl, int32 options, char *serr);
+DllImport int32 CALL_CONV_IMP swe_lunation_index_open(const char *path, char *serr);
+DllImport int32 CALL_CONV_IMP swe_lunation_find(double tjd_ut, int32 ifl, double *tret, int32 *lunation, char *serr);
+DllImport int32 CALL_CONV_IMP swe_lunar_phase_range(double tjd1, double tjd2, int32 ifl, double *tret, int32 *phases, int32 nmax, char *serr);
+DllImport int32 CALL_CONV_IMP swe_lunar_apsides_find(double tjd_ut, int32 ifl, double *tret, double *dist, char *serr);
+DllImport int32 CALL_CONV_IMP swe_lon_index_build(const char *path, int32 ipl, double tjd_start, double tjd_end, int32 iflag, char *serr);
+DllImport int32 CALL_CONV_IMP swe_lon_index_open(const char *path, char *serr);
+DllImport int32 CALL_CONV_IMP swe_lon_crossings_ut(int32 ipl, double x2cross, double tjd1, double tjd2, int32 iflag, double *tret, int32 *dir, int32 nmax, char *serr);
+DllImport int32 CALL_CONV_IMP swe_paran_body(double tjd_ut, int32 ipl, char *star, int32 epheflag, int32 rsmi, double *body, char *serr);
+DllImport int32 CALL_CONV_IMP swe_parans(const double *bodies, int32 nbody, int32 nprimary, double geolon, const double *lats, int32 nlat, int32 events, double tolerance, int32 *ids, double *tret, int32 nmax, char *serr);
+DllImport int32 CALL_CONV_IMP swe_speculum(double tjd_ut, double geolon, double geolat, const int32 *ipl, int32 nbody, int32 iflag, int32 options, double *chart, double *spec, char *serr);
+DllImport int32 CALL_CONV_IMP swe_directions(const double *chart, const double *spec, int32 nspec, int32 hsys, const double *aspects, int32 naspect, int32 options, double maxarc, double *arcs, int32 *ids, int32 nmax, char *serr);
+DllImport int32 CALL_CONV_IMP swe_aspect_matrix(const double *ref, int32 nref, const float *lon, int32 npoint, int32 ncharts, int32 c0, int32 c1, const double *asp, int32 naspect, double minscore, float *score, int32 *match, float *dev, int32 nmax, char *serr);
 
 DllImport int  CALL_CONV_IMP swe_date_conversion(
         int y , int m , int d ,         /* year, month, day */
@@ -246,6 +286,9 @@ DllImport int  CALL_CONV_IMP swe_time_equ(
         double tjd, double *e, char *serr);
 DllImport int  CALL_CONV_IMP swe_lmt_to_lat(double tjd_lmt, double geolon, double *tjd_lat, char *serr);
 DllImport int  CALL_CONV_IMP swe_lat_to_lmt(double tjd_lat, double geolon, double *tjd_lmt, char *serr);
+DllImport int32 CALL_CONV_IMP swe_time_equ_batch(const double *tjd_ut, int32 n, double *te, char *serr);
+DllImport int32 CALL_CONV_IMP swe_lmt_to_lat_batch(const double *tjd_lmt, int32 n, double geolon, double *tjd_lat, char *serr);
+DllImport int32 CALL_CONV_IMP swe_lat_to_lmt_batch(const double *tjd_lat, int32 n, double geolon, double *tjd_lmt, char *serr);
 
 DllImport double  CALL_CONV_IMP swe_get_tid_acc(void);
 DllImport void  CALL_CONV_IMP swe_set_tid_acc(double tidacc);
@@ -300,9 +343,16 @@ DllImport int32  CALL_CONV_IMP swe_pheno(double tjd, int32 ipl, int32 iflag, dou
 
 DllImport int32  CALL_CONV_IMP swe_pheno_ut(double tjd_ut, int32 ipl, int32 iflag, double *attr, char *serr);
 
+DllImport int32  CALL_CONV_IMP swe_pheno_ut_series(double tjd_ut, double step, int32 n, int32 ipl, int32 iflag, double *attr, char *serr);
+
+DllImport int32  CALL_CONV_IMP swe_pheno_ut_planets(double tjd_ut, const int32 *ipl, int32 n, int32 iflag, double *attr, char *serr);
+
+DllImport int32  CALL_CONV_IMP swe_pheno_ut_extrema(double tjd_ut, double step, int32 n, int32 ipl, int32 iflag, int32 iattr, int32 sign, double *tret, double *xret, int32 nmax, char *serr);
+
 DllImport double  CALL_CONV_IMP swe_refrac(double inalt, double atpress, double attemp, int32 calc_flag);
 DllImport double  CALL_CONV_IMP swe_refrac_extended(double inalt, double geoalt, double atpress, double attemp, double lapse_rate, int32 calc_flag, double *dret);
 DllImport void  CALL_CONV_IMP swe_set_lapse_rate(double lapse_rate);
+DllImport void  CALL_CONV_IMP swe_set_refrac_table(int32 mode);
 
 DllImport void  CALL_CONV_IMP swe_azalt(
       double tjd_ut,
@@ -320,6 +370,24 @@ DllImport void  CALL_CONV_IMP swe_azalt_rev(
       double *xin,
       double *xout);
 
+DllImport void  CALL_CONV_IMP swe_azalt_batch(
+      double tjd_ut,
+      int32 calc_flag,
+      double *geopos,
+      double atpress,
+      double attemp,
+      const double *xin,
+      int32 n,
+      double *xaz);
+
+DllImport void  CALL_CONV_IMP swe_azalt_rev_batch(
+      double tjd_ut,
+      int32 calc_flag,
+      double *geopos,
+      const double *xin,
+      int32 n,
+      double *xout);
+
 DllImport int32  CALL_CONV_IMP swe_rise_trans(
                double tjd_ut, int32 ipl, char *starname,
 	       int32 epheflag, int32 rsmi,
@@ -349,9 +417,20 @@ DllImport int32  CALL_CONV_IMP swe_nod_aps_ut(double tjd_ut, int32 ipl, int32 if
                       double *xperi, double *xaphe,
                       char *serr);
 
+DllImport int32  CALL_CONV_IMP swe_nod_aps_ut_batch(const double *tjd_ut, int32 n,
+                      const int32 *ipl, int32 nipl, int32 iflag,
+                      int32  method,
+                      double *xnasc, double *xndsc,
+                      double *xperi, double *xaphe,
+                      char *serr);
+
 DllImport int32 CALL_CONV_IMP swe_get_orbital_elements(double tjd_et, int32 ipl, int32 iflag, double *dret, char *serr);
 
+DllImport int32 CALL_CONV_IMP swe_get_orbital_elements_ut_batch(const double *tjd_ut, int32 n, const int32 *ipl, int32 nipl, int32 iflag, double *dret, char *serr);
+
 DllImport int32 CALL_CONV_IMP swe_orbit_max_min_true_distance(double tjd_et, int32 ipl, int32 iflag, double *dmax, double *dmin, double *dtrue, char *serr);
+DllImport int32 CALL_CONV_IMP swe_orbit_max_min_true_distance_ut_batch(const double *tjd_ut, int32 n, const int32 *ipl, int32 nipl, int32 iflag, double *dret, char *serr);
+DllImport void  CALL_CONV_IMP swe_set_orbit_distance_cache(double window);
 
 /*******************************************************
  * other functions from swephlib.c;
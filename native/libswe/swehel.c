@@ -71,6 +71,7 @@
 #include "swephexp.h"
 #include "sweph.h"
 #include "swephlib.h"
+#include "swememo.h"
 #include <sys/stat.h>
 
 #define PLSV   0 /*if Planet, Lunar and Stellar Visibility formula is needed PLSV=1*/
@@ -3390,7 +3391,32 @@ static int32 heliacal_ut(double JDNDaysUTStart, double *dgeo, double *datm, doub
 '                   dret[2]: end of visibility (Julian day number; 0 if SE_HELFLAG_AV)
 ' see http://www.iol.ie/~geniet/eng/atmoastroextinction.htm
 */
+static int32 heliacal_ut_search(double JDNDaysUTStart, double *dgeo, double *datm, double *dobs, char *ObjectNameIn, int32 TypeEvent, int32 helflag, double *dret, char *serr_ret);
+
 int32 CALL_CONV swe_heliacal_ut(double JDNDaysUTStart, double *dgeo, double *datm, double *dobs, char *ObjectNameIn, int32 TypeEvent, int32 helflag, double *dret, char *serr_ret)
+{
+  struct swi_memo m;
+  int32 retval;
+  if (!swi_memo_begin(&m, SEI_MEMO_HELIACAL, helflag, serr_ret))
+    return heliacal_ut_search(JDNDaysUTStart, dgeo, datm, dobs, ObjectNameIn, TypeEvent, helflag, dret, serr_ret);
+  swi_memo_add(&m, &JDNDaysUTStart, sizeof(JDNDaysUTStart));
+  swi_memo_add(&m, dgeo, 3 * sizeof(double));
+  swi_memo_add(&m, datm, 4 * sizeof(double));
+  swi_memo_add(&m, dobs, 6 * sizeof(double));
+  swi_memo_add_str(&m, ObjectNameIn);
+  swi_memo_add(&m, &TypeEvent, sizeof(TypeEvent));
+  if (swi_memo_get(&m, &retval, dret, 3, NULL)) {
+    /* side effects of the search on the caller's arrays and the topocentre */
+    default_heliacal_parameters(datm, dgeo, dobs, helflag);
+    swe_set_topo(dgeo[0], dgeo[1], dgeo[2]);
+    return retval;
+  }
+  retval = heliacal_ut_search(JDNDaysUTStart, dgeo, datm, dobs, ObjectNameIn, TypeEvent, helflag, dret, m.serr);
+  swi_memo_put(&m, retval, dret, 3, NULL);
+  return retval;
+}
+
+static int32 heliacal_ut_search(double JDNDaysUTStart, double *dgeo, double *datm, double *dobs, char *ObjectNameIn, int32 TypeEvent, int32 helflag, double *dret, char *serr_ret)
 {
   int32 retval, Planet, itry;
   char ObjectName[AS_MAXCH], serr[AS_MAXCH], s[AS_MAXCH];
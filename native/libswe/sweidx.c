@@ -0,0 +1,1567 @@
+/* Copyright (C) 1997 - 2021 Astrodienst AG, Switzerland.  All rights reserved.
+
+  License conditions
+  ------------------
+
+  This file is part of Swiss Ephemeris.
+
+  Swiss Ephemeris is distributed with NO WARRANTY OF ANY KIND.  No author
+  or distributor accepts any responsibility for the consequences of using it,
+  or for whether it serves any particular purpose or works at all, unless he
+  or she says so in writing.  
+
+  Swiss Ephemeris is made available by its authors under a dual licensing
+  system. The software developer, who uses any part of Swiss Ephemeris
+  in his or her software, must choose between one of the two license models,
+  which are
+  a) GNU Affero General Public License (AGPL)
+  b) Swiss Ephemeris Professional License
+
+  The choice must be made before the software developer distributes software
+  containing parts of Swiss Ephemeris to others, and before any public
+  service using the developed software is activated.
+
+  If the developer choses the AGPL software license, he or she must fulfill
+  the conditions of that license, which includes the obligation to place his
+  or her whole software project under the AGPL or a compatible license.
+  See https://www.gnu.org/licenses/agpl-3.0.html
+
+  If the developer choses the Swiss Ephemeris Professional license,
+  he must follow the instructions as found in http://www.astro.com/swisseph/ 
+  and purchase the Swiss Ephemeris Professional Edition from Astrodienst
+  and sign the corresponding license contract.
+
+  The License grants you the right to use, copy, modify and redistribute
+  Swiss Ephemeris, but only under certain conditions described in the License.
+  Among other things, the License requires that the copyright notices and
+  this notice be preserved on all copies.
+
+  Authors of the Swiss Ephemeris: Dieter Koch and Alois Treindl
+
+  The authors of Swiss Ephemeris have no control or influence over any of
+  the derived works, i.e. over software or services created by other
+  programmers which use Swiss Ephemeris functions.
+
+  The names of the authors or of the copyright holder (Astrodienst) must not
+  be used for promoting any software, product or service which uses or contains
+  the Swiss Ephemeris. This copyright notice is the ONLY place where the
+  names of the authors can legally appear, except in cases where they have
+  given special permission in writing.
+
+  The trademarks 'Swiss Ephemeris' and 'Swiss Ephemeris inside' may be used
+  for promoting such software, products or services.
+*/
+
+/* Precomputed eclipse index and lunation catalogue, see sweidx.h */
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "swephexp.h"
+#include "sweph.h"
+#include "swephlib.h"
+#include "sweidx.h"
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+# define ECLIDX_MMAP
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#define SEFLG_EPHMASK	(SEFLG_JPLEPH|SEFLG_SWIEPH|SEFLG_MOSEPH)
+#define ECLIDX_MAGIC		0x49454553	/* "SEEI" */
+#define IDX_BYTE_ORDER		0x01020304
+#define ECLIDX_EPS		0.0001	/* as in the searches */
+
+/* The ephemeris files an index was built from, identified at a date
+ * within its span: the planet and moon files of the Swiss Ephemeris or
+ * the JPL file (file[0]), without directory. Empty for the Moshier
+ * ephemeris and if the Swiss Ephemeris files were missing. */
+struct idx_ephe {
+  double tref;		/* middle of the span */
+  char file[2][32];
+  int32 denum[2];	/* DE number */
+  int32 fversion[2];	/* version of the Swiss Ephemeris file */
+};
+
+struct eclidx_header {
+  uint32 magic;
+  uint32 layout;
+  uint32 byte_order;
+  uint32 rec_size;
+  char version[16];	/* SE_VERSION of the builder */
+  int32 ifl;		/* ephemeris flag */
+  int32 nsol;
+  int32 nlun;
+  int32 do_interpolate_nut;
+  int32 astro_models[SEI_NMODELS];
+  struct idx_ephe ephe;
+  double tstart, tend;	/* span searched */
+  /* followed by nsol solar and nlun lunar records */
+};
+
+struct eclidx_rec {
+  double tret[10];	/* as returned by the search */
+  double attr[11];	/* swe_sol_eclipse_where() / swe_lun_eclipse_how() */
+  double geopos[2];	/* solar: geographic position of the maximum */
+  int32 retflag;
+  int32 unused;
+};
+
+/* An open index file. The index itself holds one reference and every
+ * lookup in progress another; whoever drops the last one unmaps the
+ * file. The structs are small and never freed, so that a thread that
+ * loaded an old pointer can still look at it. */
+struct idx_file {
+  void *hdr;
+  size_t size;
+  long users;
+  long unmapped;
+};
+
+#ifdef _MSC_VER
+# include <intrin.h>
+# define IDX_LOAD(p)		_InterlockedCompareExchangePointer((void *volatile *) (p), NULL, NULL)
+# define IDX_EXCHANGE(p, v)	_InterlockedExchangePointer((void *volatile *) (p), (v))
+# define IDX_ADD(p, v)		_InterlockedExchangeAdd((p), (v))
+# define IDX_SET_ONCE(p)	(_InterlockedCompareExchange((p), 1, 0) == 0)
+#else
+# define IDX_LOAD(p)		__atomic_load_n((p), __ATOMIC_ACQUIRE)
+# define IDX_EXCHANGE(p, v)	__atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+# define IDX_ADD(p, v)		__atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+# define IDX_SET_ONCE(p)	(__atomic_exchange_n((p), 1, __ATOMIC_ACQ_REL) == 0)
+#endif
+
+/* The index is process-wide and read-only. */
+static struct idx_file *eclidx_cur = NULL;
+
+static struct eclidx_rec *eclidx_recs(struct eclidx_header *hdr, int32 kind, int32 *n)
+{
+  struct eclidx_rec *recs = (struct eclidx_rec *) (hdr + 1);
+  if (kind == SE_ECLIDX_LUNAR) {
+    *n = hdr->nlun;
+    return recs + hdr->nsol;
+  }
+  *n = hdr->nsol;
+  return recs;
+}
+
+static int32 eclidx_epheflag(int32 ifl)
+{
+  ifl &= SEFLG_EPHMASK;
+  return ifl == 0 ? SEFLG_SWIEPH : ifl;
+}
+
+static void idx_ephe_file(struct idx_ephe *e, int i, const char *fnam, int32 denum, int32 fversion)
+{
+  const char *sp = strrchr(fnam, (int) *DIR_GLUE);
+  size_t len;
+  sp = sp != NULL ? sp + 1 : fnam;
+  len = strlen(sp);
+  if (len >= sizeof(e->file[i]))
+    len = sizeof(e->file[i]) - 1;
+  memcpy(e->file[i], sp, len);	/* e is zeroed */
+  e->denum[i] = denum;
+  e->fversion[i] = fversion;
+}
+
+/* Identify the ephemeris files that serve date tref with ephemeris flag
+ * ifl, opening them if necessary. */
+static void idx_ephe_get(int32 ifl, double tref, struct idx_ephe *e)
+{
+  struct file_data *fdp;
+  double x[6];
+  int i;
+  memset(e, 0, sizeof(*e));
+  e->tref = tref;
+  if (ifl == SEFLG_JPLEPH) {
+    if (!swed.jpl_file_is_open)
+      swe_calc(tref, SE_MOON, SEFLG_JPLEPH, x, NULL);
+    if (swed.jpl_file_is_open)
+      idx_ephe_file(e, 0, swed.jplfnam, swed.jpldenum, 0);
+  } else if (ifl == SEFLG_SWIEPH) {
+    for (i = SEI_FILE_PLANET; i <= SEI_FILE_MOON; i++) {
+      fdp = &swed.fidat[i];
+      if (fdp->fptr == NULL || tref < fdp->tfstart || tref > fdp->tfend)
+	swe_calc(tref, SE_MOON, SEFLG_SWIEPH, x, NULL);
+      if (fdp->fptr != NULL && tref >= fdp->tfstart && tref <= fdp->tfend)
+	idx_ephe_file(e, i, fdp->fnam, fdp->sweph_denum, fdp->fversion);
+    }
+  }
+}
+
+/* TRUE if the current settings and ephemeris files are those an index
+ * was built with */
+static AS_BOOL idx_settings_match(int32 ifl, int32 hdr_ifl, int32 do_interpolate_nut, int32 *astro_models, struct idx_ephe *ephe)
+{
+  struct idx_ephe cur;
+  if (eclidx_epheflag(ifl) != hdr_ifl)
+    return FALSE;
+  if (swed.delta_t_userdef_is_set || swed.is_tid_acc_manual
+      || swed.do_interpolate_nut != do_interpolate_nut
+      || memcmp(swed.astro_models, astro_models, SEI_NMODELS * sizeof(int32)) != 0)
+    return FALSE;
+  idx_ephe_get(hdr_ifl, ephe->tref, &cur);
+  if (memcmp(&cur, ephe, sizeof(cur)) != 0)
+    return FALSE;
+  return TRUE;
+}
+
+/* Map (or read) an index file of at least minsize bytes; NULL on error. */
+static void *idx_map(const char *path, const char *what, size_t minsize, size_t *size, char *serr)
+{
+  void *p;
+#ifdef ECLIDX_MMAP
+  struct stat st;
+  int fd = open(path, O_RDONLY);
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    if (serr != NULL)
+      sprintf(serr, "could not open %s index %.80s", what, path);
+    if (fd >= 0)
+      close(fd);
+    return NULL;
+  }
+  *size = (size_t) st.st_size;
+  p = *size >= minsize ? mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  close(fd);
+  if (p == MAP_FAILED) {
+    if (serr != NULL)
+      sprintf(serr, "could not map %s index %.80s", what, path);
+    return NULL;
+  }
+#else
+  FILE *fp = fopen(path, BFILE_R_ACCESS);
+  long len;
+  if (fp == NULL || fseek(fp, 0, SEEK_END) != 0 || (len = ftell(fp)) < (long) minsize
+      || fseek(fp, 0, SEEK_SET) != 0 || (p = malloc((size_t) len)) == NULL) {
+    if (serr != NULL)
+      sprintf(serr, "could not open %s index %.80s", what, path);
+    if (fp != NULL)
+      fclose(fp);
+    return NULL;
+  }
+  *size = (size_t) len;
+  if (fread(p, 1, *size, fp) != *size) {
+    if (serr != NULL)
+      sprintf(serr, "could not read %s index %.80s", what, path);
+    fclose(fp);
+    free(p);
+    return NULL;
+  }
+  fclose(fp);
+#endif
+  return p;
+}
+
+static void idx_unmap(void *p, size_t size)
+{
+#ifdef ECLIDX_MMAP
+  munmap(p, size);
+#else
+  (void) size;
+  free(p);
+#endif
+}
+
+static void idx_release(struct idx_file *f)
+{
+  if (f != NULL && IDX_ADD(&f->users, -1) == 1 && IDX_SET_ONCE(&f->unmapped))
+    idx_unmap(f->hdr, f->size);
+}
+
+/* Take a reference to the index in *cur; NULL if none is open */
+static struct idx_file *idx_acquire(struct idx_file **cur)
+{
+  struct idx_file *f;
+  for (;;) {
+    if ((f = (struct idx_file *) IDX_LOAD(cur)) == NULL)
+      return NULL;
+    IDX_ADD(&f->users, 1);
+    /* still open: the reference of the index keeps it mapped */
+    if (IDX_LOAD(cur) == f)
+      return f;
+    idx_release(f);
+  }
+}
+
+/* Make the mapped file hdr (NULL: none) the index in *cur. The previous
+ * one is unmapped as soon as no lookup is using it any more. */
+static int32 idx_replace(struct idx_file **cur, void *hdr, size_t size, const char *what, char *serr)
+{
+  struct idx_file *f = NULL;
+  if (hdr != NULL) {
+    if ((f = (struct idx_file *) calloc(1, sizeof(struct idx_file))) == NULL) {
+      if (serr != NULL)
+	sprintf(serr, "out of memory opening %s index", what);
+      idx_unmap(hdr, size);
+      return ERR;
+    }
+    f->hdr = hdr;
+    f->size = size;
+    f->users = 1;
+  }
+  idx_release((struct idx_file *) IDX_EXCHANGE(cur, f));
+  return OK;
+}
+
+/* Write header and record blocks to a temporary file and rename it, so
+ * that readers never see a partial index. */
+static int32 idx_write(const char *path, const char *what, const void *hdr, size_t hdr_size,
+                       const void *b1, size_t n1, const void *b2, size_t n2, char *serr)
+{
+  char tmp[AS_MAXCH];
+  FILE *fp;
+  AS_BOOL ok;
+  if (strlen(path) + 5 > sizeof(tmp)) {
+    if (serr != NULL)
+      sprintf(serr, "%s index path too long", what);
+    return ERR;
+  }
+  sprintf(tmp, "%s.tmp", path);
+  ok = (fp = fopen(tmp, BFILE_W_CREATE)) != NULL;
+  if (ok) {
+    ok = fwrite(hdr, hdr_size, 1, fp) == 1
+      && (n1 == 0 || fwrite(b1, n1, 1, fp) == 1)
+      && (n2 == 0 || fwrite(b2, n2, 1, fp) == 1);
+    ok = (fclose(fp) == 0) && ok;
+  }
+  if (!ok || rename(tmp, path) != 0) {
+    if (serr != NULL)
+      sprintf(serr, "could not write %s index %.80s", what, path);
+    remove(tmp);
+    return ERR;
+  }
+  return OK;
+}
+
+/* same selection as swe_sol_eclipse_when_glob(); -1 for invalid types */
+static int eclidx_solar_wanted(int32 ifltype, int32 retflag)
+{
+  if (ifltype == (SE_ECL_PARTIAL | SE_ECL_CENTRAL)
+      || ifltype == (SE_ECL_ANNULAR_TOTAL | SE_ECL_NONCENTRAL))
+    return -1;
+  if (ifltype == 0)
+    ifltype = SE_ECL_TOTAL | SE_ECL_ANNULAR | SE_ECL_PARTIAL
+           | SE_ECL_ANNULAR_TOTAL | SE_ECL_NONCENTRAL | SE_ECL_CENTRAL;
+  if (ifltype == SE_ECL_TOTAL || ifltype == SE_ECL_ANNULAR || ifltype == SE_ECL_ANNULAR_TOTAL)
+    ifltype |= (SE_ECL_NONCENTRAL | SE_ECL_CENTRAL);
+  if (ifltype == SE_ECL_PARTIAL)
+    ifltype |= SE_ECL_NONCENTRAL;
+  if (!(ifltype & SE_ECL_NONCENTRAL) && (retflag & SE_ECL_NONCENTRAL))
+    return FALSE;
+  if (!(ifltype & SE_ECL_CENTRAL) && (retflag & SE_ECL_CENTRAL))
+    return FALSE;
+  if (!(ifltype & SE_ECL_ANNULAR) && (retflag & SE_ECL_ANNULAR))
+    return FALSE;
+  if (!(ifltype & SE_ECL_PARTIAL) && (retflag & SE_ECL_PARTIAL))
+    return FALSE;
+  /* hybrid eclipses are total ones until their times are known */
+  if (!(ifltype & (SE_ECL_TOTAL | SE_ECL_ANNULAR_TOTAL))
+      && (retflag & (SE_ECL_TOTAL | SE_ECL_ANNULAR_TOTAL)))
+    return FALSE;
+  if (!(ifltype & SE_ECL_TOTAL) && (retflag & SE_ECL_TOTAL))
+    return FALSE;
+  if (!(ifltype & SE_ECL_ANNULAR_TOTAL) && (retflag & SE_ECL_ANNULAR_TOTAL))
+    return FALSE;
+  return TRUE;
+}
+
+/* same selection as swe_lun_eclipse_when(); -1 for invalid types */
+static int eclidx_lunar_wanted(int32 ifltype, int32 retflag)
+{
+  ifltype &= ~(SE_ECL_CENTRAL|SE_ECL_NONCENTRAL);
+  if (ifltype & (SE_ECL_ANNULAR|SE_ECL_ANNULAR_TOTAL)) {
+    ifltype &= ~(SE_ECL_ANNULAR|SE_ECL_ANNULAR_TOTAL);
+    if (ifltype == 0)
+      return -1;
+  }
+  if (ifltype == 0)
+    ifltype = SE_ECL_TOTAL | SE_ECL_PENUMBRAL | SE_ECL_PARTIAL;
+  if (!(ifltype & SE_ECL_PENUMBRAL) && (retflag & SE_ECL_PENUMBRAL))
+    return FALSE;
+  if (!(ifltype & SE_ECL_PARTIAL) && (retflag & SE_ECL_PARTIAL))
+    return FALSE;
+  if (!(ifltype & SE_ECL_TOTAL) && (retflag & SE_ECL_TOTAL))
+    return FALSE;
+  return TRUE;
+}
+
+/* The record the search would find, or NULL if the index cannot tell. */
+static struct eclidx_rec *eclidx_find_rec(struct eclidx_header *hdr, int32 kind, double tjd_start, int32 ifl, int32 ifltype, int32 backward)
+{
+  struct eclidx_rec *recs;
+  int32 n, lo, hi, mid, i;
+  int w;
+  if (!idx_settings_match(ifl, hdr->ifl, hdr->do_interpolate_nut, hdr->astro_models, &hdr->ephe))
+    return NULL;
+  if (backward ? tjd_start > hdr->tend : tjd_start < hdr->tstart)
+    return NULL;
+  recs = eclidx_recs(hdr, kind, &n);
+  /* lo = first record with tret[0] > tjd_start + ECLIDX_EPS */
+  lo = 0; hi = n;
+  while (lo < hi) {
+    mid = lo + (hi - lo) / 2;
+    if (recs[mid].tret[0] <= tjd_start + ECLIDX_EPS)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if (backward) {
+    /* last record with tret[0] < tjd_start - ECLIDX_EPS */
+    for (i = lo - 1; i >= 0 && recs[i].tret[0] >= tjd_start - ECLIDX_EPS; i--)
+      ;
+    for (; i >= 0; i--) {
+      w = kind == SE_ECLIDX_SOLAR ? eclidx_solar_wanted(ifltype, recs[i].retflag)
+			          : eclidx_lunar_wanted(ifltype, recs[i].retflag);
+      if (w < 0)
+	return NULL;
+      if (w)
+	return &recs[i];
+    }
+  } else {
+    for (i = lo; i < n; i++) {
+      w = kind == SE_ECLIDX_SOLAR ? eclidx_solar_wanted(ifltype, recs[i].retflag)
+			          : eclidx_lunar_wanted(ifltype, recs[i].retflag);
+      if (w < 0)
+	return NULL;
+      if (w)
+	return &recs[i];
+    }
+  }
+  return NULL;
+}
+
+/* Copy the record the search would find to *rec; FALSE if no index is
+ * open or it cannot tell. */
+static AS_BOOL eclidx_lookup(int32 kind, double tjd_start, int32 ifl, int32 ifltype, int32 backward, struct eclidx_rec *rec)
+{
+  struct idx_file *f;
+  struct eclidx_rec *found;
+  if ((f = idx_acquire(&eclidx_cur)) == NULL)
+    return FALSE;
+  found = eclidx_find_rec((struct eclidx_header *) f->hdr, kind, tjd_start, ifl, ifltype, backward);
+  if (found != NULL)
+    *rec = *found;
+  idx_release(f);
+  return found != NULL;
+}
+
+/* Answer a global eclipse search from the index. Returns TRUE and fills
+ * tret[10] and *retflag if the index covers the search.
+ */
+AS_BOOL swi_eclidx_when(int32 kind, double tjd_start, int32 ifl, int32 ifltype, int32 backward, double *tret, int32 *retflag)
+{
+  struct eclidx_rec rec;
+  if (!eclidx_lookup(kind, tjd_start, ifl, ifltype, backward, &rec))
+    return FALSE;
+  memcpy(tret, rec.tret, sizeof(rec.tret));
+  *retflag = rec.retflag;
+  return TRUE;
+}
+
+static int32 eclidx_search(int32 kind, double tjd_start, int32 ifl, int32 ifltype, int32 backward, double *tret, char *serr)
+{
+  if (kind == SE_ECLIDX_SOLAR)
+    return swi_sol_eclipse_when_glob(tjd_start, ifl, ifltype, tret, backward, serr);
+  return swi_lun_eclipse_when(tjd_start, ifl, ifltype, tret, backward, serr);
+}
+
+/* attributes at maximum: geopos[2] (solar only) and attr[11] */
+static int32 eclidx_attributes(int32 kind, double tjd, int32 ifl, double *geopos, double *attr, char *serr)
+{
+  double geo[10], att[20];
+  int32 retc;
+  memset(geo, 0, sizeof(geo));
+  memset(att, 0, sizeof(att));
+  if (kind == SE_ECLIDX_SOLAR)
+    retc = swe_sol_eclipse_where(tjd, ifl, geo, att, serr);
+  else
+    retc = swe_lun_eclipse_how(tjd, ifl, NULL, att, serr);
+  memcpy(geopos, geo, 2 * sizeof(double));
+  memcpy(attr, att, 11 * sizeof(double));
+  return retc;
+}
+
+/* Search all eclipses of one kind after tjd_start up to tjd_end;
+ * *n returns their number.
+ */
+static struct eclidx_rec *eclidx_collect(int32 kind, double tjd_start, double tjd_end, int32 ifl, int32 *n, char *serr)
+{
+  struct eclidx_rec *recs = NULL, *p;
+  int32 nalloc = 0;
+  double t = tjd_start;
+  *n = 0;
+  for (;;) {
+    if (*n == nalloc) {
+      nalloc = nalloc == 0 ? 1024 : nalloc * 2;
+      if ((p = (struct eclidx_rec *) realloc(recs, (size_t) nalloc * sizeof(struct eclidx_rec))) == NULL) {
+	if (serr != NULL)
+	  strcpy(serr, "out of memory building eclipse index");
+	free(recs);
+	return NULL;
+      }
+      recs = p;
+    }
+    p = &recs[*n];
+    memset(p, 0, sizeof(struct eclidx_rec));
+    if ((p->retflag = eclidx_search(kind, t, ifl, 0, 0, p->tret, serr)) == ERR) {
+      free(recs);
+      return NULL;
+    }
+    if (p->tret[0] > tjd_end)
+      return recs;
+    if (eclidx_attributes(kind, p->tret[0], ifl, p->geopos, p->attr, serr) == ERR) {
+      free(recs);
+      return NULL;
+    }
+    t = p->tret[0];
+    (*n)++;
+  }
+}
+
+/* Build an eclipse index of all solar and lunar eclipses with maximum
+ * between tjd_start and tjd_end (UT) and write it to path. ifl is the
+ * ephemeris flag. Takes a few seconds per century.
+ */
+int32 CALL_CONV swe_eclipse_index_build(const char *path, double tjd_start, double tjd_end, int32 ifl, char *serr)
+{
+  struct eclidx_header hdr;
+  struct eclidx_rec *sol, *lun;
+  int32 nsol, nlun, retc;
+  if (serr != NULL)
+    *serr = '\0';
+  ifl = eclidx_epheflag(ifl);
+  if ((sol = eclidx_collect(SE_ECLIDX_SOLAR, tjd_start, tjd_end, ifl, &nsol, serr)) == NULL)
+    return ERR;
+  if ((lun = eclidx_collect(SE_ECLIDX_LUNAR, tjd_start, tjd_end, ifl, &nlun, serr)) == NULL) {
+    free(sol);
+    return ERR;
+  }
+  memset(&hdr, 0, sizeof(hdr));
+  hdr.magic = ECLIDX_MAGIC;
+  hdr.layout = ECLIDX_LAYOUT_VERSION;
+  hdr.byte_order = IDX_BYTE_ORDER;
+  hdr.rec_size = sizeof(struct eclidx_rec);
+  strncpy(hdr.version, SE_VERSION, sizeof(hdr.version) - 1);
+  hdr.ifl = ifl;
+  hdr.nsol = nsol;
+  hdr.nlun = nlun;
+  hdr.do_interpolate_nut = swed.do_interpolate_nut;
+  memcpy(hdr.astro_models, swed.astro_models, sizeof(hdr.astro_models));
+  hdr.tstart = tjd_start;
+  hdr.tend = tjd_end;
+  idx_ephe_get(ifl, (tjd_start + tjd_end) / 2, &hdr.ephe);
+  retc = idx_write(path, "eclipse", &hdr, sizeof(hdr), sol, (size_t) nsol * sizeof(struct eclidx_rec),
+                   lun, (size_t) nlun * sizeof(struct eclidx_rec), serr);
+  free(sol);
+  free(lun);
+  return retc;
+}
+
+/* Open an eclipse index for all threads of the process; path == NULL
+ * closes it, as does swe_close(). The previous index is unmapped when
+ * no other thread is reading it any more.
+ */
+int32 CALL_CONV swe_eclipse_index_open(const char *path, char *serr)
+{
+  struct eclidx_header *hdr;
+  size_t size;
+  if (serr != NULL)
+    *serr = '\0';
+  idx_replace(&eclidx_cur, NULL, 0, "eclipse", serr);
+  if (path == NULL || *path == '\0')
+    return OK;
+  if ((hdr = (struct eclidx_header *) idx_map(path, "eclipse", sizeof(struct eclidx_header), &size, serr)) == NULL)
+    return ERR;
+  if (hdr->magic != ECLIDX_MAGIC || hdr->byte_order != IDX_BYTE_ORDER
+      || hdr->layout != ECLIDX_LAYOUT_VERSION || hdr->rec_size != sizeof(struct eclidx_rec)
+      || strncmp(hdr->version, SE_VERSION, sizeof(hdr->version)) != 0
+      || hdr->nsol < 0 || hdr->nlun < 0
+      || sizeof(struct eclidx_header) + ((size_t) hdr->nsol + hdr->nlun) * sizeof(struct eclidx_rec) > size) {
+    if (serr != NULL)
+      sprintf(serr, "eclipse index %.80s is incompatible with this version", path);
+    idx_unmap(hdr, size);
+    return ERR;
+  }
+  return idx_replace(&eclidx_cur, hdr, size, "eclipse", serr);
+}
+
+/* Next (or with backward, previous) eclipse of kind SE_ECLIDX_SOLAR or
+ * SE_ECLIDX_LUNAR like swe_sol_eclipse_when_glob() resp.
+ * swe_lun_eclipse_when(), plus the attributes at maximum:
+ *   geopos[0..1]  solar: geographic longitude and latitude of the maximum
+ *   attr[0..10]   as swe_sol_eclipse_where() resp. swe_lun_eclipse_how()
+ * geopos and attr (declare attr[20]) may be NULL. Outside the index the
+ * eclipse is searched.
+ */
+int32 CALL_CONV swe_eclipse_index_find(int32 kind, double tjd_start, int32 ifl, int32 ifltype, int32 backward, double *tret, double *geopos, double *attr, char *serr)
+{
+  struct eclidx_rec rec;
+  double geo[2], att[11];
+  int32 retflag;
+  if (kind != SE_ECLIDX_SOLAR && kind != SE_ECLIDX_LUNAR) {
+    if (serr != NULL)
+      sprintf(serr, "invalid eclipse index kind %d", kind);
+    return ERR;
+  }
+  if (eclidx_lookup(kind, tjd_start, ifl, ifltype, backward, &rec)) {
+    memcpy(tret, rec.tret, sizeof(rec.tret));
+    memcpy(geo, rec.geopos, sizeof(geo));
+    memcpy(att, rec.attr, sizeof(att));
+    retflag = rec.retflag;
+  } else {
+    if (kind == SE_ECLIDX_SOLAR)
+      retflag = swe_sol_eclipse_when_glob(tjd_start, ifl, ifltype, tret, backward, serr);
+    else
+      retflag = swe_lun_eclipse_when(tjd_start, ifl, ifltype, tret, backward, serr);
+    if (retflag <= 0 || (geopos == NULL && attr == NULL))
+      return retflag;
+    if (eclidx_attributes(kind, tret[0], ifl, geo, att, serr) == ERR)
+      return ERR;
+  }
+  if (geopos != NULL)
+    memcpy(geopos, geo, sizeof(geo));
+  if (attr != NULL) {
+    memset(attr, 0, 20 * sizeof(double));
+    memcpy(attr, att, sizeof(att));
+  }
+  return retflag;
+}
+
+/* Eclipses of kind SE_ECLIDX_SOLAR or SE_ECLIDX_LUNAR with maximum in
+ * [tjd1, tjd2), filtered by ifltype like the searches. The times of
+ * maximum and eclipse types of the first nmax of them are written to
+ * tmax[] and types[] (either may be NULL).
+ * Returns their total number or ERR.
+ */
+int32 CALL_CONV swe_eclipse_index_range(int32 kind, double tjd1, double tjd2, int32 ifl, int32 ifltype, double *tmax, int32 *types, int32 nmax, char *serr)
+{
+  double tret[10], t = tjd1 - 2 * ECLIDX_EPS;
+  int32 retflag, n = 0;
+  for (;;) {
+    if ((retflag = swe_eclipse_index_find(kind, t, ifl, ifltype, 0, tret, NULL, NULL, serr)) <= 0)
+      return retflag == 0 ? n : ERR;
+    if (tret[0] >= tjd2)
+      return n;
+    if (tret[0] >= tjd1) {
+      if (n < nmax) {
+	if (tmax != NULL)
+	  tmax[n] = tret[0];
+	if (types != NULL)
+	  types[n] = retflag;
+      }
+      n++;
+    }
+    t = tret[0];
+  }
+}
+
+/**************************************************************
+ * lunation catalogue
+ **************************************************************/
+
+#define LUNIDX_MAGIC		0x494c4553	/* "SELI" */
+#define LUNIDX_K0		2451550.09766	/* mean new moon of lunation 0 (Meeus), 2000-01-06 */
+#define LUNIDX_SYNODIC		29.530588861
+#define LUNIDX_BROWN		953		/* Brown lunation number of Meeus' lunation 0 */
+#define LUNIDX_P0		2451534.6698	/* mean perigee 1999-12-22 (Meeus) */
+#define LUNIDX_ANOMALISTIC	27.55454989
+
+struct lunidx_header {
+  uint32 magic;
+  uint32 layout;
+  uint32 byte_order;
+  uint32 rec_size;
+  char version[16];	/* SE_VERSION of the builder */
+  int32 ifl;		/* ephemeris flag */
+  int32 nlun;		/* lunations */
+  int32 naps;		/* apsides, 0 if not built */
+  int32 first_lunation;	/* Brown lunation number of the first record */
+  int32 do_interpolate_nut;
+  int32 astro_models[SEI_NMODELS];
+  struct idx_ephe ephe;
+  /* followed by nlun lunation and naps apsis records */
+};
+
+struct lunidx_rec {
+  double t[4];		/* new moon, first quarter, full moon, last quarter */
+};
+
+struct lunidx_aps {
+  double t;
+  double dist;		/* AU */
+  int32 type;		/* SE_MOONAPS_PERIGEE or SE_MOONAPS_APOGEE */
+  int32 unused;
+};
+
+static struct idx_file *lunidx_cur = NULL;
+
+static struct lunidx_rec *lunidx_recs(struct lunidx_header *hdr)
+{
+  return (struct lunidx_rec *) (hdr + 1);
+}
+
+static struct lunidx_aps *lunidx_apsides(struct lunidx_header *hdr)
+{
+  return (struct lunidx_aps *) (lunidx_recs(hdr) + hdr->nlun);
+}
+
+/* A reference to the catalogue, if it can answer for these settings;
+ * release it with idx_release() */
+static struct idx_file *lunidx_acquire(int32 ifl)
+{
+  struct idx_file *f;
+  struct lunidx_header *hdr;
+  if ((f = idx_acquire(&lunidx_cur)) == NULL)
+    return NULL;
+  hdr = (struct lunidx_header *) f->hdr;
+  if (!idx_settings_match(ifl, hdr->ifl, hdr->do_interpolate_nut, hdr->astro_models, &hdr->ephe)) {
+    idx_release(f);
+    return NULL;
+  }
+  return f;
+}
+
+/* Time (UT) when the apparent elongation of the Moon from the Sun is
+ * 0, 90, 180 or 270 degrees, for k = lunation + 0, 0.25, 0.5, 0.75.
+ * Newton iteration from the mean phase.
+ */
+static int32 lunidx_phase(double k, int32 ifl, double *tret, char *serr)
+{
+  double xs[6], xm[6], d, dt, target;
+  double t = LUNIDX_K0 + k * LUNIDX_SYNODIC;
+  int i;
+  target = (k - floor(k)) * 360.0;
+  for (i = 0; i < 20; i++) {
+    if (swe_calc_ut(t, SE_SUN, ifl | SEFLG_SPEED, xs, serr) == ERR
+	|| swe_calc_ut(t, SE_MOON, ifl | SEFLG_SPEED, xm, serr) == ERR)
+      return ERR;
+    d = swe_difdeg2n(swe_degnorm(xm[0] - xs[0]), target);
+    dt = -d / (xm[3] - xs[3]);
+    t += dt;
+    if (fabs(dt) < 1e-8)
+      break;
+  }
+  *tret = t;
+  return OK;
+}
+
+/* the lunation (Meeus numbering) whose new moon is the last one at or
+ * before tjd, and its new moon */
+static int32 lunidx_lunation_at(double tjd, int32 ifl, double *k, double *tnew, char *serr)
+{
+  double t;
+  *k = floor((tjd - LUNIDX_K0) / LUNIDX_SYNODIC);
+  if (lunidx_phase(*k, ifl, tnew, serr) == ERR)
+    return ERR;
+  while (*tnew > tjd) {
+    *k -= 1;
+    if (lunidx_phase(*k, ifl, tnew, serr) == ERR)
+      return ERR;
+  }
+  for (;;) {
+    if (lunidx_phase(*k + 1, ifl, &t, serr) == ERR)
+      return ERR;
+    if (t > tjd)
+      return OK;
+    *k += 1;
+    *tnew = t;
+  }
+}
+
+/* radial speed of the Moon */
+static int32 lunidx_rspeed(double t, int32 ifl, double *v, double *dist, char *serr)
+{
+  double xm[6];
+  if (swe_calc_ut(t, SE_MOON, ifl | SEFLG_SPEED, xm, serr) == ERR)
+    return ERR;
+  *v = xm[5];
+  if (dist != NULL)
+    *dist = xm[2];
+  return OK;
+}
+
+/* True perigee (k integer) or apogee (k + 0.5) near the mean one of
+ * anomalistic month k: zero of the radial speed, bracketed around the
+ * mean time and refined by regula falsi (Illinois).
+ */
+static int32 lunidx_apsis(double k, int32 ifl, double *tret, double *dist, char *serr)
+{
+  double tm = LUNIDX_P0 + k * LUNIDX_ANOMALISTIC;
+  double a, b, c, fa, fb, fc, sgn;
+  int side = 0, i;
+  /* perigee: radial speed goes from negative to positive */
+  sgn = (k - floor(k)) == 0 ? 1 : -1;
+  a = tm - 5; b = tm + 5;
+  if (lunidx_rspeed(a, ifl, &fa, NULL, serr) == ERR || lunidx_rspeed(b, ifl, &fb, NULL, serr) == ERR)
+    return ERR;
+  fa *= sgn; fb *= sgn;
+  if (fa >= 0 || fb <= 0) {
+    if (serr != NULL)
+      sprintf(serr, "lunar apsis near jd %f not bracketed", tm);
+    return ERR;
+  }
+  c = tm;
+  for (i = 0; i < 100 && b - a > 1e-7; i++) {
+    c = (a * fb - b * fa) / (fb - fa);
+    if (lunidx_rspeed(c, ifl, &fc, NULL, serr) == ERR)
+      return ERR;
+    fc *= sgn;
+    if (fc == 0)
+      break;
+    if (fc < 0) {
+      a = c; fa = fc;
+      if (side == -1)
+	fb /= 2;
+      side = -1;
+    } else {
+      b = c; fb = fc;
+      if (side == 1)
+	fa /= 2;
+      side = 1;
+    }
+  }
+  *tret = c;
+  return lunidx_rspeed(c, ifl, &fc, dist, serr);
+}
+
+/* Build a lunation catalogue: the times of the four main phases of every
+ * lunation from the one containing tjd_start to the one containing
+ * tjd_end (UT), with their Brown lunation numbers; with
+ * SE_LUNIDX_APSIDES in options also the perigees and apogees of the
+ * Moon in this span. ifl is the ephemeris flag.
+ */
+int32 CALL_CONV swe_lunation_index_build(const char *path, double tjd_start, double tjd_end, int32 ifl, int32 options, char *serr)
+{
+  struct lunidx_header hdr;
+  struct lunidx_rec *recs = NULL;
+  struct lunidx_aps *aps = NULL;
+  double k, k0, tnew, ka;
+  int32 nlun = 0, naps = 0, nalloc, i, retc = ERR;
+  if (serr != NULL)
+    *serr = '\0';
+  ifl = eclidx_epheflag(ifl);
+  if (lunidx_lunation_at(tjd_start, ifl, &k0, &tnew, serr) == ERR
+      || lunidx_lunation_at(tjd_end, ifl, &k, &tnew, serr) == ERR)
+    return ERR;
+  /* one more lunation, so that the last one ends */
+  nlun = (int32) (k - k0) + 2;
+  recs = (struct lunidx_rec *) calloc((size_t) nlun, sizeof(struct lunidx_rec));
+  /* two apsides per anomalistic month, which is shorter than a lunation */
+  nalloc = 2 * (int32) (nlun * LUNIDX_SYNODIC / LUNIDX_ANOMALISTIC) + 8;
+  if (options & SE_LUNIDX_APSIDES)
+    aps = (struct lunidx_aps *) calloc((size_t) nalloc, sizeof(struct lunidx_aps));
+  if (recs == NULL || ((options & SE_LUNIDX_APSIDES) && aps == NULL)) {
+    if (serr != NULL)
+      strcpy(serr, "out of memory building lunation index");
+    goto end;
+  }
+  for (i = 0; i < nlun; i++) {
+    if (lunidx_phase(k0 + i, ifl, &recs[i].t[0], serr) == ERR
+	|| lunidx_phase(k0 + i + 0.25, ifl, &recs[i].t[1], serr) == ERR
+	|| lunidx_phase(k0 + i + 0.5, ifl, &recs[i].t[2], serr) == ERR
+	|| lunidx_phase(k0 + i + 0.75, ifl, &recs[i].t[3], serr) == ERR)
+      goto end;
+  }
+  if (options & SE_LUNIDX_APSIDES) {
+    /* all apsides between the first and the last new moon */
+    ka = floor((recs[0].t[0] - LUNIDX_P0) / LUNIDX_ANOMALISTIC) - 1;
+    for (;; ka += 0.5) {
+      if (naps == nalloc) {
+	if (serr != NULL)
+	  strcpy(serr, "too many apsides building lunation index");
+	goto end;
+      }
+      if (lunidx_apsis(ka, ifl, &aps[naps].t, &aps[naps].dist, serr) == ERR)
+	goto end;
+      if (aps[naps].t < recs[0].t[0])
+	continue;
+      if (aps[naps].t > recs[nlun - 1].t[0])
+	break;
+      aps[naps].type = (ka - floor(ka)) == 0 ? SE_MOONAPS_PERIGEE : SE_MOONAPS_APOGEE;
+      naps++;
+    }
+  }
+  memset(&hdr, 0, sizeof(hdr));
+  hdr.magic = LUNIDX_MAGIC;
+  hdr.layout = LUNIDX_LAYOUT_VERSION;
+  hdr.byte_order = IDX_BYTE_ORDER;
+  hdr.rec_size = sizeof(struct lunidx_rec);
+  strncpy(hdr.version, SE_VERSION, sizeof(hdr.version) - 1);
+  hdr.ifl = ifl;
+  hdr.nlun = nlun;
+  hdr.naps = naps;
+  hdr.first_lunation = (int32) k0 + LUNIDX_BROWN;
+  hdr.do_interpolate_nut = swed.do_interpolate_nut;
+  memcpy(hdr.astro_models, swed.astro_models, sizeof(hdr.astro_models));
+  idx_ephe_get(ifl, (tjd_start + tjd_end) / 2, &hdr.ephe);
+  retc = idx_write(path, "lunation", &hdr, sizeof(hdr), recs, (size_t) nlun * sizeof(struct lunidx_rec),
+                   aps, (size_t) naps * sizeof(struct lunidx_aps), serr);
+end:
+  free(recs);
+  free(aps);
+  return retc;
+}
+
+/* Open a lunation catalogue for all threads of the process; path == NULL
+ * closes it, as does swe_close(). As with the eclipse index, the
+ * previous one is unmapped when no other thread is reading it any more.
+ */
+int32 CALL_CONV swe_lunation_index_open(const char *path, char *serr)
+{
+  struct lunidx_header *hdr;
+  size_t size;
+  if (serr != NULL)
+    *serr = '\0';
+  idx_replace(&lunidx_cur, NULL, 0, "lunation", serr);
+  if (path == NULL || *path == '\0')
+    return OK;
+  if ((hdr = (struct lunidx_header *) idx_map(path, "lunation", sizeof(struct lunidx_header), &size, serr)) == NULL)
+    return ERR;
+  if (hdr->magic != LUNIDX_MAGIC || hdr->byte_order != IDX_BYTE_ORDER
+      || hdr->layout != LUNIDX_LAYOUT_VERSION || hdr->rec_size != sizeof(struct lunidx_rec)
+      || strncmp(hdr->version, SE_VERSION, sizeof(hdr->version)) != 0
+      || hdr->nlun < 2 || hdr->naps < 0
+      || sizeof(struct lunidx_header) + (size_t) hdr->nlun * sizeof(struct lunidx_rec)
+         + (size_t) hdr->naps * sizeof(struct lunidx_aps) > size) {
+    if (serr != NULL)
+      sprintf(serr, "lunation index %.80s is incompatible with this version", path);
+    idx_unmap(hdr, size);
+    return ERR;
+  }
+  return idx_replace(&lunidx_cur, hdr, size, "lunation", serr);
+}
+
+/* The lunation containing tjd_ut (the last new moon at or before it):
+ *   tret[0]  new moon
+ *   tret[1]  first quarter
+ *   tret[2]  full moon
+ *   tret[3]  last quarter
+ *   tret[4]  next new moon
+ * *lunation returns its Brown lunation number (lunation 1 began on
+ * 1923 Jan 17). The phases are the times (UT) when the apparent
+ * geocentric longitudes of Moon and Sun differ by 0, 90, 180 and 270
+ * degrees; only the ephemeris flag of ifl is used. From the lunation
+ * catalogue by binary search, if one is open and covers the date,
+ * otherwise computed.
+ */
+int32 CALL_CONV swe_lunation_find(double tjd_ut, int32 ifl, double *tret, int32 *lunation, char *serr)
+{
+  struct idx_file *f;
+  struct lunidx_header *hdr;
+  struct lunidx_rec *recs;
+  double k, tnew;
+  int32 lo, hi, mid, i;
+  if (serr != NULL)
+    *serr = '\0';
+  ifl = eclidx_epheflag(ifl);
+  if ((f = lunidx_acquire(ifl)) != NULL) {
+    hdr = (struct lunidx_header *) f->hdr;
+    recs = lunidx_recs(hdr);
+    if (tjd_ut >= recs[0].t[0] && tjd_ut < recs[hdr->nlun - 1].t[0]) {
+      /* lo = first record with new moon > tjd_ut */
+      lo = 0; hi = hdr->nlun;
+      while (lo < hi) {
+	mid = lo + (hi - lo) / 2;
+	if (recs[mid].t[0] <= tjd_ut)
+	  lo = mid + 1;
+	else
+	  hi = mid;
+      }
+      memcpy(tret, recs[lo - 1].t, sizeof(recs[0].t));
+      tret[4] = recs[lo].t[0];
+      if (lunation != NULL)
+	*lunation = hdr->first_lunation + lo - 1;
+      idx_release(f);
+      return OK;
+    }
+    idx_release(f);
+  }
+  if (lunidx_lunation_at(tjd_ut, ifl, &k, &tnew, serr) == ERR)
+    return ERR;
+  tret[0] = tnew;
+  for (i = 1; i <= 4; i++) {
+    if (lunidx_phase(k + i * 0.25, ifl, &tret[i], serr) == ERR)
+      return ERR;
+  }
+  if (lunation != NULL)
+    *lunation = (int32) k + LUNIDX_BROWN;
+  return OK;
+}
+
+/* Main phases of the Moon in [tjd1, tjd2) (UT): the times and phases
+ * (SE_MOONPHASE_NEW ... SE_MOONPHASE_LAST_QUARTER) of the first nmax of
+ * them are written to tret[] and phases[] (either may be NULL).
+ * Returns their total number or ERR.
+ */
+int32 CALL_CONV swe_lunar_phase_range(double tjd1, double tjd2, int32 ifl, double *tret, int32 *phases, int32 nmax, char *serr)
+{
+  double t[5], tjd = tjd1;
+  int32 n = 0, i;
+  while (tjd < tjd2) {
+    if (swe_lunation_find(tjd, ifl, t, NULL, serr) == ERR)
+      return ERR;
+    for (i = 0; i < 4; i++) {
+      if (t[i] < tjd1 || t[i] >= tjd2)
+	continue;
+      if (n < nmax) {
+	if (tret != NULL)
+	  tret[n] = t[i];
+	if (phases != NULL)
+	  phases[n] = i;
+      }
+      n++;
+    }
+    tjd = t[4];
+  }
+  return n;
+}
+
+/* Next perigee and apogee of the Moon after tjd_ut: times (UT) in
+ * tret[0] (perigee) and tret[1] (apogee), geocentric distances in AU
+ * in dist[0] and dist[1] (dist may be NULL). From the lunation
+ * catalogue if it contains apsides and covers the date, otherwise
+ * computed.
+ */
+int32 CALL_CONV swe_lunar_apsides_find(double tjd_ut, int32 ifl, double *tret, double *dist, char *serr)
+{
+  struct idx_file *f;
+  struct lunidx_header *hdr;
+  struct lunidx_aps *aps;
+  double k, t, d;
+  int32 lo, hi, mid, i, found = 0;
+  if (serr != NULL)
+    *serr = '\0';
+  ifl = eclidx_epheflag(ifl);
+  if ((f = lunidx_acquire(ifl)) != NULL) {
+    hdr = (struct lunidx_header *) f->hdr;
+    aps = lunidx_apsides(hdr);
+    if (hdr->naps > 0 && tjd_ut >= aps[0].t) {
+      lo = 0; hi = hdr->naps;
+      while (lo < hi) {
+	mid = lo + (hi - lo) / 2;
+	if (aps[mid].t <= tjd_ut)
+	  lo = mid + 1;
+	else
+	  hi = mid;
+      }
+      for (i = lo; i < hdr->naps && found != 3; i++) {
+	int j = aps[i].type == SE_MOONAPS_PERIGEE ? 0 : 1;
+	if (found & (1 << j))
+	  continue;
+	tret[j] = aps[i].t;
+	if (dist != NULL)
+	  dist[j] = aps[i].dist;
+	found |= 1 << j;
+      }
+    }
+    idx_release(f);
+    if (found == 3)
+      return OK;
+  }
+  found = 0;
+  k = floor((tjd_ut - LUNIDX_P0) / LUNIDX_ANOMALISTIC) - 1;
+  for (; found != 3; k += 0.5) {
+    int j = (k - floor(k)) == 0 ? 0 : 1;
+    if (found & (1 << j))
+      continue;
+    if (lunidx_apsis(k, ifl, &t, &d, serr) == ERR)
+      return ERR;
+    if (t <= tjd_ut)
+      continue;
+    tret[j] = t;
+    if (dist != NULL)
+      dist[j] = d;
+    found |= 1 << j;
+  }
+  return OK;
+}
+
+/**************************************************************
+ * longitude index
+ **************************************************************/
+
+#define LONIDX_MAGIC		0x584c4553	/* "SELX" */
+#define LONIDX_NCOEF		9	/* Chebyshev series of degree 8 */
+#define LONIDX_NSAMPLE		32	/* derivative samples per segment for stations */
+#define LONIDX_MAX		32	/* indexes open at the same time */
+#define LONIDX_FLAGMASK		(~(SEFLG_EPHMASK | SEFLG_SPEED | SEFLG_SPEED3))
+
+struct lonidx_header {
+  uint32 magic;
+  uint32 layout;
+  uint32 byte_order;
+  uint32 rec_size;
+  char version[16];	/* SE_VERSION of the builder */
+  int32 ipl;
+  int32 iflag;		/* calculation flags, ephemeris flag included */
+  int32 nseg;
+  int32 npiece;
+  int32 sid_mode;
+  int32 do_interpolate_nut;
+  int32 astro_models[SEI_NMODELS];
+  struct idx_ephe ephe;
+  double seglen;	/* days per segment */
+  double tstart;	/* start of the first segment (UT) */
+  double sid_t0, sid_ayan_t0;
+  /* followed by nseg segments and npiece pieces */
+};
+
+/* Chebyshev coefficients of the continuous longitude over segment i,
+ * [tstart + i * seglen, tstart + (i + 1) * seglen] */
+struct lonidx_seg {
+  double c[LONIDX_NCOEF];
+};
+
+/* A piece of a segment where the longitude is monotonic. The pieces
+ * from a station to the next one form a run. */
+struct lonidx_piece {
+  double t0, t1;
+  double l0, l1;	/* continuous longitude, l0 == l1 of the previous piece */
+  int32 seg;
+  int32 run_end;	/* index of the last piece of the run */
+};
+
+static struct idx_file *lonidx_tab[LONIDX_MAX];
+
+static struct lonidx_seg *lonidx_segs(struct lonidx_header *hdr)
+{
+  return (struct lonidx_seg *) (hdr + 1);
+}
+
+static struct lonidx_piece *lonidx_pieces(struct lonidx_header *hdr)
+{
+  return (struct lonidx_piece *) (lonidx_segs(hdr) + hdr->nseg);
+}
+
+/* Segment length: short for the fast and irregular lunar points. */
+static double lonidx_seglen(int32 ipl)
+{
+  switch (ipl) {
+  case SE_MOON:
+  case SE_TRUE_NODE:
+  case SE_OSCU_APOG:
+    return 2;
+  case SE_MERCURY:
+  case SE_VENUS:
+    return 4;
+  case SE_MEAN_NODE:
+  case SE_MEAN_APOG:
+  case SE_JUPITER:
+  case SE_SATURN:
+  case SE_URANUS:
+  case SE_NEPTUNE:
+  case SE_PLUTO:
+    return 16;
+  default:
+    return 8;
+  }
+}
+
+/* longitude of segment seg and its speed at t */
+static double lonidx_eval(struct lonidx_header *hdr, int32 seg, double t, double *speed)
+{
+  double *c = lonidx_segs(hdr)[seg].c;
+  double x = 2 * (t - hdr->tstart - seg * hdr->seglen) / hdr->seglen - 1;
+  if (speed != NULL)
+    *speed = swi_edcheb(x, c, LONIDX_NCOEF) * 2 / hdr->seglen;
+  return swi_echeb(x, c, LONIDX_NCOEF);
+}
+
+/* append the piece [t0, t1] of segment seg, if not empty */
+static int32 lonidx_add_piece(struct lonidx_header *hdr, struct lonidx_piece *pc, int32 np, int32 seg, double t0, double t1)
+{
+  if (t1 <= t0)
+    return np;
+  pc[np].t0 = t0;
+  pc[np].t1 = t1;
+  pc[np].l0 = np > 0 ? pc[np - 1].l1 : lonidx_eval(hdr, seg, t0, NULL);
+  pc[np].l1 = lonidx_eval(hdr, seg, t1, NULL);
+  pc[np].seg = seg;
+  return np + 1;
+}
+
+/* Fit the Chebyshev segments of [t1, t2] and split them into monotonic
+ * pieces. The segments lie on a grid of multiples of the segment length
+ * from J2000, so that the same segments are fitted for any range. The
+ * header, segments and pieces are returned in one allocated block.
+ */
+static struct lonidx_header *lonidx_make(int32 ipl, double t1, double t2, int32 iflag, char *serr)
+{
+  struct lonidx_header *hdr;
+  struct lonidx_seg *segs;
+  struct lonidx_piece *pc;
+  double seglen = lonidx_seglen(ipl);
+  double f[LONIDX_NCOEF], x[6], lprev = 0, tp, ta, tb, va, vb, t, v, sum;
+  double k0 = floor((t1 - J2000) / seglen), k1 = ceil((t2 - J2000) / seglen);
+  int32 nseg, np = 0, i, j, k, last;
+  if (k1 <= k0)
+    k1 = k0 + 1;
+  nseg = (int32) (k1 - k0);
+  /* at most LONIDX_NSAMPLE stations per segment are found */
+  hdr = (struct lonidx_header *) calloc(1, sizeof(struct lonidx_header)
+		+ (size_t) nseg * sizeof(struct lonidx_seg)
+		+ (size_t) nseg * (LONIDX_NSAMPLE + 1) * sizeof(struct lonidx_piece));
+  if (hdr == NULL) {
+    if (serr != NULL)
+      strcpy(serr, "out of memory building longitude index");
+    return NULL;
+  }
+  hdr->magic = LONIDX_MAGIC;
+  hdr->layout = LONIDX_LAYOUT_VERSION;
+  hdr->byte_order = IDX_BYTE_ORDER;
+  hdr->rec_size = sizeof(struct lonidx_piece);
+  strncpy(hdr->version, SE_VERSION, sizeof(hdr->version) - 1);
+  hdr->ipl = ipl;
+  hdr->iflag = iflag;
+  hdr->nseg = nseg;
+  hdr->seglen = seglen;
+  hdr->tstart = J2000 + k0 * seglen;
+  if (iflag & SEFLG_SIDEREAL) {
+    hdr->sid_mode = swed.sidd.sid_mode;
+    hdr->sid_t0 = swed.sidd.t0;
+    hdr->sid_ayan_t0 = swed.sidd.ayan_t0;
+  }
+  hdr->do_interpolate_nut = swed.do_interpolate_nut;
+  memcpy(hdr->astro_models, swed.astro_models, sizeof(hdr->astro_models));
+  idx_ephe_get(eclidx_epheflag(iflag), (t1 + t2) / 2, &hdr->ephe);
+  segs = lonidx_segs(hdr);
+  for (i = 0; i < nseg; i++) {
+    /* Chebyshev nodes, forward in time */
+    for (j = LONIDX_NCOEF - 1; j >= 0; j--) {
+      t = hdr->tstart + seglen * (i + (1 + cos(M_PI * (j + 0.5) / LONIDX_NCOEF)) / 2);
+      if (swe_calc_ut(t, ipl, iflag, x, serr) == ERR) {
+	free(hdr);
+	return NULL;
+      }
+      /* continuous longitude */
+      if (i == 0 && j == LONIDX_NCOEF - 1)
+	lprev = x[0];
+      f[j] = lprev + swe_difdeg2n(x[0], lprev);
+      lprev = f[j];
+    }
+    for (k = 0; k < LONIDX_NCOEF; k++) {
+      sum = 0;
+      for (j = 0; j < LONIDX_NCOEF; j++)
+	sum += f[j] * cos(M_PI * k * (j + 0.5) / LONIDX_NCOEF);
+      segs[i].c[k] = sum * 2 / LONIDX_NCOEF;
+    }
+    /* the next segment continues from the end of this one */
+    lprev = lonidx_eval(hdr, i, hdr->tstart + (i + 1) * seglen, NULL);
+  }
+  /* split at the zeros of the speed */
+  pc = lonidx_pieces(hdr);
+  for (i = 0; i < nseg; i++) {
+    tp = ta = hdr->tstart + i * seglen;
+    lonidx_eval(hdr, i, ta, &va);
+    for (j = 1; j <= LONIDX_NSAMPLE; j++) {
+      tb = hdr->tstart + (i + (double) j / LONIDX_NSAMPLE) * seglen;
+      lonidx_eval(hdr, i, tb, &vb);
+      if ((va > 0) != (vb > 0)) {
+	/* station between ta and tb: bisection on the speed */
+	double a = ta, b = tb;
+	for (k = 0; k < 50 && b - a > 1e-9; k++) {
+	  t = (a + b) / 2;
+	  lonidx_eval(hdr, i, t, &v);
+	  if ((v > 0) == (va > 0))
+	    a = t;
+	  else
+	    b = t;
+	}
+	np = lonidx_add_piece(hdr, pc, np, i, tp, b);
+	tp = b;
+      }
+      ta = tb;
+      va = vb;
+    }
+    np = lonidx_add_piece(hdr, pc, np, i, tp, hdr->tstart + (i + 1) * seglen);
+  }
+  /* runs: consecutive pieces moving in the same direction */
+  for (i = np - 1, last = np - 1; i >= 0; i--) {
+    if (i < np - 1 && (pc[i].l1 > pc[i].l0) != (pc[i + 1].l1 > pc[i + 1].l0))
+      last = i;
+    pc[i].run_end = last;
+  }
+  hdr->npiece = np;
+  return hdr;
+}
+
+/* calculation flags of an index: speed dropped, ephemeris flag set */
+static int32 lonidx_iflag(int32 iflag)
+{
+  return (iflag & LONIDX_FLAGMASK) | eclidx_epheflag(iflag);
+}
+
+/* Only ecliptic longitudes in degrees, geocentric or heliocentric, can
+ * be indexed and searched. */
+static int32 lonidx_check_flags(int32 iflag, char *serr)
+{
+  if (iflag & (SEFLG_TOPOCTR | SEFLG_EQUATORIAL | SEFLG_XYZ | SEFLG_RADIANS)) {
+    if (serr != NULL)
+      strcpy(serr, "longitude index: only geocentric or heliocentric ecliptic longitudes");
+    return ERR;
+  }
+  return OK;
+}
+
+/* TRUE if hdr holds the longitudes of ipl for iflag and the current
+ * settings */
+static AS_BOOL lonidx_matches(struct lonidx_header *hdr, int32 ipl, int32 iflag)
+{
+  if (hdr->ipl != ipl || hdr->iflag != iflag)
+    return FALSE;
+  if (!idx_settings_match(iflag, hdr->iflag & SEFLG_EPHMASK, hdr->do_interpolate_nut, hdr->astro_models, &hdr->ephe))
+    return FALSE;
+  if ((iflag & SEFLG_SIDEREAL) && (hdr->sid_mode != swed.sidd.sid_mode
+	|| hdr->sid_t0 != swed.sidd.t0 || hdr->sid_ayan_t0 != swed.sidd.ayan_t0))
+    return FALSE;
+  return TRUE;
+}
+
+/* time in piece p when its polynomial reaches target; Newton iteration
+ * kept inside the bracket */
+static double lonidx_invert(struct lonidx_header *hdr, struct lonidx_piece *p, double target)
+{
+  double a = p->t0, b = p->t1, fa = p->l0 - target, t, tn, f, v;
+  int k;
+  t = p->l1 == p->l0 ? a : a + (b - a) * (target - p->l0) / (p->l1 - p->l0);
+  for (k = 0; k < 60; k++) {
+    f = lonidx_eval(hdr, p->seg, t, &v) - target;
+    if (f == 0)
+      break;
+    if ((f > 0) == (fa > 0))
+      a = t;
+    else
+      b = t;
+    tn = v != 0 ? t - f / v : (a + b) / 2;
+    if (!(tn > a && tn < b))
+      tn = (a + b) / 2;
+    if (fabs(tn - t) < 1e-10) {
+      t = tn;
+      break;
+    }
+    t = tn;
+  }
+  return t;
+}
+
+/* Refine a crossing with the ephemeris; the speed is taken from the
+ * polynomial. Close to a station the interpolated time is kept. */
+static int32 lonidx_polish(struct lonidx_header *hdr, int32 seg, double target, double *tjd, char *serr)
+{
+  double x[6], v, dt, t = *tjd;
+  int k;
+  target = swe_degnorm(target);
+  for (k = 0; k < 4; k++) {
+    if (swe_calc_ut(t, hdr->ipl, hdr->iflag, x, serr) == ERR)
+      return ERR;
+    lonidx_eval(hdr, seg, t, &v);
+    if (v == 0)
+      break;
+    dt = -swe_difdeg2n(x[0], target) / v;
+    if (fabs(dt) > hdr->seglen)
+      break;
+    t += dt;
+    *tjd = t;
+    if (fabs(dt) < 1e-9)
+      break;
+  }
+  return OK;
+}
+
+/* Crossings of x2cross in [tjd1, tjd2): binary search for the pieces
+ * of each run where the continuous longitude reaches x2cross + n * 360,
+ * inversion of the polynomial and refinement with the ephemeris.
+ */
+static int32 lonidx_crossings(struct lonidx_header *hdr, double x2cross, double tjd1, double tjd2, double *tret, int32 *dir, int32 nmax, char *serr)
+{
+  struct lonidx_piece *pc = lonidx_pieces(hdr);
+  int32 np = hdr->npiece, n = 0, i, e, j, lo, hi, mid, d;
+  double la, lb, m, target, t;
+  lo = 0; hi = np;
+  while (lo < hi) {
+    mid = lo + (hi - lo) / 2;
+    if (pc[mid].t1 <= tjd1)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  for (i = lo; i < np && pc[i].t0 < tjd2; i = e + 1) {
+    /* the run, up to the last piece starting before tjd2 */
+    lo = i; hi = pc[i].run_end + 1;
+    while (lo < hi) {
+      mid = lo + (hi - lo) / 2;
+      if (pc[mid].t0 < tjd2)
+	lo = mid + 1;
+      else
+	hi = mid;
+    }
+    e = lo - 1;
+    d = pc[i].l1 > pc[i].l0 ? 1 : -1;
+    la = tjd1 > pc[i].t0 ? lonidx_eval(hdr, pc[i].seg, tjd1, NULL) : pc[i].l0;
+    lb = tjd2 < pc[e].t1 ? lonidx_eval(hdr, pc[e].seg, tjd2, NULL) : pc[e].l1;
+    /* x2cross + m * 360 from la (inclusive) to lb (exclusive) */
+    m = d > 0 ? ceil((la - x2cross) / 360) : floor((la - x2cross) / 360);
+    for (;; m += d) {
+      target = x2cross + m * 360;
+      if (d > 0 ? target >= lb : target <= lb)
+	break;
+      /* first piece of the run reaching the target */
+      lo = i; hi = e;
+      while (lo < hi) {
+	mid = lo + (hi - lo) / 2;
+	if (d > 0 ? pc[mid].l1 < target : pc[mid].l1 > target)
+	  lo = mid + 1;
+	else
+	  hi = mid;
+      }
+      j = lo;
+      t = lonidx_invert(hdr, &pc[j], target);
+      if (lonidx_polish(hdr, pc[j].seg, target, &t, serr) == ERR)
+	return ERR;
+      if (t < tjd1 || t >= tjd2)
+	continue;
+      if (n < nmax) {
+	if (tret != NULL)
+	  tret[n] = t;
+	if (dir != NULL)
+	  dir[n] = d;
+      }
+      n++;
+    }
+  }
+  return n;
+}
+
+/* Build a longitude index of body ipl for tjd_start to tjd_end (UT)
+ * with the calculation flags iflag (ecliptic longitudes; tropical or,
+ * with SEFLG_SIDEREAL, in the current sidereal mode). Topocentric
+ * longitudes cannot be indexed.
+ */
+int32 CALL_CONV swe_lon_index_build(const char *path, int32 ipl, double tjd_start, double tjd_end, int32 iflag, char *serr)
+{
+  struct lonidx_header *hdr;
+  int32 retc;
+  if (serr != NULL)
+    *serr = '\0';
+  if (lonidx_check_flags(iflag, serr) == ERR)
+    return ERR;
+  if ((hdr = lonidx_make(ipl, tjd_start, tjd_end, lonidx_iflag(iflag), serr)) == NULL)
+    return ERR;
+  retc = idx_write(path, "longitude", hdr, sizeof(struct lonidx_header)
+		   + (size_t) hdr->nseg * sizeof(struct lonidx_seg)
+		   + (size_t) hdr->npiece * sizeof(struct lonidx_piece), NULL, 0, NULL, 0, serr);
+  free(hdr);
+  return retc;
+}
+
+/* Open a longitude index for all threads of the process, in addition to
+ * those already open; an index of the same body and flags is replaced.
+ * path == NULL closes all of them, as does swe_close(). Replaced and
+ * closed indexes are unmapped when no other thread is reading them.
+ */
+int32 CALL_CONV swe_lon_index_open(const char *path, char *serr)
+{
+  struct lonidx_header *hdr, *old;
+  struct idx_file *f;
+  size_t size;
+  int i, slot = -1;
+  if (serr != NULL)
+    *serr = '\0';
+  if (path == NULL || *path == '\0') {
+    for (i = 0; i < LONIDX_MAX; i++)
+      idx_replace(&lonidx_tab[i], NULL, 0, "longitude", serr);
+    return OK;
+  }
+  if ((hdr = (struct lonidx_header *) idx_map(path, "longitude", sizeof(struct lonidx_header), &size, serr)) == NULL)
+    return ERR;
+  if (hdr->magic != LONIDX_MAGIC || hdr->byte_order != IDX_BYTE_ORDER
+      || hdr->layout != LONIDX_LAYOUT_VERSION || hdr->rec_size != sizeof(struct lonidx_piece)
+      || strncmp(hdr->version, SE_VERSION, sizeof(hdr->version)) != 0
+      || hdr->nseg <= 0 || hdr->npiece < 0
+      || sizeof(struct lonidx_header) + (size_t) hdr->nseg * sizeof(struct lonidx_seg)
+         + (size_t) hdr->npiece * sizeof(struct lonidx_piece) > size) {
+    if (serr != NULL)
+      sprintf(serr, "longitude index %.80s is incompatible with this version", path);
+    idx_unmap(hdr, size);
+    return ERR;
+  }
+  for (i = 0; i < LONIDX_MAX; i++) {
+    if ((f = idx_acquire(&lonidx_tab[i])) == NULL) {
+      if (slot < 0)
+	slot = i;
+      continue;
+    }
+    old = (struct lonidx_header *) f->hdr;
+    if (old->ipl == hdr->ipl && old->iflag == hdr->iflag) {
+      idx_release(f);
+      slot = i;
+      break;
+    }
+    idx_release(f);
+  }
+  if (slot < 0) {
+    if (serr != NULL)
+      sprintf(serr, "more than %d longitude indexes open", LONIDX_MAX);
+    idx_unmap(hdr, size);
+    return ERR;
+  }
+  return idx_replace(&lonidx_tab[slot], hdr, size, "longitude", serr);
+}
+
+/* All times in [tjd1, tjd2) (UT) when body ipl reaches the ecliptic
+ * longitude x2cross, direct or retrograde, for the calculation flags
+ * iflag. The first nmax of them are written to tret[], with 1 (direct)
+ * or -1 (retrograde) in dir[] (either may be NULL). Returns their total
+ * number or ERR. An open longitude index of the body that covers the
+ * range is used; otherwise the longitudes of the range are fitted for
+ * this call. A crossing within about 0.0001 degrees of a stationary
+ * longitude may be missed or found twice. As with swe_lon_index_build(),
+ * SEFLG_TOPOCTR, SEFLG_EQUATORIAL, SEFLG_XYZ and SEFLG_RADIANS are
+ * rejected.
+ */
+int32 CALL_CONV swe_lon_crossings_ut(int32 ipl, double x2cross, double tjd1, double tjd2, int32 iflag, double *tret, int32 *dir, int32 nmax, char *serr)
+{
+  struct lonidx_header *hdr;
+  struct idx_file *f;
+  int32 n;
+  int i;
+  if (serr != NULL)
+    *serr = '\0';
+  if (lonidx_check_flags(iflag, serr) == ERR)
+    return ERR;
+  if (tjd2 <= tjd1)
+    return 0;
+  iflag = lonidx_iflag(iflag);
+  x2cross = swe_degnorm(x2cross);
+  for (i = 0; i < LONIDX_MAX; i++) {
+    if ((f = idx_acquire(&lonidx_tab[i])) == NULL)
+      continue;
+    hdr = (struct lonidx_header *) f->hdr;
+    if (lonidx_matches(hdr, ipl, iflag)
+	&& tjd1 >= hdr->tstart && tjd2 <= hdr->tstart + hdr->nseg * hdr->seglen) {
+      n = lonidx_crossings(hdr, x2cross, tjd1, tjd2, tret, dir, nmax, serr);
+      idx_release(f);
+      return n;
+    }
+    idx_release(f);
+  }
+  if ((hdr = lonidx_make(ipl, tjd1, tjd2, iflag, serr)) == NULL)
+    return ERR;
+  n = lonidx_crossings(hdr, x2cross, tjd1, tjd2, tret, dir, nmax, serr);
+  free(hdr);
+  return n;
+}
+
+/* Close the indexes of the process, from swe_close() */
+void swi_idx_close(void)
+{
+  int i;
+  idx_replace(&eclidx_cur, NULL, 0, "eclipse", NULL);
+  idx_replace(&lunidx_cur, NULL, 0, "lunation", NULL);
+  for (i = 0; i < LONIDX_MAX; i++)
+    idx_replace(&lonidx_tab[i], NULL, 0, "longitude", NULL);
+}
@@ -0,0 +1,119 @@
+/* Copyright (C) 1997 - 2021 Astrodienst AG, Switzerland.  All rights reserved.
+
+  License conditions
+  ------------------
+
+  This file is part of Swiss Ephemeris.
+
+  Swiss Ephemeris is distributed with NO WARRANTY OF ANY KIND.  No author
+  or distributor accepts any responsibility for the consequences of using it,
+  or for whether it serves any particular purpose or works at all, unless he
+  or she says so in writing.  
+
+  Swiss Ephemeris is made available by its authors under a dual licensing
+  system. The software developer, who uses any part of Swiss Ephemeris
+  in his or her software, must choose between one of the two license models,
+  which are
+  a) GNU Affero General Public License (AGPL)
+  b) Swiss Ephemeris Professional License
+
+  The choice must be made before the software developer distributes software
+  containing parts of Swiss Ephemeris to others, and before any public
+  service using the developed software is activated.
+
+  If the developer choses the AGPL software license, he or she must fulfill
+  the conditions of that license, which includes the obligation to place his
+  or her whole software project under the AGPL or a compatible license.
+  See https://www.gnu.org/licenses/agpl-3.0.html
+
+  If the developer choses the Swiss Ephemeris Professional license,
+  he must follow the instructions as found in http://www.astro.com/swisseph/ 
+  and purchase the Swiss Ephemeris Professional Edition from Astrodienst
+  and sign the corresponding license contract.
+
+  The License grants you the right to use, copy, modify and redistribute
+  Swiss Ephemeris, but only under certain conditions described in the License.
+  Among other things, the License requires that the copyright notices and
+  this notice be preserved on all copies.
+
+  Authors of the Swiss Ephemeris: Dieter Koch and Alois Treindl
+
+  The authors of Swiss Ephemeris have no control or influence over any of
+  the derived works, i.e. over software or services created by other
+  programmers which use Swiss Ephemeris functions.
+
+  The names of the authors or of the copyright holder (Astrodienst) must not
+  be used for promoting any software, product or service which uses or contains
+  the Swiss Ephemeris. This copyright notice is the ONLY place where the
+  names of the authors can legally appear, except in cases where they have
+  given special permission in writing.
+
+  The trademarks 'Swiss Ephemeris' and 'Swiss Ephemeris inside' may be used
+  for promoting such software, products or services.
+*/
+
+/* Precomputed eclipse index.
+ *
+ * swe_eclipse_index_build() runs the global solar and lunar eclipse
+ * searches over a time span and writes every eclipse found, sorted by the
+ * time of maximum, with its contact times (tret[] of the search) and
+ * attributes (swe_sol_eclipse_where() resp. swe_lun_eclipse_how() at
+ * maximum) into a binary file.
+ *
+ * After swe_eclipse_index_open(), swe_sol_eclipse_when_glob() and
+ * swe_lun_eclipse_when() answer from the index by binary search, with
+ * results identical to the search, if
+ *   - the start date lies within the span of the index,
+ *   - the ephemeris flag and the delta t, tidal acceleration, model and
+ *     nutation settings are those the index was built with,
+ *   - the ephemeris files in use for the middle of the span have the
+ *     name, DE number and file version of those the index was built
+ *     from,
+ *   - a wanted eclipse exists in the index before its end (forward) or
+ *     after its beginning (backward).
+ * Otherwise they search as usual. swe_eclipse_index_find() and
+ * swe_eclipse_index_range() also return the stored attributes.
+ *
+ * The file is written in the byte order of the machine that built it;
+ * a file with another byte order, layout or Swiss Ephemeris version is
+ * rejected by swe_eclipse_index_open().
+ */
+
+#define ECLIDX_LAYOUT_VERSION	2
+
+/* Lunation catalogue.
+ *
+ * swe_lunation_index_build() finds the new moons, quarters and full moons
+ * of every lunation of a time span, optionally also the perigees and
+ * apogees of the Moon, and writes them with the Brown lunation number of
+ * the first lunation into a file of the same kind as the eclipse index.
+ * After swe_lunation_index_open(), swe_lunation_find(),
+ * swe_lunar_phase_range() and swe_lunar_apsides_find() answer by binary
+ * search under the same conditions as the eclipse index, and compute the
+ * phases otherwise.
+ */
+
+#define LUNIDX_LAYOUT_VERSION	2
+
+/* Longitude index.
+ *
+ * swe_lon_index_build() fits the ecliptic longitude of one body over a
+ * time span with Chebyshev series of degree 8 on segments of 2 to 16
+ * days and splits them at the stations into monotonic pieces.
+ * swe_lon_crossings_ut() finds all times a longitude is reached by
+ * binary search over the pieces, inverts the series and refines the
+ * result with two or three ephemeris calculations. The series cannot
+ * be used directly: near conjunctions with the Sun, light deflection
+ * makes the apparent longitude non-smooth at the level of an arc
+ * second. Without an index, the series are fitted for the range of
+ * the query.
+ */
+
+#define LONIDX_LAYOUT_VERSION	2
+
+extern void swi_idx_close(void);
+extern AS_BOOL swi_eclidx_when(int32 kind, double tjd_start, int32 ifl, int32 ifltype, int32 backward, double *tret, int32 *retflag);
+
+/* the searches without index and result cache, in swecl.c */
+extern int32 swi_sol_eclipse_when_glob(double tjd_start, int32 ifl, int32 ifltype, double *tret, int32 backward, char *serr);
+extern int32 swi_lun_eclipse_when(double tjd_start, int32 ifl, int32 ifltype, double *tret, int32 backward, char *serr);
@@ -0,0 +1,659 @@
+/* Copyright (C) 1997 - 2021 Astrodienst AG, Switzerland.  All rights reserved.
+
+  License conditions
+  ------------------
+
+  This file is part of Swiss Ephemeris.
+
+  Swiss Ephemeris is distributed with NO WARRANTY OF ANY KIND.  No author
+  or distributor accepts any responsibility for the consequences of using it,
+  or for whether it serves any particular purpose or works at all, unless he
+  or she says so in writing.  
+
+  Swiss Ephemeris is made available by its authors under a dual licensing
+  system. The software developer, who uses any part of Swiss Ephemeris
+  in his or her software, must choose between one of the two license models,
+  which are
+  a) GNU Affero General Public License (AGPL)
+  b) Swiss Ephemeris Professional License
+
+  The choice must be made before the software developer distributes software
+  containing parts of Swiss Ephemeris to others, and before any public
+  service using the developed software is activated.
+
+  If the developer choses the AGPL software license, he or she must fulfill
+  the conditions of that license, which includes the obligation to place his
+  or her whole software project under the AGPL or a compatible license.
+  See https://www.gnu.org/licenses/agpl-3.0.html
+
+  If the developer choses the Swiss Ephemeris Professional license,
+  he must follow the instructions as found in http://www.astro.com/swisseph/ 
+  and purchase the Swiss Ephemeris Professional Edition from Astrodienst
+  and sign the corresponding license contract.
+
+  The License grants you the right to use, copy, modify and redistribute
+  Swiss Ephemeris, but only under certain conditions described in the License.
+  Among other things, the License requires that the copyright notices and
+  this notice be preserved on all copies.
+
+  Authors of the Swiss Ephemeris: Dieter Koch and Alois Treindl
+
+  The authors of Swiss Ephemeris have no control or influence over any of
+  the derived works, i.e. over software or services created by other
+  programmers which use Swiss Ephemeris functions.
+
+  The names of the authors or of the copyright holder (Astrodienst) must not
+  be used for promoting any software, product or service which uses or contains
+  the Swiss Ephemeris. This copyright notice is the ONLY place where the
+  names of the authors can legally appear, except in cases where they have
+  given special permission in writing.
+
+  The trademarks 'Swiss Ephemeris' and 'Swiss Ephemeris inside' may be used
+  for promoting such software, products or services.
+*/
+
+/* Persistent result cache, see swememo.h */
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "swephexp.h"
+#include "sweph.h"
+#include "swephlib.h"
+#include "swememo.h"
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__) && !defined(NO_RESULT_CACHE)
+# define MEMO_SUPPORTED
+# include <dirent.h>
+# include <errno.h>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <time.h>
+# include <unistd.h>
+#endif
+
+#define SEFLG_EPHMASK	(SEFLG_JPLEPH|SEFLG_SWIEPH|SEFLG_MOSEPH)
+#define MEMO_MAGIC		0x434d4553	/* "SEMC" */
+#define MEMO_STATE_READY	1
+#define MEMO_REC_DONE		1
+#define MEMO_PROBES		32	/* index slots tried per lookup */
+#define MEMO_PAGE		4096
+#define MEMO_ATTACH_WAIT_MS	2000	/* how long to wait for the creator */
+
+typedef unsigned long long memo_u64;
+
+struct memo_header {
+  uint32 magic;
+  uint32 state;
+  uint32 layout;
+  uint32 rec_size;
+  memo_u64 total_size;
+  memo_u64 index_offset;
+  memo_u64 rec_offset;
+  uint32 nslots;
+  uint32 capacity;	/* number of records that fit */
+  uint32 nrecs;		/* records appended so far */
+  uint32 unused;
+};
+
+struct memo_slot {
+  memo_u64 key;		/* 0: empty */
+  uint32 irec;		/* record number + 1, 0 while being written */
+  uint32 unused;
+};
+
+struct memo_rec {
+  uint32 state;
+  int32 func;
+  memo_u64 key, check;
+  memo_u64 sum;		/* hash of the payload below */
+  int32 retval;
+  int32 nout;
+  double out[MEMO_NOUT];
+  char str[MEMO_STRLEN];
+};
+
+/* An open cache file. The cache itself holds one reference and every
+ * lookup in progress (from swi_memo_begin() to a hit in swi_memo_get()
+ * or to swi_memo_put()) another; whoever drops the last one unmaps the
+ * file. The structs are small and never freed, so that a thread that
+ * loaded an old pointer can still look at it. */
+struct memo_map {
+  struct memo_header *hdr;
+  size_t size;
+  int32 users;
+  int32 unmapped;
+};
+
+/* The open cache and mode are process-wide; all threads share them. */
+static struct memo_map *memo_cur = NULL;
+static int32 memo_mode = 0;
+/* hits, misses, stores, verify mismatches, not stored (full); updated
+ * atomically by all threads */
+static int32 memo_stats[5];
+
+/* identity of the ephemeris files, per thread because swed is */
+static TLS memo_u64 memo_ephe_key;
+static TLS char memo_ephe_path[AS_MAXCH];
+static TLS char memo_ephe_jpl[AS_MAXCH];
+
+#ifdef MEMO_SUPPORTED
+# define MEMO_LOAD(p)		__atomic_load_n((p), __ATOMIC_ACQUIRE)
+# define MEMO_STORE(p, v)	__atomic_store_n((p), (v), __ATOMIC_RELEASE)
+# define MEMO_CAS(p, e, d)	__atomic_compare_exchange_n((p), &(e), (d), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+# define MEMO_FETCH_ADD(p, v)	__atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+# define MEMO_COUNT(i)		__atomic_fetch_add(&memo_stats[i], 1, __ATOMIC_RELAXED)
+#endif
+
+#ifdef MEMO_SUPPORTED
+static void memo_release(struct memo_map *map)
+{
+  int32 unmapped = 0;
+  if (__atomic_fetch_sub(&map->users, 1, __ATOMIC_ACQ_REL) == 1
+      && MEMO_CAS(&map->unmapped, unmapped, 1))
+    munmap(map->hdr, map->size);
+}
+#endif
+
+/* Take a reference to the open cache; NULL if none is open */
+static struct memo_map *memo_acquire(void)
+{
+#ifdef MEMO_SUPPORTED
+  struct memo_map *map;
+  for (;;) {
+    if ((map = MEMO_LOAD(&memo_cur)) == NULL)
+      return NULL;
+    __atomic_fetch_add(&map->users, 1, __ATOMIC_ACQ_REL);
+    /* still open: the reference of the cache keeps it mapped */
+    if (MEMO_LOAD(&memo_cur) == map)
+      return map;
+    memo_release(map);
+  }
+#else
+  return NULL;
+#endif
+}
+
+/* FNV-1a */
+static memo_u64 memo_hash(memo_u64 h, const void *data, size_t len)
+{
+  const unsigned char *p = (const unsigned char *) data;
+  size_t i;
+  for (i = 0; i < len; i++) {
+    h ^= p[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+#define MEMO_HASH_INIT	14695981039346656037ULL
+#define MEMO_HASH_INIT2	0x9e3779b97f4a7c15ULL
+
+#ifdef MEMO_SUPPORTED
+static AS_BOOL memo_is_ephe_file(const char *fname)
+{
+  size_t len = strlen(fname);
+  if (len < 4)
+    return FALSE;
+  fname += len - 4;
+  return strcmp(fname, ".se1") == 0 || strcmp(fname, ".eph") == 0
+    || strcmp(fname, ".txt") == 0;
+}
+
+/* Name, size and modification time of the ephemeris files (*.se1, JPL
+ * *.eph, sefstars.txt, swe_deltat.txt, ...) in all directories of the
+ * ephemeris path. Directory order does not matter.
+ */
+static memo_u64 memo_dir_key(void)
+{
+  char path[AS_MAXCH], fname[AS_MAXCH * 2];
+  char *dir, *next;
+  DIR *dp;
+  struct dirent *de;
+  struct stat st;
+  memo_u64 key = 0, h;
+  strcpy(path, swed.ephepath);
+  for (dir = path; dir != NULL; dir = next) {
+    next = strpbrk(dir, PATH_SEPARATOR);
+    if (next != NULL)
+      *next++ = '\0';
+    if (*dir == '\0' || (dp = opendir(dir)) == NULL)
+      continue;
+    while ((de = readdir(dp)) != NULL) {
+      if (!memo_is_ephe_file(de->d_name))
+	continue;
+      snprintf(fname, sizeof(fname), "%s%s%s", dir, DIR_GLUE, de->d_name);
+      if (stat(fname, &st) != 0)
+	continue;
+      h = memo_hash(MEMO_HASH_INIT, fname, strlen(fname));
+      h = memo_hash(h, &st.st_size, sizeof(st.st_size));
+      h = memo_hash(h, &st.st_mtime, sizeof(st.st_mtime));
+      key += h;
+    }
+    closedir(dp);
+  }
+  /* a JPL file given with its directory */
+  if (strpbrk(swed.jplfnam, DIR_GLUE) != NULL && stat(swed.jplfnam, &st) == 0) {
+    key = memo_hash(key, &st.st_size, sizeof(st.st_size));
+    key = memo_hash(key, &st.st_mtime, sizeof(st.st_mtime));
+  }
+  return key;
+}
+#endif
+
+/* The directory is scanned once per thread and ephemeris path. */
+static memo_u64 memo_get_ephe_key(void)
+{
+#ifdef MEMO_SUPPORTED
+  memo_u64 h;
+  if (memo_ephe_key != 0 && strcmp(memo_ephe_path, swed.ephepath) == 0
+      && strcmp(memo_ephe_jpl, swed.jplfnam) == 0)
+    return memo_ephe_key;
+  h = memo_hash(MEMO_HASH_INIT, SE_VERSION, strlen(SE_VERSION));
+  h = memo_hash(h, swed.ephepath, strlen(swed.ephepath) + 1);
+  h = memo_hash(h, swed.jplfnam, strlen(swed.jplfnam) + 1);
+  h ^= memo_dir_key();
+  if (h == 0)
+    h = 1;
+  strcpy(memo_ephe_path, swed.ephepath);
+  strcpy(memo_ephe_jpl, swed.jplfnam);
+  memo_ephe_key = h;
+#endif
+  return memo_ephe_key;
+}
+
+void swi_memo_add(struct swi_memo *m, const void *data, size_t len)
+{
+  m->h1 = memo_hash(m->h1, data, len);
+  m->h2 = memo_hash(m->h2, data, len);
+}
+
+/* NULL and "" are the same key */
+void swi_memo_add_str(struct swi_memo *m, const char *s)
+{
+  if (s == NULL)
+    s = "";
+  swi_memo_add(m, s, strlen(s) + 1);
+}
+
+/* Start a lookup for function func. Returns FALSE if no cache is open;
+ * the caller then computes as usual. Otherwise the caller adds its
+ * inputs with swi_memo_add() and computes with m->serr, which is never
+ * NULL and starts empty.
+ */
+AS_BOOL swi_memo_begin(struct swi_memo *m, int32 func, int32 iflag, char *serr)
+{
+  memo_u64 ekey;
+  int32 epheflag = iflag & SEFLG_EPHMASK;
+  /* the first call of a thread must initialise swed (and warn) itself */
+  if (!swed.swed_is_initialised || (m->map = memo_acquire()) == NULL)
+    return FALSE;
+  m->func = func;
+  m->h1 = MEMO_HASH_INIT;
+  m->h2 = MEMO_HASH_INIT2;
+  m->have_old = FALSE;
+  m->serr = serr != NULL ? serr : m->sbuf;
+  *m->serr = '\0';
+  swi_memo_add(m, &func, sizeof(func));
+  swi_memo_add(m, &iflag, sizeof(iflag));
+  /* a new library version may compute different results, also with Moshier */
+  swi_memo_add_str(m, SE_VERSION);
+  /* Moshier results do not depend on the files */
+  ekey = (epheflag == SEFLG_MOSEPH) ? 0 : memo_get_ephe_key();
+  swi_memo_add(m, &ekey, sizeof(ekey));
+  swi_memo_add(m, swed.astro_models, sizeof(swed.astro_models));
+  swi_memo_add(m, &swed.do_interpolate_nut, sizeof(swed.do_interpolate_nut));
+  swi_memo_add(m, &swed.delta_t_userdef_is_set, sizeof(swed.delta_t_userdef_is_set));
+  if (swed.delta_t_userdef_is_set)
+    swi_memo_add(m, &swed.delta_t_userdef, sizeof(swed.delta_t_userdef));
+  swi_memo_add(m, &swed.is_tid_acc_manual, sizeof(swed.is_tid_acc_manual));
+  if (swed.is_tid_acc_manual)
+    swi_memo_add(m, &swed.tid_acc, sizeof(swed.tid_acc));
+  if (iflag & SEFLG_TOPOCTR) {
+    swi_memo_add(m, &swed.topd.geolon, sizeof(double));
+    swi_memo_add(m, &swed.topd.geolat, sizeof(double));
+    swi_memo_add(m, &swed.topd.geoalt, sizeof(double));
+  }
+  if (iflag & SEFLG_SIDEREAL) {
+    swi_memo_add(m, &swed.sidd.sid_mode, sizeof(swed.sidd.sid_mode));
+    swi_memo_add(m, &swed.sidd.ayan_t0, sizeof(swed.sidd.ayan_t0));
+    swi_memo_add(m, &swed.sidd.t0, sizeof(swed.sidd.t0));
+    swi_memo_add(m, &swed.sidd.t0_is_UT, sizeof(swed.sidd.t0_is_UT));
+  }
+  return TRUE;
+}
+
+#ifdef MEMO_SUPPORTED
+static struct memo_slot *memo_slots(struct memo_header *hdr)
+{
+  return (struct memo_slot *) ((char *) hdr + hdr->index_offset);
+}
+
+static struct memo_rec *memo_recs(struct memo_header *hdr)
+{
+  return (struct memo_rec *) ((char *) hdr + hdr->rec_offset);
+}
+
+static memo_u64 memo_key(struct swi_memo *m)
+{
+  return m->h1 != 0 ? m->h1 : 1;
+}
+
+static memo_u64 memo_rec_sum(const struct memo_rec *rec)
+{
+  memo_u64 h = memo_hash(MEMO_HASH_INIT, &rec->retval, sizeof(rec->retval));
+  h = memo_hash(h, &rec->nout, sizeof(rec->nout));
+  h = memo_hash(h, rec->out, (size_t) rec->nout * sizeof(double));
+  return memo_hash(h, rec->str, sizeof(rec->str));
+}
+
+static struct memo_rec *memo_find(struct memo_header *hdr, struct swi_memo *m)
+{
+  struct memo_slot *slot;
+  struct memo_rec *rec;
+  memo_u64 key = memo_key(m), k;
+  uint32 idx = (uint32) (key % hdr->nslots), irec;
+  int i;
+  for (i = 0; i < MEMO_PROBES; i++) {
+    slot = memo_slots(hdr) + (idx + i) % hdr->nslots;
+    k = MEMO_LOAD(&slot->key);
+    if (k == 0)
+      return NULL;
+    if (k != key)
+      continue;
+    irec = MEMO_LOAD(&slot->irec);
+    if (irec == 0 || irec > hdr->capacity)
+      return NULL;
+    rec = memo_recs(hdr) + (irec - 1);
+    if (MEMO_LOAD(&rec->state) != MEMO_REC_DONE || rec->key != key
+	|| rec->check != m->h2 || rec->func != m->func
+	|| rec->nout < 0 || rec->nout > MEMO_NOUT
+	|| rec->sum != memo_rec_sum(rec))
+      return NULL;
+    return rec;
+  }
+  return NULL;
+}
+
+/* point the index entry of key at record irec (0-based) */
+static void memo_index(struct memo_header *hdr, memo_u64 key, uint32 irec)
+{
+  struct memo_slot *slot;
+  memo_u64 k;
+  uint32 idx = (uint32) (key % hdr->nslots);
+  int i;
+  for (i = 0; i < MEMO_PROBES; i++) {
+    slot = memo_slots(hdr) + (idx + i) % hdr->nslots;
+    k = 0;
+    if (MEMO_CAS(&slot->key, k, key) || k == key) {
+      MEMO_STORE(&slot->irec, irec + 1);
+      return;
+    }
+  }
+  MEMO_COUNT(4);	/* index crowded around idx */
+}
+#endif
+
+/* Copy a stored result into retval, out[nout] and, if str != NULL, str.
+ * Returns TRUE on a hit. On a miss the outputs are cleared, so that in
+ * verify mode untouched elements compare equal.
+ */
+AS_BOOL swi_memo_get(struct swi_memo *m, int32 *retval, double *out, int nout, char *str)
+{
+#ifdef MEMO_SUPPORTED
+  struct memo_map *map = (struct memo_map *) m->map;
+  struct memo_rec *rec;
+  if ((rec = memo_find(map->hdr, m)) != NULL && rec->nout == nout) {
+    if (memo_mode & SE_RESCACHE_VERIFY) {
+      m->have_old = TRUE;
+      m->old_ret = rec->retval;
+      memcpy(m->old_out, rec->out, (size_t) nout * sizeof(double));
+      memcpy(m->old_str, rec->str, MEMO_STRLEN);
+    } else {
+      *retval = rec->retval;
+      memcpy(out, rec->out, (size_t) nout * sizeof(double));
+      if (str != NULL)
+	strcpy(str, rec->str);
+      MEMO_COUNT(0);
+      memo_release(map);
+      return TRUE;
+    }
+  }
+#endif
+  memset(out, 0, (size_t) nout * sizeof(double));
+  return FALSE;
+}
+
+/* Store a computed result. Errors, results with a message in serr and
+ * star names that do not fit are not stored.
+ */
+void swi_memo_put(struct swi_memo *m, int32 retval, const double *out, int nout, const char *str)
+{
+#ifdef MEMO_SUPPORTED
+  struct memo_map *map = (struct memo_map *) m->map;
+  struct memo_header *hdr = map->hdr;
+  struct memo_rec *rec;
+  memo_u64 key = memo_key(m);
+  uint32 irec;
+  if (str == NULL)
+    str = "";
+  if (m->have_old) {
+    if (m->old_ret == retval && strcmp(m->old_str, str) == 0
+	&& memcmp(m->old_out, out, (size_t) nout * sizeof(double)) == 0) {
+      MEMO_COUNT(0);
+      memo_release(map);
+      return;
+    }
+    MEMO_COUNT(3);
+  } else {
+    MEMO_COUNT(1);
+  }
+  if (retval < 0 || *m->serr != '\0'
+      || nout > MEMO_NOUT || strlen(str) >= MEMO_STRLEN) {
+    memo_release(map);
+    return;
+  }
+  irec = MEMO_FETCH_ADD(&hdr->nrecs, 1);
+  if (irec >= hdr->capacity) {
+    MEMO_COUNT(4);
+    memo_release(map);
+    return;
+  }
+  rec = memo_recs(hdr) + irec;
+  rec->func = m->func;
+  rec->key = key;
+  rec->check = m->h2;
+  rec->retval = retval;
+  rec->nout = nout;
+  memcpy(rec->out, out, (size_t) nout * sizeof(double));
+  memset(rec->str, 0, MEMO_STRLEN);
+  strcpy(rec->str, str);
+  rec->sum = memo_rec_sum(rec);
+  MEMO_STORE(&rec->state, MEMO_REC_DONE);
+  memo_index(hdr, key, irec);
+  MEMO_COUNT(2);
+  memo_release(map);
+#endif
+}
+
+#ifdef MEMO_SUPPORTED
+static void memo_sleep_ms(int ms)
+{
+  struct timespec ts;
+  ts.tv_sec = 0;
+  ts.tv_nsec = (long) ms * 1000000L;
+  nanosleep(&ts, NULL);
+}
+
+/* Lay out and initialise a newly created file */
+static void memo_format(struct memo_header *hdr, size_t total)
+{
+  size_t index_offset, rec_offset, nrecs;
+  index_offset = MEMO_PAGE;
+  /* two index slots per record */
+  nrecs = (total - index_offset) / (sizeof(struct memo_rec) + 2 * sizeof(struct memo_slot));
+  rec_offset = (index_offset + 2 * nrecs * sizeof(struct memo_slot) + MEMO_PAGE - 1) / MEMO_PAGE * MEMO_PAGE;
+  /* ftruncate() filled everything with zeros: index and records are empty */
+  hdr->layout = MEMO_LAYOUT_VERSION;
+  hdr->rec_size = sizeof(struct memo_rec);
+  hdr->total_size = total;
+  hdr->index_offset = index_offset;
+  hdr->rec_offset = rec_offset;
+  hdr->nslots = (uint32) (2 * nrecs);
+  hdr->capacity = (uint32) ((total - rec_offset) / sizeof(struct memo_rec));
+  hdr->magic = MEMO_MAGIC;
+  MEMO_STORE(&hdr->state, MEMO_STATE_READY);
+}
+
+static int memo_compatible(struct memo_header *hdr, size_t total, const char *path, char *serr)
+{
+  if (hdr->magic != MEMO_MAGIC || hdr->layout != MEMO_LAYOUT_VERSION
+      || hdr->rec_size != sizeof(struct memo_rec) || hdr->total_size != total) {
+    if (serr != NULL)
+      sprintf(serr, "result cache %.80s has an incompatible layout, delete it", path);
+    return ERR;
+  }
+  return OK;
+}
+#endif
+
+/* Open the result cache file `path`, creating it with size_mb megabytes
+ * if it does not exist yet; an existing file keeps its size. mode is
+ * SE_RESCACHE_USE or SE_RESCACHE_USE | SE_RESCACHE_VERIFY.
+ * path == NULL or mode == 0 closes the cache.
+ * All threads of the process use the same cache; other processes may
+ * open the same file at the same time.
+ */
+int32 CALL_CONV swe_set_result_cache(const char *path, int32 size_mb, int32 mode, char *serr)
+{
+#ifdef MEMO_SUPPORTED
+  int fd, waited, i;
+  AS_BOOL created = FALSE;
+  size_t total;
+  struct stat st;
+  struct memo_header *hdr;
+  struct memo_map *map;
+  if (serr != NULL)
+    *serr = '\0';
+  /* Close the open file; threads in the middle of a lookup keep it
+   * mapped until they are done. */
+  if ((map = __atomic_exchange_n(&memo_cur, NULL, __ATOMIC_ACQ_REL)) != NULL)
+    memo_release(map);
+  if (path == NULL || *path == '\0' || mode == 0)
+    return OK;
+  if (size_mb <= 0)
+    size_mb = MEMO_DEFAULT_SIZE_MB;
+  if (size_mb < MEMO_MIN_SIZE_MB)
+    size_mb = MEMO_MIN_SIZE_MB;
+  total = (size_t) size_mb * 1024 * 1024;
+  fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd >= 0) {
+    created = TRUE;
+    if (ftruncate(fd, (off_t) total) != 0) {
+      if (serr != NULL)
+	sprintf(serr, "could not size result cache %.80s: %.80s", path, strerror(errno));
+      close(fd);
+      unlink(path);
+      return ERR;
+    }
+  } else if (errno == EEXIST) {
+    fd = open(path, O_RDWR);
+  }
+  if (fd < 0) {
+    if (serr != NULL)
+      sprintf(serr, "could not open result cache %.80s: %.80s", path, strerror(errno));
+    return ERR;
+  }
+  /* wait until the creator has sized the file */
+  for (waited = 0; !created; waited++) {
+    if (fstat(fd, &st) == 0 && (size_t) st.st_size >= MEMO_PAGE) {
+      total = (size_t) st.st_size;
+      break;
+    }
+    if (waited >= MEMO_ATTACH_WAIT_MS) {
+      if (serr != NULL)
+	sprintf(serr, "result cache %.80s was not initialised in time", path);
+      close(fd);
+      return ERR;
+    }
+    memo_sleep_ms(1);
+  }
+  hdr = (struct memo_header *) mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (hdr == (struct memo_header *) MAP_FAILED) {
+    if (serr != NULL)
+      sprintf(serr, "could not map result cache %.80s: %.80s", path, strerror(errno));
+    return ERR;
+  }
+  if (created) {
+    memo_format(hdr, total);
+  } else {
+    for (waited = 0; MEMO_LOAD(&hdr->state) != MEMO_STATE_READY; waited++) {
+      if (waited >= MEMO_ATTACH_WAIT_MS) {
+	if (serr != NULL)
+	  sprintf(serr, "result cache %.80s was not initialised in time", path);
+	munmap(hdr, total);
+	return ERR;
+      }
+      memo_sleep_ms(1);
+    }
+    if (memo_compatible(hdr, total, path, serr) != OK) {
+      munmap(hdr, total);
+      return ERR;
+    }
+  }
+  if ((map = (struct memo_map *) calloc(1, sizeof(struct memo_map))) == NULL) {
+    if (serr != NULL)
+      strcpy(serr, "result cache: out of memory");
+    munmap(hdr, total);
+    return ERR;
+  }
+  map->hdr = hdr;
+  map->size = total;
+  map->users = 1;
+  memo_mode = mode;
+  for (i = 0; i < 5; i++)
+    __atomic_store_n(&memo_stats[i], 0, __ATOMIC_RELAXED);
+  MEMO_STORE(&memo_cur, map);
+  return OK;
+#else
+  if (serr != NULL)
+    strcpy(serr, "result cache is not supported on this platform");
+  if (path == NULL || *path == '\0' || mode == 0)
+    return OK;
+  return ERR;
+#endif
+}
+
+/* Statistics of this process since swe_set_result_cache():
+ * stats[0]  results taken from the cache (in verify mode: confirmed)
+ * stats[1]  misses
+ * stats[2]  results stored
+ * stats[3]  verify mode: stored results that differed from the new ones
+ * stats[4]  results not stored because the file is full
+ * stats[5]  records in the file
+ * stats[6]  record capacity of the file
+ * Returns ERR if no cache is open.
+ */
+int32 CALL_CONV swe_get_result_cache_stats(int32 *stats)
+{
+#ifdef MEMO_SUPPORTED
+  struct memo_map *map;
+  int i;
+  for (i = 0; i < 5; i++)
+    stats[i] = __atomic_load_n(&memo_stats[i], __ATOMIC_RELAXED);
+  stats[5] = stats[6] = 0;
+  if ((map = memo_acquire()) == NULL)
+    return ERR;
+  stats[6] = (int32) map->hdr->capacity;
+  stats[5] = (int32) MEMO_LOAD(&map->hdr->nrecs);
+  if (stats[5] > stats[6])
+    stats[5] = stats[6];
+  memo_release(map);
+  return OK;
+#else
+  memset(stats, 0, 7 * sizeof(int32));
+  return ERR;
+#endif
+}
@@ -0,0 +1,118 @@
+/* Copyright (C) 1997 - 2021 Astrodienst AG, Switzerland.  All rights reserved.
+
+  License conditions
+  ------------------
+
+  This file is part of Swiss Ephemeris.
+
+  Swiss Ephemeris is distributed with NO WARRANTY OF ANY KIND.  No author
+  or distributor accepts any responsibility for the consequences of using it,
+  or for whether it serves any particular purpose or works at all, unless he
+  or she says so in writing.  
+
+  Swiss Ephemeris is made available by its authors under a dual licensing
+  system. The software developer, who uses any part of Swiss Ephemeris
+  in his or her software, must choose between one of the two license models,
+  which are
+  a) GNU Affero General Public License (AGPL)
+  b) Swiss Ephemeris Professional License
+
+  The choice must be made before the software developer distributes software
+  containing parts of Swiss Ephemeris to others, and before any public
+  service using the developed software is activated.
+
+  If the developer choses the AGPL software license, he or she must fulfill
+  the conditions of that license, which includes the obligation to place his
+  or her whole software project under the AGPL or a compatible license.
+  See https://www.gnu.org/licenses/agpl-3.0.html
+
+  If the developer choses the Swiss Ephemeris Professional license,
+  he must follow the instructions as found in http://www.astro.com/swisseph/ 
+  and purchase the Swiss Ephemeris Professional Edition from Astrodienst
+  and sign the corresponding license contract.
+
+  The License grants you the right to use, copy, modify and redistribute
+  Swiss Ephemeris, but only under certain conditions described in the License.
+  Among other things, the License requires that the copyright notices and
+  this notice be preserved on all copies.
+
+  Authors of the Swiss Ephemeris: Dieter Koch and Alois Treindl
+
+  The authors of Swiss Ephemeris have no control or influence over any of
+  the derived works, i.e. over software or services created by other
+  programmers which use Swiss Ephemeris functions.
+
+  The names of the authors or of the copyright holder (Astrodienst) must not
+  be used for promoting any software, product or service which uses or contains
+  the Swiss Ephemeris. This copyright notice is the ONLY place where the
+  names of the authors can legally appear, except in cases where they have
+  given special permission in writing.
+
+  The trademarks 'Swiss Ephemeris' and 'Swiss Ephemeris inside' may be used
+  for promoting such software, products or services.
+*/
+
+/* Persistent result cache for expensive searches (POSIX file + mmap).
+ *
+ * swe_set_result_cache() opens (or creates) a cache file that is shared by
+ * all threads and processes using the same path and survives restarts.
+ * The eclipse, occultation, heliacal and Gauquelin functions hash their
+ * inputs together with
+ *   - the function and its flags,
+ *   - the Swiss Ephemeris version,
+ *   - the ephemeris path, the JPL file name and the name, size and
+ *     modification time of the ephemeris files found in the path,
+ *   - delta t, tidal acceleration and model settings, and topocentric
+ *     and sidereal settings where the flags use them,
+ * and look the key up in the file before searching. Results are stored
+ * only if the function succeeded without a message in serr.
+ *
+ * File layout: a header, an open-addressing index of record numbers and
+ * an append-only array of fixed-size records. A record is published with
+ * a release store of its state after its payload and checksum have been
+ * written; the index slot is filled afterwards. Records are never changed
+ * or removed. When the file is full, new results are simply not stored;
+ * delete the file to start over.
+ *
+ * Closing or reopening the cache unmaps the previous file as soon as
+ * the lookups in progress in other threads are done.
+ *
+ * In verify mode (SE_RESCACHE_VERIFY) every hit is recomputed and
+ * compared with the stored result; differing results are counted and
+ * replace the stored ones.
+ */
+
+#define MEMO_LAYOUT_VERSION	1
+#define MEMO_MIN_SIZE_MB	1
+#define MEMO_DEFAULT_SIZE_MB	64
+#define MEMO_NOUT		30	/* doubles per result */
+#define MEMO_STRLEN		64	/* returned star name */
+
+/* functions using the cache */
+#define SEI_MEMO_SOL_ECLIPSE_GLOB	1
+#define SEI_MEMO_SOL_ECLIPSE_LOC	2
+#define SEI_MEMO_LUN_ECLIPSE		3
+#define SEI_MEMO_LUN_ECLIPSE_LOC	4
+#define SEI_MEMO_LUN_OCCULT_GLOB	5
+#define SEI_MEMO_LUN_OCCULT_LOC		6
+#define SEI_MEMO_HELIACAL		7
+#define SEI_MEMO_GAUQUELIN		8
+
+/* one lookup, from swi_memo_begin() to swi_memo_put() */
+struct swi_memo {
+  unsigned long long h1, h2;	/* two independent hashes of the key */
+  void *map;			/* the open cache, held until get (hit) or put */
+  int32 func;
+  char *serr;			/* caller's serr or sbuf */
+  char sbuf[AS_MAXCH];
+  AS_BOOL have_old;		/* verify mode: stored result to compare */
+  int32 old_ret;
+  double old_out[MEMO_NOUT];
+  char old_str[MEMO_STRLEN];
+};
+
+extern AS_BOOL swi_memo_begin(struct swi_memo *m, int32 func, int32 iflag, char *serr);
+extern void swi_memo_add(struct swi_memo *m, const void *data, size_t len);
+extern void swi_memo_add_str(struct swi_memo *m, const char *s);
+extern AS_BOOL swi_memo_get(struct swi_memo *m, int32 *retval, double *out, int nout, char *str);
+extern void swi_memo_put(struct swi_memo *m, int32 retval, const double *out, int nout, const char *str);
@@ -0,0 +1,311 @@
+/* Copyright (C) 1997 - 2021 Astrodienst AG, Switzerland.  All rights reserved.
+
+  License conditions
+  ------------------
+
+  This file is part of Swiss Ephemeris.
+
+  Swiss Ephemeris is distributed with NO WARRANTY OF ANY KIND.  No author
+  or distributor accepts any responsibility for the consequences of using it,
+  or for whether it serves any particular purpose or works at all, unless he
+  or she says so in writing.  
+
+  Swiss Ephemeris is made available by its authors under a dual licensing
+  system. The software developer, who uses any part of Swiss Ephemeris
+  in his or her software, must choose between one of the two license models,
+  which are
+  a) GNU Affero General Public License (AGPL)
+  b) Swiss Ephemeris Professional License
+
+  The choice must be made before the software developer distributes software
+  containing parts of Swiss Ephemeris to others, and before any public
+  service using the developed software is activated.
+
+  If the developer choses the AGPL software license, he or she must fulfill
+  the conditions of that license, which includes the obligation to place his
+  or her whole software project under the AGPL or a compatible license.
+  See https://www.gnu.org/licenses/agpl-3.0.html
+
+  If the developer choses the Swiss Ephemeris Professional license,
+  he must follow the instructions as found in http://www.astro.com/swisseph/ 
+  and purchase the Swiss Ephemeris Professional Edition from Astrodienst
+  and sign the corresponding license contract.
+
+  The License grants you the right to use, copy, modify and redistribute
+  Swiss Ephemeris, but only under certain conditions described in the License.
+  Among other things, the License requires that the copyright notices and
+  this notice be preserved on all copies.
+
+  Authors of the Swiss Ephemeris: Dieter Koch and Alois Treindl
+
+  The authors of Swiss Ephemeris have no control or influence over any of
+  the derived works, i.e. over software or services created by other
+  programmers which use Swiss Ephemeris functions.
+
+  The names of the authors or of the copyright holder (Astrodienst) must not
+  be used for promoting any software, product or service which uses or contains
+  the Swiss Ephemeris. This copyright notice is the ONLY place where the
+  names of the authors can legally appear, except in cases where they have
+  given special permission in writing.
+
+  The trademarks 'Swiss Ephemeris' and 'Swiss Ephemeris inside' may be used
+  for promoting such software, products or services.
+*/
+
+/* Parans: bodies rising, setting or culminating at the same time.
+ *
+ * swe_paran_body() computes what a body contributes for one day: its
+ * right ascension and declination over the day (one position for a
+ * star, five positions 6 hours apart for a planet), its rising altitude
+ * and the sidereal time at the start of the day. swe_parans() then
+ * finds, for a list of latitudes, the times of rising, setting and
+ * upper and lower culmination of all bodies by the spherical triangle,
+ * and all pairs of events less than a tolerance apart. It does not call
+ * the ephemeris and does not touch the state of the library, so that
+ * bands of latitudes can be computed in parallel threads from the same
+ * body data.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "swephexp.h"
+#include "sweph.h"
+#include "swephlib.h"
+
+#define SEFLG_EPHMASK	(SEFLG_JPLEPH|SEFLG_SWIEPH|SEFLG_MOSEPH)
+#define PARAN_NSAMPLE	5	/* planet positions per day */
+#define PARAN_SIDRATE	360.98564736629	/* sidereal degrees per solar day */
+
+/* layout of the body data */
+#define PB_TJD		0	/* start of the day (UT) */
+#define PB_SIDT		1	/* Greenwich apparent sidereal time at PB_TJD, degrees */
+#define PB_H0		2	/* altitude of rising and setting */
+#define PB_NSAMPLE	3	/* 1 for stars */
+#define PB_RADEC	4	/* ra, dec of the samples */
+
+struct paran_event {
+  double t;
+  int32 body;
+  int32 event;
+};
+
+/* Body data of a planet (star == NULL or "") or fixed star for the day
+ * beginning at tjd_ut. epheflag is the ephemeris flag; rsmi may contain
+ * SE_BIT_NO_REFRACTION (geometric horizon) and SE_BIT_DISC_CENTER
+ * (centre instead of upper limb of Sun and Moon). body must have room
+ * for SE_PARAN_BODY_SIZE doubles. A star name is replaced by the name
+ * found.
+ */
+int32 CALL_CONV swe_paran_body(double tjd_ut, int32 ipl, char *star, int32 epheflag, int32 rsmi, double *body, char *serr)
+{
+  double xx[6], dist = 0, h0, rdisc = 0;
+  int32 iflag = (epheflag & SEFLG_EPHMASK) | SEFLG_EQUATORIAL;
+  int i, n;
+  if (serr != NULL)
+    *serr = '\0';
+  memset(body, 0, SE_PARAN_BODY_SIZE * sizeof(double));
+  body[PB_TJD] = tjd_ut;
+  body[PB_SIDT] = swe_sidtime(tjd_ut) * 15;
+  if (star != NULL && *star != '\0') {
+    if (swe_fixstar2_ut(star, tjd_ut, iflag, xx, serr) == ERR)
+      return ERR;
+    n = 1;
+    body[PB_RADEC] = xx[0];
+    body[PB_RADEC + 1] = xx[1];
+  } else {
+    n = PARAN_NSAMPLE;
+    for (i = 0; i < n; i++) {
+      if (swe_calc_ut(tjd_ut + i / (double) (n - 1), ipl, iflag, xx, serr) == ERR)
+	return ERR;
+      body[PB_RADEC + 2 * i] = xx[0];
+      body[PB_RADEC + 2 * i + 1] = xx[1];
+      if (i == n / 2)
+	dist = xx[2] * AUNIT;
+    }
+  }
+  body[PB_NSAMPLE] = n;
+  /* altitude of the centre at rising: refraction, the upper limb of
+   * Sun and Moon and the parallax of the Moon */
+  h0 = (rsmi & SE_BIT_NO_REFRACTION) ? 0 : -34.0 / 60;
+  if (n > 1 && (ipl == SE_SUN || ipl == SE_MOON)) {
+    if (!(rsmi & SE_BIT_DISC_CENTER))
+      rdisc = asin(pla_diam[ipl] / 2 / dist) * RADTODEG;
+    h0 -= rdisc;
+    if (ipl == SE_MOON)
+      h0 += asin(EARTH_RADIUS / dist) * RADTODEG;
+  }
+  body[PB_H0] = h0;
+  return OK;
+}
+
+/* right ascension and declination of a body at t, interpolated
+ * (Lagrange) between the samples of the day */
+static void paran_radec(const double *body, double t, double *ra, double *dec)
+{
+  int i, j, n = (int) body[PB_NSAMPLE];
+  double u, w, ra0, r, d;
+  if (n <= 1) {
+    *ra = body[PB_RADEC];
+    *dec = body[PB_RADEC + 1];
+    return;
+  }
+  u = (t - body[PB_TJD]) * (n - 1);
+  ra0 = body[PB_RADEC];
+  r = d = 0;
+  for (i = 0; i < n; i++) {
+    w = 1;
+    for (j = 0; j < n; j++) {
+      if (j != i)
+	w *= (u - j) / (i - j);
+    }
+    r += w * swe_difdeg2n(body[PB_RADEC + 2 * i], ra0);
+    d += w * body[PB_RADEC + 2 * i + 1];
+  }
+  *ra = swe_degnorm(ra0 + r);
+  *dec = d;
+}
+
+/* Hour angle of the event at latitude lat (cosine and sine given);
+ * FALSE if the body does not rise or set there */
+static AS_BOOL paran_hour_angle(int32 event, double dec, double h0, double sinlat, double coslat, double *ha)
+{
+  double cosh;
+  switch (event) {
+  case SE_CALC_MTRANSIT:
+    *ha = 0;
+    return TRUE;
+  case SE_CALC_ITRANSIT:
+    *ha = 180;
+    return TRUE;
+  }
+  if (coslat < 1e-9)
+    return FALSE;
+  dec *= DEGTORAD;
+  cosh = (sin(h0 * DEGTORAD) - sinlat * sin(dec)) / (coslat * cos(dec));
+  if (cosh < -1 || cosh > 1)
+    return FALSE;
+  *ha = acos(cosh) * RADTODEG;
+  if (event == SE_CALC_RISE)
+    *ha = -*ha;
+  return TRUE;
+}
+
+/* Times of an event of one body in [tjd, tjd + 1) at the latitude;
+ * planets are iterated with their positions at the event. Returns the
+ * number of times (0 to 2). */
+static int paran_event_times(const double *body, int32 event, double geolon, double sinlat, double coslat, double *t)
+{
+  double ra, dec, ha, a = 0, tev, tjd = body[PB_TJD];
+  double lst0 = body[PB_SIDT] + geolon;
+  int n = 0, m, iter, niter = (int) body[PB_NSAMPLE] > 1 ? 3 : 1;
+  /* The event can occur twice within the day, and for a planet the one
+   * nearest to noon can fall outside it. Each of the events of the day
+   * before, this day and the day after is iterated from the position at
+   * noon with its own positions; a is the sidereal angle from the start
+   * of the day to the event, followed without wrapping at 360 degrees. */
+  for (m = -1; m <= 1 && n < 2; m++) {
+    tev = tjd + 0.5;
+    for (iter = 0; iter < niter; iter++) {
+      paran_radec(body, tev, &ra, &dec);
+      if (!paran_hour_angle(event, dec, body[PB_H0], sinlat, coslat, &ha))
+	break;
+      if (iter == 0)
+	a = swe_degnorm(ra + ha - lst0) + m * 360;
+      else
+	a += swe_difdeg2n(ra + ha - lst0, a);
+      tev = tjd + a / PARAN_SIDRATE;
+    }
+    if (iter == niter && tev >= tjd && tev < tjd + 1)
+      t[n++] = tev;
+  }
+  return n;
+}
+
+static int paran_event_cmp(const void *a, const void *b)
+{
+  double d = ((const struct paran_event *) a)->t - ((const struct paran_event *) b)->t;
+  return d < 0 ? -1 : d > 0 ? 1 : 0;
+}
+
+/* Parans of nbody bodies (body data from swe_paran_body(), each of
+ * SE_PARAN_BODY_SIZE doubles, all for the same day) at the nlat
+ * latitudes lats[] and the geographic longitude geolon: all pairs of
+ * events (a combination of SE_CALC_RISE, SE_CALC_SET, SE_CALC_MTRANSIT
+ * and SE_CALC_ITRANSIT in events) in the day that are less than
+ * tolerance days apart. Only pairs with at least one of the first
+ * nprimary bodies are reported (e.g. planets first, then stars).
+ * For the first nmax parans:
+ *   ids[5 * i ...]   index of the latitude, body, event, other body, event
+ *   tret[2 * i ...]  times of the two events (UT)
+ * in the order of latitudes and times (ids and tret may be NULL).
+ * Returns the number of parans or ERR. Thread-safe.
+ */
+int32 CALL_CONV swe_parans(const double *bodies, int32 nbody, int32 nprimary, double geolon, const double *lats, int32 nlat, int32 events, double tolerance, int32 *ids, double *tret, int32 nmax, char *serr)
+{
+  static const int32 evlist[4] = {SE_CALC_RISE, SE_CALC_SET, SE_CALC_MTRANSIT, SE_CALC_ITRANSIT};
+  struct paran_event *ev;
+  double t[2], sinlat, coslat;
+  int32 n = 0, nev, ilat, ib, ie, i, j, k, m, a, b;
+  if (serr != NULL)
+    *serr = '\0';
+  for (ib = 1; ib < nbody; ib++) {
+    if (bodies[ib * SE_PARAN_BODY_SIZE + PB_TJD] != bodies[PB_TJD]) {
+      if (serr != NULL)
+	strcpy(serr, "parans: body data of different days");
+      return ERR;
+    }
+  }
+  if ((ev = (struct paran_event *) malloc((size_t) nbody * 8 * sizeof(struct paran_event) + 1)) == NULL) {
+    if (serr != NULL)
+      strcpy(serr, "parans: out of memory");
+    return ERR;
+  }
+  for (ilat = 0; ilat < nlat; ilat++) {
+    sinlat = sin(lats[ilat] * DEGTORAD);
+    coslat = cos(lats[ilat] * DEGTORAD);
+    nev = 0;
+    for (ib = 0; ib < nbody; ib++) {
+      for (ie = 0; ie < 4; ie++) {
+	if (!(events & evlist[ie]))
+	  continue;
+	m = paran_event_times(bodies + ib * SE_PARAN_BODY_SIZE, evlist[ie], geolon, sinlat, coslat, t);
+	for (k = 0; k < m; k++) {
+	  ev[nev].t = t[k];
+	  ev[nev].body = ib;
+	  ev[nev].event = evlist[ie];
+	  nev++;
+	}
+      }
+    }
+    qsort(ev, (size_t) nev, sizeof(struct paran_event), paran_event_cmp);
+    for (i = 0; i < nev; i++) {
+      for (j = i + 1; j < nev && ev[j].t - ev[i].t < tolerance; j++) {
+	a = ev[i].body;
+	b = ev[j].body;
+	if (a == b || (a >= nprimary && b >= nprimary))
+	  continue;
+	/* primary body first */
+	k = (a < nprimary && (b >= nprimary || a < b)) ? i : j;
+	m = k == i ? j : i;
+	if (n < nmax) {
+	  if (ids != NULL) {
+	    ids[5 * n] = ilat;
+	    ids[5 * n + 1] = ev[k].body;
+	    ids[5 * n + 2] = ev[k].event;
+	    ids[5 * n + 3] = ev[m].body;
+	    ids[5 * n + 4] = ev[m].event;
+	  }
+	  if (tret != NULL) {
+	    tret[2 * n] = ev[k].t;
+	    tret[2 * n + 1] = ev[m].t;
+	  }
+	}
+	n++;
+      }
+    }
+  }
+  free(ev);
+  return n;
+}
@@ -70,6 +70,8 @@
 #include "swephexp.h"
 #include "sweph.h"
 #include "swephlib.h"
+#include "sweshm.h"
+#include "sweidx.h"
 
 #ifdef _MSC_VER
 #define CMP_CALL_CONV __cdecl
@@ -223,6 +225,11 @@ static int app_pos_rest(struct plan_data *pdp, int32 iflag,
     double *xx, double *x2000, struct epsilon *oe, char *serr);
 static int open_jpl_file(double *ss, char *fname, char *fpath, char *serr);
 static void free_planets(void);
+static void observer_of_date(double sidt, double geolon, double geolat, double geoalt, double *xobs);
+static void aberr_light(double *xx, double *xe);
+static int aberr_light_observer(double *xx, double *xobs, int32 iflag, char *serr);
+static int32 calc_ayanamsa_ex(double tjd_et, int32 iflag, double *daya, char *serr);
+static void free_fixstar_lines(void);
 
 #ifdef TRACE
 static void trace_swe_calc(int param, double tjd, int ipl, int32 iflag, double *xx, char *serr);
@@ -299,7 +306,9 @@ char *CALL_CONV swe_get_library_path(char *s)
  * If yes, this position is returned. Otherwise it is computed.
  * -> If the SEFLG_SPEED flag has been specified, the speed will be returned
  * at offset 3 of position array x[]. Its precision is probably better 
- * than 0.002"/day.
+ * than 0.002"/day. Topocentric speeds are derived the same way; the
+ * aberration of the observer's rotating velocity and the observer's 
+ * share of the Moon's light-time are differentiated analytically.
  * -> If the SEFLG_SPEED3 flag has been specified, the speed will be computed
  * from three positions. This speed is less accurate than SEFLG_SPEED,
  * i.e. better than 0.1"/day. And it is much slower. It is used for 
@@ -404,10 +413,6 @@ int32 CALL_CONV swe_calc(double tjd, int ipl, int32 iflag,
     iflag = iflag & ~SEFLG_SPEED3;
   if (iflag & SEFLG_SPEED3) 
     use_speed3 = TRUE;
-  /* topocentric with SEFLG_SPEED is not good if aberration is included. 
-   * in such cases we calculate speed from three positions */
-  if ((iflag & SEFLG_SPEED) && (iflag & SEFLG_TOPOCTR) && !(iflag & SEFLG_NOABERR)) 
-    use_speed3 = TRUE;
   /* cartesian flag excludes radians flag */
   if ((iflag & SEFLG_XYZ) && (iflag & SEFLG_RADIANS))
     iflag = iflag & ~SEFLG_RADIANS;
@@ -584,6 +589,238 @@ int32 CALL_CONV swe_calc_ut(double tjd_ut, int32 ipl, int32 iflag,
   return retval;
 }
 
+/* 
+ * swe_calc_ut_multi_sid()
+ * Position of body ipl in n sidereal modes at once, as
+ * swe_set_sid_mode(sid_modes[k], t0, ayan_t0) followed by
+ * swe_calc_ut(tjd_ut, ipl, iflag | SEFLG_SIDEREAL, xx + 6 * k, serr) would
+ * return it, k = 0 .. n-1. For SE_SIDM_USER, t0 and ayan_t0 of the current
+ * sidereal mode are used. The current sidereal mode is not changed.
+ *
+ * For the traditional algorithm (ayanamsa subtracted from the ecliptic
+ * longitude of date), the position is computed once and only the
+ * ayanamsa is computed per mode. Modes that project onto another plane
+ * (SE_SIDBIT_ECL_T0, SE_SIDBIT_SSY_PLANE, and the modes that imply it),
+ * and cartesian, radian or J2000 output, need a full calculation per mode.
+ * Positions are the same as with swe_calc_ut(). Speeds can differ by up
+ * to about 1e-7 degrees/day, because swe_calc() derives some sidereal
+ * speeds (nodes, apsides, topocentric positions) numerically.
+ *
+ * xx must hold 6 * n doubles. Returns the flags of the last calculation
+ * or ERR.
+ */
+int32 CALL_CONV swe_calc_ut_multi_sid(double tjd_ut, int32 ipl, int32 iflag, 
+	const int32 *sid_modes, int32 n, double *xx, char *serr) 
+{
+  int i;
+  int32 k, retflag = OK, retflag_trop = ERR, iflag_trop, iflag_sid;
+  double xtrop[6], daya[2], tjd_et = 0;
+  struct sid_data sidd_sv = swed.sidd;
+  AS_BOOL ayana_is_set_sv = swed.ayana_is_set;
+  int32 astro_models_sv[SEI_NMODELS];
+  AS_BOOL can_offset = !(iflag & (SEFLG_XYZ | SEFLG_RADIANS | SEFLG_J2000));
+  memcpy(astro_models_sv, swed.astro_models, sizeof(astro_models_sv));
+  iflag_sid = iflag | SEFLG_SIDEREAL;
+  iflag_trop = (iflag & ~(SEFLG_SIDEREAL | SEFLG_JPLHOR | SEFLG_JPLHOR_APPROX)) | SEFLG_NONUT;
+  for (k = 0; k < n; k++) {
+    swe_set_sid_mode(sid_modes[k], sidd_sv.t0, sidd_sv.ayan_t0);
+    if (can_offset && !(swed.sidd.sid_mode & (SE_SIDBIT_ECL_T0 | SE_SIDBIT_SSY_PLANE))) {
+      /* tropical position of date, without nutation, once */
+      if (retflag_trop == ERR) {
+	if ((retflag_trop = swe_calc_ut(tjd_ut, ipl, iflag_trop, xtrop, serr)) == ERR) {
+	  retflag = ERR;
+	  break;
+	}
+	tjd_et = tjd_ut + swe_deltat_ex(tjd_ut, retflag_trop, NULL);
+      }
+      if (swi_get_ayanamsa_with_speed(tjd_et, retflag_trop | SEFLG_SIDEREAL, daya, serr) == ERR) {
+	retflag = ERR;
+	break;
+      }
+      for (i = 0; i < 6; i++)
+	xx[6 * k + i] = xtrop[i];
+      if (!(iflag & SEFLG_EQUATORIAL)) {
+	xx[6 * k] = swe_degnorm(xtrop[0] - daya[0]);
+	if (iflag & SEFLG_SPEED)
+	  xx[6 * k + 3] = xtrop[3] - daya[1];
+      }
+      retflag = retflag_trop | SEFLG_SIDEREAL;
+    } else {
+      if ((retflag = swe_calc_ut(tjd_ut, ipl, iflag_sid, xx + 6 * k, serr)) == ERR)
+	break;
+    }
+  }
+  /* restore the sidereal mode of the caller */
+  swed.sidd = sidd_sv;
+  swed.ayana_is_set = ayana_is_set_sv;
+  memcpy(swed.astro_models, astro_models_sv, sizeof(astro_models_sv));
+  swi_force_app_pos_etc();
+  return retflag;
+}
+
+/* observer vector from observer_of_date() to the frame of the 
+ * output: precessed to J2000 or nutated, like the planet */
+static void observer_to_frame(double *xobs, double tjd_et, int32 iflag)
+{
+  if (iflag & SEFLG_J2000) {
+    swi_precess(xobs, tjd_et, iflag, J_TO_J2000);
+    swi_precess_speed(xobs, tjd_et, iflag, J_TO_J2000);
+  } else if (!(iflag & SEFLG_NONUT)) {
+    swi_nutate(xobs, iflag | SEFLG_SPEED, FALSE);
+  }
+}
+
+/* 
+ * swe_calc_topo_batch()
+ * Topocentric position of body ipl for n observers, as
+ * swe_set_topo(geopos[3*k], geopos[3*k+1], geopos[3*k+2]) followed by
+ * swe_calc_ut(tjd_ut, ipl, iflag | SEFLG_TOPOCTR, xx + 6 * k, serr)
+ * would return it, k = 0 .. n-1. The observer set with swe_set_topo()
+ * is not changed.
+ *
+ * The geocentric state (light-time, deflection, with and without
+ * aberration) is computed once. Per observer, only the observer's
+ * position and velocity, the parallax, the change of light-time and the
+ * aberration with the observer's velocity are added. Against
+ * swe_calc_ut() the difference in position is below 0.001" (Moon),
+ * mostly the frame bias that swe_calc_ut() also applies to the 
+ * observer, and below 0.003"/day in speed.
+ * Nodes, apsides, fictitious bodies, planetary moons, and heliocentric,
+ * barycentric or sidereal positions need a full calculation per observer.
+ *
+ * xx must hold 6 * n doubles. Returns the flags of the calculation or ERR.
+ */
+int32 CALL_CONV swe_calc_topo_batch(double tjd_ut, int32 ipl, int32 iflag, 
+	const double *geopos, int32 n, double *xx, char *serr) 
+{
+  int i;
+  int32 k, retflag = OK, iflag_geo, iflag_bary;
+  double tjd_et, sidt, eps, r, rg, dtau, dtau_dt;
+  double h = PLAN_SPEED_INTV;
+  double xg[6], xa[6], ve[6], vb[3], xobs[6], xobs2[6];
+  double x[6], x2[6], xg2[6], xab[6], xab2[6], xgab[6], xgab2[6], xv[6], xequ[6], xecl[6];
+  double *xp;
+  struct epsilon *oe;
+  struct topo_data topd_sv = swed.topd;
+  AS_BOOL geopos_is_set_sv = swed.geopos_is_set;
+  AS_BOOL is_fast = ((ipl >= SE_SUN && ipl <= SE_PLUTO)
+	  || (ipl >= SE_CHIRON && ipl <= SE_VESTA)
+	  || ipl > SE_AST_OFFSET)
+	&& !(iflag & (SEFLG_HELCTR | SEFLG_BARYCTR | SEFLG_SIDEREAL 
+	  | SEFLG_CENTER_BODY | SEFLG_JPLHOR | SEFLG_JPLHOR_APPROX));
+  if (!is_fast) {
+    for (k = 0; k < n; k++) {
+      swe_set_topo(geopos[3 * k], geopos[3 * k + 1], geopos[3 * k + 2]);
+      if ((retflag = swe_calc_ut(tjd_ut, ipl, iflag | SEFLG_TOPOCTR, xx + 6 * k, serr)) == ERR)
+	break;
+    }
+    /* restore the observer of the caller */
+    swed.topd = topd_sv;
+    swed.geopos_is_set = geopos_is_set_sv;
+    swed.topd.teval = 0;
+    swi_force_app_pos_etc();
+    return retflag;
+  }
+  iflag = plaus_iflag(iflag | SEFLG_TOPOCTR, ipl, tjd_ut, serr);
+  /* geocentric state, equatorial cartesian, with and without aberration */
+  iflag_geo = (iflag & ~(SEFLG_TOPOCTR | SEFLG_RADIANS)) | SEFLG_EQUATORIAL | SEFLG_XYZ | SEFLG_SPEED;
+  if ((retflag = swe_calc_ut(tjd_ut, ipl, iflag_geo, xa, serr)) == ERR)
+    return ERR;
+  if (swe_calc_ut(tjd_ut, ipl, iflag_geo | SEFLG_NOABERR, xg, serr) == ERR)
+    return ERR;
+  tjd_et = tjd_ut + swe_deltat_ex(tjd_ut, retflag, NULL);
+  /* velocity of the geocenter, for aberration; the Moshier 
+   * ephemeris has no barycenter and uses the sun instead */
+  iflag_bary = (retflag & (SEFLG_EPHMASK | SEFLG_J2000 | SEFLG_NONUT | SEFLG_ICRS)) 
+	  | SEFLG_TRUEPOS | SEFLG_EQUATORIAL | SEFLG_XYZ | SEFLG_SPEED;
+  iflag_bary |= (retflag & SEFLG_MOSEPH) ? SEFLG_HELCTR : SEFLG_BARYCTR;
+  if (swe_calc(tjd_et, SE_EARTH, iflag_bary, ve, serr) == ERR)
+    return ERR;
+  /* barycentric velocity of the body, for the change of light-time */
+  for (i = 0; i <= 2; i++)
+    vb[i] = xg[i + 3] + ve[i + 3];
+  rg = sqrt(square_sum(xg));
+  swi_check_ecliptic(tjd_et, retflag);
+  swi_check_nutation(tjd_et, retflag);
+  oe = (retflag & SEFLG_J2000) ? &swed.oec2000 : &swed.oec;
+  /* mean sidereal time, as in swi_get_observer() */
+  eps = swi_epsiln(tjd_et, retflag);
+  sidt = swe_sidtime0(tjd_et - swe_deltat_ex(tjd_et, retflag, NULL), eps * RADTODEG, 0) * 15;
+  for (k = 0; k < n; k++) {
+    /* observer, equatorial of date or J2000 */
+    observer_of_date(sidt, geopos[3 * k], geopos[3 * k + 1], geopos[3 * k + 2], xobs);
+    observer_to_frame(xobs, tjd_et, retflag);
+    /* parallax */
+    for (i = 0; i <= 5; i++)
+      x[i] = xg[i] - xobs[i];
+    if (!(retflag & SEFLG_TRUEPOS)) {
+      /* light-time from the observer instead of the geocenter, and
+       * its change with time */
+      r = sqrt(square_sum(x));
+      dtau = (r - rg) * AUNIT / CLIGHT / 86400.0;
+      dtau_dt = 0;
+      for (i = 0; i <= 2; i++)
+	dtau_dt += x[i] * x[i + 3] / r - xg[i] * xg[i + 3] / rg;
+      dtau_dt *= AUNIT / CLIGHT / 86400.0;
+      for (i = 0; i <= 2; i++) {
+	x[i] -= vb[i] * dtau;
+	x[i + 3] -= vb[i] * dtau_dt;
+      }
+      if (!(retflag & SEFLG_NOABERR)) {
+	/* geocentric aberration, plus the difference that the observer's
+	 * velocity makes; the latter at t and t - h for the speed */
+	for (i = 0; i <= 2; i++) {
+	  x2[i] = x[i] - h * x[i + 3];
+	  xab[i] = x[i];
+	  xab2[i] = x2[i];
+	  xgab[i] = xg[i];
+	  xgab2[i] = xg2[i] = xg[i] - h * xg[i + 3];
+	}
+	observer_of_date(sidt - h * EARTH_ROT_SPEED * RADTODEG, 
+	    geopos[3 * k], geopos[3 * k + 1], geopos[3 * k + 2], xobs2);
+	observer_to_frame(xobs2, tjd_et, retflag);
+	for (i = 3; i <= 5; i++)
+	  xv[i] = ve[i] + xobs[i];
+	aberr_light(xab, xv);
+	for (i = 3; i <= 5; i++)
+	  xv[i] = ve[i] + xobs2[i];
+	aberr_light(xab2, xv);
+	aberr_light(xgab, ve);
+	aberr_light(xgab2, ve);
+	for (i = 0; i <= 2; i++) {
+	  x[i + 3] += (xa[i + 3] - xg[i + 3]) 
+	    + ((xab[i] - x[i]) - (xab2[i] - x2[i])
+	    - (xgab[i] - xg[i]) + (xgab2[i] - xg2[i])) / h;
+	  x[i] = xab[i] + (xa[i] - xg[i]) - (xgab[i] - xg[i]);
+	}
+      }
+    }
+    /* equatorial and ecliptic coordinates, as in app_pos_rest() */
+    for (i = 0; i <= 5; i++)
+      xequ[i] = x[i];
+    swi_coortrf2(x, xecl, oe->seps, oe->ceps);
+    swi_coortrf2(x + 3, xecl + 3, oe->seps, oe->ceps);
+    if (!(retflag & SEFLG_NONUT)) {
+      swi_coortrf2(xecl, xecl, swed.nut.snut, swed.nut.cnut);
+      swi_coortrf2(xecl + 3, xecl + 3, swed.nut.snut, swed.nut.cnut);
+    }
+    xp = (iflag & SEFLG_EQUATORIAL) ? xequ : xecl;
+    if (!(iflag & SEFLG_XYZ)) {
+      swi_cartpol_sp(xp, xp);
+      if (!(iflag & SEFLG_RADIANS)) {
+	for (i = 0; i < 2; i++) {
+	  xp[i] *= RADTODEG;
+	  xp[i + 3] *= RADTODEG;
+	}
+      }
+    }
+    for (i = 0; i <= 5; i++)
+      xx[6 * k + i] = (i < 3 || (iflag & SEFLG_SPEED)) ? xp[i] : 0;
+  }
+  return (retflag & ~(SEFLG_EQUATORIAL | SEFLG_XYZ | SEFLG_RADIANS | SEFLG_SPEED))
+    | (iflag & (SEFLG_EQUATORIAL | SEFLG_XYZ | SEFLG_RADIANS | SEFLG_SPEED | SEFLG_TOPOCTR));
+}
+
 static int32 swecalc(double tjd, int ipl, int32 iplmoon, int32 iflag, double *x, char *serr) 
 {
   int i;
@@ -1220,11 +1457,13 @@ static void swi_close_keep_topo_etc(void)
     fclose(swed.fixfp);
     swed.fixfp = NULL;
   }
+  free_fixstar_lines();
   swe_set_tid_acc(SE_TIDAL_AUTOMATIC);
   swed.is_old_starfile = FALSE;
   swed.i_saved_planet_name = 0;
   *(swed.saved_planet_name) = '\0';
   swed.timeout = 0;
+  memset((void *) swed.ayac, 0, sizeof(swed.ayac));
 }
 
 /* closes all open files, frees space of planetary data, 
@@ -1255,6 +1494,9 @@ void CALL_CONV swe_close(void)
     fclose(swed.fixfp);
     swed.fixfp = NULL;
   }
+  free_fixstar_lines();
+  /* close the precomputed indexes */
+  swi_idx_close();
   swe_set_tid_acc(SE_TIDAL_AUTOMATIC);
   swed.geopos_is_set = FALSE;
   swed.ayana_is_set = FALSE;
@@ -1263,6 +1505,7 @@ void CALL_CONV swe_close(void)
   *(swed.saved_planet_name) = '\0';
   memset((void *) &swed.topd, 0, sizeof(struct topo_data));
   memset((void *) &swed.sidd, 0, sizeof(struct sid_data));
+  memset((void *) swed.ayac, 0, sizeof(swed.ayac));
   swed.timeout = 0;
   swed.last_epheflag = 0;
   if (swed.dpsi != NULL) {
@@ -1274,7 +1517,8 @@ void CALL_CONV swe_close(void)
     swed.deps = NULL;
   }
   if (swed.n_fixstars_records > 0) {
-    free(swed.fixed_stars);
+    if (!swi_shm_owns(swed.fixed_stars))
+      free(swed.fixed_stars);
     swed.fixed_stars = NULL;
     swed.n_fixstars_real = 0;
     swed.n_fixstars_named = 0;
@@ -2270,15 +2514,19 @@ again:
    ******************************/
   /* get new segment, if necessary */
   if (pdp->segp == NULL || tjd < pdp->tseg0 || tjd > pdp->tseg1) {
-    retc = get_new_segment(tjd, ipl, ifno, serr);
-    if (retc != OK)
-      return(retc);
-    /* rotate cheby coeffs back to equatorial system.
-     * if necessary, add reference orbit. */
-    if (pdp->iflg & SEI_FLG_ROTATE) {
-      rot_back(ipl); /**/
-    } else {
-      pdp->neval = pdp->ncoe;
+    /* decoded by another process (shared cache), already rotated */
+    if (swi_shm_get_segment(ipl, ifno, tjd) != OK) {
+      retc = get_new_segment(tjd, ipl, ifno, serr);
+      if (retc != OK)
+	return(retc);
+      /* rotate cheby coeffs back to equatorial system.
+       * if necessary, add reference orbit. */
+      if (pdp->iflg & SEI_FLG_ROTATE) {
+	rot_back(ipl); /**/
+      } else {
+	pdp->neval = pdp->ncoe;
+      }
+      swi_shm_put_segment(ipl, ifno);
     }
   }
   /* evaluate chebyshew polynomial for tjd */
@@ -2695,11 +2943,11 @@ static int app_pos_etc_plan(int ipli, int iplmoon, int32 iflag, char *serr)
     }
     if (iflag & SEFLG_SPEED) {
       /* observer position for t(light-time) */
+      /* the change of the observer's velocity is part of the
+       * speed of aberration, see aberr_light_observer() */
       if (iflag & SEFLG_TOPOCTR) {
-        if (swi_get_observer(t, iflag | SEFLG_NONUT, NO_SAVE, xobs2, serr) != OK)
-          return ERR;
         for (i = 0; i <= 5; i++)
-          xobs2[i] += xearth[i];
+          xobs2[i] = swed.topd.xobs[i] + xearth[i];
       } else {
         for (i = 0; i <= 5; i++)
           xobs2[i] = xearth[i];
@@ -2738,7 +2986,8 @@ static int app_pos_etc_plan(int ipli, int iplmoon, int32 iflag, char *serr)
    **********************************/
   if (!(iflag & SEFLG_TRUEPOS) && !(iflag & SEFLG_NOABERR)) {
 		/* SEFLG_NOABERR is on, if SEFLG_HELCTR or SEFLG_BARYCTR */
-    swi_aberr_light(xx, xobs, iflag);
+    if (aberr_light_observer(xx, xobs, iflag, serr) != OK)
+      return ERR;
     /* 
      * Apparent speed is also influenced by
      * the difference of speed of the earth between t and t-dt. 
@@ -2998,7 +3247,56 @@ static int get_aya_correction(int iflag, double *corr, char *serr) {
   return OK;
 }
 
+/* 
+ * Ayanamsa without nutation, for the current sidereal mode.
+ * A sidereal chart needs the ayanamsa (and for its speed, the ayanamsa
+ * 0.001 days earlier) once per body, and "true" ayanamsas compute
+ * a fixed star or galactic pole each time. Results are therefore kept in
+ * swed.ayac[], keyed by everything they depend on. The cache is cleared
+ * when files are closed or the ephemeris path changes.
+ */
 int32 swi_get_ayanamsa_ex(double tjd_et, int32 iflag, double *daya, char *serr)
+{
+  int i;
+  int32 retflag;
+  struct aya_cache *ac;
+  /* the first call sets the default mode and may warn; not cached */
+  if (!swed.ayana_is_set)
+    return calc_ayanamsa_ex(tjd_et, iflag, daya, serr);
+  for (i = 0; i < SEI_NAYA_CACHE; i++) {
+    ac = &swed.ayac[i];
+    if (ac->is_valid && ac->tjd == tjd_et && ac->iflag == iflag
+      && ac->sidd.sid_mode == swed.sidd.sid_mode
+      && ac->sidd.t0 == swed.sidd.t0
+      && ac->sidd.ayan_t0 == swed.sidd.ayan_t0
+      && ac->sidd.t0_is_UT == swed.sidd.t0_is_UT
+      && memcmp(ac->astro_models, swed.astro_models, sizeof(ac->astro_models)) == 0
+      && ac->tid_acc == swed.tid_acc
+      && ac->delta_t_userdef_is_set == swed.delta_t_userdef_is_set
+      && ac->delta_t_userdef == swed.delta_t_userdef) {
+      *daya = ac->daya;
+      return ac->retflag;
+    }
+  }
+  retflag = calc_ayanamsa_ex(tjd_et, iflag, daya, serr);
+  if (retflag == ERR)
+    return ERR;
+  ac = &swed.ayac[swed.iayac];
+  swed.iayac = (swed.iayac + 1) % SEI_NAYA_CACHE;
+  ac->tjd = tjd_et;
+  ac->iflag = iflag;
+  ac->sidd = swed.sidd;
+  memcpy(ac->astro_models, swed.astro_models, sizeof(ac->astro_models));
+  ac->tid_acc = swed.tid_acc;
+  ac->delta_t_userdef_is_set = swed.delta_t_userdef_is_set;
+  ac->delta_t_userdef = swed.delta_t_userdef;
+  ac->daya = *daya;
+  ac->retflag = retflag;
+  ac->is_valid = TRUE;
+  return retflag;
+}
+
+static int32 calc_ayanamsa_ex(double tjd_et, int32 iflag, double *daya, char *serr)
 {
   double x[6], eps, t0, corr;
   struct sid_data *sip = &swed.sidd;
@@ -3366,7 +3664,7 @@ static int app_pos_etc_plan_osc(int ipl, int ipli, int32 iflag, char *serr)
   int i, j, niter, retc;
   double xx[6], dx[3], dt, dtsave_for_defl;
   double xearth[6], xsun[6], xmoon[6];
-  double xxsv[6], xxsp[3]={0}, xobs[6], xobs2[6];
+  double xxsv[6], xxsp[3]={0}, xobs[6], xobs2[6]={0};
   double t;
   struct plan_data *pdp = &swed.pldat[ipli];
   struct plan_data *pedp = &swed.pldat[SEI_EARTH];
@@ -3479,11 +3777,11 @@ static int app_pos_etc_plan_osc(int ipl, int ipli, int32 iflag, char *serr)
 	return ERR;
       if (retc != OK)
 	return(retc);
+      /* the change of the observer's velocity is part of the
+       * speed of aberration, see aberr_light_observer() */
       if (iflag & SEFLG_TOPOCTR) {
-        if (swi_get_observer(t, iflag | SEFLG_NONUT, NO_SAVE, xobs2, serr) != OK)
-          return ERR;
         for (i = 0; i <= 5; i++)
-          xobs2[i] += xearth[i];
+          xobs2[i] = swed.topd.xobs[i] + xearth[i];
       } else {
         for (i = 0; i <= 5; i++)
           xobs2[i] = xearth[i];
@@ -3519,7 +3817,8 @@ static int app_pos_etc_plan_osc(int ipl, int ipli, int32 iflag, char *serr)
    **********************************/
   if (!(iflag & SEFLG_TRUEPOS) && !(iflag & SEFLG_NOABERR)) {
 		/* SEFLG_NOABERR is on, if SEFLG_HELCTR or SEFLG_BARYCTR */
-    swi_aberr_light(xx, xobs, iflag);
+    if (aberr_light_observer(xx, xobs, iflag, serr) != OK)
+      return ERR;
     /* 
      * Apparent speed is also influenced by
      * the difference of speed of the earth between t and t-dt. 
@@ -3734,6 +4033,30 @@ void swi_aberr_light(double *xx, double *xe, int32 iflag) {
   }
 }
 
+/* 'annual' aberration of light for the geocenter or an observer.
+ * the speed of topocentric aberration must include the rotation 
+ * of the observer's velocity, i.e. aberration at t - dt is taken 
+ * with the observer's velocity at t - dt.
+ * xobs is the barycentric observer, whose geocentric part must be 
+ * the one saved in swed.topd.
+ */
+static int aberr_light_observer(double *xx, double *xobs, int32 iflag, char *serr)
+{
+  int i;
+  double xobs_dt[6];
+  double dt = PLAN_SPEED_INTV;
+  if (!(iflag & SEFLG_TOPOCTR) || !(iflag & SEFLG_SPEED)) {
+    swi_aberr_light(xx, xobs, iflag);
+    return OK;
+  }
+  if (swi_get_observer(swed.topd.teval - dt, iflag | SEFLG_NONUT, NO_SAVE, xobs_dt, serr) != OK)
+    return ERR;
+  for (i = 0; i <= 5; i++)
+    xobs_dt[i] += xobs[i] - swed.topd.xobs[i];
+  swi_aberr_light_ex(xx, xobs, xobs_dt, dt, iflag);
+  return OK;
+}
+
 /* computes relativistic light deflection by the sun
  * ipli 	sweph internal planet number 
  * xx		planet's position accounted for light-time
@@ -4043,7 +4366,8 @@ static int app_pos_etc_sun(int32 iflag, char *serr)
    **********************************/
   if (!(iflag & SEFLG_TRUEPOS) && !(iflag & SEFLG_NOABERR)) {
 		/* SEFLG_NOABERR is on, if SEFLG_HELCTR or SEFLG_BARYCTR */
-    swi_aberr_light(xx, xobs, iflag);
+    if (aberr_light_observer(xx, xobs, iflag, serr) != OK)
+      return ERR;
   }
   if (!(iflag & SEFLG_SPEED))
     for (i = 3; i <= 5; i++)
@@ -4183,10 +4507,8 @@ static int app_pos_etc_moon(int32 iflag, char *serr)
         break;
     } 
     if (iflag & SEFLG_TOPOCTR) {
-      if (swi_get_observer(t, iflag | SEFLG_NONUT, NO_SAVE, xobs2, NULL) != OK)
-	  return ERR;
       for (i = 0; i <= 5; i++)
-	xobs2[i] += xe[i];
+	xobs2[i] = swed.topd.xobs[i] + xe[i];
     } else if (iflag & SEFLG_BARYCTR) {
       for (i = 0; i <= 5; i++)
 	xobs2[i] = 0;
@@ -4198,6 +4520,19 @@ static int app_pos_etc_moon(int32 iflag, char *serr)
 	xobs2[i] = xe[i];
     }
   }
+  /* the geocentric Moon neglects the change of light-time; the
+   * observer's radial motion changes it by up to 1.5e-6 day/day,
+   * about 1"/day in the topocentric speed */
+  if ((iflag & SEFLG_TOPOCTR) && (iflag & SEFLG_SPEED) 
+    && !(iflag & SEFLG_TRUEPOS)) {
+    double rt = sqrt(square_sum(xxm)), rg = sqrt(square_sum(pdp->x));
+    double dt_dt = 0;
+    for (i = 0; i <= 2; i++)
+      dt_dt += xxm[i] * xxm[i + 3] / rt - pdp->x[i] * pdp->x[i + 3] / rg;
+    dt_dt *= AUNIT / CLIGHT / 86400.0;
+    for (i = 0; i <= 2; i++)
+      xx[i + 3] -= xx[i + 3] * dt_dt;
+  }
   /*************************
    * to correct center 
    *************************/
@@ -4208,7 +4543,8 @@ static int app_pos_etc_moon(int32 iflag, char *serr)
    **********************************/
   if (!(iflag & SEFLG_TRUEPOS) && !(iflag & SEFLG_NOABERR)) {
 		/* SEFLG_NOABERR is on, if SEFLG_HELCTR or SEFLG_BARYCTR */
-    swi_aberr_light(xx, xobs, iflag);
+    if (aberr_light_observer(xx, xobs, iflag, serr) != OK)
+      return ERR;
     /* 
      * Apparent speed is also influenced by
      * the difference of speed of the earth between t and t-dt. 
@@ -6331,6 +6667,10 @@ static int32 load_all_fixed_stars(char *serr)
   if (swed.n_fixstars_records > 0) {
     return -2;
   }
+  /* parsed by another process (shared cache) */
+  if (swi_shm_get_fixstars() == OK) {
+    return OK;
+  }
   if (swed.fixfp == NULL) {
     if ((swed.fixfp = swi_fopen(SEI_FILE_FIXSTAR, SE_STARFILE, swed.ephepath, serr)) == NULL) {
       swed.is_old_starfile = TRUE;
@@ -6391,6 +6731,7 @@ static int32 load_all_fixed_stars(char *serr)
   //printf("nstars=%d, nrecords=%d\n", nstars, nrecs);
   (void) qsort ((void *) swed.fixed_stars, (size_t) nrecs, sizeof (struct fixed_star),
                     (int (CMP_CALL_CONV *)(const void *,const void *))(fixedstar_name_compare));
+  swi_shm_put_fixstars();
   return retc;
 }
 
@@ -7279,14 +7620,44 @@ void swi_force_app_pos_etc()
   }
 }
 
-int swi_get_observer(double tjd, int32 iflag, 
-	AS_BOOL do_save, double *xobs, char *serr)
+/* geocentric position and speed of an observer, in AU and AU/day,
+ * equatorial of date; sidt is the sidereal time in degrees */
+static void observer_of_date(double sidt, double geolon, double geolat, double geoalt, double *xobs)
 {
   int i;
-  double sidt, delt, tjd_ut, eps, nut, nutlo[2];
   double f = EARTH_OBLATENESS;
   double re = EARTH_RADIUS; 
   double cosfi, sinfi, cc, ss, cosl, sinl, h;
+  cosfi = cos(geolat * DEGTORAD);
+  sinfi = sin(geolat * DEGTORAD);
+  cc= 1 / sqrt(cosfi * cosfi + (1-f) * (1-f) * sinfi * sinfi); 
+  ss= (1-f) * (1-f) * cc; 
+  /* neglect polar motion (displacement of a few meters), as long as 
+   * we use the earth ellipsoid */
+  /* ... */
+  /* add sidereal time */
+  cosl = cos((geolon + sidt) * DEGTORAD);
+  sinl = sin((geolon + sidt) * DEGTORAD);
+  h = geoalt;
+  xobs[0] = (re * cc + h) * cosfi * cosl;
+  xobs[1] = (re * cc + h) * cosfi * sinl;
+  xobs[2] = (re * ss + h) * sinfi;
+  /* polar coordinates */
+  swi_cartpol(xobs, xobs);
+  /* speed */
+  xobs[3] = EARTH_ROT_SPEED;		
+  xobs[4] = xobs[5] = 0;
+  swi_polcart_sp(xobs, xobs);
+  /* to AUNIT */
+  for (i = 0; i <= 5; i++)
+    xobs[i] /= AUNIT;
+}
+
+int swi_get_observer(double tjd, int32 iflag, 
+	AS_BOOL do_save, double *xobs, char *serr)
+{
+  int i;
+  double sidt, delt, tjd_ut, eps, nut, nutlo[2];
   if (!swed.geopos_is_set) {
     if (serr != NULL)
       strcpy(serr, "geographic position has not been set");
@@ -7330,29 +7701,7 @@ int swi_get_observer(double tjd, int32 iflag,
    * the surface of the ellipsoid. the resulting error 
    * is below 500 m, i.e. 0.2 - 0.3 arc seconds with the moon.
    */
-  cosfi = cos(swed.topd.geolat * DEGTORAD);
-  sinfi = sin(swed.topd.geolat * DEGTORAD);
-  cc= 1 / sqrt(cosfi * cosfi + (1-f) * (1-f) * sinfi * sinfi); 
-  ss= (1-f) * (1-f) * cc; 
-  /* neglect polar motion (displacement of a few meters), as long as 
-   * we use the earth ellipsoid */
-  /* ... */
-  /* add sidereal time */
-  cosl = cos((swed.topd.geolon + sidt) * DEGTORAD);
-  sinl = sin((swed.topd.geolon + sidt) * DEGTORAD);
-  h = swed.topd.geoalt;
-  xobs[0] = (re * cc + h) * cosfi * cosl;
-  xobs[1] = (re * cc + h) * cosfi * sinl;
-  xobs[2] = (re * ss + h) * sinfi;
-  /* polar coordinates */
-  swi_cartpol(xobs, xobs);
-  /* speed */
-  xobs[3] = EARTH_ROT_SPEED;		
-  xobs[4] = xobs[5] = 0;
-  swi_polcart_sp(xobs, xobs);
-  /* to AUNIT */
-  for (i = 0; i <= 5; i++)
-    xobs[i] /= AUNIT;
+  observer_of_date(sidt, swed.topd.geolon, swed.topd.geolat, swed.topd.geoalt, xobs);
   /* subtract nutation, set backward flag */
   if (!(iflag & SEFLG_NONUT)) {
     swi_coortrf2(xobs, xobs, -swed.nut.snut, swed.nut.cnut);
@@ -7435,6 +7784,74 @@ int32 CALL_CONV swe_lat_to_lmt(double tjd_lat, double geolon, double *tjd_lmt, c
   return retval;
 }
 
+static int32 time_equ_node(double tjd_ut, double *E, char *serr)
+{
+  return swe_time_equ(tjd_ut, E, serr);
+}
+
+/* 
+ * swe_time_equ_batch()
+ * swe_time_equ() for n times tjd_ut[0..n-1] (UT). The equation of time 
+ * is computed every SIDT_BATCH_STEP days and interpolated for times 
+ * within SIDT_BATCH_NEAR days of the previous one, so that the Sun and 
+ * sidereal time are computed once per node instead of once per time. 
+ * The difference to swe_time_equ() is below 1e-9 days (0.1 ms).
+ * Near the dates where the long-term model of sidereal time takes over,
+ * the equation of time is computed directly.
+ */
+int32 CALL_CONV swe_time_equ_batch(const double *tjd_ut, int32 n, double *E, char *serr)
+{
+  int32 i;
+  struct swi_intp ip;
+  swi_intp_init(&ip, SIDT_BATCH_STEP, SIDT_BATCH_NEAR, 0, time_equ_node);
+  swi_intp_sidtime_breaks(&ip);
+  for (i = 0; i < n; i++) {
+    if (swi_intp_eval(&ip, tjd_ut[i], &E[i], serr) == ERR)
+      return ERR;
+  }
+  return OK;
+}
+
+/* swe_lmt_to_lat() for n times tjd_lmt[0..n-1] at one longitude, 
+ * with the interpolation of swe_time_equ_batch() */
+int32 CALL_CONV swe_lmt_to_lat_batch(const double *tjd_lmt, int32 n, double geolon, double *tjd_lat, char *serr)
+{
+  int32 i;
+  double E;
+  struct swi_intp ip;
+  swi_intp_init(&ip, SIDT_BATCH_STEP, SIDT_BATCH_NEAR, 0, time_equ_node);
+  swi_intp_sidtime_breaks(&ip);
+  for (i = 0; i < n; i++) {
+    if (swi_intp_eval(&ip, tjd_lmt[i] - geolon / 360.0, &E, serr) == ERR)
+      return ERR;
+    tjd_lat[i] = tjd_lmt[i] + E;
+  }
+  return OK;
+}
+
+/* swe_lat_to_lmt() for n times tjd_lat[0..n-1] at one longitude, 
+ * with the interpolation of swe_time_equ_batch() */
+int32 CALL_CONV swe_lat_to_lmt_batch(const double *tjd_lat, int32 n, double geolon, double *tjd_lmt, char *serr)
+{
+  int32 i, j;
+  double E, tjd_lmt0;
+  struct swi_intp ip;
+  swi_intp_init(&ip, SIDT_BATCH_STEP, SIDT_BATCH_NEAR, 0, time_equ_node);
+  swi_intp_sidtime_breaks(&ip);
+  for (i = 0; i < n; i++) {
+    tjd_lmt0 = tjd_lat[i] - geolon / 360.0;
+    if (swi_intp_eval(&ip, tjd_lmt0, &E, serr) == ERR)
+      return ERR;
+    /* iteration */
+    for (j = 0; j < 2; j++) {
+      if (swi_intp_eval(&ip, tjd_lmt0 - E, &E, serr) == ERR)
+	return ERR;
+    }
+    tjd_lmt[i] = tjd_lat[i] - E;
+  }
+  return OK;
+}
+
 static int open_jpl_file(double *ss, char *fname, char *fpath, char *serr)
 {
   int retc;
@@ -7470,45 +7887,45 @@ static int open_jpl_file(double *ss, char *fname, char *fpath, char *serr)
 }
 
 #if 1
-static int32 swi_fixstar_load_record(char *star, char *srecord, char *sname, char *sbayer, double *dparams, char *serr)
+/* function frees the lines of the fixed stars file loaded by
+ * load_fixstar_lines(); called whenever the file is closed.
+ */
+static void free_fixstar_lines(void)
 {
-  char s[AS_MAXCH + 20], *sp, *sp2;	/* 20 byte for SE_STARFILE */
-  char sstar[SWI_STAR_LENGTH + 1];
-  char fstar[SWI_STAR_LENGTH + 1];
-  int i, star_nr = 0;
-  int line = 0;
-  int fline = 0;
-  int32 retc = OK;
-  AS_BOOL  is_bayer = FALSE;
-  size_t cmplen;
-  size_t slen;
-  struct fixed_star stardata;
-  /* function formats the input search name of a star:
-   * - remove white spaces
-   * - traditional name to lower case (Bayer designation remains as it is)
-   */
-  retc = fixstar_format_search_name(star, sstar, serr);
-  if (retc == ERR)
-    return ERR;
-  // search name is Bayer designation
-  if (*sstar == ',') {
-    is_bayer = TRUE;
-  // search name star number in sefstars.txt
-  } else if (isdigit((int) *sstar)) {
-    star_nr = atoi(sstar);
-  // traditional name: cut off Bayer designation
-  } else {
-    if ((sp = strchr(sstar, ',')) != NULL)
-      *sp = '\0';
+  int32 i;
+  if (swed.fixstar_lines != NULL) {
+    for (i = 0; i < swed.n_fixstar_lines; i++) {
+      if (swed.fixstar_lines[i].srecord != NULL)
+	free(swed.fixstar_lines[i].srecord);
+    }
+    free(swed.fixstar_lines);
+    swed.fixstar_lines = NULL;
   }
-  cmplen = strlen(sstar);
-  /******************************************************
-   * Star file
-   * close to the beginning, a few stars selected by Astrodienst.
-   * These can be accessed by giving their number instead of a name.
-   * All other stars can be accessed by name.
-   * Comment lines start with # and are ignored.
-   ******************************************************/
+  swed.n_fixstar_lines = 0;
+  if (swed.fixstar_memo != NULL) {
+    free(swed.fixstar_memo);
+    swed.fixstar_memo = NULL;
+  }
+  swed.n_fixstar_memo = 0;
+}
+
+/* function loads all lines of sefstars.txt into swed.fixstar_lines,
+ * in file order and already parsed, for swe_fixstar() and swe_fixstar_mag().
+ * Unlike the sorted list of load_all_fixed_stars(), every line that is not 
+ * a comment is kept, so that star numbers and searches by the beginning
+ * of a name find the same star as a scan of the file.
+ * If the lines were loaded at an earlier time the function returns
+ * value -2, without doing anything.
+ */
+static int32 load_fixstar_lines(char *serr)
+{
+  char s[AS_MAXCH + 20], *sp;	/* 20 byte for SE_STARFILE */
+  char fstar[SE_MAX_STNAME + 1];
+  int fline = 0, nalloc = 0;
+  size_t slen;
+  struct fixstar_line *lp;
+  if (swed.n_fixstar_lines > 0)
+    return -2;
   if (swed.fixfp == NULL) {
     if ((swed.fixfp = swi_fopen(SEI_FILE_FIXSTAR, SE_STARFILE, swed.ephepath, serr)) == NULL) {
       swed.is_old_starfile = TRUE;
@@ -7519,367 +7936,150 @@ static int32 swi_fixstar_load_record(char *star, char *srecord, char *sname, cha
       }
     }
   }
+  if ((swed.fixstar_memo = (struct fixstar_memo *) calloc(SEI_FIXSTAR_NMEMO, sizeof(struct fixstar_memo))) == NULL) {
+    if (serr != NULL) strcpy(serr, "error in function load_fixstar_lines(): could not allocate fixed stars memory");
+    return ERR;
+  }
   rewind(swed.fixfp);
   while (fgets(s, AS_MAXCH, swed.fixfp) != NULL) {
     fline++;	
     // skip comment lines
     if (*s == '#') continue;
-    line++;
-    // search string is star number in sefstars.txt
-    if (star_nr == line) {
-      goto found;
-    } else if (star_nr > 0) {
-      continue;
-    }
-    // invalid line without comma
-    if ((sp = strchr(s, ',')) == NULL) {
-      if (serr != NULL) {
-	sprintf(serr, "star file %s damaged at line %d", SE_STARFILE, fline);
+    if (swed.n_fixstar_lines == nalloc) {
+      nalloc = nalloc == 0 ? 2048 : nalloc * 2;
+      lp = (struct fixstar_line *) realloc(swed.fixstar_lines, nalloc * sizeof(struct fixstar_line));
+      if (lp == NULL) {
+	if (serr != NULL) strcpy(serr, "error in function load_fixstar_lines(): could not allocate fixed stars memory");
+	free_fixstar_lines();
+	return ERR;
       }
-      return ERR;
-    } 
-    // search string is Bayer or Flamsteed designation
-    if (is_bayer) {
-      if (strncmp(sp, sstar, cmplen) == 0) {
-        goto found;
-      } else {
-        continue;
+      swed.fixstar_lines = lp;
+    }
+    lp = swed.fixstar_lines + swed.n_fixstar_lines;
+    memset((void *) lp, 0, sizeof(struct fixstar_line));
+    swed.n_fixstar_lines++;
+    lp->fline = fline;
+    // invalid line without comma, kept for error messages
+    if ((sp = strchr(s, ',')) == NULL || fixstar_cut_string(s, NULL, &lp->sd, NULL) == ERR) {
+      if ((lp->srecord = strdup(s)) == NULL) {
+	if (serr != NULL) strcpy(serr, "error in function load_fixstar_lines(): could not allocate fixed stars memory");
+	free_fixstar_lines();
+	return ERR;
       }
+      if (sp == NULL)
+	continue;
     }
-    // search string is traditional name
-    *sp = '\0';	/* cut off after first field to get star name, ',' -> '\0' */
-    //slen = swi_strnlen(s, SE_MAX_STNAME);
-    slen = strlen(s);
+    // Bayer or Flamsteed designation: compared with the line from its first comma
+    strncpy(lp->stail, sp, SWI_STAR_LENGTH);
+    // traditional name: first field without white spaces, in lower case
+    slen = (size_t) (sp - s);
     if (slen > SE_MAX_STNAME) slen = SE_MAX_STNAME;
     memcpy(fstar, s, slen);
-    fstar[slen] = '\0';  /* force termination */
-    *sp = ',';  /* add comma again */
-    //fstar[SWI_STAR_LENGTH] = '\0';	/* force termination */
-    // remove white spaces from star name
+    fstar[slen] = '\0';
     while ((sp = strchr(fstar, ' ')) != NULL)
       swi_strcpy(sp, sp+1);
-    i = (int) strlen(fstar);
-    // length of star name differs from length of search string: continue
-    if (i < (int) cmplen)
-      continue;
-    // star name to lowercase and compare with search string
-    for (sp2 = fstar; *sp2 != '\0'; sp2++) {
-      *sp2 = tolower((int) *sp2);
+    for (sp = fstar; *sp != '\0'; sp++) 
+      *sp = tolower((int) *sp);
+    fstar[SWI_STAR_LENGTH] = '\0';
+    strcpy(lp->sd.skey, fstar);
+  }
+  return OK;
+}
+
+/* star name as written by fixstar_cut_string(): traditional name and,
+ * if there is room, Bayer designation 
+ */
+static void fixstar_line_name(struct fixed_star *stardata, char *star)
+{
+  strcpy(star, stardata->starname);
+  if (strlen(stardata->starname) + strlen(stardata->starbayer) + 1 < SWI_STAR_LENGTH - 1)
+    sprintf(star + strlen(star), ",%s", stardata->starbayer);
+}
+
+static struct fixstar_memo *fixstar_memo_slot(char *sstar)
+{
+  uint32 h = 2166136261u;
+  char *sp;
+  struct fixstar_memo *mp;
+  for (sp = sstar; *sp != '\0'; sp++)
+    h = (h ^ (unsigned char) *sp) * 16777619u;
+  for (;; h++) {
+    mp = swed.fixstar_memo + (h & (SEI_FIXSTAR_NMEMO - 1));
+    if (*mp->sstar == '\0' || strcmp(mp->sstar, sstar) == 0)
+      return mp;
+  }
+}
+
+/* function finds a star in the lines of the fixed stars file, 
+ * with the same rules as a scan of the file: 
+ * - a number is the sequential number of the line, comments not counted
+ * - a Bayer designation ',xxx' matches the first line with a 
+ *   designation that begins with it
+ * - a traditional name matches the first line with a name that 
+ *   begins with it.
+ * sstar is the search name from fixstar_format_search_name(), with
+ * the Bayer designation cut off for traditional names.
+ * Names found once are remembered in swed.fixstar_memo, so that 
+ * switching between stars does not search the lines again.
+ */
+static int32 fixstar_search_line(char *star, char *sstar, struct fixed_star *stardata, char *serr)
+{
+  int32 i, iline = -1, star_nr = 0;
+  AS_BOOL is_bayer = FALSE;
+  size_t cmplen = strlen(sstar);
+  struct fixstar_line *lp;
+  struct fixstar_memo *mp;
+  if (load_fixstar_lines(serr) == ERR)
+    return ERR;
+  mp = fixstar_memo_slot(sstar);
+  if (*mp->sstar != '\0') {
+    *stardata = swed.fixstar_lines[mp->iline].sd;
+    return OK;
+  }
+  if (*sstar == ',')
+    is_bayer = TRUE;
+  else if (isdigit((int) *sstar))
+    star_nr = atoi(sstar);
+  if (star_nr > 0) {
+    if (star_nr <= swed.n_fixstar_lines)
+      iline = star_nr - 1;
+  } else {
+    for (i = 0, lp = swed.fixstar_lines; i < swed.n_fixstar_lines; i++, lp++) {
+      if (*lp->stail == '\0') {
+	if (serr != NULL) 
+	  sprintf(serr, "star file %s damaged at line %d", SE_STARFILE, lp->fline);
+	return ERR;
+      }
+      if (strncmp(is_bayer ? lp->stail : lp->sd.skey, sstar, cmplen) == 0) {
+	iline = i;
+	break;
+      }
     }
-    if (strncmp(fstar, sstar, cmplen) == 0) 
-      goto found;
   }
-  if (serr != NULL) {
-    sprintf(serr, "star  not found");
-    if (strlen(serr) + strlen(star) < AS_MAXCH) {
-      sprintf(serr, "star %s not found", star);
+  if (iline < 0) {
+    if (serr != NULL) {
+      sprintf(serr, "star  not found");
+      if (strlen(serr) + strlen(star) < AS_MAXCH) {
+	sprintf(serr, "star %s not found", star);
+      }
     }
     return ERR;
   }
-  found:
-  strcpy(srecord, s);
-  retc = fixstar_cut_string(srecord, star, &stardata, serr);
-  if (retc == ERR) return ERR;
-  if (dparams != NULL) {
-    dparams[0] = stardata.epoch; // epoch
-    // RA(epoch)
-    dparams[1] = stardata.ra;
-    // Decl(epoch)
-    dparams[2] = stardata.de;
-    // RA proper motion
-    dparams[3] = stardata.ramot;
-    // decl proper motion
-    dparams[4] = stardata.demot;
-    // radial velocity
-    dparams[5] = stardata.radvel;
-    // parallax
-    dparams[6] = stardata.parall;
-    // magnitude V
-    dparams[7] = stardata.mag;
-  }
+  lp = swed.fixstar_lines + iline;
+  if (lp->srecord != NULL)
+    return fixstar_cut_string(lp->srecord, NULL, stardata, serr);
+  *stardata = lp->sd;
+  if (swed.n_fixstar_memo >= SEI_FIXSTAR_NMEMO / 2) {
+    memset((void *) swed.fixstar_memo, 0, SEI_FIXSTAR_NMEMO * sizeof(struct fixstar_memo));
+    swed.n_fixstar_memo = 0;
+    mp = fixstar_memo_slot(sstar);
+  }
+  strcpy(mp->sstar, sstar);
+  mp->iline = iline;
+  swed.n_fixstar_memo++;
   return OK;
 }
 
-/* function calculates a fixstar from a record from sefstars.txt
- * input:
- * char *srecord     fixed star data record from sefstars.txt
- * double tjd        julian daynumber 
- * int32 iflag       SEFLG_ specifications
- * output:
- * char *star        star name, Bayer designation
- * double xx[6]      position and speed
- * char *serr        error return string
- */
-static int32 swi_fixstar_calc_from_record(char *srecord, double tjd, int32 iflag, char *star, double *xx, char *serr)
-{
-  int i;
-  int32 retc = OK;
-  double epoch, radv, parall;
-  double ra_pm, de_pm, ra, de, t;
-  struct fixed_star stardata;
-  double daya, rdist;
-  double x[6], xxsv[6], xobs[6], xobs_dt[6], *xpo = NULL, *xpo_dt = NULL;
-  static TLS double xearth[6], xearth_dt[6], xsun[6], xsun_dt[6];
-  double dt = PLAN_SPEED_INTV * 0.1;
-  int32 epheflag, iflgsave;
-  // char s[AS_MAXCH];
-  struct epsilon *oe = &swed.oec2000;
-  iflgsave = iflag;
-  iflag |= SEFLG_SPEED; /* we need this in order to work correctly */
-  if (serr != NULL)
-    *serr = '\0';
-  iflag = plaus_iflag(iflag, -1, tjd, serr);
-  epheflag = iflag & SEFLG_EPHMASK;
-  if (swi_init_swed_if_start() == 1 && !(epheflag & SEFLG_MOSEPH) && serr != NULL) {
-    strcpy(serr, "Please call swe_set_ephe_path() or swe_set_jplfile() before calling swe_fixstar() or swe_fixstar_ut()");
-  }
-  if (swed.last_epheflag != epheflag) {
-    free_planets();
-    /* close and free ephemeris files */
-    if (swed.jpl_file_is_open) {
-      swi_close_jpl_file();
-      swed.jpl_file_is_open = FALSE;
-    }
-    for (i = 0; i < SEI_NEPHFILES; i ++) {
-      if (swed.fidat[i].fptr != NULL) 
-	fclose(swed.fidat[i].fptr);
-      memset((void *) &swed.fidat[i], 0, sizeof(struct file_data));
-    }
-    swed.last_epheflag = epheflag;
-  }
-  /* high precision speed prevails fast speed */
-  /* JPL Horizons is only reproduced with SEFLG_JPLEPH */
-  if (iflag & SEFLG_SIDEREAL && !swed.ayana_is_set)
-    swe_set_sid_mode(SE_SIDM_FAGAN_BRADLEY, 0, 0);
-  /****************************************** 
-   * obliquity of ecliptic 2000 and of date * 
-   ******************************************/
-  swi_check_ecliptic(tjd, iflag);
-  /******************************************
-   * nutation                               * 
-   ******************************************/
-  swi_check_nutation(tjd, iflag);
-  retc = fixstar_cut_string(srecord, star, &stardata, serr);
-  if (retc == ERR) return ERR;
-  epoch = stardata.epoch;
-  ra_pm = stardata.ramot; de_pm = stardata.demot;
-  radv = stardata.radvel; parall = stardata.parall; 
-  ra = stardata.ra; de = stardata.de;
-  if (epoch == 1950) {
-    t= (tjd - B1950);	/* days since 1950.0 */
-  } else { /* epoch == 2000 */
-    t= (tjd - J2000);	/* days since 2000.0 */
-  }
-  x[0] = ra;
-  x[1] = de;
-  x[2] = 1;	
-  if (parall == 0) {
-    rdist = 1000000000;  
-  } else {
-    rdist = 1.0 / (parall * RADTODEG * 3600) * PARSEC_TO_AUNIT;	
-    //rdist += t * radv / 36525.0;
-  }
-// rdist = 10000;  // to reproduce pre-SE2.07 star positions
-  x[2] = rdist;
-  x[3] = ra_pm / 36525.0;
-  x[4] = de_pm / 36525.0;
-  x[5] = radv / 36525.0;
-  // Cartesian space motion vector
-  swi_polcart_sp(x, x);
-  /******************************************
-   * FK5
-   ******************************************/
-  if (epoch == 1950) {
-    swi_FK4_FK5(x, B1950);
-    swi_precess(x, B1950, 0, J_TO_J2000);
-    swi_precess(x+3, B1950, 0, J_TO_J2000);
-  } 
-  /* FK5 to ICRF, if jpl ephemeris is referred to ICRF.
-   * With data that are already ICRF, epoch = 0 */
-  if (epoch != 0) {
-    swi_icrs2fk5(x, iflag, TRUE); /* backward, i. e. to icrf */
-    /* with ephemerides < DE403, we now convert to J2000 */
-    if (swi_get_denum(SEI_SUN, iflag) >= 403) {
-      swi_bias(x, J2000, SEFLG_SPEED, FALSE);
-    }
-  }
-  /**************************************************** 
-   * earth/sun 
-   * for parallax, light deflection, and aberration,
-   ****************************************************/
-  if (!(iflag & SEFLG_BARYCTR) && (!(iflag & SEFLG_HELCTR) || !(iflag & SEFLG_MOSEPH))) {
-    if ((retc =  main_planet_bary(tjd - dt, SEI_EARTH, epheflag, iflag, NO_SAVE, xearth_dt, xearth_dt, xsun_dt, NULL, serr)) != OK) {
-      return ERR;
-    }
-    if ((retc =  main_planet_bary(tjd, SEI_EARTH, epheflag, iflag, DO_SAVE, xearth, xearth, xsun, NULL, serr)) != OK) {
-      return ERR;
-    }
-  }
-  /************************************
-   * observer: geocenter or topocenter
-   ************************************/
-  /* if topocentric position is wanted  */
-  if (iflag & SEFLG_TOPOCTR) { 
-    if (swi_get_observer(tjd - dt, iflag | SEFLG_NONUT, NO_SAVE, xobs_dt, serr) != OK)
-      return ERR;
-    if (swi_get_observer(tjd, iflag | SEFLG_NONUT, NO_SAVE, xobs, serr) != OK)
-      return ERR;
-    /* barycentric position of observer */
-    for (i = 0; i <= 5; i++) {
-      xobs[i] = xobs[i] + xearth[i];	
-      xobs_dt[i] = xobs_dt[i] + xearth_dt[i];	
-    }
-  } else if (!(iflag & SEFLG_BARYCTR) && (!(iflag & SEFLG_HELCTR) || !(iflag & SEFLG_MOSEPH))) {
-    /* barycentric position of geocenter */
-    for (i = 0; i <= 5; i++) {
-      xobs[i] = xearth[i];
-      xobs_dt[i] = xearth_dt[i];
-    }
-  }
-  /************************************
-   * position and speed at tjd        *
-   ************************************/
-  /* for parallax */ 
-  if ((iflag & SEFLG_HELCTR) && (iflag & SEFLG_MOSEPH)) {
-    xpo = NULL;		/* no parallax, if moshier and heliocentric */
-    xpo_dt = NULL;	/* no parallax, if moshier and heliocentric */
-  } else if (iflag & SEFLG_HELCTR) {
-    xpo = xsun;//psdp->x;
-    xpo_dt = xsun_dt; 
-  } else if (iflag & SEFLG_BARYCTR) {
-    xpo = NULL;		/* no parallax, if barycentric */
-    xpo_dt = NULL;	/* no parallax, if moshier and heliocentric */
-  } else {
-    xpo = xobs;
-    xpo_dt = xobs_dt;
-  }
-  if (xpo == NULL) {
-    for (i = 0; i <= 2; i++) {
-      x[i] += t * x[i+3];	
-    }
-  } else {
-    for (i = 0; i <= 2; i++) {
-      x[i] += t * x[i+3];
-      x[i] -= xpo[i];
-      x[i+3] -= xpo[i+3];
-    }
-    // rdist of date
-    //rdist = sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
-    // parallax of date
-    //parall = PARSEC_TO_AUNIT / rdist / RADTODEG / 3600.0;
-  }
-  /************************************
-   * relativistic deflection of light *
-   ************************************/
-  if ((iflag & SEFLG_TRUEPOS) == 0 && (iflag & SEFLG_NOGDEFL) == 0) {
-    swi_deflect_light(x, 0, iflag & SEFLG_SPEED);
-  }
-  /**********************************
-   * 'annual' aberration of light   *
-   * speed is incorrect !!!         *
-   **********************************/
-  if ((iflag & SEFLG_TRUEPOS) == 0 && (iflag & SEFLG_NOABERR) == 0)
-    swi_aberr_light_ex(x, xpo, xpo_dt, dt, iflag & SEFLG_SPEED);
-  /* ICRS to J2000 */
-  if (!(iflag & SEFLG_ICRS) && (swi_get_denum(SEI_SUN, iflag) >= 403 || (iflag & SEFLG_BARYCTR))) {
-    swi_bias(x, tjd, iflag, FALSE);
-  }/**/
-  /* save J2000 coordinates; required for sidereal positions */
-  for (i = 0; i <= 5; i++)
-    xxsv[i] = x[i];
-  /************************************************
-   * precession, equator 2000 -> equator of date *
-   ************************************************/
-  /*x[0] = -0.374018403; x[1] = -0.312548592; x[2] = -0.873168719;*/
-  if ((iflag & SEFLG_J2000) == 0) {
-    swi_precess(x, tjd, iflag, J2000_TO_J);
-    if (iflag & SEFLG_SPEED) {
-      swi_precess_speed(x, tjd, iflag, J2000_TO_J);
-    }
-    oe = &swed.oec;
-  } else {
-    oe = &swed.oec2000;
-  }
-  /************************************************
-   * nutation                                     *
-   ************************************************/
-  if (!(iflag & SEFLG_NONUT))
-    swi_nutate(x, iflag, FALSE);
-if ((0)) {
-  double r = sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
-  printf("%.17f %.17f %f\n", x[0]/r, x[1]/r, x[2]/r);
-}
-  /************************************************
-   * transformation to ecliptic.                  *
-   * with sidereal calc. this will be overwritten *
-   * afterwards.                                  *
-   ************************************************/
-  if ((iflag & SEFLG_EQUATORIAL) == 0) {
-    swi_coortrf2(x, x, oe->seps, oe->ceps);
-    if (iflag & SEFLG_SPEED)
-      swi_coortrf2(x+3, x+3, oe->seps, oe->ceps);
-    if (!(iflag & SEFLG_NONUT)) {
-      swi_coortrf2(x, x, swed.nut.snut, swed.nut.cnut);
-      if (iflag & SEFLG_SPEED)
-	swi_coortrf2(x+3, x+3, swed.nut.snut, swed.nut.cnut);
-    }
-  }
-  /************************************
-   * sidereal positions               *
-   ************************************/
-  if (iflag & SEFLG_SIDEREAL) {
-    /* rigorous algorithm */
-    if (swed.sidd.sid_mode & SE_SIDBIT_ECL_T0) {
-      if (swi_trop_ra2sid_lon(xxsv, x, xxsv, iflag) != OK)
-        return ERR;
-      if (iflag & SEFLG_EQUATORIAL) {
-        for (i = 0; i <= 5; i++)
-          x[i] = xxsv[i];
-      }
-    /* project onto solar system equator */
-    } else if (swed.sidd.sid_mode & SE_SIDBIT_SSY_PLANE) {
-      if (swi_trop_ra2sid_lon_sosy(xxsv, x, iflag) != OK)
-	return ERR;
-      if (iflag & SEFLG_EQUATORIAL) {
-        for (i = 0; i <= 5; i++)
-          x[i] = xxsv[i];
-      }
-    /* traditional algorithm */
-    } else {
-      swi_cartpol_sp(x, x); 
-      if (swi_get_ayanamsa_ex(tjd, iflag, &daya, serr) == ERR)
-        return ERR;
-      x[0] -= daya * DEGTORAD;
-      swi_polcart_sp(x, x); 
-    }
-  } 
-  /************************************************
-   * transformation to polar coordinates          *
-   ************************************************/
-  if ((iflag & SEFLG_XYZ) == 0)
-    swi_cartpol_sp(x, x); 
-  /********************** 
-   * radians to degrees *
-   **********************/
-  if ((iflag & SEFLG_RADIANS) == 0 && (iflag & SEFLG_XYZ) == 0) {
-    for (i = 0; i < 2; i++) {
-      x[i] *= RADTODEG;
-      x[i+3] *= RADTODEG;
-    }
-  }
-  for (i = 0; i <= 5; i++)
-    xx[i] = x[i];
-  if (!(iflgsave & SEFLG_SPEED)) {
-    iflag = iflag & ~SEFLG_SPEED;
-    for (i = 3; i <= 5; i++)
-      xx[i] = 0;
-  }
-  /* if no ephemeris has been specified, do not return chosen ephemeris */
-  if ((iflgsave & SEFLG_EPHMASK) == 0)
-    iflag = iflag & ~SEFLG_DEFAULTEPH;
-  return iflag;
-}
-
 /**********************************************************
  * get fixstar positions
  * parameters:
@@ -7898,10 +8098,11 @@ int32 CALL_CONV swe_fixstar(char *star, double tjd, int32 iflag,
 {
   int i;
   char sstar[SWI_STAR_LENGTH + 1];
-  static TLS char slast_stardata[AS_MAXCH];
   static TLS char slast_starname[AS_MAXCH];
+  static TLS struct fixed_star last_stardata;
   char srecord[AS_MAXCH + 20], *sp;	/* 20 byte for SE_STARFILE */
   int retc;
+  struct fixed_star stardata;
   if (serr != NULL)
     *serr = '\0';
 #ifdef TRACE
@@ -7920,11 +8121,13 @@ int32 CALL_CONV swe_fixstar(char *star, double tjd, int32 iflag,
       *sp = '\0';
   }
   /* star elements from last call: */
-  if (*slast_stardata != '\0' && strcmp(slast_starname, sstar) == 0) {
-    strcpy(srecord, slast_stardata);
+  if (*slast_starname != '\0' && strcmp(slast_starname, sstar) == 0) {
+    stardata = last_stardata;
     goto found;
   }
   if (get_builtin_star(star, sstar, srecord)) {
+    if ((retc = fixstar_cut_string(srecord, NULL, &stardata, serr)) == ERR)
+      goto return_err;
     goto found;
   }
   /******************************************************
@@ -7933,13 +8136,16 @@ int32 CALL_CONV swe_fixstar(char *star, double tjd, int32 iflag,
    * These can be accessed by giving their number instead of a name.
    * All other stars can be accessed by name.
    * Comment lines start with # and are ignored.
+   * The file is read only once, see fixstar_search_line().
    ******************************************************/
-  if ((retc = swi_fixstar_load_record(star, srecord, NULL, NULL, NULL, serr)) != OK)
+  if ((retc = fixstar_search_line(star, sstar, &stardata, serr)) != OK)
     goto return_err;
   found:
-  strcpy(slast_stardata, srecord);
+  last_stardata = stardata;
   strcpy(slast_starname, sstar);
-  if ((retc = swi_fixstar_calc_from_record(srecord, tjd, iflag, star, xx, serr)) == ERR)
+  retc = fixstar_calc_from_struct(&stardata, tjd, iflag, star, xx, serr);
+  fixstar_line_name(&stardata, star);
+  if (retc == ERR)
     goto return_err;
 #ifdef TRACE
   trace_swe_fixstar(2, star, tjd, iflag, xx, serr);
@@ -7990,12 +8196,11 @@ int32 CALL_CONV swe_fixstar_ut(char *star, double tjd_ut, int32 iflag,
 int32 CALL_CONV swe_fixstar_mag(char *star, double *mag, char *serr)
 {
   char sstar[SWI_STAR_LENGTH + 1];
-  static TLS char slast_stardata[AS_MAXCH];
   static TLS char slast_starname[AS_MAXCH];
-  char srecord[AS_MAXCH + 20], *sp;	/* 20 byte for SE_STARFILE */
+  static TLS struct fixed_star last_stardata;
+  char *sp;
   struct fixed_star stardata;
   int retc;
-  double dparams[20];
   if (serr != NULL)
     *serr = '\0';
   retc = fixstar_format_search_name(star, sstar, serr);
@@ -8010,27 +8215,21 @@ int32 CALL_CONV swe_fixstar_mag(char *star, double *mag, char *serr)
       *sp = '\0';
   }
   /* star elements from last call: */
-  if (*slast_stardata != '\0' && strcmp(slast_starname, sstar) == 0) {
-    strcpy(srecord, slast_stardata);
-    retc = fixstar_cut_string(srecord, star, &stardata, serr);
-    if (retc == ERR) goto return_err;
-    // magnitude V
-    dparams[7] = stardata.mag;
+  if (*slast_starname != '\0' && strcmp(slast_starname, sstar) == 0) {
+    stardata = last_stardata;
     goto found;
   }
   /******************************************************
-   * Star file
-   * close to the beginning, a few stars selected by Astrodienst.
-   * These can be accessed by giving their number instead of a name.
-   * All other stars can be accessed by name.
-   * Comment lines start with # and are ignored.
+   * Star file, read only once, see fixstar_search_line()
    ******************************************************/
-  if ((retc = swi_fixstar_load_record(star, srecord, NULL, NULL, dparams, serr)) != OK)
+  if ((retc = fixstar_search_line(star, sstar, &stardata, serr)) != OK)
     goto return_err;
   found:
-  strcpy(slast_stardata, srecord);
+  last_stardata = stardata;
   strcpy(slast_starname, sstar);
-  *mag = dparams[7];
+  fixstar_line_name(&stardata, star);
+  // magnitude V
+  *mag = stardata.mag;
   return OK;
   return_err:
   *mag = 0;
@@ -8039,30 +8238,41 @@ int32 CALL_CONV swe_fixstar_mag(char *star, double *mag, char *serr)
 
 #endif
 
-int32 CALL_CONV swe_calc_pctr(double tjd, int32 ipl, int32 iplctr, int32 iflag, double *xxret, char *serr) 
+/* flags for the barycentric J2000 states used by swe_calc_pctr() */
+static int32 pctr_state_flags(int32 iflag)
+{
+  int32 iflag2 = iflag & SEFLG_EPHMASK;
+  iflag2 |= (SEFLG_BARYCTR|SEFLG_J2000|SEFLG_ICRS|SEFLG_TRUEPOS|SEFLG_EQUATORIAL|SEFLG_XYZ|SEFLG_SPEED);
+  iflag2 |= (SEFLG_NOABERR|SEFLG_NOGDEFL);
+  return iflag2;
+}
+
+/* centre body of swe_calc_pctr(): fills in obliquity and nutation 
+ * and computes the barycentric state xxctr of iplctr at tjd.
+ * iflag has been checked by plaus_iflag(). */
+static int32 pctr_centre(double tjd, int32 iplctr, int32 iflag, double *xxctr, char *serr)
+{
+  double xx[6];
+  int32 epheflag = iflag & SEFLG_EPHMASK;
+  // this fills in obliquity and nutation values in swed
+  swe_calc(tjd + swe_deltat_ex(tjd, epheflag, serr), SE_ECL_NUT, iflag, xx, serr);
+  return swe_calc(tjd, iplctr, pctr_state_flags(iflag), xxctr, serr);
+}
+
+/* target body of swe_calc_pctr() as seen from the centre, whose 
+ * barycentric state at tjd is xxctr. If xxctr1 (the centre at tjd - 1) 
+ * is given, the velocity of the centre at the time of light emission is 
+ * interpolated, otherwise the centre is computed for that time. */
+static int32 pctr_target(double tjd, int32 ipl, int32 iplctr, int32 iflag, double *xxctr, double *xxctr1, double *xxret, char *serr)
 {
   double t = 0, dt, daya[2], dtsave_for_defl = 0;
-  double xx[6], xxctr[6], xxctr2[6], xx0[6], xxsv[24], xxsp[6], dx[6], xreturn[24];
+  double xx[6], xxctr2[6], xx0[6], xxsv[24], xxsp[6], dx[6], xreturn[24];
   double *xs;
   int i, j, niter;
   int32 iflag2, epheflag, retc;
   struct epsilon *oe;
-  if (ipl == iplctr) {
-    if (serr != NULL) 
-	  sprintf(serr, "ipl and iplctr (= %d) must not be identical\n", ipl);
-	return ERR;
-  }
-  iflag = plaus_iflag(iflag, ipl, tjd, serr);
   epheflag = iflag & SEFLG_EPHMASK;
-  // this fills in obliquity and nutation values in swed
-  swe_calc(tjd + swe_deltat_ex(tjd, epheflag, serr), SE_ECL_NUT, iflag, xx, serr);
-  iflag &= ~(SEFLG_HELCTR|SEFLG_BARYCTR);
-  iflag2 = epheflag;
-  iflag2 |= (SEFLG_BARYCTR|SEFLG_J2000|SEFLG_ICRS|SEFLG_TRUEPOS|SEFLG_EQUATORIAL|SEFLG_XYZ|SEFLG_SPEED);
-  iflag2 |= (SEFLG_NOABERR|SEFLG_NOGDEFL);
-  retc = swe_calc(tjd, iplctr, iflag2, xxctr, serr);
-  if (retc == ERR) 
-    return ERR;
+  iflag2 = pctr_state_flags(iflag);
   retc = swe_calc(tjd, ipl, iflag2, xx, serr);
   if (retc == ERR) 
     return ERR;
@@ -8120,7 +8330,12 @@ int32 CALL_CONV swe_calc_pctr(double tjd, int32 ipl, int32 iplctr, int32 iflag,
       for (i = 0; i <= 2; i++) 
         xxsp[i] = xx0[i] - xx[i] - xxsp[i];
     }
-    retc = swe_calc(t, iplctr, iflag2, xxctr2, serr);
+    if (xxctr1 != NULL) {
+      for (i = 3; i <= 5; i++)
+        xxctr2[i] = xxctr[i] - dt * (xxctr[i] - xxctr1[i]) / PLAN_SPEED_INTV;
+    } else {
+      retc = swe_calc(t, iplctr, iflag2, xxctr2, serr);
+    }
     retc = swe_calc(t, ipl, iflag2, xx, serr);
   }
   /*******************************
@@ -8282,6 +8497,63 @@ int32 CALL_CONV swe_calc_pctr(double tjd, int32 ipl, int32 iplctr, int32 iflag,
   return(iflag);
 }
 
+int32 CALL_CONV swe_calc_pctr(double tjd, int32 ipl, int32 iplctr, int32 iflag, double *xxret, char *serr) 
+{
+  double xxctr[6];
+  if (ipl == iplctr) {
+    if (serr != NULL) 
+	  sprintf(serr, "ipl and iplctr (= %d) must not be identical\n", ipl);
+	return ERR;
+  }
+  iflag = plaus_iflag(iflag, ipl, tjd, serr);
+  if (pctr_centre(tjd, iplctr, iflag, xxctr, serr) == ERR)
+    return ERR;
+  return pctr_target(tjd, ipl, iplctr, iflag & ~(SEFLG_HELCTR|SEFLG_BARYCTR), xxctr, NULL, xxret, serr);
+}
+
+/* 
+ * swe_calc_pctr_multi()
+ * Positions of the n bodies ipl[0..n-1] as seen from the body iplctr,
+ * as swe_calc_pctr(tjd, ipl[k], iplctr, iflag, xxret + 6 * k, serr)
+ * would return them. Obliquity, nutation and the state of the centre
+ * are computed once. The speed correction for the aberration needs the 
+ * velocity of the centre at the time the light left each body; it is 
+ * extrapolated from the centre at tjd and tjd - PLAN_SPEED_INTV instead
+ * of computing the centre again for every body. Positions are the same 
+ * as with swe_calc_pctr(); speeds differ by up to 5e-8 degrees/day 
+ * (Neptune and Pluto seen from Mars, about 0.2 days of light-time).
+ * 
+ * xxret must hold 6 * n doubles. Returns the flags of the last body or ERR.
+ */
+int32 CALL_CONV swe_calc_pctr_multi(double tjd, int32 iplctr, const int32 *ipl, int32 n, int32 iflag, double *xxret, char *serr)
+{
+  int32 k, iflagk, iflag_ctr = 0, retflag = OK;
+  double xxctr[6], xxctr1[6], *px1 = NULL;
+  for (k = 0; k < n; k++) {
+    if (ipl[k] == iplctr) {
+      if (serr != NULL) 
+	sprintf(serr, "ipl and iplctr (= %d) must not be identical\n", ipl[k]);
+      return ERR;
+    }
+    iflagk = plaus_iflag(iflag, ipl[k], tjd, serr);
+    if (k == 0 || iflagk != iflag_ctr) {
+      if (pctr_centre(tjd, iplctr, iflagk, xxctr, serr) == ERR)
+	return ERR;
+      px1 = NULL;
+      if ((iflagk & SEFLG_SPEED) && !(iflagk & SEFLG_NOABERR)) {
+	if (swe_calc(tjd - PLAN_SPEED_INTV, iplctr, pctr_state_flags(iflagk), xxctr1, serr) == ERR)
+	  return ERR;
+	px1 = xxctr1;
+      }
+      iflag_ctr = iflagk;
+    }
+    retflag = pctr_target(tjd, ipl[k], iplctr, iflagk & ~(SEFLG_HELCTR|SEFLG_BARYCTR), xxctr, px1, xxret + 6 * k, serr);
+    if (retflag == ERR)
+      return ERR;
+  }
+  return retflag;
+}
+
 // returns data from internal file structures sweph.fidat
 // used in last call to swe_calc() or swe_fixstar()
 // ifno = 0     planet file sepl_xxx, used for Sun .. Pluto, or jpl file
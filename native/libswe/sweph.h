@@ -769,6 +769,21 @@ struct sid_data {
   AS_BOOL t0_is_UT;
 };
 
+/* ayanamsa values already computed, see swi_get_ayanamsa_ex() */
+#define SEI_NAYA_CACHE 8
+struct aya_cache {
+  AS_BOOL is_valid;
+  double tjd;
+  int32 iflag;
+  struct sid_data sidd;
+  int32 astro_models[SEI_NMODELS];
+  double tid_acc;
+  AS_BOOL delta_t_userdef_is_set;
+  double delta_t_userdef;
+  double daya;
+  int32 retflag;
+};
+
 #define SWI_STAR_LENGTH 40
 struct fixed_star {
   char skey[SWI_STAR_LENGTH + 2]; // may be prefixed with comma, one char more
@@ -778,6 +793,22 @@ struct fixed_star {
   double epoch, ra, de, ramot, demot, radvel, parall, mag;
 };
 
+/* a line of the fixed stars file in file order, as searched by swe_fixstar() */
+struct fixstar_line {
+  struct fixed_star sd;	// sd.skey: traditional name in lower case, without blanks
+  char stail[SWI_STAR_LENGTH + 1]; // line from its first comma, for Bayer searches
+  int32 fline;		// line number in file, for error messages
+  char *srecord;	// the line itself, only if it has no comma or cannot be parsed
+};
+
+/* search names remembered by swe_fixstar(); must be a power of 2 */
+#define SEI_FIXSTAR_NMEMO	512
+
+struct fixstar_memo {
+  char sstar[SWI_STAR_LENGTH + 1];
+  int32 iline;
+};
+
 /* dpsi and deps loaded for 100 years after 1962 */
 #define SWE_DATA_DPSI_DEPS  36525   
 
@@ -844,6 +875,12 @@ struct swe_data {
   AS_BOOL n_fixstars_named;  // number of fixed stars with tradtional name
   AS_BOOL n_fixstars_records;// number of fixed stars records in fixed_stars
   struct fixed_star *fixed_stars;
+  struct aya_cache ayac[SEI_NAYA_CACHE];
+  int iayac;		/* next slot to replace in ayac[] */
+  struct fixstar_line *fixstar_lines; /* sefstars.txt in file order, for swe_fixstar() */
+  int32 n_fixstar_lines;
+  struct fixstar_memo *fixstar_memo; /* search name -> index in fixstar_lines */
+  int32 n_fixstar_memo;
 };
 
 extern TLS struct swe_data swed;
@@ -370,6 +370,10 @@ extern "C" {
 #define SE_TRUE_TO_APP	0
 #define SE_APP_TO_TRUE	1
 
+/* for swe_set_refrac_table() */
+#define SE_REFRAC_EXACT	0
+#define SE_REFRAC_TABLE	1
+
 /*
  * only used for experimenting with various JPL ephemeris files
  * which are available at Astrodienst's internal network
@@ -707,7 +711,15 @@ ext_def( int32 ) swe_calc(
 ext_def(int32) swe_calc_ut(double tjd_ut, int32 ipl, int32 iflag, 
 	double *xx, char *serr);
 
+ext_def(int32) swe_calc_ut_multi_sid(double tjd_ut, int32 ipl, int32 iflag, 
+	const int32 *sid_modes, int32 n, double *xx, char *serr);
+
+ext_def(int32) swe_calc_topo_batch(double tjd_ut, int32 ipl, int32 iflag, 
+	const double *geopos, int32 n, double *xx, char *serr);
+
 ext_def(int32) swe_calc_pctr(double tjd, int32 ipl, int32 iplctr, int32 iflag, double *xxret, char *serr);
+ext_def(int32) swe_calc_pctr_multi(double tjd, int32 iplctr, const int32 *ipl, int32 n, int32 iflag, 
+	double *xxret, char *serr);
 
 ext_def(double) swe_solcross(double x2cross, double jd_et, int32 flag, char *serr);
 ext_def(double) swe_solcross_ut(double x2cross, double jd_ut, int32 flag, char *serr);
@@ -767,6 +779,66 @@ ext_def(double) swe_get_ayanamsa_ut(double tjd_ut);
 ext_def(const char *) swe_get_ayanamsa_name(int32 isidmode);
 ext_def(const char *) swe_get_current_file_data(int ifno, double *tfstart, double *tfend, int *denum);
 
+/* cross-process shared-memory cache (POSIX systems) */
+ext_def(int32) swe_set_shared_cache(const char *name, int32 size_mb, char *serr);
+ext_def(int32) swe_remove_shared_cache(const char *name, char *serr);
+ext_def(int32) swe_get_shared_cache_stats(int32 *stats);
+
+/* persistent result cache of eclipse, occultation, heliacal and
+ * Gauquelin searches (POSIX systems) */
+#define SE_RESCACHE_USE		1
+#define SE_RESCACHE_VERIFY	2	/* recompute hits and compare */
+ext_def(int32) swe_set_result_cache(const char *path, int32 size_mb, int32 mode, char *serr);
+ext_def(int32) swe_get_result_cache_stats(int32 *stats);
+
+/* precomputed index of global solar and lunar eclipses */
+#define SE_ECLIDX_SOLAR		1
+#define SE_ECLIDX_LUNAR		2
+ext_def(int32) swe_eclipse_index_build(const char *path, double tjd_start, double tjd_end, int32 ifl, char *serr);
+ext_def(int32) swe_eclipse_index_open(const char *path, char *serr);
+ext_def(int32) swe_eclipse_index_find(int32 kind, double tjd_start, int32 ifl, int32 ifltype, int32 backward, double *tret, double *geopos, double *attr, char *serr);
+ext_def(int32) swe_eclipse_index_range(int32 kind, double tjd1, double tjd2, int32 ifl, int32 ifltype, double *tmax, int32 *types, int32 nmax, char *serr);
+
+/* lunation catalogue: main phases with Brown lunation numbers, and the
+ * perigees and apogees of the Moon */
+#define SE_LUNIDX_APSIDES		1	/* build option: also apsides */
+#define SE_MOONPHASE_NEW		0
+#define SE_MOONPHASE_FIRST_QUARTER	1
+#define SE_MOONPHASE_FULL		2
+#define SE_MOONPHASE_LAST_QUARTER	3
+#define SE_MOONAPS_PERIGEE		1
+#define SE_MOONAPS_APOGEE		2
+ext_def(int32) swe_lunation_index_build(const char *path, double tjd_start, double tjd_end, int32 ifl, int32 options, char *serr);
+ext_def(int32) swe_lunation_index_open(const char *path, char *serr);
+ext_def(int32) swe_lunation_find(double tjd_ut, int32 ifl, double *tret, int32 *lunation, char *serr);
+ext_def(int32) swe_lunar_phase_range(double tjd1, double tjd2, int32 ifl, double *tret, int32 *phases, int32 nmax, char *serr);
+ext_def(int32) swe_lunar_apsides_find(double tjd_ut, int32 ifl, double *tret, double *dist, char *serr);
+
+/* index of ecliptic longitudes for fast crossing searches */
+ext_def(int32) swe_lon_index_build(const char *path, int32 ipl, double tjd_start, double tjd_end, int32 iflag, char *serr);
+ext_def(int32) swe_lon_index_open(const char *path, char *serr);
+ext_def(int32) swe_lon_crossings_ut(int32 ipl, double x2cross, double tjd1, double tjd2, int32 iflag, double *tret, int32 *dir, int32 nmax, char *serr);
+
+/* parans: simultaneous rising, setting and culmination of bodies */
+#define SE_PARAN_BODY_SIZE	16	/* doubles of body data */
+ext_def(int32) swe_paran_body(double tjd_ut, int32 ipl, char *star, int32 epheflag, int32 rsmi, double *body, char *serr);
+ext_def(int32) swe_parans(const double *bodies, int32 nbody, int32 nprimary, double geolon, const double *lats, int32 nlat, int32 events, double tolerance, int32 *ids, double *tret, int32 nmax, char *serr);
+
+/* primary directions */
+#define SE_SPECULUM_SIZE	16	/* doubles per row of a speculum */
+#define SE_SPECULUM_CHART	4	/* doubles of chart data */
+#define SE_SPEC_ANGLES		1	/* option: add ascendant and MC */
+#define SE_SPEC_ASC		-1	/* body numbers of the angles */
+#define SE_SPEC_MC		-2
+#define SE_DIR_DIRECT		1
+#define SE_DIR_CONVERSE		2
+#define SE_DIR_WEST		4
+ext_def(int32) swe_speculum(double tjd_ut, double geolon, double geolat, const int32 *ipl, int32 nbody, int32 iflag, int32 options, double *chart, double *spec, char *serr);
+ext_def(int32) swe_directions(const double *chart, const double *spec, int32 nspec, int32 hsys, const double *aspects, int32 naspect, int32 options, double maxarc, double *arcs, int32 *ids, int32 nmax, char *serr);
+
+/* aspect matrix of one chart against many */
+ext_def(int32) swe_aspect_matrix(const double *ref, int32 nref, const float *lon, int32 npoint, int32 ncharts, int32 c0, int32 c1, const double *asp, int32 naspect, double minscore, float *score, int32 *match, float *dev, int32 nmax, char *serr);
+
 /*ext_def(void) swe_set_timeout(int32 tsec);*/
 
 /**************************** 
@@ -889,12 +961,20 @@ ext_def (int32) swe_pheno(double tjd, int32 ipl, int32 iflag, double *attr, char
  
 ext_def(int32) swe_pheno_ut(double tjd_ut, int32 ipl, int32 iflag, double *attr, char *serr);
 
+ext_def(int32) swe_pheno_ut_series(double tjd_ut, double step, int32 n, int32 ipl, int32 iflag, double *attr, char *serr);
+
+ext_def(int32) swe_pheno_ut_planets(double tjd_ut, const int32 *ipl, int32 n, int32 iflag, double *attr, char *serr);
+
+ext_def(int32) swe_pheno_ut_extrema(double tjd_ut, double step, int32 n, int32 ipl, int32 iflag, int32 iattr, int32 sign, double *tret, double *xret, int32 nmax, char *serr);
+
 ext_def (double) swe_refrac(double inalt, double atpress, double attemp, int32 calc_flag);
 
 ext_def (double) swe_refrac_extended(double inalt, double geoalt, double atpress, double attemp, double lapse_rate, int32 calc_flag, double *dret);
 
 ext_def (void) swe_set_lapse_rate(double lapse_rate);
 
+ext_def (void) swe_set_refrac_table(int32 mode);
+
 ext_def (void) swe_azalt(
       double tjd_ut,
       int32 calc_flag,
@@ -911,6 +991,24 @@ ext_def (void) swe_azalt_rev(
       double *xin, 
       double *xout); 
 
+ext_def (void) swe_azalt_batch(
+      double tjd_ut,
+      int32 calc_flag,
+      double *geopos,
+      double atpress,
+      double attemp,
+      const double *xin,
+      int32 n,
+      double *xaz);
+
+ext_def (void) swe_azalt_rev_batch(
+      double tjd_ut,
+      int32 calc_flag,
+      double *geopos,
+      const double *xin,
+      int32 n,
+      double *xout);
+
 ext_def (int32) swe_rise_trans_true_hor(
                double tjd_ut, int32 ipl, char *starname, 
 	       int32 epheflag, int32 rsmi,
@@ -939,10 +1037,23 @@ ext_def (int32) swe_nod_aps_ut(double tjd_ut, int32 ipl, int32 iflag,
                       double *xnasc, double *xndsc, 
                       double *xperi, double *xaphe, 
                       char *serr);
+ext_def (int32) swe_nod_aps_ut_batch(const double *tjd_ut, int32 n, 
+                      const int32 *ipl, int32 nipl, int32 iflag, 
+                      int32  method,
+                      double *xnasc, double *xndsc, 
+                      double *xperi, double *xaphe, 
+                      char *serr);
+
 ext_def (int32) swe_get_orbital_elements(
   double tjd_et, int32 ipl, int32 iflag, double *dret, char *serr);
 
+ext_def (int32) swe_get_orbital_elements_ut_batch(
+  const double *tjd_ut, int32 n, const int32 *ipl, int32 nipl, int32 iflag, double *dret, char *serr);
+
 ext_def (int32) swe_orbit_max_min_true_distance(double tjd_et, int32 ipl, int32 iflag, double *dmax, double *dmin, double *dtrue, char *serr);
+ext_def (int32) swe_orbit_max_min_true_distance_ut_batch(
+  const double *tjd_ut, int32 n, const int32 *ipl, int32 nipl, int32 iflag, double *dret, char *serr);
+ext_def (void) swe_set_orbit_distance_cache(double window);
 
 /**************************** 
  * exports from swephlib.c 
@@ -956,10 +1067,14 @@ ext_def(double) swe_deltat_ex(double tjd, int32 iflag, char *serr);
 ext_def(int32) swe_time_equ(double tjd, double *te, char *serr);
 ext_def(int32) swe_lmt_to_lat(double tjd_lmt, double geolon, double *tjd_lat, char *serr);
 ext_def(int32) swe_lat_to_lmt(double tjd_lat, double geolon, double *tjd_lmt, char *serr);
+ext_def(int32) swe_time_equ_batch(const double *tjd_ut, int32 n, double *te, char *serr);
+ext_def(int32) swe_lmt_to_lat_batch(const double *tjd_lmt, int32 n, double geolon, double *tjd_lat, char *serr);
+ext_def(int32) swe_lat_to_lmt_batch(const double *tjd_lat, int32 n, double geolon, double *tjd_lmt, char *serr);
 
 /* sidereal time */
 ext_def( double ) swe_sidtime0(double tjd_ut, double eps, double nut);
 ext_def( double ) swe_sidtime(double tjd_ut);
+ext_def( void ) swe_sidtime_batch(const double *tjd_ut, int32 n, double *tsid);
 ext_def( void ) swe_set_interpolate_nut(AS_BOOL do_interpolate);
 
 /* coordinate transformation polar -> polar */
@@ -77,6 +77,7 @@
 #include "swephexp.h"
 #include "sweph.h"
 #include "swephlib.h"
+#include "sweshm.h"
 #if MSDOS
 # include <process.h>
 # define strdup _strdup
@@ -662,9 +663,18 @@ static void swi_cross_prod(double *a, double *b, double *x)
 #endif
 
 /* precession matrix */
+/* precession matrix of the last call; a calculation precesses the
+ * positions of several bodies (and their speeds) to the same date */
+static TLS double pmat_tjd_save = 0;
+static TLS double pmat_save[9];
+
 static void pre_pmat(double tjd, double *rp)
 {
   double peqr[3], pecl[3], v[3], w, eqx[3];
+  if (tjd == pmat_tjd_save && tjd != 0) {
+    memcpy(rp, pmat_save, 9 * sizeof(double));
+    return;
+  }
 //tjd = 1219339.078000;
   /*equator pole */
   pre_pequ(tjd, peqr);
@@ -688,6 +698,8 @@ static void pre_pmat(double tjd, double *rp)
   rp[6] = peqr[0];
   rp[7] = peqr[1];
   rp[8] = peqr[2];
+  memcpy(pmat_save, rp, 9 * sizeof(double));
+  pmat_tjd_save = tjd;
 //  int i;
 //  for (i = 0; i < 3; i++) {
 //    fprintf(stderr, "(%.17f   %.17f   %.17f)\n", rp[i*3], rp[i*3+1],rp[i*3+2]);
@@ -3097,10 +3109,18 @@ char s[AS_MAXCH];
 char *sp;
 if (!swed.init_dt_done) {
   swed.init_dt_done = TRUE;
+  /* table read by another process (shared cache) */
+  i = swi_shm_get_deltat(dt, TABSIZ_SPACE);
+  if (i == NOT_AVAILABLE)
+    return TABSIZ;
+  if (i == OK)
+    goto find_tabsiz;
   /* no error message if file is missing */
   if ((fp = swi_fopen(-1, "swe_deltat.txt", swed.ephepath, NULL)) == NULL
-    && (fp = swi_fopen(-1, "sedeltat.txt", swed.ephepath, NULL)) == NULL)
+    && (fp = swi_fopen(-1, "sedeltat.txt", swed.ephepath, NULL)) == NULL) {
+    swi_shm_put_deltat(dt, TABSIZ_SPACE, FALSE);
     return TABSIZ; 
+  }
   while(fgets(s, AS_MAXCH, fp) != NULL) {
     sp = s;
     while (strchr(" \t", *sp) != NULL && *sp != '\0') 
@@ -3119,7 +3139,9 @@ if (!swed.init_dt_done) {
     dt[tab_index] = atof(sp);
   }
   fclose(fp);
+  swi_shm_put_deltat(dt, TABSIZ_SPACE, TRUE);
 }
+find_tabsiz:
 /* find table size */
 tabsiz = 2001 - TABSTART + 1;
 for (i = tabsiz - 1; i < TABSIZ_SPACE; i++) {
@@ -3593,6 +3615,142 @@ double CALL_CONV swe_sidtime(double tjd_ut)
   return tsid;
 }
 
+/* 
+ * swi_intp_init(), swi_intp_eval()
+ * Values of a smooth function f of time at many nearby times. f is 
+ * evaluated at multiples of step; a time is interpolated with a cubic 
+ * through the four nodes around it, and the nodes are kept for the
+ * following times. The first time of a run (farther than near days from
+ * the previous one) is computed with f directly, so that scattered
+ * times cost no more than single calls.
+ * If period != 0, f is an angle; the node values are unwrapped before
+ * interpolation and the result is not normalised.
+ */
+void swi_intp_init(struct swi_intp *ip, double step, double near, double period, 
+	int32 (*f)(double t, double *y, char *serr))
+{
+  ip->step = step;
+  ip->near = near;
+  ip->period = period;
+  ip->f = f;
+  ip->has_prev = FALSE;
+  ip->has_nodes = FALSE;
+  ip->nbreak = 0;
+}
+
+static int32 intp_node(struct swi_intp *ip, int32 k, double *y, char *serr)
+{
+  return ip->f(k * ip->step, y, serr);
+}
+
+int32 swi_intp_eval(struct swi_intp *ip, double t, double *y, char *serr)
+{
+  int j;
+  int32 k;
+  double x, l[4];
+  AS_BOOL is_near = ip->has_prev && fabs(t - ip->tprev) <= ip->near;
+  ip->tprev = t;
+  ip->has_prev = TRUE;
+  if (!is_near)
+    return ip->f(t, y, serr);
+  k = (int32) floor(t / ip->step);
+  for (j = 0; j < ip->nbreak; j++) {
+    if (ip->tbreak[j] >= (k - 1) * ip->step && ip->tbreak[j] <= (k + 2) * ip->step)
+      return ip->f(t, y, serr);
+  }
+  if (!ip->has_nodes || k != ip->kb) {
+    if (ip->has_nodes && k == ip->kb + 1) {
+      for (j = 0; j < 3; j++)
+	ip->y[j] = ip->y[j + 1];
+      if (intp_node(ip, k + 2, &ip->y[3], serr) == ERR)
+	return ERR;
+    } else if (ip->has_nodes && k == ip->kb - 1) {
+      for (j = 3; j > 0; j--)
+	ip->y[j] = ip->y[j - 1];
+      if (intp_node(ip, k - 1, &ip->y[0], serr) == ERR)
+	return ERR;
+    } else {
+      ip->has_nodes = FALSE;
+      for (j = 0; j < 4; j++) {
+	if (intp_node(ip, k - 1 + j, &ip->y[j], serr) == ERR)
+	  return ERR;
+      }
+    }
+    ip->kb = k;
+    ip->has_nodes = TRUE;
+    if (ip->period != 0) {
+      for (j = 0; j < 4; j++) {
+	while (ip->y[j] - ip->y[1] > ip->period / 2)
+	  ip->y[j] -= ip->period;
+	while (ip->y[j] - ip->y[1] < -ip->period / 2)
+	  ip->y[j] += ip->period;
+      }
+    }
+  }
+  /* Lagrange polynomial through x = -1, 0, 1, 2 */
+  x = (t - k * ip->step) / ip->step;
+  l[0] = -x * (x - 1) * (x - 2) / 6;
+  l[1] = (x + 1) * (x - 1) * (x - 2) / 2;
+  l[2] = -(x + 1) * x * (x - 2) / 2;
+  l[3] = (x + 1) * x * (x - 1) / 6;
+  *y = l[0] * ip->y[0] + l[1] * ip->y[1] + l[2] * ip->y[2] + l[3] * ip->y[3];
+  return OK;
+}
+
+/* sidereal time jumps where sidtime_long_term() takes over */
+void swi_intp_sidtime_breaks(struct swi_intp *ip)
+{
+  int sidt_model = swed.astro_models[SE_MODEL_SIDT];
+  if (sidt_model == 0) sidt_model = SEMOD_SIDT_DEFAULT;
+  if (sidt_model == SEMOD_SIDT_LONGTERM) {
+    ip->nbreak = 2;
+    ip->tbreak[0] = SIDT_LTERM_T0;
+    ip->tbreak[1] = SIDT_LTERM_T1;
+  }
+}
+
+/* Earth rotation angle in degrees, the part of sidereal time that is
+ * linear in UT; swe_sidtime_batch() interpolates the rest */
+static double sidtime_era(double tjd_ut)
+{
+  return (0.7790572732640 + 1.00273781191135448 * (tjd_ut - J2000)) * 360;
+}
+
+/* node function of swe_sidtime_batch(); cannot fail */
+static int32 sidtime_minus_era(double tjd_ut, double *y, char *serr)
+{
+  (void) serr;
+  *y = swe_degnorm(swe_sidtime(tjd_ut) * 15 - sidtime_era(tjd_ut));
+  if (*y > 180)
+    *y -= 360;
+  return OK;
+}
+
+/* 
+ * swe_sidtime_batch()
+ * swe_sidtime() for n times tjd_ut[0..n-1] (UT). 
+ * Sidereal time minus the Earth rotation angle (precession, nutation and
+ * the non-polynomial part of the equation of the equinoxes) is smooth; 
+ * it is computed every SIDT_BATCH_STEP days and interpolated for times 
+ * within SIDT_BATCH_NEAR days of the previous one. This evaluates 
+ * delta t, obliquity and nutation once per node instead of once per 
+ * time. Near the dates where the long-term model takes over, sidereal
+ * time is computed directly. The difference to swe_sidtime() is below 
+ * 3e-6 seconds of time (5e-5 s in the third millennium B.C.).
+ */
+void CALL_CONV swe_sidtime_batch(const double *tjd_ut, int32 n, double *tsid)
+{
+  int32 i;
+  double y;
+  struct swi_intp ip;
+  swi_intp_init(&ip, SIDT_BATCH_STEP, SIDT_BATCH_NEAR, 360, sidtime_minus_era);
+  swi_intp_sidtime_breaks(&ip);
+  for (i = 0; i < n; i++) {
+    swi_intp_eval(&ip, tjd_ut[i], &y, NULL);
+    tsid[i] = swe_degnorm(sidtime_era(tjd_ut[i]) + y) / 15;
+  }
+}
+
 /* SWISSEPH
  * generates name of ephemeris file
  * file name looks as follows:
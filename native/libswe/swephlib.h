@@ -175,6 +175,32 @@ extern char *swi_strncpy(char *to, char *from, size_t n);
 
 extern double swi_deltat_ephe(double tjd_ut, int32 epheflag);
 
+#define SIDT_BATCH_STEP	0.5	/* node spacing of swe_sidtime_batch() and
+				 * swe_time_equ_batch(), days */
+#define SIDT_BATCH_NEAR	2.0	/* times closer than this are interpolated */
+
+/* cubic interpolation of a smooth function of time between values at 
+ * multiples of step, for batch calculations at nearby times; 
+ * see swi_intp_eval() */
+struct swi_intp {
+  double step;		/* node spacing in days */
+  double near;		/* a time farther than this from the previous one
+			 * is computed directly */
+  double period;	/* 360 for angles, 0 otherwise */
+  int32 (*f)(double t, double *y, char *serr);
+  double tprev;
+  AS_BOOL has_prev;
+  int32 kb;		/* nodes y[0..3] are at (kb - 1 .. kb + 2) * step */
+  AS_BOOL has_nodes;
+  double y[4];
+  int nbreak;		/* discontinuities of f; nodes never span them */
+  double tbreak[2];
+};
+extern void swi_intp_init(struct swi_intp *ip, double step, double near, double period, 
+	int32 (*f)(double t, double *y, char *serr));
+extern int32 swi_intp_eval(struct swi_intp *ip, double t, double *y, char *serr);
+extern void swi_intp_sidtime_breaks(struct swi_intp *ip);
+
 #ifdef TRACE
 #  define TRACE_COUNT_MAX         10000
   extern TLS FILE *swi_fp_trace_c;
@@ -0,0 +1,796 @@
+/* Copyright (C) 1997 - 2021 Astrodienst AG, Switzerland.  All rights reserved.
+
+  License conditions
+  ------------------
+
+  This file is part of Swiss Ephemeris.
+
+  Swiss Ephemeris is distributed with NO WARRANTY OF ANY KIND.  No author
+  or distributor accepts any responsibility for the consequences of using it,
+  or for whether it serves any particular purpose or works at all, unless he
+  or she says so in writing.  
+
+  Swiss Ephemeris is made available by its authors under a dual licensing
+  system. The software developer, who uses any part of Swiss Ephemeris
+  in his or her software, must choose between one of the two license models,
+  which are
+  a) GNU Affero General Public License (AGPL)
+  b) Swiss Ephemeris Professional License
+
+  The choice must be made before the software developer distributes software
+  containing parts of Swiss Ephemeris to others, and before any public
+  service using the developed software is activated.
+
+  If the developer choses the AGPL software license, he or she must fulfill
+  the conditions of that license, which includes the obligation to place his
+  or her whole software project under the AGPL or a compatible license.
+  See https://www.gnu.org/licenses/agpl-3.0.html
+
+  If the developer choses the Swiss Ephemeris Professional license,
+  he must follow the instructions as found in http://www.astro.com/swisseph/ 
+  and purchase the Swiss Ephemeris Professional Edition from Astrodienst
+  and sign the corresponding license contract.
+
+  The License grants you the right to use, copy, modify and redistribute
+  Swiss Ephemeris, but only under certain conditions described in the License.
+  Among other things, the License requires that the copyright notices and
+  this notice be preserved on all copies.
+
+  Authors of the Swiss Ephemeris: Dieter Koch and Alois Treindl
+
+  The authors of Swiss Ephemeris have no control or influence over any of
+  the derived works, i.e. over software or services created by other
+  programmers which use Swiss Ephemeris functions.
+
+  The names of the authors or of the copyright holder (Astrodienst) must not
+  be used for promoting any software, product or service which uses or contains
+  the Swiss Ephemeris. This copyright notice is the ONLY place where the
+  names of the authors can legally appear, except in cases where they have
+  given special permission in writing.
+
+  The trademarks 'Swiss Ephemeris' and 'Swiss Ephemeris inside' may be used
+  for promoting such software, products or services.
+*/
+
+/* C++ interface to Swiss Ephemeris (header only, C++17 or later).
+ *
+ * The library keeps its settings and caches per thread (ephemeris path,
+ * open files, sidereal mode, topocentric position, ...). A swe::context
+ * holds such settings and applies them to the calling thread when one of
+ * its functions is called for the first time on that thread, or after
+ * the settings have changed. Every thread that uses a context therefore
+ * works on its own state; nothing is shared between threads, and a
+ * context may be used by several threads at the same time as long as
+ * its settings are not changed meanwhile.
+ * The destructor closes the library state of the thread that destroys
+ * the context (swe_close()), if it was set up by this context.
+ *
+ * Errors are returned as swe::expected<T>, which is std::expected<T,
+ * swe::error> with C++23 and an equivalent small class before. Batch
+ * functions take std::span (or swe::span before C++20) for input and
+ * output, so that they can write into the caller's buffers; output
+ * sizes are checked. The error of a batch function has the index of
+ * the failed element.
+ *
+ * swe::parallel_for() runs a loop on worker threads of its own and
+ * closes their state at the end; with C++17 parallel algorithms, 
+ * swe::parallel_for(std::execution::par, ...) runs it on the
+ * implementation's thread pool, where every pool thread keeps the
+ * state it got from the context.
+ *
+ * With C++20 coroutines, the event searches (eclipses, occultations,
+ * crossings, risings) are lazy sequences (swe::generator) that continue
+ * each search from the previous event and can be stopped or combined 
+ * with std::views at any point.
+ *
+ * Example:
+ *   swe::context ctx("/usr/share/sweph");
+ *   std::vector<double> jd(n), pos(6 * n);
+ *   ...
+ *   auto r = ctx.calc_ut(jd, SE_MARS, SEFLG_SWIEPH | SEFLG_SPEED, pos);
+ *   if (!r)
+ *     std::cerr << r.error().message << " at date " << r.error().index << "\n";
+ *   auto houses = ctx.houses(jd[0], 47.37, 8.55, 'P');
+ *   if (houses)
+ *     std::cout << "Asc " << houses->ascmc[SE_ASC] << "\n";
+ *   swe::parallel_calc_ut(ctx, jd, SE_MARS, SEFLG_SWIEPH | SEFLG_SPEED, pos);
+ *   for (const auto &e : ctx.solar_eclipses(jd0, jd0 + 3652.5, SE_ECL_TOTAL)) {
+ *     if (!e) break;
+ *     std::cout << e->tret[0] << "\n";
+ *   }
+ */
+
+#ifndef _SWEPHPP_INCLUDED
+#define _SWEPHPP_INCLUDED
+
+#include "swephexp.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if __has_include(<version>)
+#include <version>
+#endif
+#if defined(__cpp_lib_span)
+#include <span>
+#endif
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+#include <expected>
+#else
+#include <variant>
+#endif
+#if defined(__cpp_lib_execution)
+#include <execution>
+#endif
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define SWEPHPP_GENERATOR 1
+#include <coroutine>
+#include <iterator>
+#include <limits>
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#endif
+#endif
+
+namespace swe {
+
+/* error of a library call; index is the element of a batch call */
+struct error {
+  int32 code = ERR;
+  std::string message;
+  std::size_t index = 0;
+};
+
+#if defined(__cpp_lib_span)
+template <class T> using span = std::span<T>;
+#else
+/* the part of std::span used here */
+template <class T> class span {
+public:
+  constexpr span() noexcept = default;
+  constexpr span(T *data, std::size_t size) noexcept : data_(data), size_(size) {}
+  template <std::size_t N> constexpr span(T (&arr)[N]) noexcept : data_(arr), size_(N) {}
+  template <class C, class = std::enable_if_t<
+    std::is_convertible<decltype(std::declval<C &>().data()), T *>::value>>
+  constexpr span(C &c) noexcept : data_(c.data()), size_(c.size()) {}
+  template <class C, class = std::enable_if_t<std::is_const<T>::value &&
+    std::is_convertible<decltype(std::declval<const C &>().data()), T *>::value>>
+  constexpr span(const C &c) noexcept : data_(c.data()), size_(c.size()) {}
+  constexpr T *data() const noexcept { return data_; }
+  constexpr std::size_t size() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+  constexpr T &operator[](std::size_t i) const noexcept { return data_[i]; }
+  constexpr T *begin() const noexcept { return data_; }
+  constexpr T *end() const noexcept { return data_ + size_; }
+  constexpr span subspan(std::size_t offset, std::size_t count) const noexcept {
+    return span(data_ + offset, count);
+  }
+private:
+  T *data_ = nullptr;
+  std::size_t size_ = 0;
+};
+#endif
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+template <class T> using expected = std::expected<T, error>;
+using unexpected = std::unexpected<error>;
+#else
+/* the part of std::unexpected<swe::error> used here */
+class unexpected {
+public:
+  explicit unexpected(swe::error e) : e_(std::move(e)) {}
+  const swe::error &error() const & noexcept { return e_; }
+  swe::error &&error() && noexcept { return std::move(e_); }
+private:
+  swe::error e_;
+};
+
+/* the part of std::expected<T, swe::error> used here */
+template <class T> class expected {
+public:
+  expected() : v_(std::in_place_index<0>) {}
+  expected(const T &v) : v_(std::in_place_index<0>, v) {}
+  expected(T &&v) : v_(std::in_place_index<0>, std::move(v)) {}
+  expected(unexpected u) : v_(std::in_place_index<1>, std::move(u).error()) {}
+  bool has_value() const noexcept { return v_.index() == 0; }
+  explicit operator bool() const noexcept { return has_value(); }
+  T &value() & { check(); return std::get<0>(v_); }
+  const T &value() const & { check(); return std::get<0>(v_); }
+  T &operator*() noexcept { return *std::get_if<0>(&v_); }
+  const T &operator*() const noexcept { return *std::get_if<0>(&v_); }
+  T *operator->() noexcept { return std::get_if<0>(&v_); }
+  const T *operator->() const noexcept { return std::get_if<0>(&v_); }
+  const swe::error &error() const noexcept { return *std::get_if<1>(&v_); }
+  template <class U> T value_or(U &&other) const {
+    return has_value() ? **this : static_cast<T>(std::forward<U>(other));
+  }
+private:
+  void check() const {
+    if (!has_value())
+      throw std::runtime_error(error().message);
+  }
+  std::variant<T, swe::error> v_;
+};
+
+template <> class expected<void> {
+public:
+  expected() = default;
+  expected(unexpected u) : failed_(true), e_(std::move(u).error()) {}
+  bool has_value() const noexcept { return !failed_; }
+  explicit operator bool() const noexcept { return has_value(); }
+  void value() const {
+    if (failed_)
+      throw std::runtime_error(e_.message);
+  }
+  const swe::error &error() const noexcept { return e_; }
+private:
+  bool failed_ = false;
+  swe::error e_;
+};
+#endif
+
+/* position and speed as returned by swe_calc_ut() */
+using coords = std::array<double, 6>;
+
+/* cusps and angles as returned by swe_houses_ex2(); 
+ * cusps[1..12] (cusps[1..36] for Gauquelin sectors), ascmc[SE_ASC] etc. */
+struct house_cusps {
+  std::array<double, 37> cusps{};
+  std::array<double, 10> ascmc{};
+  int32 flag = OK;
+};
+
+#if defined(SWEPHPP_GENERATOR)
+/* lazy sequence of the event searches (C++20); an input range that 
+ * can be used with range-for and std::views, movable, not copyable */
+template <class T> class generator
+#if defined(__cpp_lib_ranges)
+  : public std::ranges::view_base
+#endif
+{
+public:
+  struct promise_type {
+    const T *value = nullptr;
+    std::exception_ptr exc;
+    generator get_return_object() noexcept {
+      return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    std::suspend_always final_suspend() const noexcept { return {}; }
+    std::suspend_always yield_value(const T &v) noexcept {
+      value = std::addressof(v);
+      return {};
+    }
+    void return_void() const noexcept {}
+    void unhandled_exception() { exc = std::current_exception(); }
+    template <class U> void await_transform(U &&) = delete;
+  };
+
+  class iterator {
+  public:
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    iterator() = default;
+    explicit iterator(std::coroutine_handle<promise_type> h) noexcept : h_(h) {}
+    const T &operator*() const noexcept { return *h_.promise().value; }
+    const T *operator->() const noexcept { return h_.promise().value; }
+    iterator &operator++() {
+      generator::resume(h_);
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+    friend bool operator==(const iterator &it, std::default_sentinel_t) noexcept {
+      return !it.h_ || it.h_.done();
+    }
+  private:
+    std::coroutine_handle<promise_type> h_;
+  };
+
+  generator() = default;
+  generator(generator &&other) noexcept : h_(std::exchange(other.h_, {})) {}
+  generator &operator=(generator &&other) noexcept {
+    if (this != &other) {
+      if (h_)
+        h_.destroy();
+      h_ = std::exchange(other.h_, {});
+    }
+    return *this;
+  }
+  ~generator() {
+    if (h_)
+      h_.destroy();
+  }
+  /* starts the search; call once */
+  iterator begin() {
+    if (h_)
+      resume(h_);
+    return iterator(h_);
+  }
+  std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+  explicit generator(std::coroutine_handle<promise_type> h) noexcept : h_(h) {}
+  static void resume(std::coroutine_handle<promise_type> h) {
+    h.resume();
+    if (h.done() && h.promise().exc)
+      std::rethrow_exception(std::exchange(h.promise().exc, nullptr));
+  }
+  std::coroutine_handle<promise_type> h_;
+};
+
+/* eclipse or occultation: type (SE_ECL_TOTAL etc.) and times as returned
+ * by swe_sol_eclipse_when_glob(), swe_lun_eclipse_when() and
+ * swe_lun_occult_when_glob(); tret[0] is the time of maximum */
+struct eclipse_event {
+  int32 type = 0;
+  std::array<double, 10> tret{};
+};
+#endif
+
+namespace detail {
+
+inline unexpected fail(int32 code, const char *serr, std::size_t index = 0) {
+  return unexpected(error{code, serr, index});
+}
+
+inline unexpected size_error(std::size_t have, std::size_t want) {
+  return unexpected(error{ERR, "output has " + std::to_string(have) +
+    " values, expected " + std::to_string(want), 0});
+}
+
+/* context and settings version last applied to this thread */
+inline thread_local unsigned long bound_id = 0;
+inline thread_local unsigned long bound_version = 0;
+
+inline std::atomic<unsigned long> &context_ids() {
+  static std::atomic<unsigned long> ids{0};
+  return ids;
+}
+
+} // namespace detail
+
+class context {
+public:
+  /* ephe_path empty: default path or SE_EPHE_PATH from the environment */
+  explicit context(std::string ephe_path = std::string(), std::string jpl_file = std::string())
+    : id_(++detail::context_ids()), ephe_path_(std::move(ephe_path)), jpl_file_(std::move(jpl_file)) {
+    bind();
+  }
+  context(const context &) = delete;
+  context &operator=(const context &) = delete;
+  ~context() {
+    if (detail::bound_id == id_) {
+      swe_close();
+      detail::bound_id = 0;
+    }
+  }
+
+  /* settings; must not be changed while other threads use the context */
+  void set_sid_mode(int32 sid_mode, double t0 = 0, double ayan_t0 = 0) {
+    sid_mode_ = sid_mode; sid_t0_ = t0; sid_ayan_t0_ = ayan_t0; has_sid_mode_ = true;
+    ++version_;
+  }
+  void set_topo(double geolon, double geolat, double geoalt) {
+    topo_ = {geolon, geolat, geoalt}; has_topo_ = true;
+    ++version_;
+  }
+
+  /* makes the library state of the calling thread use these settings;
+   * called by all functions of the class */
+  void bind() const {
+    unsigned long version = version_.load(std::memory_order_acquire);
+    if (detail::bound_id == id_ && detail::bound_version == version)
+      return;
+    if (detail::bound_id != 0 && detail::bound_id != id_)
+      swe_close();
+    swe_set_ephe_path(ephe_path_.empty() ? nullptr : ephe_path_.c_str());
+    if (!jpl_file_.empty())
+      swe_set_jpl_file(jpl_file_.c_str());
+    if (has_sid_mode_)
+      swe_set_sid_mode(sid_mode_, sid_t0_, sid_ayan_t0_);
+    if (has_topo_)
+      swe_set_topo(topo_[0], topo_[1], topo_[2]);
+    detail::bound_id = id_;
+    detail::bound_version = version;
+  }
+
+  /************************************
+   * positions
+   ************************************/
+  expected<coords> calc_ut(double tjd_ut, int32 ipl, int32 iflag) const {
+    coords xx;
+    char serr[AS_MAXCH];
+    bind();
+    int32 ret = swe_calc_ut(tjd_ut, ipl, iflag, xx.data(), serr);
+    if (ret < 0)
+      return detail::fail(ret, serr);
+    return xx;
+  }
+
+  /* one body at many dates; out[6 * i .. 6 * i + 5] for date i.
+   * Returns the flags of the last date. */
+  expected<int32> calc_ut(span<const double> tjd_ut, int32 ipl, int32 iflag, span<double> out) const {
+    char serr[AS_MAXCH];
+    int32 ret = iflag;
+    if (out.size() < 6 * tjd_ut.size())
+      return detail::size_error(out.size(), 6 * tjd_ut.size());
+    bind();
+    for (std::size_t i = 0; i < tjd_ut.size(); i++) {
+      if ((ret = swe_calc_ut(tjd_ut[i], ipl, iflag, out.data() + 6 * i, serr)) < 0)
+        return detail::fail(ret, serr, i);
+    }
+    return ret;
+  }
+
+  /* many bodies at one date; out[6 * k .. 6 * k + 5] for body k */
+  expected<int32> calc_ut(double tjd_ut, span<const int32> ipl, int32 iflag, span<double> out) const {
+    char serr[AS_MAXCH];
+    int32 ret = iflag;
+    if (out.size() < 6 * ipl.size())
+      return detail::size_error(out.size(), 6 * ipl.size());
+    bind();
+    for (std::size_t k = 0; k < ipl.size(); k++) {
+      if ((ret = swe_calc_ut(tjd_ut, ipl[k], iflag, out.data() + 6 * k, serr)) < 0)
+        return detail::fail(ret, serr, k);
+    }
+    return ret;
+  }
+
+  /************************************
+   * houses
+   ************************************/
+  expected<house_cusps> houses(double tjd_ut, double geolat, double geolon, int hsys, int32 iflag = 0) const {
+    house_cusps h;
+    char serr[AS_MAXCH];
+    bind();
+    *serr = '\0';
+    if ((h.flag = swe_houses_ex2(tjd_ut, iflag, geolat, geolon, hsys, h.cusps.data(), h.ascmc.data(),
+                                 nullptr, nullptr, serr)) < 0)
+      return detail::fail(h.flag, serr);
+    return h;
+  }
+
+  /* houses at many dates and one place; cusps[13 * i .. 13 * i + 12] 
+   * (37 values for hsys 'G') and ascmc[10 * i .. 10 * i + 9] for date i */
+  expected<void> houses(span<const double> tjd_ut, double geolat, double geolon, int hsys, int32 iflag,
+                        span<double> cusps, span<double> ascmc) const {
+    std::size_t n = tjd_ut.size();
+    return houses_at(n, [&](std::size_t i) { return tjd_ut[i]; },
+      [&](std::size_t) { return geolat; }, [&](std::size_t) { return geolon; },
+      hsys, iflag, cusps, ascmc);
+  }
+
+  /* houses at many dates and places, one place per date */
+  expected<void> houses(span<const double> tjd_ut, span<const double> geolat, span<const double> geolon, 
+                        int hsys, int32 iflag, span<double> cusps, span<double> ascmc) const {
+    std::size_t n = tjd_ut.size();
+    if (geolat.size() < n || geolon.size() < n)
+      return detail::fail(ERR, "fewer places than dates");
+    return houses_at(n, [&](std::size_t i) { return tjd_ut[i]; },
+      [&](std::size_t i) { return geolat[i]; }, [&](std::size_t i) { return geolon[i]; },
+      hsys, iflag, cusps, ascmc);
+  }
+
+  /************************************
+   * horizontal coordinates
+   ************************************/
+  /* xin[2 * k], xin[2 * k + 1]: ecliptic (SE_ECL2HOR) or equatorial 
+   * (SE_EQU2HOR) position of object k; xaz[3 * k .. 3 * k + 2]: azimuth,
+   * true and apparent altitude. geopos: longitude, latitude, height. */
+  expected<void> azalt(double tjd_ut, int32 calc_flag, const std::array<double, 3> &geopos,
+                       double atpress, double attemp, span<const double> xin, span<double> xaz) const {
+    std::size_t n = xin.size() / 2;
+    std::array<double, 3> geo = geopos;
+    if (xaz.size() < 3 * n)
+      return detail::size_error(xaz.size(), 3 * n);
+    bind();
+    swe_azalt_batch(tjd_ut, calc_flag, geo.data(), atpress, attemp, xin.data(), (int32) n, xaz.data());
+    return {};
+  }
+
+  /* xin[2 * k], xin[2 * k + 1]: azimuth and true altitude of object k;
+   * xout[2 * k], xout[2 * k + 1]: ecliptic (SE_HOR2ECL) or equatorial
+   * (SE_HOR2EQU) position */
+  expected<void> azalt_rev(double tjd_ut, int32 calc_flag, const std::array<double, 3> &geopos,
+                           span<const double> xin, span<double> xout) const {
+    std::size_t n = xin.size() / 2;
+    std::array<double, 3> geo = geopos;
+    if (xout.size() < 2 * n)
+      return detail::size_error(xout.size(), 2 * n);
+    bind();
+    swe_azalt_rev_batch(tjd_ut, calc_flag, geo.data(), xin.data(), (int32) n, xout.data());
+    return {};
+  }
+
+#if defined(SWEPHPP_GENERATOR)
+  /************************************
+   * event searches (C++20)
+   ************************************/
+  /* The sequences are computed while they are iterated, so a consumer 
+   * can stop at any time. Each search continues from the result before
+   * instead of from t0. The last element of a sequence that fails is 
+   * the error. The context must outlive the sequence. */
+
+  /* global solar eclipses with maximum between t0 and t1, backward in
+   * time if t1 < t0; ifltype as for swe_sol_eclipse_when_glob() */
+  generator<expected<eclipse_event>> solar_eclipses(double t0, double t1, int32 ifltype = 0,
+                                                    int32 ifl = SEFLG_SWIEPH) const {
+    int32 backward = t1 < t0;
+    char serr[AS_MAXCH];
+    for (double t = t0;;) {
+      eclipse_event e;
+      bind();
+      if ((e.type = swe_sol_eclipse_when_glob(t, ifl, ifltype, e.tret.data(), backward, serr)) < 0) {
+        co_yield detail::fail(e.type, serr);
+        co_return;
+      }
+      if (backward ? e.tret[0] < t1 : e.tret[0] > t1)
+        co_return;
+      co_yield e;
+      t = e.tret[0];
+    }
+  }
+
+  /* lunar eclipses with maximum between t0 and t1, as solar_eclipses() */
+  generator<expected<eclipse_event>> lunar_eclipses(double t0, double t1, int32 ifltype = 0,
+                                                    int32 ifl = SEFLG_SWIEPH) const {
+    int32 backward = t1 < t0;
+    char serr[AS_MAXCH];
+    for (double t = t0;;) {
+      eclipse_event e;
+      bind();
+      if ((e.type = swe_lun_eclipse_when(t, ifl, ifltype, e.tret.data(), backward, serr)) < 0) {
+        co_yield detail::fail(e.type, serr);
+        co_return;
+      }
+      if (backward ? e.tret[0] < t1 : e.tret[0] > t1)
+        co_return;
+      co_yield e;
+      t = e.tret[0];
+    }
+  }
+
+  /* occultations of a planet (starname empty) or star by the Moon 
+   * between t0 and t1. One conjunction is tested per search 
+   * (SE_ECL_ONE_TRY), so the sequence ends at t1 even for bodies
+   * that are never occulted. */
+  generator<expected<eclipse_event>> occultations(int32 ipl, std::string starname, double t0, double t1,
+                                                  int32 ifltype = 0, int32 ifl = SEFLG_SWIEPH) const {
+    int32 backward = t1 < t0;
+    double direction = backward ? -1 : 1;
+    char serr[AS_MAXCH];
+    std::array<char, AS_MAXCH> star{};
+    for (double t = t0; backward ? t >= t1 : t <= t1;) {
+      eclipse_event e;
+      starname.copy(star.data(), star.size() - 1);
+      bind();
+      e.type = swe_lun_occult_when_glob(t, ipl, starname.empty() ? nullptr : star.data(), ifl, ifltype,
+                                        e.tret.data(), backward | SE_ECL_ONE_TRY, serr);
+      if (e.type < 0) {
+        co_yield detail::fail(e.type, serr);
+        co_return;
+      }
+      if (e.type == 0) {	/* no occultation at this conjunction */
+        t = e.tret[0] + direction;
+        continue;
+      }
+      if (backward ? e.tret[0] < t1 : e.tret[0] > t1)
+        co_return;
+      co_yield e;
+      t = e.tret[0];
+    }
+  }
+
+  /* times (UT) at which the Sun (swe_solcross_ut()), the Moon 
+   * (swe_mooncross_ut()) or, heliocentrically, a planet 
+   * (swe_helio_cross_ut()) crosses longitude lon, from t0 on */
+  generator<expected<double>> crossings(int32 ipl, double lon, double t0,
+                                        double t1 = std::numeric_limits<double>::infinity(),
+                                        int32 iflag = SEFLG_SWIEPH) const {
+    char serr[AS_MAXCH];
+    for (double t = t0;;) {
+      double tc = 0;
+      int32 ret = OK;
+      bind();
+      if (ipl == SE_SUN) {
+        if ((tc = swe_solcross_ut(lon, t, iflag, serr)) < t)
+          ret = ERR;
+      } else if (ipl == SE_MOON) {
+        if ((tc = swe_mooncross_ut(lon, t, iflag, serr)) < t)
+          ret = ERR;
+      } else {
+        ret = swe_helio_cross_ut(ipl, lon, t, iflag, 1, &tc, serr);
+      }
+      if (ret < 0) {
+        co_yield detail::fail(ret, serr);
+        co_return;
+      }
+      if (tc > t1)
+        co_return;
+      co_yield tc;
+      t = tc + 1;	/* well past this crossing, before the next one */
+    }
+  }
+
+  /* rising, setting or transit times (UT) as of swe_rise_trans(), from 
+   * t0 on; rsmi SE_CALC_RISE etc. Days on which the body does not rise
+   * or set are skipped; the sequence ends after a year without event. */
+  generator<expected<double>> rise_trans(int32 ipl, std::array<double, 3> geopos, double t0,
+                                         double t1 = std::numeric_limits<double>::infinity(),
+                                         int32 rsmi = SE_CALC_RISE, int32 epheflag = SEFLG_SWIEPH,
+                                         double atpress = 0, double attemp = 0,
+                                         std::string starname = std::string()) const {
+    char serr[AS_MAXCH];
+    std::array<char, AS_MAXCH> star{};
+    double tlast = t0;
+    for (double t = t0; t <= t1 && t - tlast < 366;) {
+      double tr = 0;
+      starname.copy(star.data(), star.size() - 1);
+      bind();
+      int32 ret = swe_rise_trans(t, ipl, starname.empty() ? nullptr : star.data(), epheflag, rsmi,
+                                 geopos.data(), atpress, attemp, &tr, serr);
+      if (ret == -2) {	/* circumpolar on this day */
+        t += 1;
+        continue;
+      }
+      if (ret < 0) {
+        co_yield detail::fail(ret, serr);
+        co_return;
+      }
+      if (tr > t1)
+        co_return;
+      co_yield tr;
+      t = tlast = tr + 1.0 / 1440;
+    }
+  }
+
+  generator<expected<double>> risings(int32 ipl, std::array<double, 3> geopos, double t0,
+                                      double t1 = std::numeric_limits<double>::infinity(),
+                                      int32 epheflag = SEFLG_SWIEPH) const {
+    return rise_trans(ipl, geopos, t0, t1, SE_CALC_RISE, epheflag);
+  }
+#endif
+
+private:
+  template <class Tjd, class Lat, class Lon>
+  expected<void> houses_at(std::size_t n, Tjd tjd, Lat lat, Lon lon, int hsys, int32 iflag,
+                           span<double> cusps, span<double> ascmc) const {
+    std::size_t ncusps = (hsys == 'G') ? 37 : 13;
+    char serr[AS_MAXCH];
+    if (cusps.size() < ncusps * n)
+      return detail::size_error(cusps.size(), ncusps * n);
+    if (ascmc.size() < 10 * n)
+      return detail::size_error(ascmc.size(), 10 * n);
+    bind();
+    for (std::size_t i = 0; i < n; i++) {
+      *serr = '\0';
+      int ret = swe_houses_ex2(tjd(i), iflag, lat(i), lon(i), hsys, cusps.data() + ncusps * i,
+                               ascmc.data() + 10 * i, nullptr, nullptr, serr);
+      if (ret < 0)
+        return detail::fail(ret, serr, i);
+    }
+    return {};
+  }
+
+  unsigned long id_;
+  std::atomic<unsigned long> version_{1};
+  std::string ephe_path_;
+  std::string jpl_file_;
+  bool has_sid_mode_ = false;
+  int32 sid_mode_ = 0;
+  double sid_t0_ = 0, sid_ayan_t0_ = 0;
+  bool has_topo_ = false;
+  std::array<double, 3> topo_{};
+};
+
+/************************************
+ * parallel helpers
+ ************************************/
+
+/* calls fn(begin, end) for consecutive chunks of [0, n) on nthreads
+ * threads of its own (default: hardware concurrency). Each thread uses
+ * the context's settings on a library state of its own, which is closed
+ * when the thread has finished. An exception thrown by fn is rethrown
+ * after all threads have finished. */
+template <class Fn>
+void parallel_for(const context &ctx, std::size_t n, Fn &&fn, unsigned nthreads = 0) {
+  if (nthreads == 0)
+    nthreads = std::thread::hardware_concurrency();
+  if (nthreads == 0)
+    nthreads = 1;
+  if (nthreads > n)
+    nthreads = (unsigned) (n > 0 ? n : 1);
+  std::exception_ptr exc;
+  std::mutex mtx;
+  std::vector<std::thread> workers;
+  std::size_t chunk = (n + nthreads - 1) / nthreads;
+  for (unsigned t = 0; t < nthreads; t++) {
+    std::size_t begin = t * chunk, end = std::min(n, begin + chunk);
+    if (begin >= end)
+      break;
+    workers.emplace_back([&, begin, end] {
+      try {
+        ctx.bind();
+        fn(begin, end);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!exc)
+          exc = std::current_exception();
+      }
+      swe_close();
+      detail::bound_id = 0;
+    });
+  }
+  for (auto &w : workers)
+    w.join();
+  if (exc)
+    std::rethrow_exception(exc);
+}
+
+#if defined(__cpp_lib_execution)
+/* same with a standard execution policy, in chunks of the given size;
+ * the threads of the policy keep their library state */
+template <class ExecutionPolicy, class Fn,
+  class = std::enable_if_t<std::is_execution_policy<std::decay_t<ExecutionPolicy>>::value>>
+void parallel_for(ExecutionPolicy &&policy, const context &ctx, std::size_t n, Fn &&fn,
+                  std::size_t chunk = 64) {
+  std::vector<std::size_t> begins;
+  if (chunk == 0)
+    chunk = 1;
+  for (std::size_t b = 0; b < n; b += chunk)
+    begins.push_back(b);
+  std::for_each(std::forward<ExecutionPolicy>(policy), begins.begin(), begins.end(),
+    [&](std::size_t begin) {
+      ctx.bind();
+      fn(begin, std::min(n, begin + chunk));
+    });
+}
+#endif
+
+namespace detail {
+
+/* keeps the error with the lowest index of several workers */
+struct first_error {
+  std::mutex mtx;
+  bool failed = false;
+  error err;
+  void set(const error &e, std::size_t offset) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!failed || e.index + offset < err.index) {
+      err = e;
+      err.index += offset;
+      failed = true;
+    }
+  }
+};
+
+} // namespace detail
+
+/* ctx.calc_ut() for one body at many dates, on several threads */
+inline expected<void> parallel_calc_ut(const context &ctx, span<const double> tjd_ut, int32 ipl, int32 iflag,
+                                       span<double> out, unsigned nthreads = 0) {
+  detail::first_error fe;
+  if (out.size() < 6 * tjd_ut.size())
+    return detail::size_error(out.size(), 6 * tjd_ut.size());
+  parallel_for(ctx, tjd_ut.size(), [&](std::size_t begin, std::size_t end) {
+    auto r = ctx.calc_ut(tjd_ut.subspan(begin, end - begin), ipl, iflag, out.subspan(6 * begin, 6 * (end - begin)));
+    if (!r)
+      fe.set(r.error(), begin);
+  }, nthreads);
+  if (fe.failed)
+    return unexpected(fe.err);
+  return {};
+}
+
+} // namespace swe
+
+#endif /* _SWEPHPP_INCLUDED */
@@ -0,0 +1,656 @@
+/* Copyright (C) 1997 - 2021 Astrodienst AG, Switzerland.  All rights reserved.
+
+  License conditions
+  ------------------
+
+  This file is part of Swiss Ephemeris.
+
+  Swiss Ephemeris is distributed with NO WARRANTY OF ANY KIND.  No author
+  or distributor accepts any responsibility for the consequences of using it,
+  or for whether it serves any particular purpose or works at all, unless he
+  or she says so in writing.  
+
+  Swiss Ephemeris is made available by its authors under a dual licensing
+  system. The software developer, who uses any part of Swiss Ephemeris
+  in his or her software, must choose between one of the two license models,
+  which are
+  a) GNU Affero General Public License (AGPL)
+  b) Swiss Ephemeris Professional License
+
+  The choice must be made before the software developer distributes software
+  containing parts of Swiss Ephemeris to others, and before any public
+  service using the developed software is activated.
+
+  If the developer choses the AGPL software license, he or she must fulfill
+  the conditions of that license, which includes the obligation to place his
+  or her whole software project under the AGPL or a compatible license.
+  See https://www.gnu.org/licenses/agpl-3.0.html
+
+  If the developer choses the Swiss Ephemeris Professional license,
+  he must follow the instructions as found in http://www.astro.com/swisseph/ 
+  and purchase the Swiss Ephemeris Professional Edition from Astrodienst
+  and sign the corresponding license contract.
+
+  The License grants you the right to use, copy, modify and redistribute
+  Swiss Ephemeris, but only under certain conditions described in the License.
+  Among other things, the License requires that the copyright notices and
+  this notice be preserved on all copies.
+
+  Authors of the Swiss Ephemeris: Dieter Koch and Alois Treindl
+
+  The authors of Swiss Ephemeris have no control or influence over any of
+  the derived works, i.e. over software or services created by other
+  programmers which use Swiss Ephemeris functions.
+
+  The names of the authors or of the copyright holder (Astrodienst) must not
+  be used for promoting any software, product or service which uses or contains
+  the Swiss Ephemeris. This copyright notice is the ONLY place where the
+  names of the authors can legally appear, except in cases where they have
+  given special permission in writing.
+
+  The trademarks 'Swiss Ephemeris' and 'Swiss Ephemeris inside' may be used
+  for promoting such software, products or services.
+*/
+
+/* Cross-process shared-memory cache, see sweshm.h */
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include "swephexp.h"
+#include "sweph.h"
+#include "swephlib.h"
+#include "sweshm.h"
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__) && !defined(NO_SHARED_CACHE)
+# define SHM_SUPPORTED
+# include <errno.h>
+# include <fcntl.h>
+# include <signal.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <time.h>
+# include <unistd.h>
+#endif
+
+#define SHM_MAGIC		0x48534553	/* "SESH" */
+#define SHM_STATE_READY		1
+/* states of the star and delta t regions */
+#define SHM_REGION_EMPTY	0
+#define SHM_REGION_WRITING	1
+#define SHM_REGION_READY	2
+#define SHM_REGION_TOO_SMALL	3
+#define SHM_PROBES		4	/* slots tried per segment lookup */
+#define SHM_SEG_NCOEF		(3 * (MAXORD + 1))
+#define SHM_STAR_BYTES		(4 * 1024 * 1024)
+#define SHM_DT_MAX		1024
+#define SHM_PAGE		4096
+#define SHM_ATTACH_WAIT_MS	2000	/* how long to wait for the creator */
+#define SHM_MAX_MAPS		16	/* mappings kept over detach and re-attach */
+
+typedef unsigned long long shm_u64;
+
+struct shm_header {
+  uint32 magic;
+  uint32 state;
+  uint32 layout;
+  uint32 nslots;
+  uint32 slot_size;
+  uint32 star_size;	/* sizeof(struct fixed_star) */
+  char version[16];	/* SE_VERSION of the creator */
+  shm_u64 total_size;
+  shm_u64 seg_offset;
+  shm_u64 star_offset;
+  shm_u64 star_capacity;
+  shm_u64 dt_offset;
+};
+
+/* The lock word of a slot holds the sequence number in its low 32 bits
+ * and the pid of the last writer in the high 32 bits, so that a slot
+ * left odd by a killed writer can be reclaimed. */
+#define SHM_SEQ(lock)		((uint32) (lock))
+#define SHM_WRITER(lock)	((pid_t) ((lock) >> 32))
+#define SHM_LOCK(pid, seq)	((shm_u64) (uint32) (pid) << 32 | (seq))
+
+struct shm_seg_slot {
+  shm_u64 seq;		/* lock word; sequence 0 empty, odd while being written */
+  int32 ibdy;
+  int32 iseg;
+  int32 ncoe;
+  int32 neval;
+  shm_u64 fkey;		/* ephemeris file identity */
+  double tseg0, tseg1;
+  double coef[SHM_SEG_NCOEF];	/* after rot_back() */
+};
+
+struct shm_star_region {
+  uint32 state;
+  int32 nrecs;
+  int32 nreal;
+  int32 nnamed;
+  shm_u64 key;
+  /* followed by nrecs struct fixed_star, sorted by key */
+};
+
+struct shm_dt_region {
+  uint32 state;
+  int32 n;
+  int32 found;		/* FALSE: no delta t file in the ephemeris path */
+  int32 unused;
+  shm_u64 key;
+  double tab[SHM_DT_MAX];
+};
+
+/* The mapping is process-wide; all threads share it. Mappings are never
+ * removed: after a detach or re-attach, star arrays of other threads may
+ * still point into an earlier one, so all of them are remembered for
+ * swi_shm_owns(). */
+static struct shm_header *shm_hdr = NULL;
+#ifdef SHM_SUPPORTED
+static struct shm_header *shm_maps[SHM_MAX_MAPS];
+static dev_t shm_map_dev[SHM_MAX_MAPS];
+static ino_t shm_map_ino[SHM_MAX_MAPS];
+static int32 shm_nmaps = 0;
+#endif
+/* segment hits, segment stores, stars shared, delta t shared; updated
+ * atomically by all threads */
+static int32 shm_stats[4];
+
+#ifdef SHM_SUPPORTED
+# define SHM_LOAD(p)		__atomic_load_n((p), __ATOMIC_ACQUIRE)
+# define SHM_LOAD_RELAXED(p)	__atomic_load_n((p), __ATOMIC_RELAXED)
+# define SHM_STORE(p, v)	__atomic_store_n((p), (v), __ATOMIC_RELEASE)
+# define SHM_CAS(p, e, d)	__atomic_compare_exchange_n((p), &(e), (d), 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)
+# define SHM_FENCE()		__atomic_thread_fence(__ATOMIC_ACQUIRE)
+# define SHM_WFENCE()		__atomic_thread_fence(__ATOMIC_RELEASE)
+# define SHM_COUNT(i)		__atomic_fetch_add(&shm_stats[i], 1, __ATOMIC_RELAXED)
+# define SHM_FLAG(i)		__atomic_store_n(&shm_stats[i], 1, __ATOMIC_RELAXED)
+#endif
+
+/* FNV-1a */
+static shm_u64 shm_hash(shm_u64 h, const void *data, size_t len)
+{
+  const unsigned char *p = (const unsigned char *) data;
+  size_t i;
+  for (i = 0; i < len; i++) {
+    h ^= p[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+#define SHM_HASH_INIT	14695981039346656037ULL
+
+static shm_u64 shm_file_key(int ifno)
+{
+  struct file_data *fdp = &swed.fidat[ifno];
+  shm_u64 h = shm_hash(SHM_HASH_INIT, fdp->fnam, strlen(fdp->fnam));
+  h = shm_hash(h, &fdp->sweph_denum, sizeof(fdp->sweph_denum));
+  h = shm_hash(h, &fdp->fversion, sizeof(fdp->fversion));
+  h = shm_hash(h, &fdp->tfstart, sizeof(fdp->tfstart));
+  return h;
+}
+
+/* key of files found in the ephemeris path (stars, delta t) */
+static shm_u64 shm_path_key(const char *fname)
+{
+  shm_u64 h = shm_hash(SHM_HASH_INIT, swed.ephepath, strlen(swed.ephepath));
+  return shm_hash(h, fname, strlen(fname));
+}
+
+#ifdef SHM_SUPPORTED
+static struct shm_seg_slot *shm_slots(void)
+{
+  return (struct shm_seg_slot *) ((char *) shm_hdr + shm_hdr->seg_offset);
+}
+
+static struct shm_star_region *shm_stars(void)
+{
+  return (struct shm_star_region *) ((char *) shm_hdr + shm_hdr->star_offset);
+}
+
+static struct shm_dt_region *shm_deltat(void)
+{
+  return (struct shm_dt_region *) ((char *) shm_hdr + shm_hdr->dt_offset);
+}
+
+static uint32 shm_slot_index(shm_u64 fkey, int32 ibdy, int32 iseg)
+{
+  shm_u64 h = shm_hash(fkey, &ibdy, sizeof(ibdy));
+  h = shm_hash(h, &iseg, sizeof(iseg));
+  return (uint32) (h % shm_hdr->nslots);
+}
+
+/* TRUE if the process that last locked a slot no longer exists */
+static AS_BOOL shm_writer_died(pid_t pid)
+{
+  if (pid <= 0 || pid == getpid())
+    return FALSE;
+  return kill(pid, 0) != 0 && errno == ESRCH;
+}
+#endif
+
+/* Copy a decoded segment for time tjd from the cache into pdp->segp.
+ * Returns OK on a hit; on ERR the caller reads the segment from file.
+ */
+int swi_shm_get_segment(int ipli, int ifno, double tjd)
+{
+#ifdef SHM_SUPPORTED
+  struct plan_data *pdp = &swed.pldat[ipli];
+  struct shm_seg_slot *slot;
+  shm_u64 fkey, seq;
+  uint32 idx;
+  int32 iseg;
+  int k, ncoef;
+  double tseg0, tseg1;
+  int neval;
+  if (shm_hdr == NULL || pdp->ncoe <= 0 || pdp->ncoe * 3 > SHM_SEG_NCOEF)
+    return ERR;
+  if (tjd < pdp->tfstart || tjd > pdp->tfend)
+    return ERR;
+  iseg = (int32) ((tjd - pdp->tfstart) / pdp->dseg);
+  fkey = shm_file_key(ifno);
+  idx = shm_slot_index(fkey, pdp->ibdy, iseg);
+  ncoef = pdp->ncoe * 3;
+  for (k = 0; k < SHM_PROBES; k++) {
+    slot = shm_slots() + (idx + k) % shm_hdr->nslots;
+    seq = SHM_LOAD(&slot->seq);
+    if (SHM_SEQ(seq) == 0 || (SHM_SEQ(seq) & 1))
+      continue;
+    if (slot->fkey != fkey || slot->ibdy != pdp->ibdy || slot->iseg != iseg
+	|| slot->ncoe != pdp->ncoe)
+      continue;
+    if (pdp->segp == NULL
+	&& (pdp->segp = (double *) malloc((size_t) ncoef * sizeof(double))) == NULL)
+      return ERR;
+    memcpy(pdp->segp, slot->coef, (size_t) ncoef * sizeof(double));
+    tseg0 = slot->tseg0;
+    tseg1 = slot->tseg1;
+    neval = slot->neval;
+    SHM_FENCE();
+    if (SHM_LOAD_RELAXED(&slot->seq) != seq)
+      return ERR;	/* overwritten while copying */
+    pdp->tseg0 = tseg0;
+    pdp->tseg1 = tseg1;
+    pdp->neval = neval;
+    SHM_COUNT(0);
+    return OK;
+  }
+#endif
+  return ERR;
+}
+
+/* Publish the segment just read into pdp->segp (after rot_back()). */
+void swi_shm_put_segment(int ipli, int ifno)
+{
+#ifdef SHM_SUPPORTED
+  struct plan_data *pdp = &swed.pldat[ipli];
+  struct shm_seg_slot *slot, *victim = NULL;
+  shm_u64 fkey, lock;
+  uint32 idx, seq;
+  pid_t pid = getpid();
+  int32 iseg;
+  int k, ncoef;
+  if (shm_hdr == NULL || pdp->segp == NULL || pdp->ncoe <= 0 || pdp->ncoe * 3 > SHM_SEG_NCOEF)
+    return;
+  iseg = (int32) ((pdp->tseg0 - pdp->tfstart) / pdp->dseg + 0.5);
+  fkey = shm_file_key(ifno);
+  idx = shm_slot_index(fkey, pdp->ibdy, iseg);
+  for (k = 0; k < SHM_PROBES; k++) {
+    slot = shm_slots() + (idx + k) % shm_hdr->nslots;
+    seq = SHM_SEQ(SHM_LOAD(&slot->seq));
+    if (seq == 0) {
+      victim = slot;
+      break;
+    }
+    if (!(seq & 1) && slot->fkey == fkey && slot->ibdy == pdp->ibdy && slot->iseg == iseg)
+      return;		/* another process was faster */
+  }
+  /* table full around idx: replace the home slot */
+  if (victim == NULL)
+    victim = shm_slots() + idx;
+  lock = SHM_LOAD_RELAXED(&victim->seq);
+  seq = SHM_SEQ(lock);
+  /* an odd slot is being written, unless its writer was killed; then
+   * it is taken over and stays odd until rewritten */
+  if ((seq & 1) && !shm_writer_died(SHM_WRITER(lock)))
+    return;
+  seq += (seq & 1) ? 2 : 1;
+  if (!SHM_CAS(&victim->seq, lock, SHM_LOCK(pid, seq)))
+    return;		/* somebody else is writing this slot */
+  /* the odd sequence must be visible before any of the data */
+  SHM_WFENCE();
+  ncoef = pdp->ncoe * 3;
+  victim->fkey = fkey;
+  victim->ibdy = pdp->ibdy;
+  victim->iseg = iseg;
+  victim->ncoe = pdp->ncoe;
+  victim->neval = pdp->neval;
+  victim->tseg0 = pdp->tseg0;
+  victim->tseg1 = pdp->tseg1;
+  memcpy(victim->coef, pdp->segp, (size_t) ncoef * sizeof(double));
+  SHM_STORE(&victim->seq, SHM_LOCK(pid, seq + 1));
+  SHM_COUNT(1);
+#endif
+}
+
+/* Use the shared fixed star array, if another process has loaded it
+ * from the same file. Returns OK if swed.fixed_stars now points into
+ * the shared segment.
+ */
+int swi_shm_get_fixstars(void)
+{
+#ifdef SHM_SUPPORTED
+  struct shm_star_region *reg;
+  if (shm_hdr == NULL)
+    return ERR;
+  reg = shm_stars();
+  if (SHM_LOAD(&reg->state) != SHM_REGION_READY || reg->key != shm_path_key(SE_STARFILE))
+    return ERR;
+  swed.fixed_stars = (struct fixed_star *) (reg + 1);
+  swed.n_fixstars_real = reg->nreal;
+  swed.n_fixstars_named = reg->nnamed;
+  swed.n_fixstars_records = reg->nrecs;
+  SHM_FLAG(2);
+  return OK;
+#else
+  return ERR;
+#endif
+}
+
+/* Publish the fixed star array just loaded; the calling thread then
+ * switches to the shared copy as well.
+ */
+void swi_shm_put_fixstars(void)
+{
+#ifdef SHM_SUPPORTED
+  struct shm_star_region *reg;
+  size_t nbytes;
+  uint32 state = SHM_REGION_EMPTY;
+  if (shm_hdr == NULL || swed.n_fixstars_records <= 0 || swi_shm_owns(swed.fixed_stars))
+    return;
+  reg = shm_stars();
+  if (!SHM_CAS(&reg->state, state, SHM_REGION_WRITING))
+    return;
+  nbytes = (size_t) swed.n_fixstars_records * sizeof(struct fixed_star);
+  if (nbytes > shm_hdr->star_capacity) {
+    SHM_STORE(&reg->state, SHM_REGION_TOO_SMALL);
+    return;
+  }
+  memcpy(reg + 1, swed.fixed_stars, nbytes);
+  reg->nrecs = swed.n_fixstars_records;
+  reg->nreal = swed.n_fixstars_real;
+  reg->nnamed = swed.n_fixstars_named;
+  reg->key = shm_path_key(SE_STARFILE);
+  SHM_STORE(&reg->state, SHM_REGION_READY);
+  free(swed.fixed_stars);
+  swed.fixed_stars = (struct fixed_star *) (reg + 1);
+  SHM_FLAG(2);
+#endif
+}
+
+/* TRUE if p points into a shared segment (must not be freed), also
+ * one that the process has detached from */
+AS_BOOL swi_shm_owns(void *p)
+{
+#ifdef SHM_SUPPORTED
+  int32 i, n = SHM_LOAD(&shm_nmaps);
+  if (p == NULL)
+    return FALSE;
+  for (i = 0; i < n; i++) {
+    if ((char *) p >= (char *) shm_maps[i]
+	&& (char *) p < (char *) shm_maps[i] + shm_maps[i]->total_size)
+      return TRUE;
+  }
+#endif
+  return FALSE;
+}
+
+/* Copy the delta t table read by another process.
+ * Returns OK if tab was filled, NOT_AVAILABLE if it is known that there
+ * is no delta t file, ERR if the table is not in the cache.
+ */
+int swi_shm_get_deltat(double *tab, int n)
+{
+#ifdef SHM_SUPPORTED
+  struct shm_dt_region *reg;
+  if (shm_hdr == NULL || n > SHM_DT_MAX)
+    return ERR;
+  reg = shm_deltat();
+  if (SHM_LOAD(&reg->state) != SHM_REGION_READY || reg->n != n
+      || reg->key != shm_path_key("swe_deltat.txt"))
+    return ERR;
+  SHM_FLAG(3);
+  if (!reg->found)
+    return NOT_AVAILABLE;
+  memcpy(tab, reg->tab, (size_t) n * sizeof(double));
+  return OK;
+#else
+  return ERR;
+#endif
+}
+
+void swi_shm_put_deltat(double *tab, int n, AS_BOOL found)
+{
+#ifdef SHM_SUPPORTED
+  struct shm_dt_region *reg;
+  uint32 state = SHM_REGION_EMPTY;
+  if (shm_hdr == NULL || n > SHM_DT_MAX)
+    return;
+  reg = shm_deltat();
+  if (!SHM_CAS(&reg->state, state, SHM_REGION_WRITING))
+    return;
+  reg->n = n;
+  reg->found = found;
+  reg->key = shm_path_key("swe_deltat.txt");
+  if (found)
+    memcpy(reg->tab, tab, (size_t) n * sizeof(double));
+  SHM_STORE(&reg->state, SHM_REGION_READY);
+#endif
+}
+
+#ifdef SHM_SUPPORTED
+static void shm_sleep_ms(int ms)
+{
+  struct timespec ts;
+  ts.tv_sec = 0;
+  ts.tv_nsec = (long) ms * 1000000L;
+  nanosleep(&ts, NULL);
+}
+
+static size_t shm_round(size_t n)
+{
+  return (n + SHM_PAGE - 1) / SHM_PAGE * SHM_PAGE;
+}
+
+/* Lay out and initialise a newly created segment */
+static void shm_format(struct shm_header *hdr, size_t total)
+{
+  size_t seg_offset, star_offset, dt_offset;
+  dt_offset = shm_round(sizeof(struct shm_header));
+  star_offset = shm_round(dt_offset + sizeof(struct shm_dt_region));
+  seg_offset = star_offset + SHM_STAR_BYTES;
+  /* ftruncate() filled everything with zeros: all regions are empty */
+  hdr->layout = SHM_LAYOUT_VERSION;
+  hdr->slot_size = sizeof(struct shm_seg_slot);
+  hdr->star_size = sizeof(struct fixed_star);
+  strncpy(hdr->version, SE_VERSION, sizeof(hdr->version) - 1);
+  hdr->total_size = total;
+  hdr->dt_offset = dt_offset;
+  hdr->star_offset = star_offset;
+  hdr->star_capacity = SHM_STAR_BYTES - sizeof(struct shm_star_region);
+  hdr->seg_offset = seg_offset;
+  hdr->nslots = (uint32) ((total - seg_offset) / sizeof(struct shm_seg_slot));
+  hdr->magic = SHM_MAGIC;
+  SHM_STORE(&hdr->state, SHM_STATE_READY);
+}
+
+static int shm_compatible(struct shm_header *hdr, char *serr)
+{
+  if (hdr->magic != SHM_MAGIC || hdr->layout != SHM_LAYOUT_VERSION
+      || hdr->slot_size != sizeof(struct shm_seg_slot)
+      || hdr->star_size != sizeof(struct fixed_star)
+      || strncmp(hdr->version, SE_VERSION, sizeof(hdr->version)) != 0) {
+    if (serr != NULL)
+      sprintf(serr, "shared cache has an incompatible layout (created by version %.15s)", hdr->version);
+    return ERR;
+  }
+  return OK;
+}
+#endif
+
+/* Attach to the shared cache `name` (e.g. "/swisseph"), creating it with
+ * size_mb megabytes if it does not exist yet. Later processes use the size
+ * chosen by the creator. name == NULL detaches.
+ * Call before the first calculation; all threads of the process use the
+ * same cache. The segment persists until swe_remove_shared_cache().
+ */
+int32 CALL_CONV swe_set_shared_cache(const char *name, int32 size_mb, char *serr)
+{
+#ifdef SHM_SUPPORTED
+  int fd, waited, i;
+  AS_BOOL created = FALSE;
+  size_t total;
+  struct stat st;
+  struct shm_header *hdr;
+  if (serr != NULL)
+    *serr = '\0';
+  /* Detaching keeps the mapping: star arrays of other threads may
+   * still point into it. */
+  shm_hdr = NULL;
+  if (name == NULL || *name == '\0')
+    return OK;
+  if (size_mb <= 0)
+    size_mb = SHM_DEFAULT_SIZE_MB;
+  if (size_mb < SHM_MIN_SIZE_MB)
+    size_mb = SHM_MIN_SIZE_MB;
+  total = (size_t) size_mb * 1024 * 1024;
+  fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd >= 0) {
+    created = TRUE;
+    if (ftruncate(fd, (off_t) total) != 0) {
+      if (serr != NULL)
+	sprintf(serr, "could not size shared cache %.80s: %.80s", name, strerror(errno));
+      close(fd);
+      shm_unlink(name);
+      return ERR;
+    }
+  } else if (errno == EEXIST) {
+    fd = shm_open(name, O_RDWR, 0600);
+  }
+  if (fd < 0) {
+    if (serr != NULL)
+      sprintf(serr, "could not open shared cache %.80s: %.80s", name, strerror(errno));
+    return ERR;
+  }
+  /* wait until the creator has sized the segment */
+  for (waited = 0; !created; waited++) {
+    if (fstat(fd, &st) == 0 && (size_t) st.st_size >= sizeof(struct shm_header)) {
+      total = (size_t) st.st_size;
+      break;
+    }
+    if (waited >= SHM_ATTACH_WAIT_MS) {
+      if (serr != NULL)
+	sprintf(serr, "shared cache %.80s was not initialised in time", name);
+      close(fd);
+      return ERR;
+    }
+    shm_sleep_ms(1);
+  }
+  if (created && fstat(fd, &st) != 0)
+    memset(&st, 0, sizeof(st));
+  /* attached before: use the same mapping again */
+  for (i = 0; i < shm_nmaps; i++) {
+    if (shm_map_dev[i] == st.st_dev && shm_map_ino[i] == st.st_ino && shm_maps[i]->total_size == total) {
+      close(fd);
+      shm_hdr = shm_maps[i];
+      for (i = 0; i < 4; i++)
+	__atomic_store_n(&shm_stats[i], 0, __ATOMIC_RELAXED);
+      return OK;
+    }
+  }
+  if (shm_nmaps >= SHM_MAX_MAPS) {
+    if (serr != NULL)
+      sprintf(serr, "too many shared caches attached (%d)", SHM_MAX_MAPS);
+    close(fd);
+    return ERR;
+  }
+  hdr = (struct shm_header *) mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (hdr == (struct shm_header *) MAP_FAILED) {
+    if (serr != NULL)
+      sprintf(serr, "could not map shared cache %.80s: %.80s", name, strerror(errno));
+    return ERR;
+  }
+  if (created) {
+    shm_format(hdr, total);
+  } else {
+    for (waited = 0; SHM_LOAD(&hdr->state) != SHM_STATE_READY; waited++) {
+      if (waited >= SHM_ATTACH_WAIT_MS) {
+	if (serr != NULL)
+	  sprintf(serr, "shared cache %.80s was not initialised in time", name);
+	munmap(hdr, total);
+	return ERR;
+      }
+      shm_sleep_ms(1);
+    }
+    if (shm_compatible(hdr, serr) != OK || hdr->total_size != total) {
+      munmap(hdr, total);
+      return ERR;
+    }
+  }
+  shm_maps[shm_nmaps] = hdr;
+  shm_map_dev[shm_nmaps] = st.st_dev;
+  shm_map_ino[shm_nmaps] = st.st_ino;
+  SHM_STORE(&shm_nmaps, shm_nmaps + 1);
+  shm_hdr = hdr;
+  for (i = 0; i < 4; i++)
+    __atomic_store_n(&shm_stats[i], 0, __ATOMIC_RELAXED);
+  return OK;
+#else
+  if (serr != NULL)
+    strcpy(serr, "shared cache is not supported on this platform");
+  if (name == NULL || *name == '\0')
+    return OK;
+  return ERR;
+#endif
+}
+
+/* Remove a shared cache segment. Processes attached to it keep using it;
+ * the memory is released when the last of them exits.
+ */
+int32 CALL_CONV swe_remove_shared_cache(const char *name, char *serr)
+{
+#ifdef SHM_SUPPORTED
+  if (shm_unlink(name) != 0 && errno != ENOENT) {
+    if (serr != NULL)
+      sprintf(serr, "could not remove shared cache %.80s: %.80s", name, strerror(errno));
+    return ERR;
+  }
+  return OK;
+#else
+  if (serr != NULL)
+    strcpy(serr, "shared cache is not supported on this platform");
+  return ERR;
+#endif
+}
+
+/* Statistics of this process since swe_set_shared_cache():
+ * stats[0]  segments taken from the cache
+ * stats[1]  segments stored into the cache
+ * stats[2]  1 if the fixed star array is shared
+ * stats[3]  1 if the delta t table was taken from the cache
+ * Returns ERR if no cache is attached.
+ */
+int32 CALL_CONV swe_get_shared_cache_stats(int32 *stats)
+{
+  int i;
+  for (i = 0; i < 4; i++) {
+#ifdef SHM_SUPPORTED
+    stats[i] = SHM_LOAD_RELAXED(&shm_stats[i]);
+#else
+    stats[i] = shm_stats[i];
+#endif
+  }
+  return shm_hdr != NULL ? OK : ERR;
+}
@@ -0,0 +1,90 @@
+/* Copyright (C) 1997 - 2021 Astrodienst AG, Switzerland.  All rights reserved.
+
+  License conditions
+  ------------------
+
+  This file is part of Swiss Ephemeris.
+
+  Swiss Ephemeris is distributed with NO WARRANTY OF ANY KIND.  No author
+  or distributor accepts any responsibility for the consequences of using it,
+  or for whether it serves any particular purpose or works at all, unless he
+  or she says so in writing.  
+
+  Swiss Ephemeris is made available by its authors under a dual licensing
+  system. The software developer, who uses any part of Swiss Ephemeris
+  in his or her software, must choose between one of the two license models,
+  which are
+  a) GNU Affero General Public License (AGPL)
+  b) Swiss Ephemeris Professional License
+
+  The choice must be made before the software developer distributes software
+  containing parts of Swiss Ephemeris to others, and before any public
+  service using the developed software is activated.
+
+  If the developer choses the AGPL software license, he or she must fulfill
+  the conditions of that license, which includes the obligation to place his
+  or her whole software project under the AGPL or a compatible license.
+  See https://www.gnu.org/licenses/agpl-3.0.html
+
+  If the developer choses the Swiss Ephemeris Professional license,
+  he must follow the instructions as found in http://www.astro.com/swisseph/ 
+  and purchase the Swiss Ephemeris Professional Edition from Astrodienst
+  and sign the corresponding license contract.
+
+  The License grants you the right to use, copy, modify and redistribute
+  Swiss Ephemeris, but only under certain conditions described in the License.
+  Among other things, the License requires that the copyright notices and
+  this notice be preserved on all copies.
+
+  Authors of the Swiss Ephemeris: Dieter Koch and Alois Treindl
+
+  The authors of Swiss Ephemeris have no control or influence over any of
+  the derived works, i.e. over software or services created by other
+  programmers which use Swiss Ephemeris functions.
+
+  The names of the authors or of the copyright holder (Astrodienst) must not
+  be used for promoting any software, product or service which uses or contains
+  the Swiss Ephemeris. This copyright notice is the ONLY place where the
+  names of the authors can legally appear, except in cases where they have
+  given special permission in writing.
+
+  The trademarks 'Swiss Ephemeris' and 'Swiss Ephemeris inside' may be used
+  for promoting such software, products or services.
+*/
+
+/* Cross-process shared-memory cache (POSIX shm).
+ *
+ * Several processes on one host (cluster workers, PM2 instances) can attach
+ * to one named shared-memory segment with swe_set_shared_cache(). The first
+ * process creates and formats it, the others attach. The segment holds
+ *   - decoded (and rotated) Chebyshev segments of the ephemeris files,
+ *   - the parsed and sorted fixed-star array of sefstars.txt,
+ *   - the delta t table read from swe_deltat.txt,
+ * so that warm-up work and memory for these do not grow with the number of
+ * processes.
+ *
+ * Concurrency: segment slots are protected by a sequence lock; a reader
+ * copies a slot and retries nothing - if the sequence changed during the
+ * copy, the lookup counts as a miss and the data are read from file as
+ * usual. The lock word also holds the pid of the writer: a slot that a
+ * killed process left locked is taken over by the next writer that finds
+ * the pid gone, so all processes attached to one cache must share a pid
+ * namespace. The star and delta t regions are written once and never
+ * change afterwards, so processes use them in place.
+ *
+ * The layout is versioned (SHM_LAYOUT_VERSION, Swiss Ephemeris version,
+ * record sizes). A process that finds an incompatible segment runs without
+ * the cache.
+ */
+
+#define SHM_LAYOUT_VERSION	2
+#define SHM_MIN_SIZE_MB		8
+#define SHM_DEFAULT_SIZE_MB	64
+
+extern int swi_shm_get_segment(int ipli, int ifno, double tjd);
+extern void swi_shm_put_segment(int ipli, int ifno);
+extern int swi_shm_get_fixstars(void);
+extern void swi_shm_put_fixstars(void);
+extern AS_BOOL swi_shm_owns(void *p);
+extern int swi_shm_get_deltat(double *tab, int n);
+extern void swi_shm_put_deltat(double *tab, int n, AS_BOOL found);
@@ -0,0 +1,172 @@
+#!/usr/bin/env node
+/**
+ * Swiss Ephemeris benchmark runner
+ *
+ * Runs the workloads against the native addon and the WASM build, appends the
+ * results to a JSON history and exits with status 1 when a workload is slower
+ * than the recent baseline by more than the threshold.
+ *
+ * Usage: node src/cli.mjs [options]
+ *
+ *   --targets <list>      node,wasm (default: every target that loads)
+ *   --workloads <list>    Workload names or groups, e.g. positions,houses/Koch
+ *   --min-time <ms>       Measuring time per workload (default: 500)
+ *   --cold-samples <n>    Processes per cold-init measurement (default: 5, 0 = skip)
+ *   --threshold <frac>    Allowed slowdown before failing (default: 0.10)
+ *   --window <n>          Earlier runs forming the baseline (default: 5)
+ *   --history <file>      History file (default: results/history.json)
+ *   --no-save             Compare only, do not append this run
+ *   --accept              Append this run even if it regressed
+ *   --json                Print this run as JSON on stdout
+ */
+
+import { execFileSync } from 'node:child_process';
+import path from 'node:path';
+import { fileURLToPath } from 'node:url';
+import { parseArgs } from 'node:util';
+
+import { formatNs, measure, median } from './harness.mjs';
+import {
+  compareWithHistory,
+  currentCommit,
+  describeEnvironment,
+  loadHistory,
+  saveHistory,
+} from './history.mjs';
+import { loadTarget, startEphemerisServer, TARGETS } from './targets.mjs';
+import { selectWorkloads } from './workloads.mjs';
+
+const here = path.dirname(fileURLToPath(import.meta.url));
+
+const { values: args } = parseArgs({
+  options: {
+    targets: { type: 'string' },
+    workloads: { type: 'string' },
+    'min-time': { type: 'string', default: '500' },
+    'cold-samples': { type: 'string', default: '5' },
+    threshold: { type: 'string', default: '0.10' },
+    window: { type: 'string', default: '5' },
+    history: { type: 'string', default: path.join(here, '..', 'results', 'history.json') },
+    'no-save': { type: 'boolean', default: false },
+    accept: { type: 'boolean', default: false },
+    json: { type: 'boolean', default: false },
+  },
+});
+
+const list = value => (value ? value.split(',').map(s => s.trim()).filter(Boolean) : []);
+const explicitTargets = list(args.targets);
+const targets = explicitTargets.length ? explicitTargets : TARGETS;
+const workloads = selectWorkloads(list(args.workloads));
+const minTime = Number(args['min-time']);
+const coldSamples = Number(args['cold-samples']);
+const threshold = Number(args.threshold);
+const window = Number(args.window);
+
+// Human-readable progress goes to stderr when stdout carries JSON
+const log = args.json ? (...a) => console.error(...a) : (...a) => console.log(...a);
+
+/**
+ * Time process start to first position in fresh processes
+ */
+function measureColdInit(target, ephemeris, ephemerisUrl) {
+  const script = path.join(here, 'cold-init.mjs');
+  const samples = [];
+  for (let i = 0; i < coldSamples; i++) {
+    const output = execFileSync(process.execPath, [script, target, ephemeris, ephemerisUrl], {
+      encoding: 'utf8',
+      stdio: ['ignore', 'pipe', 'inherit'],
+    });
+    samples.push(JSON.parse(output.trim().split('\n').pop()).ms * 1e6);
+  }
+  samples.sort((a, b) => a - b);
+  return {
+    nsPerItem: median(samples),
+    min: samples[0],
+    max: samples[samples.length - 1],
+    samples: samples.length,
+    items: samples.length,
+  };
+}
+
+async function main() {
+  const server = await startEphemerisServer();
+  const results = {};
+
+  try {
+    for (const targetName of targets) {
+      let target;
+      try {
+        target = await loadTarget(targetName, { ephemerisUrl: server.url });
+      } catch (e) {
+        if (explicitTargets.length) throw e;
+        log(`Skipping ${targetName}: ${e.message}`);
+        continue;
+      }
+
+      log(`\n${targetName}`);
+      for (const workload of workloads) {
+        if (!workload.requires.every(fn => typeof target.api[fn] === 'function')) {
+          log(`  ${workload.name.padEnd(24)} (not available)`);
+          continue;
+        }
+        const result = measure(workload.setup(target.api), { minTime });
+        results[`${targetName}:${workload.name}`] = result;
+        log(`  ${workload.name.padEnd(24)} ${formatNs(result.nsPerItem).padStart(10)} / item`);
+      }
+      target.close();
+
+      if (coldSamples > 0) {
+        for (const ephemeris of ['swiss', 'moshier']) {
+          const name = `init/${ephemeris}`;
+          const result = measureColdInit(targetName, ephemeris, server.url);
+          results[`${targetName}:${name}`] = result;
+          log(`  ${name.padEnd(24)} ${formatNs(result.nsPerItem).padStart(10)}`);
+        }
+      }
+    }
+  } finally {
+    await server.close();
+  }
+
+  if (Object.keys(results).length === 0) {
+    throw new Error('No target could be benchmarked; build @swisseph/node or @swisseph/browser first');
+  }
+
+  const run = {
+    timestamp: new Date().toISOString(),
+    commit: currentCommit(),
+    environment: describeEnvironment(),
+    settings: { minTime, coldSamples },
+    results,
+  };
+
+  const history = loadHistory(args.history);
+  const comparison = compareWithHistory(history, run, { threshold, window });
+  const regressions = comparison.filter(c => c.regression);
+
+  log(`\nCompared with the median of the last ${window} runs (threshold ${(threshold * 100).toFixed(0)}%):`);
+  for (const c of comparison) {
+    const change = c.change === null ? 'new' : `${c.change >= 0 ? '+' : ''}${(c.change * 100).toFixed(1)}%`;
+    log(`  ${c.regression ? '!' : ' '} ${c.id.padEnd(30)} ${change.padStart(8)}`);
+  }
+
+  if (!args['no-save'] && (regressions.length === 0 || args.accept)) {
+    history.runs.push(run);
+    saveHistory(args.history, history);
+    log(`\nSaved to ${args.history}`);
+  }
+
+  if (args.json) {
+    process.stdout.write(JSON.stringify({ run, comparison }, null, 2) + '\n');
+  }
+
+  if (regressions.length > 0) {
+    log(`\n${regressions.length} regression(s) beyond ${(threshold * 100).toFixed(0)}%`);
+    process.exitCode = 1;
+  }
+}
+
+main().catch(e => {
+  console.error(e);
+  process.exitCode = 2;
+});
@@ -0,0 +1,35 @@
+/**
+ * Cold initialization probe, run in a fresh process per sample
+ *
+ * Usage: node cold-init.mjs <node|wasm> <swiss|moshier> [ephemerisUrl]
+ *
+ * Prints the milliseconds from the first line of this script to the first
+ * computed position: module load, addon/WASM instantiation, ephemeris file
+ * opening (or download for WASM) and one calculation.
+ */
+
+import { performance } from 'node:perf_hooks';
+
+const start = performance.now();
+
+const [target, ephemeris, ephemerisUrl] = process.argv.slice(2);
+
+const { loadTarget } = await import('./targets.mjs');
+const { CalculationFlag, Planet } = await import('@swisseph/core');
+
+const swiss = ephemeris === 'swiss';
+const { api, close } = await loadTarget(target, {
+  ephemerisUrl: swiss ? ephemerisUrl : undefined,
+});
+const flags = (swiss ? CalculationFlag.SwissEphemeris : CalculationFlag.MoshierEphemeris) |
+  CalculationFlag.Speed;
+const position = api.calculatePosition(2451545.0, Planet.Moon, flags);
+
+const elapsed = performance.now() - start;
+close();
+
+if (swiss && (position.flags & CalculationFlag.SwissEphemeris) === 0) {
+  console.error('Swiss Ephemeris files were not used');
+  process.exit(1);
+}
+process.stdout.write(JSON.stringify({ ms: elapsed }) + '\n');
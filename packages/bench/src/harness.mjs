@@ -0,0 +1,75 @@
+/**
+ * Timing harness
+ *
+ * A workload's `run()` performs one batch of work and returns the number of
+ * items it computed (positions, house sets, eclipses, ...). The harness calls
+ * it until `minTime` has elapsed and reports nanoseconds per item. The median
+ * over batches is the headline figure because it ignores the occasional GC
+ * pause or scheduler hiccup; the spread is kept so noisy results are visible.
+ */
+
+const NS_PER_MS = 1e6;
+
+function nowNs() {
+  return process.hrtime.bigint();
+}
+
+/**
+ * Median of a list of numbers (not modified)
+ */
+export function median(values) {
+  const sorted = [...values].sort((a, b) => a - b);
+  const mid = sorted.length >> 1;
+  return sorted.length % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+}
+
+/**
+ * Measure one workload
+ *
+ * @param {() => number} run - Executes one batch, returns items computed
+ * @param {object} options
+ * @param {number} options.minTime - Minimum measuring time in ms
+ * @param {number} options.warmup - Warm-up time in ms (JIT, caches, file handles)
+ * @param {number} options.minSamples - Minimum number of batches
+ * @returns {{nsPerItem: number, min: number, max: number, samples: number, items: number}}
+ */
+export function measure(run, { minTime = 500, warmup = 100, minSamples = 5 } = {}) {
+  const warmupEnd = nowNs() + BigInt(Math.round(warmup * NS_PER_MS));
+  do {
+    run();
+  } while (nowNs() < warmupEnd);
+
+  const perItem = [];
+  let items = 0;
+  const start = nowNs();
+  const end = start + BigInt(Math.round(minTime * NS_PER_MS));
+  for (;;) {
+    const t0 = nowNs();
+    const count = run();
+    const t1 = nowNs();
+    if (!(count > 0)) {
+      throw new Error('Workload returned no items');
+    }
+    perItem.push(Number(t1 - t0) / count);
+    items += count;
+    if (t1 >= end && perItem.length >= minSamples) break;
+  }
+
+  perItem.sort((a, b) => a - b);
+  return {
+    nsPerItem: median(perItem),
+    min: perItem[0],
+    max: perItem[perItem.length - 1],
+    samples: perItem.length,
+    items,
+  };
+}
+
+/**
+ * Format nanoseconds for the console
+ */
+export function formatNs(ns) {
+  if (ns >= NS_PER_MS) return `${(ns / NS_PER_MS).toFixed(2)} ms`;
+  if (ns >= 1e3) return `${(ns / 1e3).toFixed(2)} µs`;
+  return `${ns.toFixed(0)} ns`;
+}
@@ -0,0 +1,93 @@
+/**
+ * Benchmark history and regression check
+ *
+ * The history file is a JSON document with one entry per run. Timings are
+ * only comparable on the same machine and runtime, so each run records an
+ * environment key and a new run is compared with the median of the last
+ * `window` runs that share it.
+ */
+
+import { execFileSync } from 'node:child_process';
+import { existsSync, mkdirSync, readFileSync, writeFileSync } from 'node:fs';
+import os from 'node:os';
+import path from 'node:path';
+
+import { median } from './harness.mjs';
+
+export const HISTORY_VERSION = 1;
+
+/**
+ * Describe the machine and runtime of this run
+ */
+export function describeEnvironment() {
+  const cpus = os.cpus();
+  const cpu = cpus.length ? cpus[0].model.trim() : 'unknown';
+  const environment = {
+    platform: process.platform,
+    arch: process.arch,
+    cpu,
+    cores: cpus.length,
+    node: process.version,
+  };
+  environment.key = [environment.platform, environment.arch, cpu, environment.node].join('|');
+  return environment;
+}
+
+/**
+ * Current git commit, if the tree is a checkout
+ */
+export function currentCommit() {
+  try {
+    return execFileSync('git', ['rev-parse', '--short', 'HEAD'], {
+      encoding: 'utf8',
+      stdio: ['ignore', 'pipe', 'ignore'],
+    }).trim();
+  } catch (e) {
+    return null;
+  }
+}
+
+export function loadHistory(file) {
+  if (!existsSync(file)) {
+    return { version: HISTORY_VERSION, runs: [] };
+  }
+  const history = JSON.parse(readFileSync(file, 'utf8'));
+  if (history.version !== HISTORY_VERSION || !Array.isArray(history.runs)) {
+    throw new Error(`${file} is not a version ${HISTORY_VERSION} benchmark history`);
+  }
+  return history;
+}
+
+export function saveHistory(file, history) {
+  mkdirSync(path.dirname(file), { recursive: true });
+  writeFileSync(file, JSON.stringify(history, null, 2) + '\n');
+}
+
+/**
+ * Compare a run with earlier runs from the same environment
+ *
+ * @param {object} history - Loaded history (not including `run`)
+ * @param {object} run - Current run
+ * @param {object} options
+ * @param {number} options.threshold - Allowed slowdown as a fraction (0.1 = 10%)
+ * @param {number} options.window - Number of earlier runs forming the baseline
+ * @returns {Array<{id: string, baseline: number | null, current: number, change: number | null, regression: boolean}>}
+ */
+export function compareWithHistory(history, run, { threshold, window }) {
+  const previous = history.runs
+    .filter(r => r.environment.key === run.environment.key)
+    .slice(-window);
+
+  return Object.entries(run.results).map(([id, result]) => {
+    const earlier = previous
+      .map(r => r.results[id])
+      .filter(Boolean)
+      .map(r => r.nsPerItem);
+    if (earlier.length === 0) {
+      return { id, baseline: null, current: result.nsPerItem, change: null, regression: false };
+    }
+    const baseline = median(earlier);
+    const change = result.nsPerItem / baseline - 1;
+    return { id, baseline, current: result.nsPerItem, change, regression: change > threshold };
+  });
+}
@@ -0,0 +1,113 @@
+/**
+ * Benchmark targets
+ *
+ * Both targets expose the calculation functions under the same names, so a
+ * workload is written once and run against the native addon and the WASM
+ * build. Everything runs offline: the WASM build reads the ephemeris files
+ * bundled with @swisseph/node through a loopback HTTP server, the same path
+ * `loadEphemerisFiles()` takes in a browser.
+ */
+
+import { createReadStream, statSync } from 'node:fs';
+import { createServer } from 'node:http';
+import { createRequire } from 'node:module';
+import path from 'node:path';
+import { fileURLToPath } from 'node:url';
+
+export const TARGETS = ['node', 'wasm'];
+
+export const EPHEMERIS_FILES = ['sepl_18.se1', 'semo_18.se1', 'seas_18.se1'];
+
+export const EPHEMERIS_DIR = fileURLToPath(new URL('../../node/ephemeris/', import.meta.url));
+
+/**
+ * Serve the bundled ephemeris directory on 127.0.0.1
+ *
+ * @returns {Promise<{url: string, close: () => Promise<void>}>}
+ */
+export function startEphemerisServer(dir = EPHEMERIS_DIR) {
+  const server = createServer((req, res) => {
+    const name = path.basename(decodeURIComponent(new URL(req.url, 'http://x').pathname));
+    const file = path.join(dir, name);
+    let size;
+    try {
+      size = statSync(file).size;
+    } catch (e) {
+      res.writeHead(404).end();
+      return;
+    }
+    res.writeHead(200, { 'Content-Length': size, 'Content-Type': 'application/octet-stream' });
+    createReadStream(file).pipe(res);
+  });
+
+  return new Promise((resolve, reject) => {
+    server.once('error', reject);
+    server.listen(0, '127.0.0.1', () => {
+      const { port } = server.address();
+      resolve({
+        url: `http://127.0.0.1:${port}`,
+        close: () => new Promise(done => server.close(() => done())),
+      });
+    });
+  });
+}
+
+async function loadNodeTarget() {
+  const module = await import('@swisseph/node');
+  const api = module.default ?? module;
+  return { name: 'node', api, close: () => api.close() };
+}
+
+/**
+ * @param {object} options
+ * @param {string} [options.ephemerisUrl] - Base URL of the ephemeris server;
+ *   without it the WASM build only has the Moshier ephemeris
+ */
+async function loadWasmTarget({ ephemerisUrl } = {}) {
+  const entry = import.meta.resolve('@swisseph/browser');
+  const distDir = path.dirname(fileURLToPath(entry));
+
+  // The Emscripten glue is a classic script with `export default` appended;
+  // its Node branch expects the CommonJS globals.
+  globalThis.require ??= createRequire(entry);
+  globalThis.__dirname ??= distDir;
+
+  const { SwissEphemeris } = await import(entry);
+  const api = new SwissEphemeris();
+  await quietly(() => api.init(path.join(distDir, 'swisseph.wasm')));
+  if (ephemerisUrl) {
+    await api.loadEphemerisFiles(
+      EPHEMERIS_FILES.map(name => ({ name, url: `${ephemerisUrl}/${name}` }))
+    );
+  }
+  return { name: 'wasm', api, close: () => api.close() };
+}
+
+/**
+ * Run `fn` with console.log silenced (init banners)
+ */
+async function quietly(fn) {
+  const log = console.log;
+  console.log = () => {};
+  try {
+    return await fn();
+  } finally {
+    console.log = log;
+  }
+}
+
+/**
+ * Load a target by name
+ *
+ * @param {'node' | 'wasm'} name
+ */
+export function loadTarget(name, options) {
+  switch (name) {
+    case 'node':
+      return loadNodeTarget(options);
+    case 'wasm':
+      return loadWasmTarget(options);
+    default:
+      throw new Error(`Unknown target "${name}" (expected one of ${TARGETS.join(', ')})`);
+  }
+}
@@ -0,0 +1,197 @@
+/**
+ * Benchmark workloads
+ *
+ * Each workload prepares its inputs once in `setup(api)` and returns the
+ * batch function timed by the harness. Inputs are deterministic so results
+ * are comparable between runs. `requires` lists the API functions a workload
+ * needs; targets that lack one of them skip it.
+ */
+
+import {
+  CalculationFlag,
+  HouseSystem,
+  Planet,
+  PositionSeries,
+  RiseTransitFlag,
+} from '@swisseph/core';
+
+const SWISS = CalculationFlag.SwissEphemeris | CalculationFlag.Speed;
+
+/** 2000-01-01 12:00 UT */
+const J2000 = 2451545.0;
+
+/** Deterministic date spread over 1900-2100 */
+function dates(count, step = 73.0491) {
+  const days = new Float64Array(count);
+  for (let i = 0; i < count; i++) {
+    days[i] = J2000 - 36525 + ((i * step) % 73050);
+  }
+  return days;
+}
+
+/** Deterministic locations between the polar circles */
+function locations(count) {
+  const lat = new Float64Array(count);
+  const lon = new Float64Array(count);
+  for (let i = 0; i < count; i++) {
+    lat[i] = -65 + ((i * 37.3) % 130);
+    lon[i] = -180 + ((i * 91.7) % 360);
+  }
+  return { lat, lon };
+}
+
+const POSITION_BODIES = [
+  Planet.Sun, Planet.Moon, Planet.Mercury, Planet.Venus, Planet.Mars,
+  Planet.Jupiter, Planet.Saturn, Planet.Uranus, Planet.Neptune, Planet.Pluto,
+];
+
+const HOUSE_SYSTEMS = [
+  'Placidus', 'Koch', 'Porphyrius', 'Regiomontanus', 'Campanus',
+  'Equal', 'WholeSign', 'Alcabitus', 'Morinus', 'PolichPage',
+];
+
+export const WORKLOADS = [
+  {
+    name: 'positions/single',
+    group: 'positions',
+    requires: ['calculatePosition'],
+    setup(api) {
+      const days = dates(1000);
+      return () => {
+        for (const body of POSITION_BODIES) {
+          for (let i = 0; i < days.length; i++) {
+            api.calculatePosition(days[i], body, SWISS);
+          }
+        }
+        return POSITION_BODIES.length * days.length;
+      };
+    },
+  },
+  {
+    name: 'positions/bulk',
+    group: 'positions',
+    requires: ['calculatePositionSeries'],
+    setup(api) {
+      const days = dates(1000);
+      const target = new PositionSeries(days.length);
+      target.julianDays.set(days);
+      return () => {
+        for (const body of POSITION_BODIES) {
+          api.calculatePositionSeries(target.julianDays, body, SWISS, target);
+        }
+        return POSITION_BODIES.length * days.length;
+      };
+    },
+  },
+  {
+    name: 'positions/topocentric',
+    group: 'positions',
+    requires: ['calculatePosition', 'setTopocentric'],
+    setup(api) {
+      const days = dates(1000);
+      const flags = SWISS | CalculationFlag.Topocentric;
+      return () => {
+        api.setTopocentric(-74.006, 40.7128, 10);
+        for (const body of POSITION_BODIES) {
+          for (let i = 0; i < days.length; i++) {
+            api.calculatePosition(days[i], body, flags);
+          }
+        }
+        return POSITION_BODIES.length * days.length;
+      };
+    },
+  },
+  ...HOUSE_SYSTEMS.map(system => ({
+    name: `houses/${system}`,
+    group: 'houses',
+    requires: ['calculateHouses'],
+    setup(api) {
+      const days = dates(500);
+      const { lat, lon } = locations(500);
+      const hsys = HouseSystem[system];
+      return () => {
+        for (let i = 0; i < days.length; i++) {
+          api.calculateHouses(days[i], lat[i], lon[i], hsys);
+        }
+        return days.length;
+      };
+    },
+  })),
+  {
+    name: 'houses/bulk',
+    group: 'houses',
+    requires: ['calculateHouseSeries'],
+    setup(api) {
+      const days = dates(500);
+      const { lat, lon } = locations(500);
+      return () => {
+        api.calculateHouseSeries(days, lat, lon, HouseSystem.Placidus);
+        return days.length;
+      };
+    },
+  },
+  {
+    name: 'eclipses/lunar',
+    group: 'eclipses',
+    requires: ['findNextLunarEclipse'],
+    setup(api) {
+      return () => {
+        let jd = J2000;
+        for (let i = 0; i < 10; i++) {
+          jd = api.findNextLunarEclipse(jd, SWISS).maximum + 1;
+        }
+        return 10;
+      };
+    },
+  },
+  {
+    name: 'eclipses/solar',
+    group: 'eclipses',
+    requires: ['findNextSolarEclipse'],
+    setup(api) {
+      return () => {
+        let jd = J2000;
+        for (let i = 0; i < 10; i++) {
+          jd = api.findNextSolarEclipse(jd, SWISS).maximum + 1;
+        }
+        return 10;
+      };
+    },
+  },
+  {
+    name: 'riseset/sun',
+    group: 'riseset',
+    requires: ['calculateRiseTransitSet'],
+    setup(api) {
+      const { lat, lon } = locations(50);
+      return () => {
+        for (let i = 0; i < lat.length; i++) {
+          api.calculateRiseTransitSet(J2000 + i, Planet.Sun, RiseTransitFlag.Rise, lon[i], lat[i], 0, SWISS);
+        }
+        return lat.length;
+      };
+    },
+  },
+  {
+    name: 'riseset/moon',
+    group: 'riseset',
+    requires: ['calculateRiseTransitSet'],
+    setup(api) {
+      const { lat, lon } = locations(50);
+      return () => {
+        for (let i = 0; i < lat.length; i++) {
+          api.calculateRiseTransitSet(J2000 + i, Planet.Moon, RiseTransitFlag.Rise, lon[i], lat[i], 0, SWISS);
+        }
+        return lat.length;
+      };
+    },
+  },
+];
+
+/**
+ * Workloads matching a list of name prefixes (all when empty)
+ */
+export function selectWorkloads(filters) {
+  if (!filters || filters.length === 0) return WORKLOADS;
+  return WORKLOADS.filter(w => filters.some(f => w.name === f || w.name.startsWith(`${f}/`) || w.group === f));
+}
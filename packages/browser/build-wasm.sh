@@ -31,7 +31,12 @@ SOURCES=(
     "$SWE_DIR/swemmoon.c"
     "$SWE_DIR/swemplan.c"
     "$SWE_DIR/swehouse.c"
+    "$SWE_DIR/swedirs.c"
+    "$SWE_DIR/sweshm.c"
     "$SWE_DIR/swecl.c"
+    "$SWE_DIR/swememo.c"
+    "$SWE_DIR/sweidx.c"
+    "$SWE_DIR/sweparan.c"
     "$SWE_DIR/swehel.c"
     "src/swisseph_wasm.c"
 )
@@ -46,10 +51,13 @@ EXPORTED_FUNCTIONS='[
     "_swe_julday_wrap",
     "_swe_revjul_wrap",
     "_swe_calc_ut_wrap",
+    "_swe_calc_ut_series_wrap",
     "_swe_get_planet_name_wrap",
     "_swe_lun_eclipse_when_wrap",
     "_swe_sol_eclipse_when_glob_wrap",
+    "_swe_heliacal_ut_wrap",
     "_swe_houses_wrap",
+    "_swe_houses_series_wrap",
     "_swe_set_sid_mode_wrap",
     "_swe_get_ayanamsa_ut_wrap",
     "_swe_get_ayanamsa_ex_ut_wrap",
@@ -65,11 +73,11 @@ emcc ${SOURCES[@]} \
     -o "$OUT_DIR/swisseph.js" \
     -s WASM=1 \
     -s EXPORTED_FUNCTIONS="$EXPORTED_FUNCTIONS" \
-    -s EXPORTED_RUNTIME_METHODS='["ccall","cwrap","getValue","setValue","UTF8ToString","stringToUTF8","lengthBytesUTF8","allocateUTF8","FS"]' \
+    -s EXPORTED_RUNTIME_METHODS='["ccall","cwrap","getValue","setValue","UTF8ToString","stringToUTF8","lengthBytesUTF8","allocateUTF8","FS","HEAPF64","HEAP32"]' \
     -s ALLOW_MEMORY_GROWTH=1 \
     -s MODULARIZE=1 \
     -s EXPORT_NAME="SwissEphModule" \
-    -s ENVIRONMENT='web,worker' \
+    -s ENVIRONMENT='web,worker,node' \
     -s FILESYSTEM=1 \
     -s FORCE_FILESYSTEM=1 \
     -O3 \
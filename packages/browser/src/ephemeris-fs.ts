@@ -0,0 +1,324 @@
+/**
+ * Byte-range backed ephemeris files for the Emscripten filesystem
+ *
+ * Ephemeris files are exposed to the C library as read-only filesystem nodes
+ * whose `read` operation copies straight from fetched ArrayBuffer chunks into
+ * the WASM heap. Nothing is written to MEMFS, so a file is held in memory once,
+ * and chunks that have not been downloaded yet are fetched by HTTP range
+ * requests when the C readers (`swi_fopen`/`do_fread`) first touch them.
+ */
+
+/**
+ * Ephemeris file to download
+ */
+export interface EphemerisFileSource {
+  /** File name as expected by Swiss Ephemeris (e.g. 'sepl_18.se1') */
+  name: string;
+
+  /** Download URL */
+  url: string;
+}
+
+/**
+ * Options for SwissEphemeris.mountEphemerisFiles()
+ */
+export interface MountEphemerisOptions {
+  /** Size of a range request in bytes (default: 64 KiB) */
+  chunkSize?: number;
+
+  /**
+   * Download the rest of each file in the background after mounting
+   * (default: true). Without prefetching, chunks are only fetched when read,
+   * which requires a Web Worker (synchronous XHR).
+   */
+  prefetch?: boolean;
+}
+
+export const DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+/** WASI errno used by the Emscripten filesystem for I/O errors */
+const EIO = 29;
+
+/**
+ * Thrown when a chunk is needed synchronously but cannot be fetched
+ */
+export class ChunkUnavailableError extends Error {
+  constructor(url: string, index: number) {
+    super(
+      `Ephemeris data for ${url} (chunk ${index}) is not downloaded yet. ` +
+      `Await swe.ephemerisReady() or run calculations in a Web Worker.`
+    );
+    this.name = 'ChunkUnavailableError';
+  }
+}
+
+/**
+ * Synchronous binary XHR is only allowed in workers
+ */
+function canFetchSynchronously(): boolean {
+  const scope = globalThis as any;
+  return (
+    typeof XMLHttpRequest !== 'undefined' &&
+    typeof scope.WorkerGlobalScope !== 'undefined' &&
+    scope instanceof scope.WorkerGlobalScope
+  );
+}
+
+/**
+ * Parse a `Content-Range: bytes start-end/size` header
+ *
+ * The size is null when the server reports it as unknown (`*`).
+ */
+function parseContentRange(header: string | null): { start: number; end: number; size: number | null } | null {
+  const match = header ? /^\s*bytes\s+(\d+)-(\d+)\/(\d+|\*)\s*$/.exec(header) : null;
+  if (!match) return null;
+  return {
+    start: parseInt(match[1], 10),
+    end: parseInt(match[2], 10),
+    size: match[3] === '*' ? null : parseInt(match[3], 10),
+  };
+}
+
+/**
+ * Remote file split into fixed-size chunks that are filled on demand
+ */
+export class RangeFile {
+  private readonly chunks: Array<Uint8Array | undefined>;
+  private missing: number;
+
+  private constructor(
+    readonly url: string,
+    readonly size: number,
+    readonly chunkSize: number
+  ) {
+    this.chunks = new Array(Math.ceil(size / chunkSize));
+    this.missing = this.chunks.length;
+  }
+
+  /**
+   * Create a file from data that is already in memory (no copy)
+   */
+  static fromBuffer(url: string, buffer: ArrayBuffer, chunkSize: number = DEFAULT_CHUNK_SIZE): RangeFile {
+    const file = new RangeFile(url, buffer.byteLength, chunkSize);
+    for (let i = 0; i < file.chunks.length; i++) {
+      const start = i * chunkSize;
+      file.store(i, new Uint8Array(buffer, start, Math.min(chunkSize, buffer.byteLength - start)));
+    }
+    return file;
+  }
+
+  /**
+   * Open a remote file by fetching its first chunk, which also yields its size
+   *
+   * Servers that ignore the Range header return the whole file, which is
+   * then used as is. A partial first chunk is not kept; it is fetched again
+   * when read.
+   */
+  static async open(url: string, chunkSize: number = DEFAULT_CHUNK_SIZE): Promise<RangeFile> {
+    const response = await fetch(url, { headers: { Range: `bytes=0-${chunkSize - 1}` } });
+    if (!response.ok) {
+      throw new Error(`Failed to download ${url}: ${response.statusText}`);
+    }
+
+    const data = await response.arrayBuffer();
+    if (response.status !== 206) {
+      return RangeFile.fromBuffer(url, data, chunkSize);
+    }
+
+    const range = parseContentRange(response.headers.get('Content-Range'));
+    if (range === null || range.size === null) {
+      throw new Error(`Failed to download ${url}: missing Content-Range header`);
+    }
+
+    const file = new RangeFile(url, range.size, chunkSize);
+    file.storeChunk(0, range, new Uint8Array(data));
+    return file;
+  }
+
+  /** True once every chunk is in memory */
+  get complete(): boolean {
+    return this.missing === 0;
+  }
+
+  /**
+   * Copy bytes into `buffer` (the WASM heap), fetching missing chunks
+   * synchronously where the environment allows it
+   *
+   * @returns Number of bytes read (0 at end of file)
+   */
+  read(buffer: Uint8Array, offset: number, length: number, position: number): number {
+    if (position >= this.size) return 0;
+
+    const end = Math.min(this.size, position + length);
+    let pos = position;
+    while (pos < end) {
+      const index = Math.floor(pos / this.chunkSize);
+      const chunk = this.chunks[index] ?? this.fetchChunkSync(index);
+      const from = pos - index * this.chunkSize;
+      const count = Math.min(chunk.length - from, end - pos);
+      if (count <= 0) {
+        throw new Error(`Failed to download ${this.url}: chunk ${index} is incomplete`);
+      }
+      buffer.set(chunk.subarray(from, from + count), offset + (pos - position));
+      pos += count;
+    }
+    return end - position;
+  }
+
+  /**
+   * Download all missing chunks in one streamed range request
+   */
+  async prefetch(): Promise<void> {
+    const first = this.chunks.findIndex(chunk => chunk === undefined);
+    if (first < 0) return;
+
+    const start = first * this.chunkSize;
+    const response = await fetch(this.url, { headers: { Range: `bytes=${start}-` } });
+    if (!response.ok) {
+      throw new Error(`Failed to download ${this.url}: ${response.statusText}`);
+    }
+    // A server that ignores Range sends the file from byte 0
+    let offset = 0;
+    if (response.status === 206) {
+      const range = parseContentRange(response.headers.get('Content-Range'));
+      if (range === null || range.start !== start) {
+        throw new Error(`Failed to download ${this.url}: unexpected Content-Range`);
+      }
+      offset = start;
+    }
+
+    if (!response.body) {
+      this.storeRange(offset, new Uint8Array(await response.arrayBuffer()));
+      return;
+    }
+
+    // Assemble network pieces into chunk-aligned buffers as they arrive
+    const reader = response.body.getReader();
+    let index = Math.floor(offset / this.chunkSize);
+    let current = new Uint8Array(this.chunkLength(index));
+    let filled = 0;
+    for (;;) {
+      const { done, value } = await reader.read();
+      if (done) break;
+
+      let used = 0;
+      while (used < value.length && index < this.chunks.length) {
+        const count = Math.min(current.length - filled, value.length - used);
+        current.set(value.subarray(used, used + count), filled);
+        filled += count;
+        used += count;
+        if (filled === current.length) {
+          this.store(index, current);
+          index++;
+          if (index < this.chunks.length) {
+            current = new Uint8Array(this.chunkLength(index));
+          }
+          filled = 0;
+        }
+      }
+    }
+  }
+
+  private chunkLength(index: number): number {
+    return Math.min(this.chunkSize, this.size - index * this.chunkSize);
+  }
+
+  private store(index: number, data: Uint8Array): void {
+    if (this.chunks[index] === undefined) {
+      this.chunks[index] = data;
+      this.missing--;
+    }
+  }
+
+  /**
+   * Store a 206 body if it is exactly the requested chunk; anything else
+   * (short body, other range) leaves the chunk missing
+   */
+  private storeChunk(index: number, range: { start: number; end: number } | null, data: Uint8Array): void {
+    const length = this.chunkLength(index);
+    if (
+      range !== null &&
+      range.start === index * this.chunkSize &&
+      range.end - range.start + 1 === length &&
+      data.length === length
+    ) {
+      this.store(index, data);
+    }
+  }
+
+  private storeRange(offset: number, data: Uint8Array): void {
+    for (let pos = 0; pos < data.length; ) {
+      const index = Math.floor((offset + pos) / this.chunkSize);
+      const length = this.chunkLength(index);
+      if ((offset + pos) % this.chunkSize !== 0 || pos + length > data.length) break;
+      this.store(index, data.subarray(pos, pos + length));
+      pos += length;
+    }
+  }
+
+  private fetchChunkSync(index: number): Uint8Array {
+    if (!canFetchSynchronously()) {
+      throw new ChunkUnavailableError(this.url, index);
+    }
+
+    const start = index * this.chunkSize;
+    const xhr = new XMLHttpRequest();
+    xhr.open('GET', this.url, false);
+    xhr.setRequestHeader('Range', `bytes=${start}-${start + this.chunkLength(index) - 1}`);
+    xhr.responseType = 'arraybuffer';
+    xhr.send(null);
+    if (xhr.status !== 206 && xhr.status !== 200) {
+      throw new Error(`Failed to download ${this.url}: ${xhr.statusText}`);
+    }
+
+    const data = new Uint8Array(xhr.response as ArrayBuffer);
+    if (xhr.status === 200) {
+      this.storeRange(0, data);
+    } else {
+      this.storeChunk(index, parseContentRange(xhr.getResponseHeader('Content-Range')), data);
+    }
+
+    const chunk = this.chunks[index];
+    if (chunk === undefined) {
+      throw new Error(`Failed to download ${this.url}: incomplete response for chunk ${index}`);
+    }
+    return chunk;
+  }
+}
+
+/**
+ * Create a read-only Emscripten filesystem node backed by a RangeFile
+ *
+ * The node reuses the MEMFS operations for stat/seek (driven by `usedBytes`)
+ * and replaces `read` so that the C library reads from the chunks directly.
+ */
+export function createRangeFileNode(FS: any, dir: string, name: string, file: RangeFile): void {
+  const path = `${dir}/${name}`;
+  try {
+    FS.unlink(path);
+  } catch (e) {
+    // File did not exist yet
+  }
+
+  const node = FS.createFile(dir, name, {}, true, false);
+  node.contents = file;
+  Object.defineProperty(node, 'usedBytes', { get: () => file.size });
+
+  node.stream_ops = {
+    ...node.stream_ops,
+    read: (_stream: any, buffer: Uint8Array, offset: number, length: number, position: number) => {
+      try {
+        return file.read(buffer, offset, length, position);
+      } catch (e) {
+        console.warn((e as Error).message);
+        throw new FS.ErrnoError(EIO);
+      }
+    },
+    write: () => {
+      throw new FS.ErrnoError(EIO);
+    },
+    mmap: () => {
+      throw new FS.ErrnoError(EIO);
+    },
+  };
+}
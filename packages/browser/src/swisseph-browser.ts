@@ -20,6 +20,8 @@ import {
   SolarEclipse,
   DateTime,
   ExtendedDateTime,
+  HeliacalEvent,
+  HeliacalEventType,
   normalizeFlags,
   normalizeEclipseTypes,
   LunarEclipseImpl,
@@ -27,8 +29,21 @@ import {
   DateTimeImpl,
   CalculationFlag,
   CommonCalculationFlags,
+  PositionSeries,
+  HouseSeries,
+  POSITION_COMPONENTS,
+  HOUSE_CUSP_SLOTS,
+  HOUSE_ASCMC_SLOTS,
 } from '@swisseph/core';
 
+import {
+  EphemerisFileSource,
+  MountEphemerisOptions,
+  RangeFile,
+  DEFAULT_CHUNK_SIZE,
+  createRangeFileNode,
+} from './ephemeris-fs.js';
+
 /**
  * Emscripten Module interface
  */
@@ -46,15 +61,22 @@ interface EmscriptenModule {
   ) => any;
   allocateUTF8: (str: string) => number;
   getValue: (ptr: number, type: string) => number;
+  setValue: (ptr: number, value: number, type: string) => void;
+  stringToUTF8: (str: string, outPtr: number, maxBytesToWrite: number) => void;
   UTF8ToString: (ptr: number) => string;
   _malloc: (size: number) => number;
   _free: (ptr: number) => void;
+  HEAPF64: Float64Array;
+  HEAP32: Int32Array;
   FS: {
     mkdir: (path: string) => void;
     writeFile: (path: string, data: Uint8Array) => void;
     readFile: (path: string) => Uint8Array;
     unlink: (path: string) => void;
+    createFile: (parent: string, name: string, properties: object, canRead: boolean, canWrite: boolean) => any;
+    ErrnoError: new (errno: number) => Error;
   };
+  [key: string]: any;
 }
 
 /**
@@ -83,6 +105,9 @@ interface SwissEphModule extends EmscriptenModule {
 export class SwissEphemeris {
   private module: SwissEphModule | null = null;
   private ready: boolean = false;
+  private ephemerisDownloads: Promise<void>[] = [];
+  private scratchPtr: number = 0;
+  private scratchBytes: number = 0;
 
   // Wrapped C functions
   private _julday!: (
@@ -210,6 +235,19 @@ export class SwissEphemeris {
     }
   }
 
+  /**
+   * Heap buffer reused by bulk calculations (grows as needed)
+   */
+  private _scratch(bytes: number): number {
+    if (bytes > this.scratchBytes) {
+      const m = this.module!;
+      if (this.scratchPtr) m._free(this.scratchPtr);
+      this.scratchPtr = m._malloc(bytes);
+      this.scratchBytes = bytes;
+    }
+    return this.scratchPtr;
+  }
+
   /**
    * Get Swiss Ephemeris version string
    */
@@ -240,6 +278,9 @@ export class SwissEphemeris {
    * Simple one-line method to download standard ephemeris files (~2MB).
    * After loading, you can use CalculationFlag.SwissEphemeris for maximum precision.
    *
+   * @param options - Pass `{ onDemand: true }` to mount the files with
+   *   mountEphemerisFiles() instead of waiting for the full download
+   *
    * @example
    * // Simple: Load all standard files
    * await swe.loadStandardEphemeris();
@@ -247,19 +288,28 @@ export class SwissEphemeris {
    * // Then use Swiss Ephemeris for calculations
    * const sun = swe.calculatePosition(jd, Planet.Sun, CalculationFlag.SwissEphemeris);
    */
-  async loadStandardEphemeris(): Promise<void> {
+  async loadStandardEphemeris(
+    options: MountEphemerisOptions & { onDemand?: boolean } = {}
+  ): Promise<void> {
     const CDN_BASE = 'https://cdn.jsdelivr.net/gh/aloistr/swisseph/ephe';
-    await this.loadEphemerisFiles([
+    const files = [
       { name: 'sepl_18.se1', url: `${CDN_BASE}/sepl_18.se1` },
       { name: 'semo_18.se1', url: `${CDN_BASE}/semo_18.se1` },
       { name: 'seas_18.se1', url: `${CDN_BASE}/seas_18.se1` },
-    ]);
+    ];
+    if (options.onDemand) {
+      await this.mountEphemerisFiles(files, options);
+    } else {
+      await this.loadEphemerisFiles(files);
+    }
   }
 
   /**
    * Load Swiss Ephemeris data files from URLs
    *
-   * Downloads ephemeris files and writes them to the virtual filesystem.
+   * Downloads ephemeris files completely and exposes them to the WASM
+   * filesystem. The C library reads directly from the downloaded buffers;
+   * the data are not copied into MEMFS.
    * Use this for maximum precision calculations or custom file sources.
    *
    * @param files - Array of files to download with name and URL
@@ -280,20 +330,12 @@ export class SwissEphemeris {
    * // Then use Swiss Ephemeris
    * const sun = swe.calculatePosition(jd, Planet.Sun, CalculationFlag.SwissEphemeris);
    */
-  async loadEphemerisFiles(
-    files: Array<{ name: string; url: string }>
-  ): Promise<void> {
+  async loadEphemerisFiles(files: EphemerisFileSource[]): Promise<void> {
     this._checkReady();
     const m = this.module!;
+    this._ensureEphemerisDirectory();
 
-    // Create ephemeris directory in virtual filesystem
-    try {
-      m.FS.mkdir('/ephemeris');
-    } catch (e) {
-      // Directory might already exist, ignore
-    }
-
-    // Download and write each file
+    // Download each file and expose the buffer as a read-only node
     for (const file of files) {
       const response = await fetch(file.url);
       if (!response.ok) {
@@ -301,15 +343,81 @@ export class SwissEphemeris {
       }
 
       const arrayBuffer = await response.arrayBuffer();
-      const data = new Uint8Array(arrayBuffer);
-
-      m.FS.writeFile(`/ephemeris/${file.name}`, data);
+      createRangeFileNode(m.FS, '/ephemeris', file.name, RangeFile.fromBuffer(file.url, arrayBuffer));
     }
 
     // Set ephemeris path to virtual directory
     this.setEphemerisPath('/ephemeris');
   }
 
+  /**
+   * Mount Swiss Ephemeris data files without waiting for the full download
+   *
+   * Only the first chunk of each file (header and size) is fetched before
+   * this resolves. The remaining bytes are filled by HTTP range requests:
+   * in the background (`prefetch`, default) and, inside a Web Worker, on
+   * demand when the C library reads a range that has not arrived yet.
+   *
+   * On the main thread a calculation that needs data which have not been
+   * downloaded yet throws; await ephemerisReady() first or run calculations
+   * in a worker. The server must support range requests (any static server
+   * or CDN does).
+   *
+   * @param files - Array of files with name and URL
+   * @param options - Chunk size and background prefetching
+   *
+   * @example
+   * await swe.mountEphemerisFiles([
+   *   { name: 'sepl_18.se1', url: '/ephe/sepl_18.se1' },
+   *   { name: 'semo_18.se1', url: '/ephe/semo_18.se1' }
+   * ]);
+   * // ... later, or right away inside a worker
+   * await swe.ephemerisReady();
+   */
+  async mountEphemerisFiles(
+    files: EphemerisFileSource[],
+    options: MountEphemerisOptions = {}
+  ): Promise<void> {
+    this._checkReady();
+    const m = this.module!;
+    const chunkSize = options.chunkSize ?? DEFAULT_CHUNK_SIZE;
+    this._ensureEphemerisDirectory();
+
+    const rangeFiles = await Promise.all(files.map(file => RangeFile.open(file.url, chunkSize)));
+    rangeFiles.forEach((rangeFile, i) => {
+      createRangeFileNode(m.FS, '/ephemeris', files[i].name, rangeFile);
+      if (options.prefetch !== false && !rangeFile.complete) {
+        const download = rangeFile.prefetch();
+        download.catch(error => console.warn(`Ephemeris download failed: ${error.message}`));
+        this.ephemerisDownloads.push(download);
+      }
+    });
+
+    this.setEphemerisPath('/ephemeris');
+  }
+
+  /**
+   * Wait until all background ephemeris downloads have completed
+   *
+   * Resolves immediately if nothing is being downloaded.
+   */
+  async ephemerisReady(): Promise<void> {
+    const downloads = this.ephemerisDownloads;
+    this.ephemerisDownloads = [];
+    await Promise.all(downloads);
+  }
+
+  /**
+   * Create the ephemeris directory in the virtual filesystem
+   */
+  private _ensureEphemerisDirectory(): void {
+    try {
+      this.module!.FS.mkdir('/ephemeris');
+    } catch (e) {
+      // Directory might already exist, ignore
+    }
+  }
+
   /**
    * Calculate Julian day number from calendar date
    *
@@ -508,6 +616,65 @@ export class SwissEphemeris {
     };
   }
 
+  /**
+   * Calculate planetary positions for many Julian days at once
+   *
+   * Results are written into a structure-of-arrays PositionSeries
+   * (Float64Array columns) by a single WASM call. Pass `target` to reuse a
+   * series between calls; the WASM-side buffer is reused as well, so repeated
+   * bulk calculations allocate nothing.
+   *
+   * @param julianDays - Julian days in Universal Time
+   * @param body - Celestial body to calculate
+   * @param flags - Calculation flags (default: Moshier with speed)
+   * @param target - Optional series of the same length to fill
+   * @returns PositionSeries with one row per Julian day
+   *
+   * @example
+   * const days = new Float64Array(365).map((_, i) => jd + i);
+   * const moon = swe.calculatePositionSeries(days, Planet.Moon);
+   * console.log(moon.longitude[0], moon.at(10).latitude);
+   */
+  calculatePositionSeries(
+    julianDays: Float64Array | ArrayLike<number>,
+    body: CelestialBody,
+    flags: CalculationFlagInput = CommonCalculationFlags.DefaultMoshier,
+    target?: PositionSeries
+  ): PositionSeries {
+    this._checkReady();
+
+    const normalizedFlags = normalizeFlags(flags);
+    const n = julianDays.length;
+    const series = target ?? new PositionSeries(n);
+    if (series.length !== n) {
+      throw new RangeError(`Target series has ${series.length} rows, expected ${n}`);
+    }
+    if (series.julianDays !== julianDays) {
+      series.julianDays.set(julianDays);
+    }
+
+    const m = this.module!;
+    const tjdPtr = this._scratch(n * 8 * (1 + POSITION_COMPONENTS) + n * 4 + 256);
+    const outPtr = tjdPtr + n * 8;
+    const flagsPtr = outPtr + n * 8 * POSITION_COMPONENTS;
+    const serrPtr = flagsPtr + n * 4;
+
+    m.HEAPF64.set(series.julianDays, tjdPtr >> 3);
+    const computed = m.ccall(
+      'swe_calc_ut_series_wrap',
+      'number',
+      ['number', 'number', 'number', 'number', 'number', 'number', 'number'],
+      [tjdPtr, n, body, normalizedFlags, outPtr, flagsPtr, serrPtr]
+    );
+    if (computed < n) {
+      throw new Error(m.UTF8ToString(serrPtr) || `Failed to calculate position ${computed}`);
+    }
+
+    series.values.set(m.HEAPF64.subarray(outPtr >> 3, (outPtr >> 3) + n * POSITION_COMPONENTS));
+    series.flags.set(m.HEAP32.subarray(flagsPtr >> 2, (flagsPtr >> 2) + n));
+    return series;
+  }
+
   /**
    * Get celestial body name
    *
@@ -695,6 +862,80 @@ export class SwissEphemeris {
     );
   }
 
+  /**
+   * Find the next heliacal event of a planet or fixed star
+   *
+   * Atmospheric and observer conditions use the Swiss Ephemeris defaults
+   * (standard atmosphere for the given altitude, 36-year-old observer).
+   *
+   * @param startJulianDay - Julian day (UT) to start search from
+   * @param objectName - Planet or fixed star name (e.g. 'venus', 'sirius')
+   * @param eventType - Heliacal event to search for
+   * @param longitude - Geographic longitude in degrees (positive = east)
+   * @param latitude - Geographic latitude in degrees (positive = north)
+   * @param altitude - Altitude above sea level in meters
+   * @param flags - Calculation flags (default: Moshier)
+   * @returns HeliacalEvent with visibility start, optimum and end
+   *
+   * @example
+   * const rising = swe.findHeliacalEvent(jd, 'sirius', HeliacalEventType.HeliacalRising, 31.2, 30.0, 20);
+   */
+  findHeliacalEvent(
+    startJulianDay: number,
+    objectName: string,
+    eventType: HeliacalEventType,
+    longitude: number,
+    latitude: number,
+    altitude: number,
+    flags: CalculationFlagInput = CalculationFlag.MoshierEphemeris
+  ): HeliacalEvent {
+    this._checkReady();
+
+    const normalizedFlags = normalizeFlags(flags);
+    const m = this.module!;
+    const geoposPtr = m._malloc(3 * 8);
+    const datmPtr = m._malloc(4 * 8);
+    const dobsPtr = m._malloc(6 * 8);
+    const dretPtr = m._malloc(50 * 8);
+    const namePtr = m._malloc(256);
+    const serrPtr = m._malloc(256);
+
+    try {
+      m.setValue(geoposPtr, longitude, 'double');
+      m.setValue(geoposPtr + 8, latitude, 'double');
+      m.setValue(geoposPtr + 16, altitude, 'double');
+      for (let i = 0; i < 4; i++) m.setValue(datmPtr + i * 8, 0, 'double');
+      for (let i = 0; i < 6; i++) m.setValue(dobsPtr + i * 8, 0, 'double');
+      // swe_heliacal_ut() may write the normalized name back into the buffer
+      m.stringToUTF8(objectName, namePtr, 256);
+
+      const retflag = m.ccall(
+        'swe_heliacal_ut_wrap',
+        'number',
+        ['number', 'number', 'number', 'number', 'number', 'number', 'number', 'number', 'number'],
+        [startJulianDay, geoposPtr, datmPtr, dobsPtr, namePtr, eventType, normalizedFlags, dretPtr, serrPtr]
+      );
+
+      if (retflag < 0) {
+        const error = m.UTF8ToString(serrPtr);
+        throw new Error(error || 'Failed to calculate heliacal event');
+      }
+
+      return {
+        visibilityStart: m.getValue(dretPtr, 'double'),
+        optimum: m.getValue(dretPtr + 8, 'double'),
+        visibilityEnd: m.getValue(dretPtr + 16, 'double'),
+      };
+    } finally {
+      m._free(geoposPtr);
+      m._free(datmPtr);
+      m._free(dobsPtr);
+      m._free(dretPtr);
+      m._free(namePtr);
+      m._free(serrPtr);
+    }
+  }
+
   /**
    * Calculate house cusps and angles
    *
@@ -757,11 +998,74 @@ export class SwissEphemeris {
     };
   }
 
+  /**
+   * Calculate house cusps and angles for many dates and/or locations at once
+   *
+   * Row `i` uses `julianDays[i]`, `latitudes[i]` and `longitudes[i]`.
+   *
+   * @param julianDays - Julian days in Universal Time
+   * @param latitudes - Geographic latitudes
+   * @param longitudes - Geographic longitudes
+   * @param houseSystem - House system (default: Placidus)
+   * @param target - Optional series of the same length and house system to fill
+   * @returns HouseSeries with one row per input
+   */
+  calculateHouseSeries(
+    julianDays: Float64Array | ArrayLike<number>,
+    latitudes: Float64Array | ArrayLike<number>,
+    longitudes: Float64Array | ArrayLike<number>,
+    houseSystem: HouseSystem = HouseSystem.Placidus,
+    target?: HouseSeries
+  ): HouseSeries {
+    this._checkReady();
+
+    const n = julianDays.length;
+    if (latitudes.length !== n || longitudes.length !== n) {
+      throw new RangeError('julianDays, latitudes and longitudes must have the same length');
+    }
+    const series = target ?? new HouseSeries(n, houseSystem);
+    if (series.length !== n || series.houseSystem !== houseSystem) {
+      throw new RangeError('Target series does not match the requested length or house system');
+    }
+    if (series.julianDays !== julianDays) series.julianDays.set(julianDays);
+    if (series.latitudes !== latitudes) series.latitudes.set(latitudes);
+    if (series.longitudes !== longitudes) series.longitudes.set(longitudes);
+
+    const m = this.module!;
+    const tjdPtr = this._scratch(n * 8 * (3 + HOUSE_CUSP_SLOTS + HOUSE_ASCMC_SLOTS));
+    const latPtr = tjdPtr + n * 8;
+    const lonPtr = latPtr + n * 8;
+    const cuspsPtr = lonPtr + n * 8;
+    const ascmcPtr = cuspsPtr + n * 8 * HOUSE_CUSP_SLOTS;
+
+    m.HEAPF64.set(series.julianDays, tjdPtr >> 3);
+    m.HEAPF64.set(series.latitudes, latPtr >> 3);
+    m.HEAPF64.set(series.longitudes, lonPtr >> 3);
+    const computed = m.ccall(
+      'swe_houses_series_wrap',
+      'number',
+      ['number', 'number', 'number', 'number', 'number', 'number', 'number'],
+      [tjdPtr, latPtr, lonPtr, n, houseSystem.charCodeAt(0), cuspsPtr, ascmcPtr]
+    );
+    if (computed < n) {
+      throw new Error(`Failed to calculate houses for row ${computed}`);
+    }
+
+    series.cuspValues.set(m.HEAPF64.subarray(cuspsPtr >> 3, (cuspsPtr >> 3) + n * HOUSE_CUSP_SLOTS));
+    series.ascmcValues.set(m.HEAPF64.subarray(ascmcPtr >> 3, (ascmcPtr >> 3) + n * HOUSE_ASCMC_SLOTS));
+    return series;
+  }
+
   /**
    * Close Swiss Ephemeris and free resources
    */
   close(): void {
     if (this.ready) {
+      if (this.scratchPtr) {
+        this.module!._free(this.scratchPtr);
+        this.scratchPtr = 0;
+        this.scratchBytes = 0;
+      }
       this._close();
     }
   }
@@ -769,6 +1073,7 @@ export class SwissEphemeris {
 
 // Export all types
 export * from '@swisseph/core';
+export type { EphemerisFileSource, MountEphemerisOptions } from './ephemeris-fs.js';
 
 // Export singleton instance for convenience
 export const swisseph = new SwissEphemeris();
@@ -24,6 +24,24 @@ int swe_calc_ut_wrap(double tjd_ut, int ipl, int iflag, double *xx, char *serr)
     return swe_calc_ut(tjd_ut, ipl, iflag, xx, serr);
 }
 
+// Positions for a series of Julian days, written column by column:
+// out[c * n + i] is component c of row i. Returns the number of rows
+// computed; a value below n means row <return value> failed (see serr).
+EMSCRIPTEN_KEEPALIVE
+int swe_calc_ut_series_wrap(const double *tjd, int n, int ipl, int iflag, double *out, int *retflags, char *serr) {
+    double xx[6];
+    int i, c;
+    for (i = 0; i < n; i++) {
+        int ret = swe_calc_ut(tjd[i], ipl, iflag, xx, serr);
+        if (ret < 0)
+            return i;
+        for (c = 0; c < 6; c++)
+            out[c * n + i] = xx[c];
+        retflags[i] = ret;
+    }
+    return n;
+}
+
 EMSCRIPTEN_KEEPALIVE
 char* swe_get_planet_name_wrap(int ipl) {
     static char name[256];
@@ -41,11 +59,33 @@ int swe_sol_eclipse_when_glob_wrap(double tjd_start, int ifl, int ifltype, doubl
     return swe_sol_eclipse_when_glob(tjd_start, ifl, ifltype, tret, backward, serr);
 }
 
+EMSCRIPTEN_KEEPALIVE
+int swe_heliacal_ut_wrap(double tjd_start, double *geopos, double *datm, double *dobs, char *object_name, int type_event, int iflag, double *dret, char *serr) {
+    return swe_heliacal_ut(tjd_start, geopos, datm, dobs, object_name, type_event, iflag, dret, serr);
+}
+
 EMSCRIPTEN_KEEPALIVE
 int swe_houses_wrap(double tjd_ut, double geolat, double geolon, int hsys, double *cusps, double *ascmc) {
     return swe_houses(tjd_ut, geolat, geolon, hsys, cusps, ascmc);
 }
 
+// Houses for a series of dates/locations, written column by column:
+// cusps[k * n + i], ascmc[k * n + i]. Returns the number of rows computed.
+EMSCRIPTEN_KEEPALIVE
+int swe_houses_series_wrap(const double *tjd, const double *geolat, const double *geolon, int n, int hsys, double *cusps_out, double *ascmc_out) {
+    double cusps[13], ascmc[10];
+    int i, k;
+    for (i = 0; i < n; i++) {
+        if (swe_houses(tjd[i], geolat[i], geolon[i], hsys, cusps, ascmc) < 0)
+            return i;
+        for (k = 0; k < 13; k++)
+            cusps_out[k * n + i] = cusps[k];
+        for (k = 0; k < 10; k++)
+            ascmc_out[k * n + i] = ascmc[k];
+    }
+    return n;
+}
+
 EMSCRIPTEN_KEEPALIVE
 void swe_set_sid_mode_wrap(int sid_mode, double t0, double ayan_t0) {
     swe_set_sid_mode(sid_mode, t0, ayan_t0);
@@ -0,0 +1,199 @@
+import { ChunkUnavailableError, RangeFile } from '../src/ephemeris-fs';
+
+const URL_ = 'https://example.com/sepl_18.se1';
+const CHUNK = 16;
+
+/** File contents: byte i has value i & 0xff */
+function fileData(size: number): Uint8Array {
+  const data = new Uint8Array(size);
+  for (let i = 0; i < size; i++) data[i] = i & 0xff;
+  return data;
+}
+
+function parseRange(header: string | undefined): [number, number] | null {
+  const match = header ? /^bytes=(\d+)-(\d*)$/.exec(header) : null;
+  return match ? [parseInt(match[1], 10), match[2] ? parseInt(match[2], 10) : Infinity] : null;
+}
+
+interface ServerOptions {
+  /** Answer range requests with 200 and the whole file */
+  ignoreRange?: boolean;
+  /** Bytes cut from the end of every 206 body */
+  shortBy?: number;
+  /** Split response bodies into pieces of this size */
+  pieceSize?: number;
+}
+
+/**
+ * Mock HTTP server behind fetch() and synchronous XMLHttpRequest
+ */
+function mockServer(data: Uint8Array, options: ServerOptions = {}) {
+  const requests: string[] = [];
+
+  function respond(range: string | undefined): { status: number; body: Uint8Array; contentRange: string | null } {
+    requests.push(range ?? '');
+    const parsed = parseRange(range);
+    if (options.ignoreRange || parsed === null) {
+      return { status: 200, body: data, contentRange: null };
+    }
+    const start = parsed[0];
+    const end = Math.min(parsed[1], data.length - 1);
+    const body = data.slice(start, end + 1 - (options.shortBy ?? 0));
+    return { status: 206, body, contentRange: `bytes ${start}-${end}/${data.length}` };
+  }
+
+  function stream(body: Uint8Array): ReadableStream<Uint8Array> {
+    const pieceSize = options.pieceSize ?? body.length;
+    let pos = 0;
+    return new ReadableStream({
+      pull(controller) {
+        if (pos >= body.length) {
+          controller.close();
+          return;
+        }
+        controller.enqueue(body.slice(pos, pos + pieceSize));
+        pos += pieceSize;
+      },
+    });
+  }
+
+  (globalThis as any).fetch = jest.fn(async (_url: string, init?: { headers?: Record<string, string> }) => {
+    const { status, body, contentRange } = respond(init?.headers?.Range);
+    const headers = new Headers();
+    if (contentRange) headers.set('Content-Range', contentRange);
+    return new Response(stream(body), { status, headers });
+  });
+
+  class MockXMLHttpRequest {
+    status = 0;
+    statusText = '';
+    response: ArrayBuffer | null = null;
+    responseType = '';
+    private range: string | undefined;
+    private contentRange: string | null = null;
+
+    open(_method: string, _url: string, async: boolean): void {
+      expect(async).toBe(false);
+    }
+
+    setRequestHeader(name: string, value: string): void {
+      if (name === 'Range') this.range = value;
+    }
+
+    send(): void {
+      const { status, body, contentRange } = respond(this.range);
+      this.status = status;
+      this.statusText = status === 206 ? 'Partial Content' : 'OK';
+      this.response = body.slice().buffer;
+      this.contentRange = contentRange;
+    }
+
+    getResponseHeader(name: string): string | null {
+      return name === 'Content-Range' ? this.contentRange : null;
+    }
+  }
+
+  return { requests, MockXMLHttpRequest };
+}
+
+/** Pretend to run in a Web Worker with synchronous XHR */
+function enterWorker(xhr: unknown): void {
+  (globalThis as any).XMLHttpRequest = xhr;
+  (globalThis as any).WorkerGlobalScope = class {
+    static [Symbol.hasInstance](): boolean {
+      return true;
+    }
+  };
+}
+
+function readAll(file: RangeFile, length: number = file.size): Uint8Array {
+  const buffer = new Uint8Array(length);
+  expect(file.read(buffer, 0, length, 0)).toBe(length);
+  return buffer;
+}
+
+describe('RangeFile', () => {
+  const realFetch = globalThis.fetch;
+
+  afterEach(() => {
+    (globalThis as any).fetch = realFetch;
+    delete (globalThis as any).XMLHttpRequest;
+    delete (globalThis as any).WorkerGlobalScope;
+  });
+
+  test('fetches the first chunk and then missing chunks by range', async () => {
+    const data = fileData(5 * CHUNK + 3);
+    const server = mockServer(data);
+    enterWorker(server.MockXMLHttpRequest);
+
+    const file = await RangeFile.open(URL_, CHUNK);
+    expect(file.size).toBe(data.length);
+    expect(file.complete).toBe(false);
+    expect(server.requests).toEqual([`bytes=0-${CHUNK - 1}`]);
+
+    const buffer = new Uint8Array(10);
+    expect(file.read(buffer, 0, 10, 3 * CHUNK - 4)).toBe(10);
+    expect(buffer).toEqual(data.subarray(3 * CHUNK - 4, 3 * CHUNK + 6));
+    expect(server.requests.slice(1)).toEqual([
+      `bytes=${2 * CHUNK}-${3 * CHUNK - 1}`,
+      `bytes=${3 * CHUNK}-${4 * CHUNK - 1}`,
+    ]);
+
+    // the last chunk is shorter than the others
+    expect(file.read(buffer, 0, 10, data.length - 2)).toBe(2);
+    expect(buffer.subarray(0, 2)).toEqual(data.subarray(data.length - 2));
+    expect(file.read(buffer, 0, 10, data.length)).toBe(0);
+  });
+
+  test('uses the whole file when the server ignores Range', async () => {
+    const data = fileData(3 * CHUNK + 5);
+    const server = mockServer(data, { ignoreRange: true });
+
+    const file = await RangeFile.open(URL_, CHUNK);
+    expect(file.size).toBe(data.length);
+    expect(file.complete).toBe(true);
+    expect(readAll(file)).toEqual(data);
+    expect(server.requests).toHaveLength(1);
+  });
+
+  test('treats a short 206 body as a missing chunk', async () => {
+    const data = fileData(4 * CHUNK);
+    const server = mockServer(data, { shortBy: 3 });
+    enterWorker(server.MockXMLHttpRequest);
+
+    const file = await RangeFile.open(URL_, CHUNK);
+    expect(file.size).toBe(data.length);
+    expect(file.complete).toBe(false);
+
+    // the short first chunk was not kept and the refetch is short again
+    const buffer = new Uint8Array(CHUNK);
+    expect(() => file.read(buffer, 0, CHUNK, 0)).toThrow(/incomplete response for chunk 0/);
+    expect(() => file.read(buffer, 0, CHUNK, 2 * CHUNK)).toThrow(/incomplete response for chunk 2/);
+    expect(server.requests).toHaveLength(3);
+  });
+
+  test('throws ChunkUnavailableError for a missing chunk on the main thread', async () => {
+    const data = fileData(4 * CHUNK);
+    mockServer(data);
+
+    const file = await RangeFile.open(URL_, CHUNK);
+    const buffer = new Uint8Array(8);
+    expect(file.read(buffer, 0, 8, 4)).toBe(8);
+    expect(buffer).toEqual(data.subarray(4, 12));
+    expect(() => file.read(buffer, 0, 8, CHUNK)).toThrow(ChunkUnavailableError);
+  });
+
+  test('prefetch assembles streamed pieces across chunk boundaries', async () => {
+    const data = fileData(6 * CHUNK + 7);
+    const server = mockServer(data, { pieceSize: 7 });
+
+    const file = await RangeFile.open(URL_, CHUNK);
+    await file.prefetch();
+    expect(server.requests).toEqual([`bytes=0-${CHUNK - 1}`, `bytes=${CHUNK}-`]);
+    expect(file.complete).toBe(true);
+    expect(readAll(file)).toEqual(data);
+
+    await file.prefetch();
+    expect(server.requests).toHaveLength(2);
+  });
+});
@@ -381,6 +381,72 @@ export enum RiseTransitFlag {
   LowerTransit = 8
 }
 
+/**
+ * Coordinate system of the input/output of horizontal coordinate transforms
+ */
+export enum CoordinateSystem {
+  /** Ecliptic longitude/latitude (true equinox of date) */
+  Ecliptic = 0,
+  /** Right ascension/declination (true equinox of date) */
+  Equatorial = 1
+}
+
+/**
+ * Heliacal event type for heliacal visibility searches
+ */
+export enum HeliacalEventType {
+  /** Heliacal rising (morning first) */
+  HeliacalRising = 1,
+  /** Heliacal setting (evening last) */
+  HeliacalSetting = 2,
+  /** Evening first (inferior planets and Moon) */
+  EveningFirst = 3,
+  /** Morning last (inferior planets and Moon) */
+  MorningLast = 4
+}
+
+/**
+ * Method for nodes and apsides (combinable with FocalPoint)
+ */
+export enum NodeMethod {
+  /** Mean nodes/apsides (Sun to Neptune and Moon) */
+  Mean = 1,
+  /** Osculating nodes/apsides */
+  Osculating = 2,
+  /** Osculating, about the solar system barycentre for planets beyond Jupiter */
+  OsculatingBarycentric = 4,
+  /** Second focal point of the orbit instead of the aphelion */
+  FocalPoint = 256
+}
+
+/**
+ * Main phases of the Moon
+ */
+export enum MoonPhase {
+  /** New moon (elongation 0°) */
+  NewMoon = 0,
+  /** First quarter (elongation 90°) */
+  FirstQuarter = 1,
+  /** Full moon (elongation 180°) */
+  FullMoon = 2,
+  /** Last quarter (elongation 270°) */
+  LastQuarter = 3
+}
+
+/**
+ * Key converting arcs of primary directions into years
+ */
+export enum DirectionKey {
+  /** Ptolemy: 1° per year */
+  Ptolemy = 0,
+  /** Naibod: mean daily motion of the Sun, 0°59'08" per year */
+  Naibod = 1,
+  /** Cardan: 0°59'12" per year */
+  Cardan = 2,
+  /** Daily motion of the Sun in right ascension at birth */
+  SolarArc = 3
+}
+
 /**
  * Constants for special offsets
  */
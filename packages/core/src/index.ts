@@ -18,6 +18,11 @@ export {
   EclipseType,
   SiderealMode,
   RiseTransitFlag,
+  CoordinateSystem,
+  HeliacalEventType,
+  NodeMethod,
+  MoonPhase,
+  DirectionKey,
   CommonCalculationFlags,
   CommonEclipseTypes,
   AsteroidOffset,
@@ -38,11 +43,30 @@ export type {
   LunarEclipse,
   SolarEclipse,
   RiseTransitSet,
+  HeliacalEvent,
+  PlanetaryPhenomena,
+  PhenomenonExtremum,
+  OrbitalElements,
 } from './results.js';
 
 // Export implementation classes
 export { LunarEclipseImpl, SolarEclipseImpl, DateTimeImpl } from './implementations.js';
 
+// Export structure-of-arrays containers for bulk calculations
+export {
+  PositionSeries,
+  PositionView,
+  HouseSeries,
+  PhenomenaSeries,
+  NodesApsidesSeries,
+  OrbitalElementsSeries,
+  POSITION_COMPONENTS,
+  PHENOMENA_COMPONENTS,
+  ORBITAL_ELEMENT_COUNT,
+  HOUSE_CUSP_SLOTS,
+  HOUSE_ASCMC_SLOTS,
+} from './series.js';
+
 // Export flag utilities
 export {
   CalculationFlags,
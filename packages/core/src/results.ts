@@ -266,3 +266,111 @@ export interface RiseTransitSet {
   /** Event type (rise, set, or transit) */
   eventType: number;
 }
+
+/**
+ * Heliacal event result
+ * Result from findHeliacalEvent()
+ */
+export interface HeliacalEvent {
+  /** Start of visibility (Julian day, Universal Time) */
+  visibilityStart: number;
+
+  /** Optimum visibility (Julian day, Universal Time), 0 if not calculated */
+  optimum: number;
+
+  /** End of visibility (Julian day, Universal Time), 0 if not calculated */
+  visibilityEnd: number;
+}
+
+/**
+ * Planetary phenomena result
+ * Result from calculatePhenomena()
+ */
+export interface PlanetaryPhenomena {
+  /** Phase angle (Earth-body-Sun) in degrees */
+  phaseAngle: number;
+
+  /** Illuminated fraction of the disc (0-1) */
+  phase: number;
+
+  /** Elongation from the Sun in degrees */
+  elongation: number;
+
+  /** Apparent diameter of the disc in degrees */
+  apparentDiameter: number;
+
+  /** Apparent magnitude */
+  magnitude: number;
+
+  /** Horizontal parallax in degrees (Moon only, 0 otherwise) */
+  horizontalParallax: number;
+}
+
+/**
+ * Extremum of a planetary phenomenon
+ * Result from findGreatestElongations() and findGreatestBrilliancy()
+ */
+export interface PhenomenonExtremum {
+  /** Time of the extremum (Julian day, Universal Time) */
+  time: number;
+
+  /** Value at that time (degrees for elongation, magnitude for brilliancy) */
+  value: number;
+}
+
+/**
+ * Osculating orbital elements (Kepler elements)
+ * Result from OrbitalElementsSeries.get()
+ */
+export interface OrbitalElements {
+  /** Semimajor axis in AU */
+  semimajorAxis: number;
+
+  /** Eccentricity */
+  eccentricity: number;
+
+  /** Inclination in degrees */
+  inclination: number;
+
+  /** Longitude of the ascending node in degrees */
+  ascendingNode: number;
+
+  /** Argument of perihelion in degrees */
+  argumentOfPerihelion: number;
+
+  /** Longitude of perihelion in degrees */
+  longitudeOfPerihelion: number;
+
+  /** Mean anomaly in degrees */
+  meanAnomaly: number;
+
+  /** True anomaly in degrees */
+  trueAnomaly: number;
+
+  /** Eccentric anomaly in degrees */
+  eccentricAnomaly: number;
+
+  /** Mean longitude in degrees */
+  meanLongitude: number;
+
+  /** Sidereal orbital period in tropical years */
+  siderealPeriod: number;
+
+  /** Mean daily motion in degrees */
+  meanDailyMotion: number;
+
+  /** Tropical period in years */
+  tropicalPeriod: number;
+
+  /** Synodic period in days (negative for inner planets and the Moon) */
+  synodicPeriod: number;
+
+  /** Time of perihelion passage (Julian day, TT) */
+  perihelionPassage: number;
+
+  /** Perihelion distance in AU */
+  perihelionDistance: number;
+
+  /** Aphelion distance in AU */
+  aphelionDistance: number;
+}
@@ -0,0 +1,337 @@
+/**
+ * Swiss Ephemeris Type Definitions - Structure-of-Arrays Result Containers
+ *
+ * Bulk calculations return one container per call instead of one object per
+ * result. Every quantity is a Float64Array column, and the native bindings
+ * write straight into the backing buffers, so a computation over millions of
+ * dates allocates no per-row JavaScript objects. Row views are created only
+ * when asked for and can be reused.
+ */
+
+import { HouseSystem, HousePoint } from './enums.js';
+import { OrbitalElements, PlanetaryPhenomena, PlanetaryPosition } from './results.js';
+
+/**
+ * Number of quantities per position (xx[0..5] of swe_calc_ut)
+ */
+export const POSITION_COMPONENTS = 6;
+
+/**
+ * Number of cusp slots per house result (cusps[0..12] of swe_houses)
+ */
+export const HOUSE_CUSP_SLOTS = 13;
+
+/**
+ * Number of angle slots per house result (ascmc[0..9] of swe_houses)
+ */
+export const HOUSE_ASCMC_SLOTS = 10;
+
+/**
+ * Number of quantities per phenomena result (attr[0..5] of swe_pheno_ut)
+ */
+export const PHENOMENA_COMPONENTS = 6;
+
+/**
+ * Number of values per orbital element set (dret[0..16] of swe_get_orbital_elements)
+ */
+export const ORBITAL_ELEMENT_COUNT = 17;
+
+/**
+ * Series of planetary positions for one body over many Julian days
+ *
+ * `values` holds the six components column by column
+ * (all longitudes, then all latitudes, ...); the named columns are views
+ * into it.
+ *
+ * @example
+ * const series = calculatePositionSeries(julianDays, Planet.Moon);
+ * let max = -Infinity;
+ * for (let i = 0; i < series.length; i++) {
+ *   max = Math.max(max, series.longitudeSpeed[i]);
+ * }
+ */
+export class PositionSeries {
+  /** Julian days (UT) of the rows */
+  readonly julianDays: Float64Array;
+
+  /** Backing store: POSITION_COMPONENTS columns of `length` values */
+  readonly values: Float64Array;
+
+  /** Return flags per row */
+  readonly flags: Int32Array;
+
+  readonly longitude: Float64Array;
+  readonly latitude: Float64Array;
+  readonly distance: Float64Array;
+  readonly longitudeSpeed: Float64Array;
+  readonly latitudeSpeed: Float64Array;
+  readonly distanceSpeed: Float64Array;
+
+  constructor(readonly length: number) {
+    this.julianDays = new Float64Array(length);
+    this.values = new Float64Array(length * POSITION_COMPONENTS);
+    this.flags = new Int32Array(length);
+
+    this.longitude = this.column(0);
+    this.latitude = this.column(1);
+    this.distance = this.column(2);
+    this.longitudeSpeed = this.column(3);
+    this.latitudeSpeed = this.column(4);
+    this.distanceSpeed = this.column(5);
+  }
+
+  /**
+   * View of one component (0 = longitude ... 5 = distance speed)
+   */
+  column(component: number): Float64Array {
+    return this.values.subarray(component * this.length, (component + 1) * this.length);
+  }
+
+  /**
+   * Lazy view of one row
+   *
+   * @param index - Row index
+   * @param reuse - View to repoint instead of allocating a new one
+   */
+  at(index: number, reuse?: PositionView): PositionView {
+    if (reuse) {
+      reuse.index = index;
+      return reuse;
+    }
+    return new PositionView(this, index);
+  }
+
+  /**
+   * Copy one row into a plain PlanetaryPosition object
+   */
+  toPosition(index: number): PlanetaryPosition {
+    return {
+      longitude: this.longitude[index],
+      latitude: this.latitude[index],
+      distance: this.distance[index],
+      longitudeSpeed: this.longitudeSpeed[index],
+      latitudeSpeed: this.latitudeSpeed[index],
+      distanceSpeed: this.distanceSpeed[index],
+      flags: this.flags[index],
+    };
+  }
+}
+
+/**
+ * Row view into a PositionSeries, shaped like PlanetaryPosition
+ */
+export class PositionView implements PlanetaryPosition {
+  constructor(private readonly series: PositionSeries, public index: number) {}
+
+  get julianDay(): number { return this.series.julianDays[this.index]; }
+  get longitude(): number { return this.series.longitude[this.index]; }
+  get latitude(): number { return this.series.latitude[this.index]; }
+  get distance(): number { return this.series.distance[this.index]; }
+  get longitudeSpeed(): number { return this.series.longitudeSpeed[this.index]; }
+  get latitudeSpeed(): number { return this.series.latitudeSpeed[this.index]; }
+  get distanceSpeed(): number { return this.series.distanceSpeed[this.index]; }
+  get flags(): number { return this.series.flags[this.index]; }
+}
+
+/**
+ * Series of house calculations (one row per date/location)
+ *
+ * `cuspValues` holds cusp slots 0-12 and `ascmcValues` the ten angle slots,
+ * both column by column.
+ */
+export class HouseSeries {
+  /** Julian days (UT) of the rows */
+  readonly julianDays: Float64Array;
+
+  /** Geographic latitudes of the rows */
+  readonly latitudes: Float64Array;
+
+  /** Geographic longitudes of the rows */
+  readonly longitudes: Float64Array;
+
+  /** Backing store: HOUSE_CUSP_SLOTS columns of `length` values */
+  readonly cuspValues: Float64Array;
+
+  /** Backing store: HOUSE_ASCMC_SLOTS columns of `length` values */
+  readonly ascmcValues: Float64Array;
+
+  readonly ascendant: Float64Array;
+  readonly mc: Float64Array;
+  readonly armc: Float64Array;
+  readonly vertex: Float64Array;
+
+  constructor(readonly length: number, readonly houseSystem: HouseSystem) {
+    this.julianDays = new Float64Array(length);
+    this.latitudes = new Float64Array(length);
+    this.longitudes = new Float64Array(length);
+    this.cuspValues = new Float64Array(length * HOUSE_CUSP_SLOTS);
+    this.ascmcValues = new Float64Array(length * HOUSE_ASCMC_SLOTS);
+
+    this.ascendant = this.point(HousePoint.Ascendant);
+    this.mc = this.point(HousePoint.MC);
+    this.armc = this.point(HousePoint.ARMC);
+    this.vertex = this.point(HousePoint.Vertex);
+  }
+
+  /**
+   * View of one house cusp over all rows (1-12)
+   */
+  cusp(house: number): Float64Array {
+    return this.cuspValues.subarray(house * this.length, (house + 1) * this.length);
+  }
+
+  /**
+   * View of one angle over all rows
+   */
+  point(point: HousePoint): Float64Array {
+    return this.ascmcValues.subarray(point * this.length, (point + 1) * this.length);
+  }
+}
+
+/**
+ * Series of planetary phenomena for one body at equidistant times
+ *
+ * `values` holds the six quantities column by column, like PositionSeries.
+ *
+ * @example
+ * const venus = calculatePhenomenaSeries(jd, 1, 584, Planet.Venus);
+ * const brightest = venus.magnitude.indexOf(Math.min(...venus.magnitude));
+ */
+export class PhenomenaSeries {
+  /** Julian days (UT) of the rows */
+  readonly julianDays: Float64Array;
+
+  /** Backing store: PHENOMENA_COMPONENTS columns of `length` values */
+  readonly values: Float64Array;
+
+  readonly phaseAngle: Float64Array;
+  readonly phase: Float64Array;
+  readonly elongation: Float64Array;
+  readonly apparentDiameter: Float64Array;
+  readonly magnitude: Float64Array;
+  readonly horizontalParallax: Float64Array;
+
+  constructor(readonly length: number) {
+    this.julianDays = new Float64Array(length);
+    this.values = new Float64Array(length * PHENOMENA_COMPONENTS);
+
+    this.phaseAngle = this.column(0);
+    this.phase = this.column(1);
+    this.elongation = this.column(2);
+    this.apparentDiameter = this.column(3);
+    this.magnitude = this.column(4);
+    this.horizontalParallax = this.column(5);
+  }
+
+  /**
+   * View of one quantity (0 = phase angle ... 5 = horizontal parallax)
+   */
+  column(component: number): Float64Array {
+    return this.values.subarray(component * this.length, (component + 1) * this.length);
+  }
+
+  /**
+   * Copy one row into a plain PlanetaryPhenomena object
+   */
+  toPhenomena(index: number): PlanetaryPhenomena {
+    return {
+      phaseAngle: this.phaseAngle[index],
+      phase: this.phase[index],
+      elongation: this.elongation[index],
+      apparentDiameter: this.apparentDiameter[index],
+      magnitude: this.magnitude[index],
+      horizontalParallax: this.horizontalParallax[index],
+    };
+  }
+}
+
+/**
+ * Nodes and apsides of several bodies over many Julian days
+ *
+ * Each array holds POSITION_COMPONENTS values per date and body, row by
+ * row: the point of body `b` at date `d` starts at `offset(d, b)`.
+ */
+export class NodesApsidesSeries {
+  /** Julian days (UT) of the dates */
+  readonly julianDays: Float64Array;
+
+  readonly ascendingNode: Float64Array;
+  readonly descendingNode: Float64Array;
+  readonly perihelion: Float64Array;
+  readonly aphelion: Float64Array;
+
+  constructor(readonly length: number, readonly bodies: readonly number[]) {
+    const size = length * bodies.length * POSITION_COMPONENTS;
+    this.julianDays = new Float64Array(length);
+    this.ascendingNode = new Float64Array(size);
+    this.descendingNode = new Float64Array(size);
+    this.perihelion = new Float64Array(size);
+    this.aphelion = new Float64Array(size);
+  }
+
+  /**
+   * Index of the first component of body number `body` (index into
+   * `bodies`) at date number `date`
+   */
+  offset(date: number, body: number): number {
+    return (date * this.bodies.length + body) * POSITION_COMPONENTS;
+  }
+}
+
+/**
+ * Osculating orbital elements of several bodies over many Julian days
+ *
+ * `values` holds ORBITAL_ELEMENT_COUNT values per date and body, row by row.
+ */
+export class OrbitalElementsSeries {
+  /** Julian days (UT) of the dates */
+  readonly julianDays: Float64Array;
+
+  /** Backing store: ORBITAL_ELEMENT_COUNT values per date and body */
+  readonly values: Float64Array;
+
+  constructor(readonly length: number, readonly bodies: readonly number[]) {
+    this.julianDays = new Float64Array(length);
+    this.values = new Float64Array(length * bodies.length * ORBITAL_ELEMENT_COUNT);
+  }
+
+  /**
+   * Element `element` (0 = semimajor axis ... 16 = aphelion distance) of
+   * body number `body` at every date
+   */
+  element(element: number, body: number): Float64Array {
+    const out = new Float64Array(this.length);
+    const stride = this.bodies.length * ORBITAL_ELEMENT_COUNT;
+    for (let d = 0, i = body * ORBITAL_ELEMENT_COUNT + element; d < this.length; d++, i += stride) {
+      out[d] = this.values[i];
+    }
+    return out;
+  }
+
+  /**
+   * Copy the elements of body number `body` at date number `date` into an object
+   */
+  get(date: number, body: number): OrbitalElements {
+    const v = this.values;
+    const o = (date * this.bodies.length + body) * ORBITAL_ELEMENT_COUNT;
+    return {
+      semimajorAxis: v[o],
+      eccentricity: v[o + 1],
+      inclination: v[o + 2],
+      ascendingNode: v[o + 3],
+      argumentOfPerihelion: v[o + 4],
+      longitudeOfPerihelion: v[o + 5],
+      meanAnomaly: v[o + 6],
+      trueAnomaly: v[o + 7],
+      eccentricAnomaly: v[o + 8],
+      meanLongitude: v[o + 9],
+      siderealPeriod: v[o + 10],
+      meanDailyMotion: v[o + 11],
+      tropicalPeriod: v[o + 12],
+      synodicPeriod: v[o + 13],
+      perihelionPassage: v[o + 14],
+      perihelionDistance: v[o + 15],
+      aphelionDistance: v[o + 16],
+    };
+  }
+}
@@ -12,7 +12,13 @@
         "libswe/swemplan.c",
         "libswe/swehouse.c",
         "libswe/swecl.c",
-        "libswe/swehel.c"
+        "libswe/swehel.c",
+        "libswe/sweshm.c",
+        "libswe/swememo.c",
+        "libswe/sweidx.c",
+        "libswe/sweparan.c",
+        "libswe/swedirs.c",
+        "libswe/sweaspect.c"
       ],
       "include_dirs": [
         "<!@(node -p \"require('node-addon-api').include\")",
@@ -42,7 +48,8 @@
           "cflags_cc": ["-std=c++14", "-stdlib=libc++"]
         }],
         ["OS=='linux'", {
-          "cflags_cc": ["-std=c++14"]
+          "cflags_cc": ["-std=c++14"],
+          "libraries": ["-lrt"]
         }],
         ["OS=='win'", {
           "msvs_settings": {
@@ -2,6 +2,9 @@
 #include <napi.h>
 #include "swephexp.h"
 #include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
 
 // Wrapper for swe_set_ephe_path
 Napi::Value SetEphePath(const Napi::CallbackInfo& info) {
@@ -108,6 +111,154 @@ Napi::Value CalcUt(const Napi::CallbackInfo& info) {
   return result;
 }
 
+// Wrapper for swe_calc_ut over a series of Julian days
+// Writes structure-of-arrays output: out[c * n + i] is component c of row i
+Napi::Value CalcUtSeries(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 5 || !info[0].IsTypedArray() || !info[3].IsTypedArray() || !info[4].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd (Float64Array), ipl, iflag, out (Float64Array), retflags (Int32Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array tjdArray = info[0].As<Napi::Float64Array>();
+  int32 ipl = info[1].As<Napi::Number>().Int32Value();
+  int32 iflag = info[2].As<Napi::Number>().Int32Value();
+  Napi::Float64Array outArray = info[3].As<Napi::Float64Array>();
+  Napi::Int32Array retflagsArray = info[4].As<Napi::Int32Array>();
+
+  size_t n = tjdArray.ElementLength();
+  if (outArray.ElementLength() < 6 * n || retflagsArray.ElementLength() < n) {
+    Napi::RangeError::New(env, "Output arrays are too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const double *tjd = tjdArray.Data();
+  double *out = outArray.Data();
+  int32_t *retflags = retflagsArray.Data();
+  double xx[6];
+  char serr[256];
+
+  for (size_t i = 0; i < n; i++) {
+    int32 ret = swe_calc_ut(tjd[i], ipl, iflag, xx, serr);
+    if (ret < 0) {
+      Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    for (size_t c = 0; c < 6; c++) {
+      out[c * n + i] = xx[c];
+    }
+    retflags[i] = ret;
+  }
+
+  return env.Undefined();
+}
+
+// Wrapper for swe_calc_ut_multi_sid
+// Writes out[6 * k + c], component c for sidereal mode k
+Napi::Value CalcUtMultiSid(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 5 || !info[3].IsTypedArray() || !info[4].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut, ipl, iflag, sid_modes (Int32Array), out (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double tjd_ut = info[0].As<Napi::Number>().DoubleValue();
+  int32 ipl = info[1].As<Napi::Number>().Int32Value();
+  int32 iflag = info[2].As<Napi::Number>().Int32Value();
+  Napi::Int32Array modesArray = info[3].As<Napi::Int32Array>();
+  Napi::Float64Array outArray = info[4].As<Napi::Float64Array>();
+
+  size_t n = modesArray.ElementLength();
+  if (outArray.ElementLength() < 6 * n) {
+    Napi::RangeError::New(env, "Output array is too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  char serr[256];
+  int32 ret = swe_calc_ut_multi_sid(tjd_ut, ipl, iflag, modesArray.Data(), (int32) n, outArray.Data(), serr);
+
+  if (ret < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ret);
+}
+
+// Wrapper for swe_calc_topo_batch
+// geopos holds (longitude, latitude, altitude) per observer; writes
+// out[6 * k + c], component c for observer k
+Napi::Value CalcTopoBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 5 || !info[3].IsTypedArray() || !info[4].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut, ipl, iflag, geopos (Float64Array), out (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double tjd_ut = info[0].As<Napi::Number>().DoubleValue();
+  int32 ipl = info[1].As<Napi::Number>().Int32Value();
+  int32 iflag = info[2].As<Napi::Number>().Int32Value();
+  Napi::Float64Array geoposArray = info[3].As<Napi::Float64Array>();
+  Napi::Float64Array outArray = info[4].As<Napi::Float64Array>();
+
+  size_t n = geoposArray.ElementLength() / 3;
+  if (outArray.ElementLength() < 6 * n) {
+    Napi::RangeError::New(env, "Output array is too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  char serr[256];
+  int32 ret = swe_calc_topo_batch(tjd_ut, ipl, iflag, geoposArray.Data(), (int32) n, outArray.Data(), serr);
+
+  if (ret < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ret);
+}
+
+// Wrapper for swe_calc_pctr_multi
+// Takes Universal Time; writes out[6 * k + c], component c for body k
+Napi::Value CalcPctrMulti(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 5 || !info[2].IsTypedArray() || !info[4].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut, iplctr, ipl (Int32Array), iflag, out (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double tjd_ut = info[0].As<Napi::Number>().DoubleValue();
+  int32 iplctr = info[1].As<Napi::Number>().Int32Value();
+  Napi::Int32Array iplArray = info[2].As<Napi::Int32Array>();
+  int32 iflag = info[3].As<Napi::Number>().Int32Value();
+  Napi::Float64Array outArray = info[4].As<Napi::Float64Array>();
+
+  size_t n = iplArray.ElementLength();
+  if (outArray.ElementLength() < 6 * n) {
+    Napi::RangeError::New(env, "Output array is too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  char serr[256];
+  double tjd_et = tjd_ut + swe_deltat_ex(tjd_ut, iflag, serr);
+  int32 ret = swe_calc_pctr_multi(tjd_et, iplctr, iplArray.Data(), (int32) n, iflag, outArray.Data(), serr);
+
+  if (ret < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ret);
+}
+
 // Wrapper for swe_close
 Napi::Value Close(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
@@ -207,6 +358,315 @@ Napi::Value SolEclipseWhenGlob(const Napi::CallbackInfo& info) {
   return result;
 }
 
+// Wrapper for swe_pheno_ut_series
+// Writes structure-of-arrays output for attr[0..5]: out[c * n + i] is
+// attribute c at tjd_ut + i * step
+Napi::Value PhenoUtSeries(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 5 || !info[4].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut, step, ipl, iflag, out (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double tjd_ut = info[0].As<Napi::Number>().DoubleValue();
+  double step = info[1].As<Napi::Number>().DoubleValue();
+  int32 ipl = info[2].As<Napi::Number>().Int32Value();
+  int32 iflag = info[3].As<Napi::Number>().Int32Value();
+  Napi::Float64Array outArray = info[4].As<Napi::Float64Array>();
+
+  size_t n = outArray.ElementLength() / 6;
+  double *out = outArray.Data();
+  const size_t chunk = 64;
+  double attr[20 * chunk];
+  char serr[256];
+  int32 ret = 0;
+
+  for (size_t i0 = 0; i0 < n; i0 += chunk) {
+    size_t m = n - i0 < chunk ? n - i0 : chunk;
+    ret = swe_pheno_ut_series(tjd_ut + i0 * step, step, (int32) m, ipl, iflag, attr, serr);
+    if (ret < 0) {
+      Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    for (size_t i = 0; i < m; i++) {
+      for (size_t c = 0; c < 6; c++) {
+        out[c * n + i0 + i] = attr[20 * i + c];
+      }
+    }
+  }
+
+  return Napi::Number::New(env, ret);
+}
+
+// Wrapper for swe_pheno_ut_planets
+// Writes out[6 * k + c], attribute c of body k
+Napi::Value PhenoUtPlanets(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 4 || !info[1].IsTypedArray() || !info[3].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut, ipl (Int32Array), iflag, out (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double tjd_ut = info[0].As<Napi::Number>().DoubleValue();
+  Napi::Int32Array iplArray = info[1].As<Napi::Int32Array>();
+  int32 iflag = info[2].As<Napi::Number>().Int32Value();
+  Napi::Float64Array outArray = info[3].As<Napi::Float64Array>();
+
+  size_t n = iplArray.ElementLength();
+  if (outArray.ElementLength() < 6 * n) {
+    Napi::RangeError::New(env, "Output array is too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double *out = outArray.Data();
+  const size_t chunk = 16;
+  double attr[20 * chunk];
+  char serr[256];
+  int32 ret = 0;
+
+  for (size_t k0 = 0; k0 < n; k0 += chunk) {
+    size_t m = n - k0 < chunk ? n - k0 : chunk;
+    ret = swe_pheno_ut_planets(tjd_ut, iplArray.Data() + k0, (int32) m, iflag, attr, serr);
+    if (ret < 0) {
+      Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    for (size_t k = 0; k < m; k++) {
+      for (size_t c = 0; c < 6; c++) {
+        out[6 * (k0 + k) + c] = attr[20 * k + c];
+      }
+    }
+  }
+
+  return Napi::Number::New(env, ret);
+}
+
+// Wrapper for swe_pheno_ut_extrema
+// Fills tret/xret with the extrema found and returns their number
+Napi::Value PhenoUtExtrema(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 9 || !info[7].IsTypedArray() || !info[8].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut, step, n, ipl, iflag, iattr, sign, tret (Float64Array), xret (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double tjd_ut = info[0].As<Napi::Number>().DoubleValue();
+  double step = info[1].As<Napi::Number>().DoubleValue();
+  int32 n = info[2].As<Napi::Number>().Int32Value();
+  int32 ipl = info[3].As<Napi::Number>().Int32Value();
+  int32 iflag = info[4].As<Napi::Number>().Int32Value();
+  int32 iattr = info[5].As<Napi::Number>().Int32Value();
+  int32 sign = info[6].As<Napi::Number>().Int32Value();
+  Napi::Float64Array tretArray = info[7].As<Napi::Float64Array>();
+  Napi::Float64Array xretArray = info[8].As<Napi::Float64Array>();
+
+  size_t nmax = tretArray.ElementLength();
+  if (xretArray.ElementLength() < nmax) {
+    Napi::RangeError::New(env, "Output arrays are too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  char serr[256];
+  int32 ret = swe_pheno_ut_extrema(tjd_ut, step, n, ipl, iflag, iattr, sign,
+      tretArray.Data(), xretArray.Data(), (int32) nmax, serr);
+
+  if (ret < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ret);
+}
+
+// Wrapper for swe_nod_aps_ut_batch
+// Each output holds 6 values per date and body: [(i * nipl + k) * 6 + c]
+Napi::Value NodApsUtBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 8 || !info[0].IsTypedArray() || !info[1].IsTypedArray() ||
+      !info[4].IsTypedArray() || !info[5].IsTypedArray() ||
+      !info[6].IsTypedArray() || !info[7].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut (Float64Array), ipl (Int32Array), iflag, method, xnasc, xndsc, xperi, xaphe (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array tjdArray = info[0].As<Napi::Float64Array>();
+  Napi::Int32Array iplArray = info[1].As<Napi::Int32Array>();
+  int32 iflag = info[2].As<Napi::Number>().Int32Value();
+  int32 method = info[3].As<Napi::Number>().Int32Value();
+  Napi::Float64Array nascArray = info[4].As<Napi::Float64Array>();
+  Napi::Float64Array ndscArray = info[5].As<Napi::Float64Array>();
+  Napi::Float64Array periArray = info[6].As<Napi::Float64Array>();
+  Napi::Float64Array apheArray = info[7].As<Napi::Float64Array>();
+
+  size_t n = tjdArray.ElementLength();
+  size_t nipl = iplArray.ElementLength();
+  size_t size = 6 * n * nipl;
+  if (nascArray.ElementLength() < size || ndscArray.ElementLength() < size ||
+      periArray.ElementLength() < size || apheArray.ElementLength() < size) {
+    Napi::RangeError::New(env, "Output arrays are too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  char serr[256];
+  int32 ret = swe_nod_aps_ut_batch(tjdArray.Data(), (int32) n, iplArray.Data(), (int32) nipl,
+      iflag, method, nascArray.Data(), ndscArray.Data(), periArray.Data(), apheArray.Data(), serr);
+
+  if (ret < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ret);
+}
+
+// Wrapper for swe_get_orbital_elements_ut_batch
+// Writes 17 values per date and body: out[(i * nipl + k) * 17 + c]
+Napi::Value GetOrbitalElementsUtBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 4 || !info[0].IsTypedArray() || !info[1].IsTypedArray() || !info[3].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut (Float64Array), ipl (Int32Array), iflag, out (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array tjdArray = info[0].As<Napi::Float64Array>();
+  Napi::Int32Array iplArray = info[1].As<Napi::Int32Array>();
+  int32 iflag = info[2].As<Napi::Number>().Int32Value();
+  Napi::Float64Array outArray = info[3].As<Napi::Float64Array>();
+
+  size_t n = tjdArray.ElementLength();
+  size_t nipl = iplArray.ElementLength();
+  if (outArray.ElementLength() < 17 * n * nipl) {
+    Napi::RangeError::New(env, "Output array is too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  char serr[256];
+  int32 ret = swe_get_orbital_elements_ut_batch(tjdArray.Data(), (int32) n, iplArray.Data(), (int32) nipl,
+      iflag, outArray.Data(), serr);
+
+  if (ret < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ret);
+}
+
+// Wrapper for swe_orbit_max_min_true_distance_ut_batch
+// Writes 3 values per date and body: out[(i * nipl + k) * 3 + c]
+Napi::Value OrbitMaxMinTrueDistanceUtBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 4 || !info[0].IsTypedArray() || !info[1].IsTypedArray() || !info[3].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut (Float64Array), ipl (Int32Array), iflag, out (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array tjdArray = info[0].As<Napi::Float64Array>();
+  Napi::Int32Array iplArray = info[1].As<Napi::Int32Array>();
+  int32 iflag = info[2].As<Napi::Number>().Int32Value();
+  Napi::Float64Array outArray = info[3].As<Napi::Float64Array>();
+
+  size_t n = tjdArray.ElementLength();
+  size_t nipl = iplArray.ElementLength();
+  if (outArray.ElementLength() < 3 * n * nipl) {
+    Napi::RangeError::New(env, "Output array is too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  char serr[256];
+  int32 ret = swe_orbit_max_min_true_distance_ut_batch(tjdArray.Data(), (int32) n, iplArray.Data(), (int32) nipl,
+      iflag, outArray.Data(), serr);
+
+  if (ret < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ret);
+}
+
+// Wrapper for swe_set_orbit_distance_cache
+Napi::Value SetOrbitDistanceCache(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected window").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  swe_set_orbit_distance_cache(info[0].As<Napi::Number>().DoubleValue());
+
+  return env.Undefined();
+}
+
+// Wrapper for swe_sidtime_batch
+// Writes the sidereal time in hours for each tjd_ut[i] to out[i]
+Napi::Value SidtimeBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsTypedArray() || !info[1].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut (Float64Array), out (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array tjdArray = info[0].As<Napi::Float64Array>();
+  Napi::Float64Array outArray = info[1].As<Napi::Float64Array>();
+
+  size_t n = tjdArray.ElementLength();
+  if (outArray.ElementLength() < n) {
+    Napi::RangeError::New(env, "Output array is too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  swe_sidtime_batch(tjdArray.Data(), (int32) n, outArray.Data());
+
+  return env.Undefined();
+}
+
+// Wrapper for swe_time_equ_batch
+// Writes the equation of time in days for each tjd_ut[i] to out[i]
+Napi::Value TimeEquBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsTypedArray() || !info[1].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut (Float64Array), out (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array tjdArray = info[0].As<Napi::Float64Array>();
+  Napi::Float64Array outArray = info[1].As<Napi::Float64Array>();
+
+  size_t n = tjdArray.ElementLength();
+  if (outArray.ElementLength() < n) {
+    Napi::RangeError::New(env, "Output array is too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  char serr[256];
+  int32 ret = swe_time_equ_batch(tjdArray.Data(), (int32) n, outArray.Data(), serr);
+
+  if (ret < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ret);
+}
+
 // Wrapper for swe_houses
 Napi::Value Houses(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
@@ -249,6 +709,56 @@ Napi::Value Houses(const Napi::CallbackInfo& info) {
   return result;
 }
 
+// Wrapper for swe_houses over a series of dates/locations
+// Writes structure-of-arrays output: cusps[k * n + i], ascmc[k * n + i]
+Napi::Value HousesSeries(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 6 || !info[0].IsTypedArray() || !info[1].IsTypedArray() || !info[2].IsTypedArray() ||
+      !info[4].IsTypedArray() || !info[5].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut, geolat, geolon (Float64Array), hsys, cusps, ascmc (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array tjdArray = info[0].As<Napi::Float64Array>();
+  Napi::Float64Array latArray = info[1].As<Napi::Float64Array>();
+  Napi::Float64Array lonArray = info[2].As<Napi::Float64Array>();
+  int hsys = info[3].As<Napi::String>().Utf8Value()[0];
+  Napi::Float64Array cuspsArray = info[4].As<Napi::Float64Array>();
+  Napi::Float64Array ascmcArray = info[5].As<Napi::Float64Array>();
+
+  size_t n = tjdArray.ElementLength();
+  if (latArray.ElementLength() < n || lonArray.ElementLength() < n ||
+      cuspsArray.ElementLength() < 13 * n || ascmcArray.ElementLength() < 10 * n) {
+    Napi::RangeError::New(env, "Input or output arrays are too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const double *tjd = tjdArray.Data();
+  const double *lat = latArray.Data();
+  const double *lon = lonArray.Data();
+  double *cuspsOut = cuspsArray.Data();
+  double *ascmcOut = ascmcArray.Data();
+  double cusps[13];
+  double ascmc[10];
+
+  for (size_t i = 0; i < n; i++) {
+    if (swe_houses(tjd[i], lat[i], lon[i], hsys, cusps, ascmc) < 0) {
+      Napi::Error::New(env, "Failed to calculate houses").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    for (size_t k = 0; k < 13; k++) {
+      cuspsOut[k * n + i] = cusps[k];
+    }
+    for (size_t k = 0; k < 10; k++) {
+      ascmcOut[k * n + i] = ascmc[k];
+    }
+  }
+
+  return env.Undefined();
+}
+
 // Wrapper for swe_set_sid_mode
 Napi::Value SetSidMode(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
@@ -384,22 +894,900 @@ Napi::Value GetAyanamsaExUt(const Napi::CallbackInfo& info) {
   return Napi::Number::New(env, daya);
 }
 
+// Wrapper for swe_azalt_batch
+Napi::Value AzaltBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 7 || !info[2].IsTypedArray() || !info[5].IsTypedArray() || !info[6].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut, calc_flag, geopos (Float64Array), atpress, attemp, xin (Float64Array), xaz (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double tjd_ut = info[0].As<Napi::Number>().DoubleValue();
+  int32 calc_flag = info[1].As<Napi::Number>().Int32Value();
+  Napi::Float64Array geoposArray = info[2].As<Napi::Float64Array>();
+  double atpress = info[3].As<Napi::Number>().DoubleValue();
+  double attemp = info[4].As<Napi::Number>().DoubleValue();
+  Napi::Float64Array xinArray = info[5].As<Napi::Float64Array>();
+  Napi::Float64Array xazArray = info[6].As<Napi::Float64Array>();
+
+  size_t n = xinArray.ElementLength() / 2;
+  if (geoposArray.ElementLength() < 3 || xazArray.ElementLength() < 3 * n) {
+    Napi::RangeError::New(env, "Output array is too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  swe_azalt_batch(tjd_ut, calc_flag, geoposArray.Data(), atpress, attemp,
+                  xinArray.Data(), (int32) n, xazArray.Data());
+
+  return env.Undefined();
+}
+
+// Wrapper for swe_azalt_rev_batch
+Napi::Value AzaltRevBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 5 || !info[2].IsTypedArray() || !info[3].IsTypedArray() || !info[4].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut, calc_flag, geopos (Float64Array), xin (Float64Array), xout (Float64Array)")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double tjd_ut = info[0].As<Napi::Number>().DoubleValue();
+  int32 calc_flag = info[1].As<Napi::Number>().Int32Value();
+  Napi::Float64Array geoposArray = info[2].As<Napi::Float64Array>();
+  Napi::Float64Array xinArray = info[3].As<Napi::Float64Array>();
+  Napi::Float64Array xoutArray = info[4].As<Napi::Float64Array>();
+
+  size_t n = xinArray.ElementLength() / 2;
+  if (geoposArray.ElementLength() < 3 || xoutArray.ElementLength() < 2 * n) {
+    Napi::RangeError::New(env, "Output array is too small").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  swe_azalt_rev_batch(tjd_ut, calc_flag, geoposArray.Data(), xinArray.Data(), (int32) n, xoutArray.Data());
+
+  return env.Undefined();
+}
+
+// Wrapper for swe_set_refrac_table
+Napi::Value SetRefracTable(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected mode").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  swe_set_refrac_table(info[0].As<Napi::Number>().Int32Value());
+
+  return env.Undefined();
+}
+
+// Wrapper for swe_set_shared_cache
+Napi::Value SetSharedCache(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+    // Detach
+    swe_set_shared_cache(NULL, 0, NULL);
+    return env.Undefined();
+  }
+
+  if (!info[0].IsString()) {
+    Napi::TypeError::New(env, "String expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string name = info[0].As<Napi::String>().Utf8Value();
+  int32 size_mb = info.Length() > 1 ? info[1].As<Napi::Number>().Int32Value() : 0;
+
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  if (swe_set_shared_cache(name.c_str(), size_mb, serr) < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+// Wrapper for swe_remove_shared_cache
+Napi::Value RemoveSharedCache(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "String expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string name = info[0].As<Napi::String>().Utf8Value();
+
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  if (swe_remove_shared_cache(name.c_str(), serr) < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+// Wrapper for swe_get_shared_cache_stats
+Napi::Value GetSharedCacheStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int32 stats[4];
+  int32 ret = swe_get_shared_cache_stats(stats);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("attached", Napi::Boolean::New(env, ret == OK));
+  result.Set("segmentHits", Napi::Number::New(env, stats[0]));
+  result.Set("segmentStores", Napi::Number::New(env, stats[1]));
+  result.Set("fixedStarsShared", Napi::Boolean::New(env, stats[2] != 0));
+  result.Set("deltaTShared", Napi::Boolean::New(env, stats[3] != 0));
+
+  return result;
+}
+
+// Wrapper for swe_set_result_cache
+Napi::Value SetResultCache(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+    // Close
+    swe_set_result_cache(NULL, 0, 0, NULL);
+    return env.Undefined();
+  }
+
+  if (!info[0].IsString()) {
+    Napi::TypeError::New(env, "String expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string path = info[0].As<Napi::String>().Utf8Value();
+  int32 size_mb = info.Length() > 1 ? info[1].As<Napi::Number>().Int32Value() : 0;
+  int32 mode = info.Length() > 2 ? info[2].As<Napi::Number>().Int32Value() : SE_RESCACHE_USE;
+
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  if (swe_set_result_cache(path.c_str(), size_mb, mode, serr) < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+// Wrapper for swe_get_result_cache_stats
+Napi::Value GetResultCacheStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int32 stats[7];
+  int32 ret = swe_get_result_cache_stats(stats);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("open", Napi::Boolean::New(env, ret == OK));
+  result.Set("hits", Napi::Number::New(env, stats[0]));
+  result.Set("misses", Napi::Number::New(env, stats[1]));
+  result.Set("stores", Napi::Number::New(env, stats[2]));
+  result.Set("mismatches", Napi::Number::New(env, stats[3]));
+  result.Set("notStored", Napi::Number::New(env, stats[4]));
+  result.Set("records", Napi::Number::New(env, stats[5]));
+  result.Set("capacity", Napi::Number::New(env, stats[6]));
+
+  return result;
+}
+
+// Wrapper for swe_eclipse_index_open
+Napi::Value EclipseIndexOpen(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+    // Close
+    swe_eclipse_index_open(NULL, NULL);
+    return env.Undefined();
+  }
+
+  if (!info[0].IsString()) {
+    Napi::TypeError::New(env, "String expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string path = info[0].As<Napi::String>().Utf8Value();
+
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  if (swe_eclipse_index_open(path.c_str(), serr) < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+// Wrapper for swe_eclipse_index_range
+// Returns [times, types] of the eclipse maxima in [tjd1, tjd2)
+Napi::Value EclipseIndexRange(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 4) {
+    Napi::TypeError::New(env, "Expected kind, start, end and flags")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int32 kind = info[0].As<Napi::Number>().Int32Value();
+  double tjd1 = info[1].As<Napi::Number>().DoubleValue();
+  double tjd2 = info[2].As<Napi::Number>().DoubleValue();
+  int32 ifl = info[3].As<Napi::Number>().Int32Value();
+  int32 ifltype = info.Length() >= 5 ? info[4].As<Napi::Number>().Int32Value() : 0;
+
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  // count first, then fill
+  int32 n = swe_eclipse_index_range(kind, tjd1, tjd2, ifl, ifltype, NULL, NULL, 0, serr);
+  if (n < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array times = Napi::Float64Array::New(env, n);
+  Napi::Int32Array types = Napi::Int32Array::New(env, n);
+  if (n > 0 && swe_eclipse_index_range(kind, tjd1, tjd2, ifl, ifltype, times.Data(), types.Data(), n, serr) < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Array result = Napi::Array::New(env, 2);
+  result[0u] = times;
+  result[1u] = types;
+
+  return result;
+}
+
+// Wrapper for swe_lunation_index_open
+Napi::Value LunationIndexOpen(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+    // Close
+    swe_lunation_index_open(NULL, NULL);
+    return env.Undefined();
+  }
+
+  if (!info[0].IsString()) {
+    Napi::TypeError::New(env, "String expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string path = info[0].As<Napi::String>().Utf8Value();
+
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  if (swe_lunation_index_open(path.c_str(), serr) < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+// Wrapper for swe_lunation_find
+// Returns [lunation, [new moon, first quarter, full moon, last quarter, next new moon]]
+Napi::Value LunationFind(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2) {
+    Napi::TypeError::New(env, "Expected Julian day and flags")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double tjd_ut = info[0].As<Napi::Number>().DoubleValue();
+  int32 ifl = info[1].As<Napi::Number>().Int32Value();
+
+  double tret[5];
+  int32 lunation;
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  if (swe_lunation_find(tjd_ut, ifl, tret, &lunation, serr) < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Array tretArray = Napi::Array::New(env, 5);
+  for (int i = 0; i < 5; i++) {
+    tretArray[i] = Napi::Number::New(env, tret[i]);
+  }
+
+  Napi::Array result = Napi::Array::New(env, 2);
+  result[0u] = Napi::Number::New(env, lunation);
+  result[1u] = tretArray;
+
+  return result;
+}
+
+// Wrapper for swe_lunar_phase_range
+// Returns [times, phases] of the main phases in [tjd1, tjd2)
+Napi::Value LunarPhaseRange(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 3) {
+    Napi::TypeError::New(env, "Expected start, end and flags")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double tjd1 = info[0].As<Napi::Number>().DoubleValue();
+  double tjd2 = info[1].As<Napi::Number>().DoubleValue();
+  int32 ifl = info[2].As<Napi::Number>().Int32Value();
+
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  // count first, then fill
+  int32 n = swe_lunar_phase_range(tjd1, tjd2, ifl, NULL, NULL, 0, serr);
+  if (n < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array times = Napi::Float64Array::New(env, n);
+  Napi::Int32Array phases = Napi::Int32Array::New(env, n);
+  if (n > 0 && swe_lunar_phase_range(tjd1, tjd2, ifl, times.Data(), phases.Data(), n, serr) < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Array result = Napi::Array::New(env, 2);
+  result[0u] = times;
+  result[1u] = phases;
+
+  return result;
+}
+
+// Wrapper for swe_lunar_apsides_find
+// Returns [perigee, perigee distance, apogee, apogee distance]
+Napi::Value LunarApsidesFind(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2) {
+    Napi::TypeError::New(env, "Expected Julian day and flags")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double tjd_ut = info[0].As<Napi::Number>().DoubleValue();
+  int32 ifl = info[1].As<Napi::Number>().Int32Value();
+
+  double tret[2], dist[2];
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  if (swe_lunar_apsides_find(tjd_ut, ifl, tret, dist, serr) < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Array result = Napi::Array::New(env, 4);
+  result[0u] = Napi::Number::New(env, tret[0]);
+  result[1u] = Napi::Number::New(env, dist[0]);
+  result[2u] = Napi::Number::New(env, tret[1]);
+  result[3u] = Napi::Number::New(env, dist[1]);
+
+  return result;
+}
+
+// Wrapper for swe_lon_index_build
+Napi::Value LonIndexBuild(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 5 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "Expected path, body, start, end and flags")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string path = info[0].As<Napi::String>().Utf8Value();
+  int32 ipl = info[1].As<Napi::Number>().Int32Value();
+  double tjd_start = info[2].As<Napi::Number>().DoubleValue();
+  double tjd_end = info[3].As<Napi::Number>().DoubleValue();
+  int32 iflag = info[4].As<Napi::Number>().Int32Value();
+
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  if (swe_lon_index_build(path.c_str(), ipl, tjd_start, tjd_end, iflag, serr) < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+// Wrapper for swe_lon_index_open
+Napi::Value LonIndexOpen(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+    // Close all
+    swe_lon_index_open(NULL, NULL);
+    return env.Undefined();
+  }
+
+  if (!info[0].IsString()) {
+    Napi::TypeError::New(env, "String expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string path = info[0].As<Napi::String>().Utf8Value();
+
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  if (swe_lon_index_open(path.c_str(), serr) < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+// Wrapper for swe_lon_crossings_ut
+// Returns [times, directions] of the crossings in [tjd1, tjd2)
+Napi::Value LonCrossingsUt(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 5) {
+    Napi::TypeError::New(env, "Expected body, longitude, start, end and flags")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int32 ipl = info[0].As<Napi::Number>().Int32Value();
+  double x2cross = info[1].As<Napi::Number>().DoubleValue();
+  double tjd1 = info[2].As<Napi::Number>().DoubleValue();
+  double tjd2 = info[3].As<Napi::Number>().DoubleValue();
+  int32 iflag = info[4].As<Napi::Number>().Int32Value();
+
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  // without an index every call fits the range, so query once into a
+  // buffer and only again if it was too small
+  std::vector<double> tret(256);
+  std::vector<int32> dir(256);
+  int32 n = swe_lon_crossings_ut(ipl, x2cross, tjd1, tjd2, iflag, tret.data(), dir.data(), (int32) tret.size(), serr);
+  if (n > (int32) tret.size()) {
+    tret.resize(n);
+    dir.resize(n);
+    n = swe_lon_crossings_ut(ipl, x2cross, tjd1, tjd2, iflag, tret.data(), dir.data(), n, serr);
+  }
+  if (n < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array times = Napi::Float64Array::New(env, n);
+  Napi::Int32Array directions = Napi::Int32Array::New(env, n);
+  for (int32 i = 0; i < n; i++) {
+    times[i] = tret[i];
+    directions[i] = dir[i];
+  }
+
+  Napi::Array result = Napi::Array::New(env, 2);
+  result[0u] = times;
+  result[1u] = directions;
+
+  return result;
+}
+
+// Wrapper for swe_paran_body and swe_parans: the body data are computed
+// once, then the latitudes are split into bands that are searched in
+// parallel threads
+Napi::Value Parans(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 10 || !info[1].IsTypedArray() || !info[4].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut, planets (Int32Array), stars, geolon, latitudes (Float64Array), events, tolerance, flags, rsmi and threads")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double tjd_ut = info[0].As<Napi::Number>().DoubleValue();
+  Napi::Int32Array planets = info[1].As<Napi::Int32Array>();
+  double geolon = info[3].As<Napi::Number>().DoubleValue();
+  Napi::Float64Array latArray = info[4].As<Napi::Float64Array>();
+  int32 events = info[5].As<Napi::Number>().Int32Value();
+  double tolerance = info[6].As<Napi::Number>().DoubleValue();
+  int32 epheflag = info[7].As<Napi::Number>().Int32Value();
+  int32 rsmi = info[8].As<Napi::Number>().Int32Value();
+  int32 nthreads = info[9].As<Napi::Number>().Int32Value();
+
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  // stars: a list of names or "all" for the whole catalogue by number
+  std::vector<std::string> stars;
+  bool allStars = info[2].IsString() && info[2].As<Napi::String>().Utf8Value() == "all";
+  if (!allStars && info[2].IsArray()) {
+    Napi::Array starArray = info[2].As<Napi::Array>();
+    for (uint32_t i = 0; i < starArray.Length(); i++) {
+      Napi::Value v = starArray[i];
+      if (!v.IsString()) {
+        Napi::TypeError::New(env, "String expected").ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+      stars.push_back(v.As<Napi::String>().Utf8Value());
+    }
+  }
+
+  int32 nplanet = (int32) planets.ElementLength();
+  std::vector<double> bodies((size_t) nplanet * SE_PARAN_BODY_SIZE);
+  for (int32 i = 0; i < nplanet; i++) {
+    if (swe_paran_body(tjd_ut, planets[i], NULL, epheflag, rsmi, bodies.data() + (size_t) i * SE_PARAN_BODY_SIZE, serr) < 0) {
+      Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+  std::vector<std::string> names;
+  double body[SE_PARAN_BODY_SIZE];
+  for (size_t i = 0; allStars || i < stars.size(); i++) {
+    char star[SE_MAX_STNAME * 2 + 1];
+    memset(star, 0, sizeof(star));
+    if (allStars)
+      snprintf(star, sizeof(star), "%d", (int) i + 1);
+    else
+      strncpy(star, stars[i].c_str(), SE_MAX_STNAME * 2);
+    if (swe_paran_body(tjd_ut, 0, star, epheflag, rsmi, body, serr) < 0) {
+      if (allStars && i > 0)
+        break;
+      Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    bodies.insert(bodies.end(), body, body + SE_PARAN_BODY_SIZE);
+    names.push_back(star);
+  }
+  int32 nbody = (int32) (bodies.size() / SE_PARAN_BODY_SIZE);
+
+  int32 nlat = (int32) latArray.ElementLength();
+  if (nthreads < 1)
+    nthreads = (int32) std::thread::hardware_concurrency();
+  if (nthreads < 1)
+    nthreads = 1;
+  if (nthreads > nlat)
+    nthreads = nlat > 0 ? nlat : 1;
+
+  // one band of latitudes per thread; a band is searched again only if
+  // its buffer was too small
+  std::vector<std::vector<int32>> ids(nthreads);
+  std::vector<std::vector<double>> tret(nthreads);
+  std::vector<int32> counts(nthreads, 0);
+  std::vector<std::string> errors(nthreads);
+  const double* lats = latArray.Data();
+  auto band = [&](int32 k) {
+    int32 lo = (int32) ((int64_t) nlat * k / nthreads);
+    int32 hi = (int32) ((int64_t) nlat * (k + 1) / nthreads);
+    char err[256];
+    memset(err, 0, sizeof(err));
+    int32 cap = 1024;
+    int32 n;
+    for (;;) {
+      ids[k].resize((size_t) cap * 5);
+      tret[k].resize((size_t) cap * 2);
+      n = swe_parans(bodies.data(), nbody, nplanet, geolon, lats + lo, hi - lo, events, tolerance,
+                     ids[k].data(), tret[k].data(), cap, err);
+      if (n <= cap)
+        break;
+      cap = n;
+    }
+    if (n < 0) {
+      errors[k] = err;
+      return;
+    }
+    for (int32 i = 0; i < n; i++)
+      ids[k][5 * i] += lo;
+    counts[k] = n;
+  };
+  std::vector<std::thread> threads;
+  for (int32 k = 1; k < nthreads; k++)
+    threads.emplace_back(band, k);
+  band(0);
+  for (auto& t : threads)
+    t.join();
+
+  int32 n = 0;
+  for (int32 k = 0; k < nthreads; k++) {
+    if (!errors[k].empty()) {
+      Napi::Error::New(env, errors[k]).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    n += counts[k];
+  }
+
+  Napi::Float64Array times = Napi::Float64Array::New(env, (size_t) n * 2);
+  Napi::Int32Array parans = Napi::Int32Array::New(env, (size_t) n * 5);
+  size_t it = 0, ii = 0;
+  for (int32 k = 0; k < nthreads; k++) {
+    for (int32 i = 0; i < counts[k] * 2; i++)
+      times[it++] = tret[k][i];
+    for (int32 i = 0; i < counts[k] * 5; i++)
+      parans[ii++] = ids[k][i];
+  }
+  Napi::Array starNames = Napi::Array::New(env, names.size());
+  for (size_t i = 0; i < names.size(); i++)
+    starNames[(uint32_t) i] = Napi::String::New(env, names[i]);
+
+  Napi::Array result = Napi::Array::New(env, 3);
+  result[0u] = times;
+  result[1u] = parans;
+  result[2u] = starNames;
+
+  return result;
+}
+
+// Wrapper for swe_speculum
+Napi::Value Speculum(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 6 || !info[3].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected tjd_ut, geolon, geolat, bodies (Int32Array), flags and options")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double tjd_ut = info[0].As<Napi::Number>().DoubleValue();
+  double geolon = info[1].As<Napi::Number>().DoubleValue();
+  double geolat = info[2].As<Napi::Number>().DoubleValue();
+  Napi::Int32Array ipl = info[3].As<Napi::Int32Array>();
+  int32 iflag = info[4].As<Napi::Number>().Int32Value();
+  int32 options = info[5].As<Napi::Number>().Int32Value();
+
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  int32 nbody = (int32) ipl.ElementLength();
+  Napi::Float64Array chart = Napi::Float64Array::New(env, SE_SPECULUM_CHART);
+  std::vector<double> spec((size_t) (nbody + 2) * SE_SPECULUM_SIZE);
+  int32 n = swe_speculum(tjd_ut, geolon, geolat, ipl.Data(), nbody, iflag, options, chart.Data(), spec.data(), serr);
+  if (n < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array rows = Napi::Float64Array::New(env, (size_t) n * SE_SPECULUM_SIZE);
+  memcpy(rows.Data(), spec.data(), (size_t) n * SE_SPECULUM_SIZE * sizeof(double));
+
+  Napi::Array result = Napi::Array::New(env, 2);
+  result[0u] = chart;
+  result[1u] = rows;
+
+  return result;
+}
+
+// Wrapper for swe_directions
+Napi::Value Directions(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 6 || !info[0].IsTypedArray() || !info[1].IsTypedArray() || !info[2].IsString() || !info[3].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected chart, speculum (Float64Array), house system, aspects (Float64Array), options and maximum arc")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array chart = info[0].As<Napi::Float64Array>();
+  Napi::Float64Array spec = info[1].As<Napi::Float64Array>();
+  std::string hsysStr = info[2].As<Napi::String>().Utf8Value();
+  Napi::Float64Array aspects = info[3].As<Napi::Float64Array>();
+  int32 options = info[4].As<Napi::Number>().Int32Value();
+  double maxarc = info[5].As<Napi::Number>().DoubleValue();
+
+  if (chart.ElementLength() < SE_SPECULUM_CHART || hsysStr.empty()) {
+    Napi::TypeError::New(env, "Expected chart and house system").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  char serr[256];
+  memset(serr, 0, sizeof(serr));
+
+  int32 nspec = (int32) (spec.ElementLength() / SE_SPECULUM_SIZE);
+  int32 naspect = (int32) aspects.ElementLength();
+  std::vector<double> arcs(1024);
+  std::vector<int32> ids(4096);
+  int32 n = swe_directions(chart.Data(), spec.Data(), nspec, hsysStr[0], aspects.Data(), naspect, options, maxarc,
+                           arcs.data(), ids.data(), (int32) arcs.size(), serr);
+  if (n > (int32) arcs.size()) {
+    arcs.resize(n);
+    ids.resize((size_t) n * 4);
+    n = swe_directions(chart.Data(), spec.Data(), nspec, hsysStr[0], aspects.Data(), naspect, options, maxarc,
+                       arcs.data(), ids.data(), n, serr);
+  }
+  if (n < 0) {
+    Napi::Error::New(env, serr).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array arcArray = Napi::Float64Array::New(env, n);
+  Napi::Int32Array idArray = Napi::Int32Array::New(env, (size_t) n * 4);
+  memcpy(arcArray.Data(), arcs.data(), (size_t) n * sizeof(double));
+  memcpy(idArray.Data(), ids.data(), (size_t) n * 4 * sizeof(int32));
+
+  Napi::Array result = Napi::Array::New(env, 2);
+  result[0u] = arcArray;
+  result[1u] = idArray;
+
+  return result;
+}
+
+// Wrapper for swe_aspect_matrix: the charts are split into ranges
+// that are compared in parallel threads
+Napi::Value AspectMatrix(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 6 || !info[0].IsTypedArray() || !info[1].IsTypedArray() || !info[3].IsTypedArray()) {
+    Napi::TypeError::New(env, "Expected reference (Float64Array), longitudes (Float32Array), points, aspects (Float64Array), minimum score and threads")
+        .ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Float64Array ref = info[0].As<Napi::Float64Array>();
+  Napi::Float32Array lon = info[1].As<Napi::Float32Array>();
+  int32 npoint = info[2].As<Napi::Number>().Int32Value();
+  Napi::Float64Array asp = info[3].As<Napi::Float64Array>();
+  double minscore = info[4].As<Napi::Number>().DoubleValue();
+  int32 nthreads = info[5].As<Napi::Number>().Int32Value();
+
+  if (npoint < 1 || lon.ElementLength() % npoint != 0) {
+    Napi::TypeError::New(env, "Expected longitudes of whole charts").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int32 nref = (int32) ref.ElementLength();
+  int32 ncharts = (int32) (lon.ElementLength() / npoint);
+  int32 naspect = (int32) (asp.ElementLength() / 3);
+  if (nthreads < 1)
+    nthreads = (int32) std::thread::hardware_concurrency();
+  if (nthreads < 1)
+    nthreads = 1;
+  // ranges of whole vectors of 4 charts, at least 1024 charts each
+  if (nthreads > ncharts / 1024)
+    nthreads = ncharts / 1024 > 0 ? ncharts / 1024 : 1;
+
+  Napi::Float32Array scores = Napi::Float32Array::New(env, ncharts);
+  float* score = scores.Data();
+  const double* refData = ref.Data();
+  const float* lonData = lon.Data();
+  const double* aspData = asp.Data();
+
+  std::vector<std::vector<int32>> match(nthreads);
+  std::vector<std::vector<float>> dev(nthreads);
+  std::vector<int32> counts(nthreads, 0);
+  std::vector<std::string> errors(nthreads);
+  auto range = [&](int32 k) {
+    int32 c0 = (int32) ((int64_t) ncharts * k / nthreads) & ~3;
+    int32 c1 = k == nthreads - 1 ? ncharts : (int32) ((int64_t) ncharts * (k + 1) / nthreads) & ~3;
+    char err[256];
+    memset(err, 0, sizeof(err));
+    int32 cap = 4096;
+    int32 n;
+    for (;;) {
+      match[k].resize((size_t) cap * 2);
+      dev[k].resize(cap);
+      n = swe_aspect_matrix(refData, nref, lonData, npoint, ncharts, c0, c1, aspData, naspect, minscore, score,
+                            match[k].data(), dev[k].data(), cap, err);
+      if (n <= cap)
+        break;
+      cap = n;
+    }
+    if (n < 0)
+      errors[k] = err;
+    else
+      counts[k] = n;
+  };
+  std::vector<std::thread> threads;
+  for (int32 k = 1; k < nthreads; k++)
+    threads.emplace_back(range, k);
+  range(0);
+  for (auto& t : threads)
+    t.join();
+
+  size_t n = 0;
+  for (int32 k = 0; k < nthreads; k++) {
+    if (!errors[k].empty()) {
+      Napi::Error::New(env, errors[k]).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    n += counts[k];
+  }
+
+  Napi::Int32Array charts = Napi::Int32Array::New(env, n);
+  Napi::Uint8Array refPoints = Napi::Uint8Array::New(env, n);
+  Napi::Uint8Array points = Napi::Uint8Array::New(env, n);
+  Napi::Uint8Array aspects = Napi::Uint8Array::New(env, n);
+  Napi::Float32Array deviations = Napi::Float32Array::New(env, n);
+  size_t m = 0;
+  for (int32 k = 0; k < nthreads; k++) {
+    for (int32 i = 0; i < counts[k]; i++, m++) {
+      int32 id = match[k][2 * i + 1];
+      charts[m] = match[k][2 * i];
+      refPoints[m] = (uint8_t) (id >> 16);
+      points[m] = (uint8_t) (id >> 8);
+      aspects[m] = (uint8_t) id;
+      deviations[m] = dev[k][i];
+    }
+  }
+
+  Napi::Array result = Napi::Array::New(env, 6);
+  result[0u] = scores;
+  result[1u] = charts;
+  result[2u] = refPoints;
+  result[3u] = points;
+  result[4u] = aspects;
+  result[5u] = deviations;
+
+  return result;
+}
+
 // Initialize the addon
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
   exports.Set("set_ephe_path", Napi::Function::New(env, SetEphePath));
   exports.Set("julday", Napi::Function::New(env, Julday));
   exports.Set("revjul", Napi::Function::New(env, Revjul));
   exports.Set("calc_ut", Napi::Function::New(env, CalcUt));
+  exports.Set("calc_ut_series", Napi::Function::New(env, CalcUtSeries));
+  exports.Set("calc_ut_multi_sid", Napi::Function::New(env, CalcUtMultiSid));
+  exports.Set("calc_topo_batch", Napi::Function::New(env, CalcTopoBatch));
+  exports.Set("calc_pctr_multi", Napi::Function::New(env, CalcPctrMulti));
   exports.Set("close", Napi::Function::New(env, Close));
   exports.Set("get_planet_name", Napi::Function::New(env, GetPlanetName));
   exports.Set("lun_eclipse_when", Napi::Function::New(env, LunEclipseWhen));
   exports.Set("sol_eclipse_when_glob", Napi::Function::New(env, SolEclipseWhenGlob));
+  exports.Set("pheno_ut_series", Napi::Function::New(env, PhenoUtSeries));
+  exports.Set("pheno_ut_planets", Napi::Function::New(env, PhenoUtPlanets));
+  exports.Set("pheno_ut_extrema", Napi::Function::New(env, PhenoUtExtrema));
+  exports.Set("nod_aps_ut_batch", Napi::Function::New(env, NodApsUtBatch));
+  exports.Set("get_orbital_elements_ut_batch", Napi::Function::New(env, GetOrbitalElementsUtBatch));
+  exports.Set("orbit_max_min_true_distance_ut_batch", Napi::Function::New(env, OrbitMaxMinTrueDistanceUtBatch));
+  exports.Set("set_orbit_distance_cache", Napi::Function::New(env, SetOrbitDistanceCache));
+  exports.Set("sidtime_batch", Napi::Function::New(env, SidtimeBatch));
+  exports.Set("time_equ_batch", Napi::Function::New(env, TimeEquBatch));
   exports.Set("houses", Napi::Function::New(env, Houses));
+  exports.Set("houses_series", Napi::Function::New(env, HousesSeries));
   exports.Set("set_sid_mode", Napi::Function::New(env, SetSidMode));
   exports.Set("set_topo", Napi::Function::New(env, SetTopo));
   exports.Set("get_ayanamsa_ut", Napi::Function::New(env, GetAyanamsaUt));
   exports.Set("get_ayanamsa_ex_ut", Napi::Function::New(env, GetAyanamsaExUt));
   exports.Set("rise_trans", Napi::Function::New(env, RiseTrans));
+  exports.Set("azalt_batch", Napi::Function::New(env, AzaltBatch));
+  exports.Set("azalt_rev_batch", Napi::Function::New(env, AzaltRevBatch));
+  exports.Set("set_refrac_table", Napi::Function::New(env, SetRefracTable));
+  exports.Set("set_shared_cache", Napi::Function::New(env, SetSharedCache));
+  exports.Set("remove_shared_cache", Napi::Function::New(env, RemoveSharedCache));
+  exports.Set("get_shared_cache_stats", Napi::Function::New(env, GetSharedCacheStats));
+  exports.Set("set_result_cache", Napi::Function::New(env, SetResultCache));
+  exports.Set("get_result_cache_stats", Napi::Function::New(env, GetResultCacheStats));
+  exports.Set("eclipse_index_open", Napi::Function::New(env, EclipseIndexOpen));
+  exports.Set("eclipse_index_range", Napi::Function::New(env, EclipseIndexRange));
+  exports.Set("lunation_index_open", Napi::Function::New(env, LunationIndexOpen));
+  exports.Set("lunation_find", Napi::Function::New(env, LunationFind));
+  exports.Set("lunar_phase_range", Napi::Function::New(env, LunarPhaseRange));
+  exports.Set("lunar_apsides_find", Napi::Function::New(env, LunarApsidesFind));
+  exports.Set("lon_index_build", Napi::Function::New(env, LonIndexBuild));
+  exports.Set("lon_index_open", Napi::Function::New(env, LonIndexOpen));
+  exports.Set("lon_crossings_ut", Napi::Function::New(env, LonCrossingsUt));
+  exports.Set("parans", Napi::Function::New(env, Parans));
+  exports.Set("speculum", Napi::Function::New(env, Speculum));
+  exports.Set("directions", Napi::Function::New(env, Directions));
+  exports.Set("aspect_matrix", Napi::Function::New(env, AspectMatrix));
 
   return exports;
 }
@@ -27,6 +27,18 @@ import {
   DateTimeImpl,
   CalculationFlag,
   CommonCalculationFlags,
+  PositionSeries,
+  HouseSeries,
+  PhenomenaSeries,
+  NodesApsidesSeries,
+  OrbitalElementsSeries,
+  NodeMethod,
+  PHENOMENA_COMPONENTS,
+  PlanetaryPhenomena,
+  PhenomenonExtremum,
+  CoordinateSystem,
+  MoonPhase,
+  DirectionKey,
 } from '@swisseph/core';
 
 import * as path from 'path';
@@ -203,6 +215,71 @@ export function julianDayToDate(
   return new DateTimeImpl(result[0], result[1], result[2], result[3], calendarType);
 }
 
+/**
+ * Calculate Greenwich apparent sidereal time for many Julian days
+ *
+ * Sidereal time minus the Earth rotation angle is computed every half day
+ * and interpolated for times less than two days apart, so nutation and
+ * obliquity are evaluated once per node. The result differs from a
+ * single-time calculation by less than 3e-6 seconds.
+ *
+ * @param julianDays - Julian days in Universal Time
+ * @param target - Optional output array to reuse
+ * @returns Sidereal time in hours for each date
+ *
+ * @example
+ * const days = Float64Array.from({ length: 1440 }, (_, i) => jd + i / 1440);
+ * const lst = calculateSiderealTimes(days).map((h) => (h + longitude / 15 + 24) % 24);
+ */
+export function calculateSiderealTimes(
+  julianDays: Float64Array | ArrayLike<number>,
+  target?: Float64Array
+): Float64Array {
+  const output = target ?? new Float64Array(julianDays.length);
+  if (output.length < julianDays.length) {
+    throw new RangeError(`Target has ${output.length} values, expected ${julianDays.length}`);
+  }
+
+  binding.sidtime_batch(
+    julianDays instanceof Float64Array ? julianDays : Float64Array.from(julianDays),
+    output
+  );
+  return output;
+}
+
+/**
+ * Calculate the equation of time (apparent minus mean solar time) for many Julian days
+ *
+ * Like calculateSiderealTimes(), the values are interpolated between
+ * half-day nodes for times less than two days apart; the difference to
+ * a single-time calculation is below 0.1 ms.
+ *
+ * @param julianDays - Julian days in Universal Time
+ * @param target - Optional output array to reuse
+ * @returns Equation of time in days for each date
+ *
+ * @example
+ * const [e] = calculateEquationOfTime([jd]);
+ * console.log(`Sundial is ${(e * 1440).toFixed(1)} minutes ahead`);
+ */
+export function calculateEquationOfTime(
+  julianDays: Float64Array | ArrayLike<number>,
+  target?: Float64Array
+): Float64Array {
+  ensureEphemerisInitialized(CalculationFlag.SwissEphemeris);
+
+  const output = target ?? new Float64Array(julianDays.length);
+  if (output.length < julianDays.length) {
+    throw new RangeError(`Target has ${output.length} values, expected ${julianDays.length}`);
+  }
+
+  binding.time_equ_batch(
+    julianDays instanceof Float64Array ? julianDays : Float64Array.from(julianDays),
+    output
+  );
+  return output;
+}
+
 /**
  * Calculate planetary positions
  *
@@ -256,6 +333,53 @@ export function calculatePosition(
   };
 }
 
+/**
+ * Calculate planetary positions for many Julian days at once
+ *
+ * Results are written into a structure-of-arrays PositionSeries
+ * (Float64Array columns) by a single native call, so no JavaScript object is
+ * created per result. Pass `target` to reuse a series between calls and keep
+ * repeated bulk calculations allocation-free.
+ *
+ * @param julianDays - Julian days in Universal Time
+ * @param body - Celestial body to calculate
+ * @param flags - Calculation flags (default: SwissEphemeris with speed)
+ * @param target - Optional series of the same length to fill
+ * @returns PositionSeries with one row per Julian day
+ * @throws Error if any position fails to calculate
+ *
+ * @example
+ * const days = new Float64Array(36525).map((_, i) => 2451545.0 + i);
+ * const moon = calculatePositionSeries(days, Planet.Moon);
+ * console.log(moon.longitude[0], moon.longitudeSpeed[0]);
+ *
+ * // Lazy row view shaped like PlanetaryPosition
+ * const row = moon.at(100);
+ * console.log(row.longitude);
+ */
+export function calculatePositionSeries(
+  julianDays: Float64Array | ArrayLike<number>,
+  body: CelestialBody,
+  flags: CalculationFlagInput = CommonCalculationFlags.DefaultSwissEphemeris,
+  target?: PositionSeries
+): PositionSeries {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const series = target ?? new PositionSeries(julianDays.length);
+  if (series.length !== julianDays.length) {
+    throw new RangeError(
+      `Target series has ${series.length} rows, expected ${julianDays.length}`
+    );
+  }
+  if (series.julianDays !== julianDays) {
+    series.julianDays.set(julianDays);
+  }
+
+  binding.calc_ut_series(series.julianDays, body, normalizedFlags, series.values, series.flags);
+  return series;
+}
+
 /**
  * Calculate house cusps and angles
  *
@@ -309,109 +433,1354 @@ export function calculateHouses(
 }
 
 /**
- * Find the next lunar eclipse
+ * Calculate house cusps and angles for many dates and/or locations at once
+ *
+ * Row `i` uses `julianDays[i]`, `latitudes[i]` and `longitudes[i]`. Results
+ * are written into a structure-of-arrays HouseSeries by a single native call.
+ *
+ * @param julianDays - Julian days in Universal Time
+ * @param latitudes - Geographic latitudes (positive = north)
+ * @param longitudes - Geographic longitudes (positive = east)
+ * @param houseSystem - House system to use (default: Placidus)
+ * @param target - Optional series of the same length and house system to fill
+ * @returns HouseSeries with one row per input
+ *
+ * @example
+ * const n = 1440; // one chart per minute of a day in London
+ * const days = new Float64Array(n).map((_, i) => jd + i / 1440);
+ * const houses = calculateHouseSeries(days, new Float64Array(n).fill(51.5), new Float64Array(n).fill(-0.13));
+ * console.log(houses.ascendant[0], houses.cusp(10)[0]);
+ */
+export function calculateHouseSeries(
+  julianDays: Float64Array | ArrayLike<number>,
+  latitudes: Float64Array | ArrayLike<number>,
+  longitudes: Float64Array | ArrayLike<number>,
+  houseSystem: HouseSystem = HouseSystem.Placidus,
+  target?: HouseSeries
+): HouseSeries {
+  const n = julianDays.length;
+  if (latitudes.length !== n || longitudes.length !== n) {
+    throw new RangeError('julianDays, latitudes and longitudes must have the same length');
+  }
+
+  const series = target ?? new HouseSeries(n, houseSystem);
+  if (series.length !== n || series.houseSystem !== houseSystem) {
+    throw new RangeError('Target series does not match the requested length or house system');
+  }
+  if (series.julianDays !== julianDays) series.julianDays.set(julianDays);
+  if (series.latitudes !== latitudes) series.latitudes.set(latitudes);
+  if (series.longitudes !== longitudes) series.longitudes.set(longitudes);
+
+  binding.houses_series(
+    series.julianDays,
+    series.latitudes,
+    series.longitudes,
+    houseSystem,
+    series.cuspValues,
+    series.ascmcValues
+  );
+  return series;
+}
+
+/**
+ * Find the next lunar eclipse
+ *
+ * Searches for the next lunar eclipse after the given Julian day.
+ *
+ * @param startJulianDay - Julian day to start search from
+ * @param flags - Calculation flags (default: SwissEphemeris)
+ * @param eclipseType - Filter by eclipse type (0 = all types)
+ * @param backward - Search backward in time if true
+ * @returns LunarEclipse object with times and convenience methods
+ *
+ * @example
+ * // Find next lunar eclipse
+ * const jd = julianDay(2025, 1, 1);
+ * const eclipse = findNextLunarEclipse(jd);
+ *
+ * console.log(`Eclipse maximum: ${julianDayToDate(eclipse.maximum)}`);
+ * console.log(`Is total: ${eclipse.isTotal()}`);
+ * console.log(`Totality duration: ${eclipse.getTotalityDuration()} hours`);
+ *
+ * // Find previous lunar eclipse
+ * const previousEclipse = findNextLunarEclipse(jd, undefined, 0, true);
+ */
+export function findNextLunarEclipse(
+  startJulianDay: number,
+  flags: CalculationFlagInput = CalculationFlag.SwissEphemeris,
+  eclipseType: EclipseTypeFlagInput = 0,
+  backward: boolean = false
+): LunarEclipse {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+  const normalizedEclipseType = normalizeEclipseTypes(eclipseType);
+
+  const result = binding.lun_eclipse_when(
+    startJulianDay,
+    normalizedFlags,
+    normalizedEclipseType,
+    backward ? 1 : 0
+  ) as [number, number[]];
+
+  const [retFlag, tret] = result;
+
+  return new LunarEclipseImpl(
+    retFlag,
+    tret[0], // maximum
+    tret[1], // partial begin
+    tret[2], // partial end
+    tret[3], // total begin
+    tret[4], // total end
+    tret[5], // penumbral begin
+    tret[6]  // penumbral end
+  );
+}
+
+/**
+ * Find the next solar eclipse globally
+ *
+ * Searches for the next solar eclipse visible anywhere on Earth.
+ *
+ * @param startJulianDay - Julian day to start search from
+ * @param flags - Calculation flags (default: SwissEphemeris)
+ * @param eclipseType - Filter by eclipse type (0 = all types)
+ * @param backward - Search backward in time if true
+ * @returns SolarEclipse object with times and convenience methods
+ *
+ * @example
+ * // Find next solar eclipse
+ * const jd = julianDay(2025, 1, 1);
+ * const eclipse = findNextSolarEclipse(jd);
+ *
+ * console.log(`Eclipse maximum: ${julianDayToDate(eclipse.maximum)}`);
+ * console.log(`Is total: ${eclipse.isTotal()}`);
+ * console.log(`Is annular: ${eclipse.isAnnular()}`);
+ * console.log(`Is central: ${eclipse.isCentral()}`);
+ */
+export function findNextSolarEclipse(
+  startJulianDay: number,
+  flags: CalculationFlagInput = CalculationFlag.SwissEphemeris,
+  eclipseType: EclipseTypeFlagInput = 0,
+  backward: boolean = false
+): SolarEclipse {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+  const normalizedEclipseType = normalizeEclipseTypes(eclipseType);
+
+  const result = binding.sol_eclipse_when_glob(
+    startJulianDay,
+    normalizedFlags,
+    normalizedEclipseType,
+    backward ? 1 : 0
+  ) as [number, number[]];
+
+  const [retFlag, tret] = result;
+
+  return new SolarEclipseImpl(
+    retFlag,
+    tret[0], // maximum
+    tret[1], // partial begin
+    tret[2], // partial end
+    tret[3], // central begin
+    tret[4], // central end
+    tret[5], // center line begin
+    tret[6]  // center line end
+  );
+}
+
+/**
+ * Time of maximum and type of an eclipse
+ */
+export interface EclipseMaximum {
+  /** Julian day (UT) of maximum eclipse */
+  maximum: number;
+
+  /** Eclipse type flags, as returned by the eclipse searches */
+  type: number;
+}
+
+const ECLIPSE_INDEX_SOLAR = 1;
+const ECLIPSE_INDEX_LUNAR = 2;
+
+/**
+ * Answer eclipse searches from a precomputed index
+ *
+ * The package ships an index of all solar and lunar eclipses from 1800 to
+ * 2399 for the bundled Swiss Ephemeris files. While it is open,
+ * findNextSolarEclipse(), findNextLunarEclipse() and findEclipsesInRange()
+ * look eclipses up by binary search instead of searching; results are
+ * identical. Dates outside the index and other ephemeris settings are
+ * searched as before.
+ *
+ * @param filePath - Index file, default: the bundled index
+ * @throws Error if the file cannot be read or was built by another version
+ *
+ * @example
+ * openEclipseIndex();
+ * const eclipse = findNextSolarEclipse(julianDay(2025, 1, 1)); // microseconds
+ */
+export function openEclipseIndex(filePath?: string): void {
+  binding.eclipse_index_open(filePath ?? path.join(getBundledEphemerisPath(), 'seecl_18.idx'));
+}
+
+/**
+ * Stop using the eclipse index
+ */
+export function closeEclipseIndex(): void {
+  binding.eclipse_index_open(null);
+}
+
+/**
+ * Find all solar or lunar eclipses in a time range
+ *
+ * @param kind - 'solar' (global) or 'lunar'
+ * @param startJulianDay - Start of the range (UT), inclusive
+ * @param endJulianDay - End of the range (UT), exclusive
+ * @param eclipseType - Filter by eclipse type (0 = all types)
+ * @param flags - Calculation flags (default: SwissEphemeris)
+ * @returns Times of maximum and types, in time order
+ *
+ * @example
+ * // Total solar eclipses of the 21st century
+ * const totals = findEclipsesInRange('solar', julianDay(2001, 1, 1), julianDay(2101, 1, 1), EclipseType.Total);
+ */
+export function findEclipsesInRange(
+  kind: 'solar' | 'lunar',
+  startJulianDay: number,
+  endJulianDay: number,
+  eclipseType: EclipseTypeFlagInput = 0,
+  flags: CalculationFlagInput = CalculationFlag.SwissEphemeris
+): EclipseMaximum[] {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const [times, types] = binding.eclipse_index_range(
+    kind === 'solar' ? ECLIPSE_INDEX_SOLAR : ECLIPSE_INDEX_LUNAR,
+    startJulianDay,
+    endJulianDay,
+    normalizedFlags,
+    normalizeEclipseTypes(eclipseType)
+  ) as [Float64Array, Int32Array];
+
+  const result: EclipseMaximum[] = [];
+  for (let i = 0; i < times.length; i++) {
+    result.push({ maximum: times[i], type: types[i] });
+  }
+  return result;
+}
+
+/**
+ * One lunation, from new moon to new moon
+ */
+export interface Lunation {
+  /** Brown lunation number (lunation 1 began on 1923 January 17) */
+  number: number;
+
+  /** Julian day (UT) of the new moon */
+  newMoon: number;
+
+  /** Julian day (UT) of the first quarter */
+  firstQuarter: number;
+
+  /** Julian day (UT) of the full moon */
+  fullMoon: number;
+
+  /** Julian day (UT) of the last quarter */
+  lastQuarter: number;
+
+  /** Julian day (UT) of the next new moon, which ends the lunation */
+  nextNewMoon: number;
+}
+
+/**
+ * Main phase of the Moon at a time
+ */
+export interface MoonPhaseTime {
+  /** Julian day (UT) */
+  time: number;
+
+  /** Phase reached at that time */
+  phase: MoonPhase;
+}
+
+/**
+ * Next perigee and apogee of the Moon
+ */
+export interface LunarApsides {
+  /** Julian day (UT) of the next perigee */
+  perigee: number;
+
+  /** Geocentric distance at perigee in AU */
+  perigeeDistance: number;
+
+  /** Julian day (UT) of the next apogee */
+  apogee: number;
+
+  /** Geocentric distance at apogee in AU */
+  apogeeDistance: number;
+}
+
+/**
+ * Answer lunation and lunar apsis queries from a precomputed catalogue
+ *
+ * The package ships a catalogue of the new moons, quarters, full moons,
+ * perigees and apogees from 1800 to 2399 for the bundled Swiss Ephemeris
+ * files. While it is open, findLunation(), findMoonPhases() and
+ * findLunarApsides() look the times up by binary search; without it (or
+ * outside its range) they are computed, with identical results.
+ *
+ * @param filePath - Catalogue file, default: the bundled catalogue
+ * @throws Error if the file cannot be read or was built by another version
+ *
+ * @example
+ * openLunationIndex();
+ * const lunation = findLunation(julianDay(2025, 3, 20));
+ * console.log(lunation.number, lunation.fullMoon); // 1264, 2460748.788
+ */
+export function openLunationIndex(filePath?: string): void {
+  binding.lunation_index_open(filePath ?? path.join(getBundledEphemerisPath(), 'selun_18.idx'));
+}
+
+/**
+ * Stop using the lunation catalogue
+ */
+export function closeLunationIndex(): void {
+  binding.lunation_index_open(null);
+}
+
+/**
+ * Find the lunation containing a date
+ *
+ * Phases are the times when the apparent geocentric longitudes of Moon and
+ * Sun differ by 0°, 90°, 180° and 270°.
+ *
+ * @param julianDay - Julian day (UT)
+ * @param flags - Calculation flags; only the ephemeris is used (default: SwissEphemeris)
+ * @returns The lunation whose new moon is the last one at or before the date
+ *
+ * @example
+ * const { number, fullMoon, nextNewMoon } = findLunation(julianDay(2025, 1, 1));
+ */
+export function findLunation(
+  julianDay: number,
+  flags: CalculationFlagInput = CalculationFlag.SwissEphemeris
+): Lunation {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const [number, times] = binding.lunation_find(julianDay, normalizedFlags) as [number, number[]];
+  return {
+    number,
+    newMoon: times[0],
+    firstQuarter: times[1],
+    fullMoon: times[2],
+    lastQuarter: times[3],
+    nextNewMoon: times[4],
+  };
+}
+
+/**
+ * Find all main phases of the Moon in a time range
+ *
+ * @param startJulianDay - Start of the range (UT), inclusive
+ * @param endJulianDay - End of the range (UT), exclusive
+ * @param flags - Calculation flags; only the ephemeris is used (default: SwissEphemeris)
+ * @returns Times and phases, in time order
+ *
+ * @example
+ * // Full moons of 2025
+ * const fullMoons = findMoonPhases(julianDay(2025, 1, 1), julianDay(2026, 1, 1))
+ *   .filter((p) => p.phase === MoonPhase.FullMoon);
+ */
+export function findMoonPhases(
+  startJulianDay: number,
+  endJulianDay: number,
+  flags: CalculationFlagInput = CalculationFlag.SwissEphemeris
+): MoonPhaseTime[] {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const [times, phases] = binding.lunar_phase_range(startJulianDay, endJulianDay, normalizedFlags) as [
+    Float64Array,
+    Int32Array,
+  ];
+
+  const result: MoonPhaseTime[] = [];
+  for (let i = 0; i < times.length; i++) {
+    result.push({ time: times[i], phase: phases[i] as MoonPhase });
+  }
+  return result;
+}
+
+/**
+ * Find the next perigee and apogee of the Moon
+ *
+ * @param julianDay - Julian day (UT) to search from
+ * @param flags - Calculation flags; only the ephemeris is used (default: SwissEphemeris)
+ * @returns Times (UT) and geocentric distances of the next perigee and apogee
+ *
+ * @example
+ * const { perigee, perigeeDistance } = findLunarApsides(julianDay(2025, 3, 20));
+ * console.log(perigeeDistance * 149597870.7); // about 358135 km
+ */
+export function findLunarApsides(
+  julianDay: number,
+  flags: CalculationFlagInput = CalculationFlag.SwissEphemeris
+): LunarApsides {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const [perigee, perigeeDistance, apogee, apogeeDistance] = binding.lunar_apsides_find(
+    julianDay,
+    normalizedFlags
+  ) as number[];
+  return { perigee, perigeeDistance, apogee, apogeeDistance };
+}
+
+/**
+ * A time when a body reaches an ecliptic longitude
+ */
+export interface LongitudeCrossing {
+  /** Julian day (UT) */
+  time: number;
+
+  /** True if the body is retrograde at the crossing */
+  retrograde: boolean;
+}
+
+/**
+ * Build a longitude index of one body and write it to a file
+ *
+ * The index stores the ecliptic longitude as Chebyshev series split at the
+ * stations, so that findLongitudeCrossings() finds all crossings of a
+ * longitude by binary search. Building takes 0.2 to 2 seconds per
+ * 200 years, and the file is 0.5 to 4.5 MB.
+ *
+ * @param filePath - File to write
+ * @param body - Celestial body
+ * @param startJulianDay - Start of the span (UT)
+ * @param endJulianDay - End of the span (UT)
+ * @param flags - Calculation flags, e.g. Sidereal or Heliocentric (default: SwissEphemeris)
+ * @throws Error for topocentric or equatorial flags, or if the file cannot be written
+ *
+ * @example
+ * buildLongitudeIndex('/var/cache/saturn.idx', Planet.Saturn, julianDay(1900, 1, 1), julianDay(2100, 1, 1));
+ * openLongitudeIndex('/var/cache/saturn.idx');
+ */
+export function buildLongitudeIndex(
+  filePath: string,
+  body: CelestialBody,
+  startJulianDay: number,
+  endJulianDay: number,
+  flags: CalculationFlagInput = CalculationFlag.SwissEphemeris
+): void {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  binding.lon_index_build(filePath, body, startJulianDay, endJulianDay, normalizedFlags);
+}
+
+/**
+ * Use a longitude index for findLongitudeCrossings()
+ *
+ * Several indexes can be open, one per body and flags; opening an index of
+ * the same body and flags replaces the previous one. Open indexes at
+ * startup, before calculations run in worker threads.
+ *
+ * @param filePath - Index written by buildLongitudeIndex()
+ * @throws Error if the file cannot be read or was built by another version
+ */
+export function openLongitudeIndex(filePath: string): void {
+  binding.lon_index_open(filePath);
+}
+
+/**
+ * Stop using all longitude indexes
+ */
+export function closeLongitudeIndexes(): void {
+  binding.lon_index_open(null);
+}
+
+/**
+ * Find all times a body reaches an ecliptic longitude
+ *
+ * Finds direct and retrograde crossings, e.g. all passes of Mars over a
+ * natal point or a planetary return. With an open longitude index of the
+ * body that covers the range, the crossings are found by binary search and
+ * a few refinement steps (about 15 µs each); otherwise the longitude over
+ * the range is fitted first. A crossing within about 0.0001° of a
+ * stationary longitude may be missed or found twice.
+ *
+ * @param body - Celestial body
+ * @param longitude - Ecliptic longitude in degrees
+ * @param startJulianDay - Start of the range (UT), inclusive
+ * @param endJulianDay - End of the range (UT), exclusive
+ * @param flags - Calculation flags, e.g. Sidereal or Heliocentric (default: SwissEphemeris)
+ * @returns Crossings in time order
+ * @throws Error for topocentric or equatorial flags
+ *
+ * @example
+ * // Saturn returns to 12°34' Capricorn
+ * const returns = findLongitudeCrossings(Planet.Saturn, 282 + 34 / 60, julianDay(1990, 1, 1), julianDay(2080, 1, 1));
+ */
+export function findLongitudeCrossings(
+  body: CelestialBody,
+  longitude: number,
+  startJulianDay: number,
+  endJulianDay: number,
+  flags: CalculationFlagInput = CalculationFlag.SwissEphemeris
+): LongitudeCrossing[] {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const [times, directions] = binding.lon_crossings_ut(
+    body,
+    longitude,
+    startJulianDay,
+    endJulianDay,
+    normalizedFlags
+  ) as [Float64Array, Int32Array];
+
+  const result: LongitudeCrossing[] = [];
+  for (let i = 0; i < times.length; i++) {
+    result.push({ time: times[i], retrograde: directions[i] < 0 });
+  }
+  return result;
+}
+
+// rise/set flags of swe_paran_body() (SE_BIT_*)
+const PARAN_DISC_CENTER = 256;
+const PARAN_NO_REFRACTION = 512;
+
+/**
+ * Two bodies on the angles (horizon or meridian) at the same time
+ */
+export interface Paran {
+  /** Geographic latitude in degrees */
+  latitude: number;
+
+  /** Planet of the paran */
+  body: CelestialBody;
+
+  /** Event of the planet (RiseTransitFlag) */
+  event: number;
+
+  /** Other planet, or name of the fixed star ("Name,Nomenclature") */
+  other: CelestialBody | string;
+
+  /** Event of the other body (RiseTransitFlag) */
+  otherEvent: number;
+
+  /** Julian day (UT) of the event of the planet */
+  time: number;
+
+  /** Julian day (UT) of the event of the other body */
+  otherTime: number;
+}
+
+/**
+ * Options for findParans()
+ */
+export interface ParanOptions {
+  /** Events to combine (RiseTransitFlag bits, default: all four) */
+  events?: number;
+
+  /** Maximum time between the two events in minutes (default: 4) */
+  toleranceMinutes?: number;
+
+  /** Geographic longitude in degrees; only shifts the day searched (default: 0) */
+  longitude?: number;
+
+  /** Calculation flags (default: SwissEphemeris) */
+  flags?: CalculationFlagInput;
+
+  /** Rise and set at the geometric horizon, without refraction */
+  noRefraction?: boolean;
+
+  /** Rise and set of the centre instead of the upper limb of Sun and Moon */
+  discCenter?: boolean;
+
+  /** Number of threads searching bands of latitudes (default: one per CPU) */
+  threads?: number;
+}
+
+/**
+ * Find parans of planets with planets and fixed stars over a range of latitudes
+ *
+ * A paran is a pair of bodies rising, setting or culminating at the same
+ * time. Right ascension and declination of every body are computed once for
+ * the day that begins at julianDay; the times of the events at each latitude
+ * follow from the spherical triangle, and all pairs of events less than the
+ * tolerance apart are reported. Pairs of two stars are not. The latitudes are
+ * split into bands searched in parallel, so that paran maps of the whole star
+ * catalogue (stars = 'all') take a fraction of a second.
+ *
+ * Event times agree with calculateRiseTransitSet() to a few seconds; rising
+ * and setting use a fixed refraction of 34'.
+ *
+ * @param julianDay - Start of the day (UT)
+ * @param planets - Planets to find parans of
+ * @param stars - Fixed star names, or 'all' for the whole catalogue
+ * @param latitudes - Geographic latitudes in degrees
+ * @param options - Events, tolerance, longitude, flags and threads
+ * @returns Parans in the order of latitudes and times
+ * @throws Error if a star is not found
+ *
+ * @example
+ * // Parans of the Sun and Moon with Sirius and Regulus, every degree from 60°S to 60°N
+ * const latitudes = Array.from({ length: 121 }, (_, i) => i - 60);
+ * const parans = findParans(julianDay(2025, 3, 1), [Planet.Sun, Planet.Moon], ['Sirius', 'Regulus'], latitudes);
+ */
+export function findParans(
+  julianDay: number,
+  planets: CelestialBody[],
+  stars: string[] | 'all',
+  latitudes: number[],
+  options: ParanOptions = {}
+): Paran[] {
+  const normalizedFlags = normalizeFlags(options.flags ?? CalculationFlag.SwissEphemeris);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const rsmi = (options.noRefraction ? PARAN_NO_REFRACTION : 0) | (options.discCenter ? PARAN_DISC_CENTER : 0);
+  const [times, ids, names] = binding.parans(
+    julianDay,
+    Int32Array.from(planets),
+    stars,
+    options.longitude ?? 0,
+    Float64Array.from(latitudes),
+    options.events ?? 15,
+    (options.toleranceMinutes ?? 4) / 1440,
+    normalizedFlags,
+    rsmi,
+    options.threads ?? 0
+  ) as [Float64Array, Int32Array, string[]];
+
+  const bodyOf = (i: number): CelestialBody | string => (i < planets.length ? planets[i] : names[i - planets.length]);
+  const result: Paran[] = [];
+  for (let i = 0; i < times.length / 2; i++) {
+    result.push({
+      latitude: latitudes[ids[5 * i]],
+      body: planets[ids[5 * i + 1]],
+      event: ids[5 * i + 2],
+      other: bodyOf(ids[5 * i + 3]),
+      otherEvent: ids[5 * i + 4],
+      time: times[2 * i],
+      otherTime: times[2 * i + 1],
+    });
+  }
+  return result;
+}
+
+// speculum layout of swe_speculum() (SE_SPECULUM_SIZE doubles per row)
+const SPECULUM_SIZE = 16;
+const SPECULUM_ANGLES = 1;
+const DIRECTION_DIRECT = 1;
+const DIRECTION_CONVERSE = 2;
+const DIRECTION_WEST = 4;
+
+/**
+ * One body (or angle) of a chart speculum
+ */
+export interface SpeculumRow {
+  /** Body, or 'ASC' / 'MC' for the angles */
+  body: CelestialBody | 'ASC' | 'MC';
+
+  /** Right ascension in degrees */
+  rightAscension: number;
+
+  /** Declination in degrees */
+  declination: number;
+
+  /** Ecliptic longitude in degrees */
+  longitude: number;
+
+  /** Ecliptic latitude in degrees */
+  latitude: number;
+
+  /** Hour angle in degrees, positive west of the upper meridian */
+  hourAngle: number;
+
+  /** Distance from the nearer meridian in degrees */
+  meridianDistance: number;
+
+  /** Ascensional difference in degrees */
+  ascensionalDifference: number;
+
+  /** Diurnal semi-arc in degrees (0 or 180 if the body does not rise or set) */
+  diurnalSemiArc: number;
+
+  /** Nocturnal semi-arc in degrees */
+  nocturnalSemiArc: number;
+
+  /** True if the body is above the horizon */
+  aboveHorizon: boolean;
+
+  /** Mundane position (Placidus), degrees west of the MC; -1 if the body does not rise or set */
+  placidus: number;
+
+  /** Mundane position (Regiomontanus), degrees west of the MC */
+  regiomontanus: number;
+
+  /** Mundane position (Campanus), degrees west of the MC */
+  campanus: number;
+}
+
+/**
+ * Speculum of a chart, the input of findPrimaryDirections()
+ */
+export interface Speculum {
+  /** Julian day (UT) of the chart */
+  julianDay: number;
+
+  /** Right ascension of the MC in degrees */
+  armc: number;
+
+  /** True obliquity of the ecliptic in degrees */
+  obliquity: number;
+
+  /** Geographic latitude in degrees */
+  geoLatitude: number;
+
+  /** Speed of the Sun in right ascension, degrees per day */
+  sunSpeedRA: number;
+
+  /** Bodies, followed by the ascendant and MC */
+  rows: SpeculumRow[];
+
+  /** Chart data for the native directions */
+  readonly chart: Float64Array;
+
+  /** Rows for the native directions */
+  readonly data: Float64Array;
+}
+
+/**
+ * An arc of a primary direction
+ */
+export interface PrimaryDirection {
+  /** Promissor (row of the speculum) */
+  promissor: CelestialBody;
+
+  /** Significator (row of the speculum) */
+  significator: CelestialBody | 'ASC' | 'MC';
+
+  /** Mundane aspect in degrees */
+  aspect: number;
+
+  /** True if the significator is directed to the promissor */
+  converse: boolean;
+
+  /** True if the aspect point lies west of the body that stays */
+  west: boolean;
+
+  /** Arc of direction in degrees of right ascension */
+  arc: number;
+
+  /** Age in years by the key */
+  years: number;
+
+  /** Julian day (UT) of the direction */
+  julianDay: number;
+}
+
+/**
+ * Options for findPrimaryDirections()
+ */
+export interface PrimaryDirectionOptions {
+  /** Placidus, Regiomontanus or Campanus (default: Placidus) */
+  method?: HouseSystem;
+
+  /** Mundane aspects in degrees (default: 0, 60, 90, 120, 180) */
+  aspects?: number[];
+
+  /** Add converse directions (default: false) */
+  converse?: boolean;
+
+  /** Key of the arcs (default: Naibod) */
+  key?: DirectionKey;
+
+  /** Years after the birth (default: 90) */
+  maxYears?: number;
+}
+
+/**
+ * Calculate the speculum of a chart for primary directions
+ *
+ * Right ascension, declination, hour angle, semi-arcs and the mundane
+ * positions of Placidus, Regiomontanus and Campanus of each body, followed by
+ * the ascendant and MC. A mundane position m is the house position
+ * 10 - m / 30 of swe_house_pos(). Compute the speculum once and pass it to
+ * findPrimaryDirections() for every method and key.
+ *
+ * @param julianDay - Time of the chart (UT)
+ * @param longitude - Geographic longitude in degrees (east positive)
+ * @param latitude - Geographic latitude in degrees
+ * @param bodies - Promissors and significators
+ * @param flags - Calculation flags (default: SwissEphemeris)
+ * @returns Speculum of the chart
+ *
+ * @example
+ * const speculum = calculateSpeculum(birth, -0.13, 51.5, [Planet.Sun, Planet.Moon, Planet.Mars]);
+ */
+export function calculateSpeculum(
+  julianDay: number,
+  longitude: number,
+  latitude: number,
+  bodies: CelestialBody[],
+  flags: CalculationFlagInput = CalculationFlag.SwissEphemeris
+): Speculum {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const [chart, data] = binding.speculum(
+    julianDay,
+    longitude,
+    latitude,
+    Int32Array.from(bodies),
+    normalizedFlags,
+    SPECULUM_ANGLES
+  ) as [Float64Array, Float64Array];
+
+  const rows: SpeculumRow[] = [];
+  for (let i = 0; i < data.length / SPECULUM_SIZE; i++) {
+    const r = data.subarray(i * SPECULUM_SIZE, (i + 1) * SPECULUM_SIZE);
+    rows.push({
+      body: i < bodies.length ? bodies[i] : i === bodies.length ? 'ASC' : 'MC',
+      rightAscension: r[0],
+      declination: r[1],
+      longitude: r[2],
+      latitude: r[3],
+      hourAngle: r[5],
+      meridianDistance: r[6],
+      ascensionalDifference: r[7],
+      diurnalSemiArc: r[8],
+      nocturnalSemiArc: r[9],
+      aboveHorizon: r[14] !== 0,
+      placidus: r[10],
+      regiomontanus: r[11],
+      campanus: r[12],
+    });
+  }
+
+  return {
+    julianDay,
+    armc: chart[0],
+    obliquity: chart[1],
+    geoLatitude: chart[2],
+    sunSpeedRA: chart[3],
+    rows,
+    chart,
+    data,
+  };
+}
+
+/**
+ * Find the primary directions of a chart
+ *
+ * Mundane directions of every body to every body and angle, for a list of
+ * aspects, in the semi-arc system of Placidus or the circles of position of
+ * Regiomontanus or Campanus. The promissor is carried by the diurnal motion
+ * to the aspect point of the significator (with converse, also the
+ * significator to the aspect point of the promissor). The hour angle of the
+ * aspect point is solved in closed form from the speculum, so a 90-year
+ * table of all pairs takes well under a millisecond.
+ *
+ * @param speculum - Speculum from calculateSpeculum()
+ * @param options - Method, aspects, converse, key and years
+ * @returns Directions by increasing arc
+ * @throws Error if the method is not Placidus, Regiomontanus or Campanus
+ *
+ * @example
+ * const directions = findPrimaryDirections(speculum, { method: HouseSystem.Regiomontanus, key: DirectionKey.Ptolemy });
+ */
+export function findPrimaryDirections(speculum: Speculum, options: PrimaryDirectionOptions = {}): PrimaryDirection[] {
+  const aspects = options.aspects ?? [0, 60, 90, 120, 180];
+  const rate = directionKeyRate(options.key ?? DirectionKey.Naibod, speculum);
+  const flags = DIRECTION_DIRECT | (options.converse ? DIRECTION_CONVERSE : 0);
+
+  const [arcs, ids] = binding.directions(
+    speculum.chart,
+    speculum.data,
+    options.method ?? HouseSystem.Placidus,
+    Float64Array.from(aspects),
+    flags,
+    (options.maxYears ?? 90) * rate
+  ) as [Float64Array, Int32Array];
+
+  const result: PrimaryDirection[] = [];
+  for (let i = 0; i < arcs.length; i++) {
+    const years = arcs[i] / rate;
+    result.push({
+      promissor: speculum.rows[ids[4 * i]].body as CelestialBody,
+      significator: speculum.rows[ids[4 * i + 1]].body,
+      aspect: aspects[ids[4 * i + 2]],
+      converse: (ids[4 * i + 3] & DIRECTION_CONVERSE) !== 0,
+      west: (ids[4 * i + 3] & DIRECTION_WEST) !== 0,
+      arc: arcs[i],
+      years,
+      julianDay: speculum.julianDay + years * 365.24219,
+    });
+  }
+  return result;
+}
+
+/**
+ * Degrees of arc per year of a key of directions
+ * @internal
+ */
+function directionKeyRate(key: DirectionKey, speculum: Speculum): number {
+  switch (key) {
+    case DirectionKey.Ptolemy:
+      return 1;
+    case DirectionKey.Cardan:
+      return 59.2 / 60;
+    case DirectionKey.SolarArc:
+      return speculum.sunSpeedRA;
+    default:
+      return 0.98564733;
+  }
+}
+
+/**
+ * An aspect for compareCharts()
+ */
+export interface AspectDefinition {
+  /** Angle in degrees, 0 to 180 */
+  angle: number;
+
+  /** Orb in degrees */
+  orb: number;
+
+  /** Score of the exact aspect, falling linearly to 0 at the orb (default: 1) */
+  weight?: number;
+}
+
+/**
+ * Options for compareCharts()
+ */
+export interface CompareChartsOptions {
+  /** List the aspects of the charts with at least this score (default: all charts) */
+  minScore?: number;
+
+  /** Number of threads comparing ranges of charts (default: one per CPU) */
+  threads?: number;
+}
+
+/**
+ * Scores and aspects of compareCharts(), as parallel typed arrays
+ */
+export interface ChartComparison {
+  /** Score of each chart */
+  scores: Float32Array;
+
+  /** Chart of each aspect, in chart order */
+  chart: Int32Array;
+
+  /** Point of the reference chart of each aspect */
+  referencePoint: Uint8Array;
+
+  /** Point of the chart of each aspect */
+  point: Uint8Array;
+
+  /** Index of the aspect definition */
+  aspect: Uint8Array;
+
+  /** Deviation from the exact aspect in degrees */
+  deviation: Float32Array;
+}
+
+/**
+ * Pack the longitudes of many charts for compareCharts()
+ *
+ * @param charts - Longitudes of the points of each chart, all of the same length
+ * @returns Longitudes packed by point: point p of chart c at p * charts.length + c
+ */
+export function packChartLongitudes(charts: ArrayLike<number>[]): Float32Array {
+  const points = charts.length > 0 ? charts[0].length : 0;
+  const packed = new Float32Array(points * charts.length);
+  for (let c = 0; c < charts.length; c++) {
+    for (let p = 0; p < points; p++) {
+      const lon = charts[c][p] % 360;
+      packed[p * charts.length + c] = lon < 0 ? lon + 360 : lon;
+    }
+  }
+  return packed;
+}
+
+/**
+ * Compare one chart against many: aspects between all pairs of points
+ *
+ * For every chart, the angular distance of every point of the reference to
+ * every point of the chart is tested against the aspects, and each aspect
+ * within its orb scores weight * (1 - deviation / orb). The native kernel
+ * runs over the charts with SIMD instructions (4 charts per instruction) and
+ * splits them between threads; 100,000 charts of 15 points against 15
+ * points with 10 aspects take about 80 ms in one thread. The aspects of the
+ * charts that reach minScore are listed; listing is not vectorised, so set
+ * minScore for large comparisons.
+ *
+ * @param reference - Longitudes of the points of the reference chart (at most 255)
+ * @param longitudes - Longitudes of the charts from packChartLongitudes(), 0 to 360
+ * @param pointCount - Points per chart (at most 255)
+ * @param aspects - Aspects with orbs (at most 32)
+ * @param options - Minimum score to list and threads
+ * @returns Scores of all charts and the aspects of the listed charts
+ * @throws Error if there are too many points or aspects
+ *
+ * @example
+ * const packed = packChartLongitudes(charts);
+ * const result = compareCharts(natal, packed, 15, [
+ *   { angle: 0, orb: 8, weight: 10 },
+ *   { angle: 120, orb: 7, weight: 6 },
+ *   { angle: 90, orb: 6, weight: -5 },
+ * ], { minScore: 150 });
+ */
+export function compareCharts(
+  reference: ArrayLike<number>,
+  longitudes: Float32Array,
+  pointCount: number,
+  aspects: AspectDefinition[],
+  options: CompareChartsOptions = {}
+): ChartComparison {
+  const definitions = new Float64Array(aspects.length * 3);
+  aspects.forEach((a, i) => {
+    definitions[3 * i] = a.angle;
+    definitions[3 * i + 1] = a.orb;
+    definitions[3 * i + 2] = a.weight ?? 1;
+  });
+
+  const [scores, chart, referencePoint, point, aspect, deviation] = binding.aspect_matrix(
+    Float64Array.from(reference, (lon) => ((lon % 360) + 360) % 360),
+    longitudes,
+    pointCount,
+    definitions,
+    options.minScore ?? -Infinity,
+    options.threads ?? 0
+  ) as [Float32Array, Int32Array, Uint8Array, Uint8Array, Uint8Array, Float32Array];
+
+  return { scores, chart, referencePoint, point, aspect, deviation };
+}
+
+/**
+ * Calculate planetary phenomena of one body at equidistant times
+ *
+ * Phase angle, phase, elongation, apparent diameter, magnitude and (for the
+ * Moon) horizontal parallax, as returned by swe_pheno_ut(), written into a
+ * structure-of-arrays PhenomenaSeries by one native call.
+ *
+ * @param startJulianDay - Julian day (UT) of the first row
+ * @param step - Days between rows
+ * @param count - Number of rows
+ * @param body - Celestial body to calculate
+ * @param flags - Calculation flags (default: SwissEphemeris)
+ * @param target - Optional series of the same length to fill
+ * @returns PhenomenaSeries with one row per time
+ *
+ * @example
+ * // Daily magnitude of Venus over one synodic period
+ * const venus = calculatePhenomenaSeries(julianDay(2025, 1, 1), 1, 584, Planet.Venus);
+ * console.log(venus.magnitude[0], venus.elongation[0]);
+ */
+export function calculatePhenomenaSeries(
+  startJulianDay: number,
+  step: number,
+  count: number,
+  body: CelestialBody,
+  flags: CalculationFlagInput = CalculationFlag.SwissEphemeris,
+  target?: PhenomenaSeries
+): PhenomenaSeries {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const series = target ?? new PhenomenaSeries(count);
+  if (series.length !== count) {
+    throw new RangeError(`Target series has ${series.length} rows, expected ${count}`);
+  }
+  for (let i = 0; i < count; i++) {
+    series.julianDays[i] = startJulianDay + i * step;
+  }
+
+  binding.pheno_ut_series(startJulianDay, step, body, normalizedFlags, series.values);
+  return series;
+}
+
+/**
+ * Calculate planetary phenomena of several bodies at one time
+ *
+ * The Sun is calculated once and shared by all bodies.
+ *
+ * @param julianDay - Julian day number in Universal Time
+ * @param bodies - Celestial bodies to calculate
+ * @param flags - Calculation flags (default: SwissEphemeris)
+ * @returns One PlanetaryPhenomena object per body, in the order given
+ *
+ * @example
+ * const [mercury, venus] = calculatePhenomena(jd, [Planet.Mercury, Planet.Venus]);
+ * console.log(`Venus: ${venus.magnitude.toFixed(2)}m, ${(venus.phase * 100).toFixed(0)}% lit`);
+ */
+export function calculatePhenomena(
+  julianDay: number,
+  bodies: CelestialBody[],
+  flags: CalculationFlagInput = CalculationFlag.SwissEphemeris
+): PlanetaryPhenomena[] {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const output = new Float64Array(bodies.length * PHENOMENA_COMPONENTS);
+  binding.pheno_ut_planets(julianDay, Int32Array.from(bodies), normalizedFlags, output);
+
+  return bodies.map((_, k) => {
+    const o = k * PHENOMENA_COMPONENTS;
+    return {
+      phaseAngle: output[o],
+      phase: output[o + 1],
+      elongation: output[o + 2],
+      apparentDiameter: output[o + 3],
+      magnitude: output[o + 4],
+      horizontalParallax: output[o + 5],
+    };
+  });
+}
+
+/**
+ * Sample attribute `attribute` of swe_pheno_ut() and refine its extrema
+ * @internal
+ */
+function findPhenomenonExtrema(
+  startJulianDay: number,
+  endJulianDay: number,
+  body: CelestialBody,
+  attribute: number,
+  sign: number,
+  flags: CalculationFlagInput,
+  step: number
+): PhenomenonExtremum[] {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const samples = Math.floor((endJulianDay - startJulianDay) / step) + 1;
+  const capacity = Math.max(1, Math.ceil(samples / 2));
+  const times = new Float64Array(capacity);
+  const values = new Float64Array(capacity);
+  const found = binding.pheno_ut_extrema(
+    startJulianDay, step, samples, body, normalizedFlags, attribute, sign, times, values
+  );
+
+  const result: PhenomenonExtremum[] = [];
+  for (let i = 0; i < found; i++) {
+    result.push({ time: times[i], value: values[i] });
+  }
+  return result;
+}
+
+/**
+ * Find the greatest elongations of a body from the Sun
+ *
+ * Elongation is sampled every `step` days and each local maximum is refined
+ * by parabolic interpolation to about a second. The step must be shorter
+ * than half the interval between two extrema (1 day suits all planets and
+ * the Moon).
+ *
+ * @param startJulianDay - Start of the search (Julian day, UT)
+ * @param endJulianDay - End of the search (Julian day, UT)
+ * @param body - Celestial body, usually Mercury or Venus
+ * @param flags - Calculation flags (default: SwissEphemeris)
+ * @param step - Sampling interval in days (default: 1)
+ * @returns Times and elongations (degrees) in chronological order
+ *
+ * @example
+ * const elongations = findGreatestElongations(
+ *   julianDay(2025, 1, 1), julianDay(2026, 1, 1), Planet.Mercury
+ * );
+ * for (const e of elongations) {
+ *   console.log(julianDayToDate(e.time).toISOString(), e.value.toFixed(1));
+ * }
+ */
+export function findGreatestElongations(
+  startJulianDay: number,
+  endJulianDay: number,
+  body: CelestialBody,
+  flags: CalculationFlagInput = CalculationFlag.SwissEphemeris,
+  step: number = 1
+): PhenomenonExtremum[] {
+  return findPhenomenonExtrema(startJulianDay, endJulianDay, body, 2, 1, flags, step);
+}
+
+/**
+ * Find the times of greatest brilliancy of a body
+ *
+ * Local minima of the apparent magnitude, found like the extrema in
+ * findGreatestElongations().
+ *
+ * @param startJulianDay - Start of the search (Julian day, UT)
+ * @param endJulianDay - End of the search (Julian day, UT)
+ * @param body - Celestial body, usually Venus
+ * @param flags - Calculation flags (default: SwissEphemeris)
+ * @param step - Sampling interval in days (default: 1)
+ * @returns Times and magnitudes in chronological order
+ */
+export function findGreatestBrilliancy(
+  startJulianDay: number,
+  endJulianDay: number,
+  body: CelestialBody,
+  flags: CalculationFlagInput = CalculationFlag.SwissEphemeris,
+  step: number = 1
+): PhenomenonExtremum[] {
+  return findPhenomenonExtrema(startJulianDay, endJulianDay, body, 4, -1, flags, step);
+}
+
+/**
+ * Calculate nodes and apsides of several bodies for many Julian days
+ *
+ * One native call covers all dates and bodies; the bodies are calculated
+ * date by date. Each point has the same six components as a position
+ * (longitude, latitude, distance and their speeds, or cartesian
+ * coordinates with the Xyz flag).
+ *
+ * @param julianDays - Julian days in Universal Time
+ * @param bodies - Planets or asteroids (not the lunar nodes and apsides)
+ * @param flags - Calculation flags (default: SwissEphemeris | Speed)
+ * @param method - Mean or osculating points, optionally with FocalPoint (default: Mean)
+ * @param target - Optional series with the same dates and bodies to fill
+ * @returns NodesApsidesSeries with ascending/descending node, perihelion and aphelion
+ *
+ * @example
+ * const days = Float64Array.from({ length: 36500 }, (_, i) => jd + i);
+ * const nodes = calculateNodesApsides(days, [Planet.Mars, Planet.Jupiter], undefined, NodeMethod.Osculating);
+ * const marsNodeToday = nodes.ascendingNode[nodes.offset(0, 0)];
+ */
+export function calculateNodesApsides(
+  julianDays: Float64Array | ArrayLike<number>,
+  bodies: CelestialBody[],
+  flags: CalculationFlagInput = CommonCalculationFlags.DefaultSwissEphemeris,
+  method: number = NodeMethod.Mean,
+  target?: NodesApsidesSeries
+): NodesApsidesSeries {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const series = target ?? new NodesApsidesSeries(julianDays.length, bodies);
+  if (series.length !== julianDays.length || series.bodies.length !== bodies.length) {
+    throw new RangeError('Target series does not match the requested dates and bodies');
+  }
+  if (series.julianDays !== julianDays) series.julianDays.set(julianDays);
+
+  binding.nod_aps_ut_batch(
+    series.julianDays,
+    Int32Array.from(bodies),
+    normalizedFlags,
+    method,
+    series.ascendingNode,
+    series.descendingNode,
+    series.perihelion,
+    series.aphelion
+  );
+  return series;
+}
+
+/**
+ * Calculate osculating orbital elements of several bodies for many Julian days
  *
- * Searches for the next lunar eclipse after the given Julian day.
+ * For each date the state vectors of all bodies are gathered first and
+ * then converted to elements in one pass.
  *
- * @param startJulianDay - Julian day to start search from
- * @param flags - Calculation flags (default: SwissEphemeris)
- * @param eclipseType - Filter by eclipse type (0 = all types)
- * @param backward - Search backward in time if true
- * @returns LunarEclipse object with times and convenience methods
+ * @param julianDays - Julian days in Universal Time
+ * @param bodies - Planets, the Earth (Earth-Moon barycentre), the Moon or asteroids
+ * @param flags - Calculation flags; Barycentric selects barycentric elements beyond Jupiter (default: SwissEphemeris)
+ * @param target - Optional series with the same dates and bodies to fill
+ * @returns OrbitalElementsSeries with 17 elements per date and body
  *
  * @example
- * // Find next lunar eclipse
- * const jd = julianDay(2025, 1, 1);
- * const eclipse = findNextLunarEclipse(jd);
- *
- * console.log(`Eclipse maximum: ${julianDayToDate(eclipse.maximum)}`);
- * console.log(`Is total: ${eclipse.isTotal()}`);
- * console.log(`Totality duration: ${eclipse.getTotalityDuration()} hours`);
- *
- * // Find previous lunar eclipse
- * const previousEclipse = findNextLunarEclipse(jd, undefined, 0, true);
+ * const orbits = calculateOrbitalElements([jd], [Planet.Mars]);
+ * console.log(orbits.get(0, 0).eccentricity);
  */
-export function findNextLunarEclipse(
-  startJulianDay: number,
+export function calculateOrbitalElements(
+  julianDays: Float64Array | ArrayLike<number>,
+  bodies: CelestialBody[],
   flags: CalculationFlagInput = CalculationFlag.SwissEphemeris,
-  eclipseType: EclipseTypeFlagInput = 0,
-  backward: boolean = false
-): LunarEclipse {
+  target?: OrbitalElementsSeries
+): OrbitalElementsSeries {
   const normalizedFlags = normalizeFlags(flags);
   ensureEphemerisInitialized(normalizedFlags);
-  const normalizedEclipseType = normalizeEclipseTypes(eclipseType);
-
-  const result = binding.lun_eclipse_when(
-    startJulianDay,
-    normalizedFlags,
-    normalizedEclipseType,
-    backward ? 1 : 0
-  ) as [number, number[]];
 
-  const [retFlag, tret] = result;
+  const series = target ?? new OrbitalElementsSeries(julianDays.length, bodies);
+  if (series.length !== julianDays.length || series.bodies.length !== bodies.length) {
+    throw new RangeError('Target series does not match the requested dates and bodies');
+  }
+  if (series.julianDays !== julianDays) series.julianDays.set(julianDays);
 
-  return new LunarEclipseImpl(
-    retFlag,
-    tret[0], // maximum
-    tret[1], // partial begin
-    tret[2], // partial end
-    tret[3], // total begin
-    tret[4], // total end
-    tret[5], // penumbral begin
-    tret[6]  // penumbral end
+  binding.get_orbital_elements_ut_batch(
+    series.julianDays,
+    Int32Array.from(bodies),
+    normalizedFlags,
+    series.values
   );
+  return series;
 }
 
 /**
- * Find the next solar eclipse globally
- *
- * Searches for the next solar eclipse visible anywhere on Earth.
- *
- * @param startJulianDay - Julian day to start search from
- * @param flags - Calculation flags (default: SwissEphemeris)
- * @param eclipseType - Filter by eclipse type (0 = all types)
- * @param backward - Search backward in time if true
- * @returns SolarEclipse object with times and convenience methods
+ * Calculate the maximum, minimum and current distance of several bodies
+ * from the Earth for many Julian days
+ *
+ * The maximum and minimum are the extreme distances between the
+ * osculating orbits of the body and the Earth-Moon barycentre (from the
+ * Sun, with the Heliocentric flag). The Kepler elements of the Earth are
+ * computed once per date. See setOrbitDistanceCache() to make repeated
+ * calls cheap.
+ *
+ * @param julianDays - Julian days in Universal Time
+ * @param bodies - Planets, the Sun, the Moon or asteroids
+ * @param flags - Calculation flags; Heliocentric selects distances from the Sun (default: SwissEphemeris)
+ * @param target - Optional array of 3 * julianDays.length * bodies.length values to fill
+ * @returns [maximum, minimum, true] distance in AU for each date and body,
+ *   body b at date d starting at (d * bodies.length + b) * 3
  *
  * @example
- * // Find next solar eclipse
- * const jd = julianDay(2025, 1, 1);
- * const eclipse = findNextSolarEclipse(jd);
- *
- * console.log(`Eclipse maximum: ${julianDayToDate(eclipse.maximum)}`);
- * console.log(`Is total: ${eclipse.isTotal()}`);
- * console.log(`Is annular: ${eclipse.isAnnular()}`);
- * console.log(`Is central: ${eclipse.isCentral()}`);
+ * setOrbitDistanceCache(30);
+ * const d = calculateOrbitDistances([jd], [Planet.Mars]);
+ * const relative = (d[2] - d[1]) / (d[0] - d[1]); // 0 = closest, 1 = farthest
  */
-export function findNextSolarEclipse(
-  startJulianDay: number,
+export function calculateOrbitDistances(
+  julianDays: Float64Array | ArrayLike<number>,
+  bodies: CelestialBody[],
   flags: CalculationFlagInput = CalculationFlag.SwissEphemeris,
-  eclipseType: EclipseTypeFlagInput = 0,
-  backward: boolean = false
-): SolarEclipse {
+  target?: Float64Array
+): Float64Array {
   const normalizedFlags = normalizeFlags(flags);
   ensureEphemerisInitialized(normalizedFlags);
-  const normalizedEclipseType = normalizeEclipseTypes(eclipseType);
-
-  const result = binding.sol_eclipse_when_glob(
-    startJulianDay,
-    normalizedFlags,
-    normalizedEclipseType,
-    backward ? 1 : 0
-  ) as [number, number[]];
 
-  const [retFlag, tret] = result;
+  const size = 3 * julianDays.length * bodies.length;
+  const output = target ?? new Float64Array(size);
+  if (output.length !== size) {
+    throw new RangeError(`Target has ${output.length} values, expected ${size}`);
+  }
 
-  return new SolarEclipseImpl(
-    retFlag,
-    tret[0], // maximum
-    tret[1], // partial begin
-    tret[2], // partial end
-    tret[3], // central begin
-    tret[4], // central end
-    tret[5], // center line begin
-    tret[6]  // center line end
+  binding.orbit_max_min_true_distance_ut_batch(
+    julianDays instanceof Float64Array ? julianDays : Float64Array.from(julianDays),
+    Int32Array.from(bodies),
+    normalizedFlags,
+    output
   );
+  return output;
+}
+
+/**
+ * Keep the orbit geometry found by calculateOrbitDistances()
+ *
+ * The geocentric maximum and minimum distance need a search over both
+ * orbits, about 0.5 ms per body. With a window, a body calculated again
+ * within that many days of its last full search starts from the previous
+ * solution instead (about 20 µs). Both searches stop within 1e-4 AU of
+ * the extremum, but not at the same point, so results differ by up to
+ * that amount.
+ *
+ * @param windowDays - Days to reuse a search, 0 to search every time (default)
+ *
+ * @example
+ * setOrbitDistanceCache(30);
+ */
+export function setOrbitDistanceCache(windowDays: number): void {
+  binding.set_orbit_distance_cache(windowDays);
 }
 
 /**
@@ -467,6 +1836,58 @@ export function setSiderealMode(
   binding.set_sid_mode(siderealMode, t0, ayanT0);
 }
 
+/**
+ * Calculate a body's sidereal position in several ayanamsa systems at once
+ *
+ * Equivalent to calling setSiderealMode() and calculatePosition() with
+ * CalculationFlag.Sidereal for every mode, but the tropical position is
+ * computed once and only the ayanamsa is evaluated per mode. The current
+ * sidereal mode is left unchanged.
+ *
+ * @param julianDay - Julian day number in Universal Time
+ * @param body - Celestial body to calculate
+ * @param siderealModes - Ayanamsa systems (SiderealMode values)
+ * @param flags - Calculation flags (default: SwissEphemeris with speed);
+ *                CalculationFlag.Sidereal is added automatically
+ * @returns One PlanetaryPosition per sidereal mode, in the same order
+ * @throws Error if calculation fails
+ *
+ * @example
+ * const moon = calculateSiderealPositions(jd, Planet.Moon, [
+ *   SiderealMode.Lahiri,
+ *   SiderealMode.Raman,
+ *   SiderealMode.Krishnamurti,
+ * ]);
+ * moon.forEach((p) => console.log(p.longitude));
+ */
+export function calculateSiderealPositions(
+  julianDay: number,
+  body: CelestialBody,
+  siderealModes: ArrayLike<number>,
+  flags: CalculationFlagInput = CommonCalculationFlags.DefaultSwissEphemeris
+): PlanetaryPosition[] {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const modes = Int32Array.from(siderealModes);
+  const xx = new Float64Array(6 * modes.length);
+  const retFlags = binding.calc_ut_multi_sid(julianDay, body, normalizedFlags, modes, xx) as number;
+
+  const positions: PlanetaryPosition[] = [];
+  for (let k = 0; k < modes.length; k++) {
+    positions.push({
+      longitude: xx[6 * k],
+      latitude: xx[6 * k + 1],
+      distance: xx[6 * k + 2],
+      longitudeSpeed: xx[6 * k + 3],
+      latitudeSpeed: xx[6 * k + 4],
+      distanceSpeed: xx[6 * k + 5],
+      flags: retFlags,
+    });
+  }
+  return positions;
+}
+
 /**
  * Set the geographic location for topocentric calculations
  *
@@ -510,6 +1931,90 @@ export function setTopocentric(
   binding.set_topo(longitude, latitude, altitude);
 }
 
+/**
+ * Calculate topocentric positions of one body for many observers
+ *
+ * The geocentric position, light-time and aberration are computed once;
+ * only parallax, the change of light-time and the observer's share of
+ * aberration are added per observer. This is much faster than calling
+ * setTopocentric() and calculatePosition() for each place, and leaves the
+ * location set with setTopocentric() unchanged. Nodes, apsides and
+ * sidereal positions fall back to a full calculation per observer.
+ *
+ * @param julianDay - Julian day number in Universal Time
+ * @param body - Celestial body to calculate
+ * @param observers - Triples of longitude, latitude (degrees) and altitude (meters)
+ * @param flags - Calculation flags; Topocentric is implied (default: SwissEphemeris | Speed)
+ * @param target - Optional output array of 6 values per observer to reuse
+ * @returns Longitude, latitude, distance and their speeds (6 values per observer)
+ *
+ * @example
+ * const cities = new Float64Array([
+ *   -74.006, 40.7128, 10,  // New York
+ *   72.8777, 19.076, 14,   // Mumbai
+ * ]);
+ * const moon = calculateTopocentricPositions(jd, Planet.Moon, cities);
+ * console.log(`Moon from Mumbai: ${moon[6]}°`);
+ */
+export function calculateTopocentricPositions(
+  julianDay: number,
+  body: CelestialBody,
+  observers: Float64Array | ArrayLike<number>,
+  flags: CalculationFlagInput = CommonCalculationFlags.DefaultSwissEphemeris,
+  target?: Float64Array
+): Float64Array {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const geopos = observers instanceof Float64Array ? observers : Float64Array.from(observers);
+  const count = Math.floor(geopos.length / 3);
+  const output = target ?? new Float64Array(count * 6);
+  if (output.length < count * 6) {
+    throw new RangeError(`Target has ${output.length} values, expected ${count * 6}`);
+  }
+
+  binding.calc_topo_batch(julianDay, body, normalizedFlags, geopos, output);
+  return output;
+}
+
+/**
+ * Calculate positions of several bodies as seen from another body
+ *
+ * Positions are apparent (light-time, deflection and aberration) for an
+ * observer at the centre body, e.g. for Mars- or Jupiter-centric charts.
+ * Obliquity, nutation and the state of the centre are computed once for
+ * all bodies.
+ *
+ * @param julianDay - Julian day number in Universal Time
+ * @param center - Body at the centre (a planet, not the Earth)
+ * @param bodies - Bodies to calculate; must not include the centre
+ * @param flags - Calculation flags (default: SwissEphemeris | Speed)
+ * @param target - Optional output array of 6 values per body to reuse
+ * @returns Longitude, latitude, distance and their speeds (6 values per body)
+ *
+ * @example
+ * const fromMars = calculatePlanetocentricPositions(jd, Planet.Mars, [Planet.Sun, Planet.Earth, Planet.Jupiter]);
+ * console.log(`Earth from Mars: ${fromMars[6]}°`);
+ */
+export function calculatePlanetocentricPositions(
+  julianDay: number,
+  center: CelestialBody,
+  bodies: CelestialBody[],
+  flags: CalculationFlagInput = CommonCalculationFlags.DefaultSwissEphemeris,
+  target?: Float64Array
+): Float64Array {
+  const normalizedFlags = normalizeFlags(flags);
+  ensureEphemerisInitialized(normalizedFlags);
+
+  const output = target ?? new Float64Array(bodies.length * 6);
+  if (output.length < bodies.length * 6) {
+    throw new RangeError(`Target has ${output.length} values, expected ${bodies.length * 6}`);
+  }
+
+  binding.calc_pctr_multi(julianDay, center, Int32Array.from(bodies), normalizedFlags, output);
+  return output;
+}
+
 /**
  * Get the ayanamsa (sidereal offset) value for a given date
  *
@@ -663,6 +2168,287 @@ export function calculateRiseTransitSet(
   };
 }
 
+/**
+ * Convert many ecliptic or equatorial positions to horizontal coordinates
+ *
+ * All objects share one time and observer, so sidereal time, obliquity and
+ * the refraction setup are computed once per call. Use this for sky views
+ * that transform thousands of objects per frame.
+ *
+ * @param julianDay - Julian day number in Universal Time
+ * @param coordinates - Pairs of longitude/latitude (or right ascension/declination) in degrees
+ * @param longitude - Observer's geographic longitude
+ * @param latitude - Observer's geographic latitude
+ * @param altitude - Observer's altitude above sea level in meters (default: 0)
+ * @param from - Coordinate system of the input (default: Ecliptic)
+ * @param atmosphericPressure - Pressure in millibars; 0 estimates it from the altitude (default: 0)
+ * @param atmosphericTemperature - Temperature in Celsius (default: 0)
+ * @param target - Optional output array of 3 values per object to reuse
+ * @returns Triples of azimuth (from south, clockwise), true altitude and apparent altitude
+ *
+ * @example
+ * // Two stars given as right ascension/declination
+ * const radec = new Float64Array([88.79, 7.41, 101.29, -16.72]);
+ * const horizontal = horizontalCoordinates(jd, radec, -74.006, 40.7128, 10, CoordinateSystem.Equatorial);
+ * console.log(`Azimuth ${horizontal[0]}, altitude ${horizontal[2]}`);
+ */
+export function horizontalCoordinates(
+  julianDay: number,
+  coordinates: Float64Array | ArrayLike<number>,
+  longitude: number,
+  latitude: number,
+  altitude: number = 0,
+  from: CoordinateSystem = CoordinateSystem.Ecliptic,
+  atmosphericPressure: number = 0,
+  atmosphericTemperature: number = 0,
+  target?: Float64Array
+): Float64Array {
+  ensureEphemerisInitialized(CalculationFlag.SwissEphemeris);
+
+  const input = coordinates instanceof Float64Array ? coordinates : Float64Array.from(coordinates);
+  const count = Math.floor(input.length / 2);
+  const output = target ?? new Float64Array(count * 3);
+  if (output.length < count * 3) {
+    throw new RangeError(`Target has ${output.length} values, expected ${count * 3}`);
+  }
+
+  binding.azalt_batch(
+    julianDay,
+    from,
+    new Float64Array([longitude, latitude, altitude]),
+    atmosphericPressure,
+    atmosphericTemperature,
+    input,
+    output
+  );
+  return output;
+}
+
+/**
+ * Convert many horizontal positions back to ecliptic or equatorial coordinates
+ *
+ * @param julianDay - Julian day number in Universal Time
+ * @param horizontal - Pairs of azimuth (from south, clockwise) and true altitude in degrees
+ * @param longitude - Observer's geographic longitude
+ * @param latitude - Observer's geographic latitude
+ * @param altitude - Observer's altitude above sea level in meters (default: 0)
+ * @param to - Coordinate system of the output (default: Ecliptic)
+ * @param target - Optional output array of 2 values per object to reuse
+ * @returns Pairs of longitude/latitude (or right ascension/declination)
+ */
+export function horizontalToCoordinates(
+  julianDay: number,
+  horizontal: Float64Array | ArrayLike<number>,
+  longitude: number,
+  latitude: number,
+  altitude: number = 0,
+  to: CoordinateSystem = CoordinateSystem.Ecliptic,
+  target?: Float64Array
+): Float64Array {
+  ensureEphemerisInitialized(CalculationFlag.SwissEphemeris);
+
+  const input = horizontal instanceof Float64Array ? horizontal : Float64Array.from(horizontal);
+  const count = Math.floor(input.length / 2);
+  const output = target ?? new Float64Array(count * 2);
+  if (output.length < count * 2) {
+    throw new RangeError(`Target has ${output.length} values, expected ${count * 2}`);
+  }
+
+  binding.azalt_rev_batch(
+    julianDay,
+    to,
+    new Float64Array([longitude, latitude, altitude]),
+    input,
+    output
+  );
+  return output;
+}
+
+/**
+ * Switch between exact and table-driven atmospheric refraction
+ *
+ * With tables enabled, refraction in horizontalCoordinates() and the
+ * native altitude conversions is interpolated in tables built once per
+ * observer altitude, pressure and temperature, instead of evaluating (and
+ * for true to apparent altitude, iterating) the refraction formula. The
+ * interpolation error is below 3e-8 degrees.
+ *
+ * @param enabled - true to use tables, false for the exact formulae (default)
+ *
+ * @example
+ * setRefractionTable(true);
+ * const horizontal = horizontalCoordinates(jd, stars, 8.55, 47.37);
+ */
+export function setRefractionTable(enabled: boolean): void {
+  binding.set_refrac_table(enabled ? 1 : 0);
+}
+
+/**
+ * Options for enableSharedCache()
+ */
+export interface SharedCacheOptions {
+  /** Name of the shared-memory segment (default: '/swisseph') */
+  name?: string;
+
+  /** Size in megabytes when the segment is created (default: 64, minimum: 8) */
+  sizeMB?: number;
+}
+
+/**
+ * Shared cache statistics of the current process
+ */
+export interface SharedCacheStats {
+  /** True while a shared cache is attached */
+  attached: boolean;
+
+  /** Ephemeris segments taken from the cache instead of the files */
+  segmentHits: number;
+
+  /** Ephemeris segments this process decoded and stored */
+  segmentStores: number;
+
+  /** True if the fixed star catalogue is used from the cache */
+  fixedStarsShared: boolean;
+
+  /** True if the delta T table was taken from the cache */
+  deltaTShared: boolean;
+}
+
+const DEFAULT_SHARED_CACHE_NAME = '/swisseph';
+
+/**
+ * Share decoded ephemeris data between processes on this host
+ *
+ * Attaches to a POSIX shared-memory segment, creating it if this is the
+ * first process. Decoded ephemeris segments, the parsed fixed star
+ * catalogue and the delta T table are then read from and published to the
+ * segment, so cluster workers and PM2 instances do not each decode and hold
+ * their own copies. Calculation results are unchanged.
+ *
+ * Call it once per process, before the first calculation. All processes
+ * sharing a cache must use the same ephemeris path. Not available on Windows.
+ *
+ * @param options - Segment name and size
+ * @throws Error if the segment cannot be created or has an incompatible layout
+ *
+ * @example
+ * // In every cluster worker
+ * enableSharedCache({ name: '/myapp-swisseph' });
+ * const moon = calculatePosition(jd, Planet.Moon);
+ */
+export function enableSharedCache(options: SharedCacheOptions = {}): void {
+  binding.set_shared_cache(options.name ?? DEFAULT_SHARED_CACHE_NAME, options.sizeMB ?? 0);
+}
+
+/**
+ * Stop using the shared cache in this process
+ */
+export function disableSharedCache(): void {
+  binding.set_shared_cache(null);
+}
+
+/**
+ * Remove a shared cache segment from the system
+ *
+ * Processes that are attached keep using it; the memory is released when
+ * the last of them exits. Call this on deployment shutdown or after an
+ * upgrade of @swisseph/node.
+ *
+ * @param name - Segment name (default: '/swisseph')
+ */
+export function removeSharedCache(name: string = DEFAULT_SHARED_CACHE_NAME): void {
+  binding.remove_shared_cache(name);
+}
+
+/**
+ * Get shared cache statistics of the current process
+ */
+export function getSharedCacheStats(): SharedCacheStats {
+  return binding.get_shared_cache_stats();
+}
+
+/**
+ * Options for enableResultCache()
+ */
+export interface ResultCacheOptions {
+  /** Path of the cache file; it is created if it does not exist */
+  path: string;
+
+  /** Size in megabytes when the file is created (default: 64, minimum: 1) */
+  sizeMB?: number;
+
+  /** Recompute every hit and compare it with the stored result (default: false) */
+  verify?: boolean;
+}
+
+/**
+ * Result cache statistics of the current process
+ */
+export interface ResultCacheStats {
+  /** True while a result cache is open */
+  open: boolean;
+
+  /** Results taken from the cache (with verify: confirmed by recomputing) */
+  hits: number;
+
+  /** Searches that were not in the cache */
+  misses: number;
+
+  /** Results this process stored */
+  stores: number;
+
+  /** With verify: stored results that differed from the recomputed ones */
+  mismatches: number;
+
+  /** Results not stored because the file is full */
+  notStored: number;
+
+  /** Records in the file, from all processes */
+  records: number;
+
+  /** Number of records the file can hold */
+  capacity: number;
+}
+
+const RESULT_CACHE_USE = 1;
+const RESULT_CACHE_VERIFY = 2;
+
+/**
+ * Keep eclipse, occultation, heliacal and Gauquelin search results on disk
+ *
+ * Opens (or creates) a cache file that findNextLunarEclipse(),
+ * findNextSolarEclipse() and the other search functions of the library
+ * consult before searching. Results are keyed by function, inputs, flags,
+ * library version and the ephemeris files in use, so a repeated query is
+ * answered in microseconds, also after a restart and from other processes
+ * using the same file. Not available on Windows.
+ *
+ * @param options - File path, size and verify mode
+ * @throws Error if the file cannot be created or has an incompatible layout
+ *
+ * @example
+ * enableResultCache({ path: '/var/cache/myapp/swisseph-results.bin' });
+ * const eclipse = findNextLunarEclipse(julianDay(2025, 1, 1));
+ */
+export function enableResultCache(options: ResultCacheOptions): void {
+  const mode = options.verify ? RESULT_CACHE_USE | RESULT_CACHE_VERIFY : RESULT_CACHE_USE;
+  binding.set_result_cache(options.path, options.sizeMB ?? 0, mode);
+}
+
+/**
+ * Stop using the result cache in this process
+ */
+export function disableResultCache(): void {
+  binding.set_result_cache(null);
+}
+
+/**
+ * Get result cache statistics of the current process
+ */
+export function getResultCacheStats(): ResultCacheStats {
+  return binding.get_result_cache_stats();
+}
+
 /**
  * Close Swiss Ephemeris and free resources
  *
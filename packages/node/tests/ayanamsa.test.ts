@@ -1,8 +1,11 @@
 import {
   CalculationFlag,
+  calculatePosition,
+  calculateSiderealPositions,
   getAyanamsa,
   getAyanamsaExUt,
   julianDay,
+  Planet,
   setSiderealMode,
   SiderealMode,
 } from '@swisseph/node';
@@ -41,4 +44,49 @@ describe('ayanamsa calculations', () => {
 
     expect(arrayFlags).toBeCloseTo(numericFlags, 10);
   });
+
+  test('calculates several sidereal modes in one call', () => {
+    const modes = [
+      SiderealMode.FaganBradley,
+      SiderealMode.Lahiri,
+      SiderealMode.TrueCitra,
+      SiderealMode.J2000,
+    ];
+    const flags = CalculationFlag.SwissEphemeris | CalculationFlag.Speed;
+    const multi = calculateSiderealPositions(jd, Planet.Mars, modes, flags);
+
+    expect(multi).toHaveLength(modes.length);
+    modes.forEach((mode, k) => {
+      setSiderealMode(mode);
+      const single = calculatePosition(jd, Planet.Mars, flags | CalculationFlag.Sidereal);
+      expect(multi[k].longitude).toBeCloseTo(single.longitude, 10);
+      expect(multi[k].latitude).toBeCloseTo(single.latitude, 10);
+      expect(multi[k].longitudeSpeed).toBeCloseTo(single.longitudeSpeed, 6);
+    });
+  });
+
+  test('leaves the current sidereal mode unchanged', () => {
+    const before = getAyanamsaExUt(jd);
+    calculateSiderealPositions(jd, Planet.Sun, [SiderealMode.Raman, SiderealMode.TrueCitra]);
+    expect(getAyanamsaExUt(jd)).toBe(before);
+  });
+
+  test('alternating star-based ayanamsas match one mode at a time', () => {
+    const modes = [
+      SiderealMode.TrueCitra,
+      SiderealMode.TrueRevati,
+      SiderealMode.TrueMula,
+      SiderealMode.GalacticCenter0Sag,
+    ];
+    const expected = [24.1890371225, 20.3952549362, 24.9292294970, 27.1953487804];
+    const alternating = [0, 1, 2, 3, 0, 1, 2, 3].map((k) => {
+      setSiderealMode(modes[k]);
+      return getAyanamsaExUt(jd, CalculationFlag.SwissEphemeris);
+    });
+
+    modes.forEach((mode, k) => {
+      expect(alternating[k]).toBeCloseTo(expected[k], 9);
+      expect(alternating[k + 4]).toBe(alternating[k]);
+    });
+  });
 });
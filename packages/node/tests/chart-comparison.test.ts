@@ -0,0 +1,50 @@
+import { compareCharts, packChartLongitudes } from '@swisseph/node';
+
+describe('chart comparison', () => {
+  const aspects = [
+    { angle: 0, orb: 8, weight: 10 },
+    { angle: 180, orb: 8, weight: 8 },
+    { angle: 120, orb: 6, weight: 6 },
+    { angle: 90, orb: 6, weight: -5 },
+  ];
+
+  test('scores the aspects between two charts', () => {
+    // five charts: one vector of four plus one
+    const packed = packChartLongitudes([
+      [12, 280],
+      [130, 220],
+      [50, 50],
+      [10, 100],
+      [-5, 190],
+    ]);
+    const result = compareCharts([10, 100], packed, 2, aspects, { minScore: 10 });
+
+    const expected = [7.5 - 5 - 5 * (1 - 2 / 6) + 8, 12, 0, 10, 3];
+    expected.forEach((score, i) => expect(result.scores[i]).toBeCloseTo(score, 4));
+
+    // the aspects of the charts scoring at least 10
+    expect(Array.from(result.chart)).toEqual([1, 1, 3, 3, 3, 3]);
+    expect(Array.from(result.aspect)).toEqual([2, 2, 0, 3, 3, 0]);
+    expect(Array.from(result.referencePoint)).toEqual([0, 1, 0, 0, 1, 1]);
+    expect(Array.from(result.point)).toEqual([0, 1, 0, 1, 0, 1]);
+  });
+
+  test('gives the same result in any number of threads', () => {
+    let seed = 1;
+    const random = () => ((seed = (seed * 16807) % 2147483647) / 2147483647) * 360;
+    const charts = Array.from({ length: 10007 }, () => Array.from({ length: 15 }, random));
+    const natal = Array.from({ length: 15 }, random);
+    const packed = packChartLongitudes(charts);
+
+    const one = compareCharts(natal, packed, 15, aspects, { minScore: 150, threads: 1 });
+    const many = compareCharts(natal, packed, 15, aspects, { minScore: 150, threads: 4 });
+
+    expect(many).toEqual(one);
+    expect(one.chart.length).toBeGreaterThan(0);
+    expect(one.chart.every((c) => one.scores[c] >= 150)).toBe(true);
+  });
+
+  test('rejects an orb of zero', () => {
+    expect(() => compareCharts([0], packChartLongitudes([[0]]), 1, [{ angle: 0, orb: 0 }])).toThrow();
+  });
+});
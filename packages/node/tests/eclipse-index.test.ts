@@ -0,0 +1,77 @@
+import { mkdtempSync, rmSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import {
+  closeEclipseIndex,
+  EclipseType,
+  findEclipsesInRange,
+  findNextLunarEclipse,
+  findNextSolarEclipse,
+  julianDay,
+  openEclipseIndex,
+  setEphemerisPath,
+} from '@swisseph/node';
+
+describe('precomputed eclipse index', () => {
+  const starts = [julianDay(1850, 3, 1), julianDay(2025, 1, 1), julianDay(2024, 4, 8, 18), julianDay(2301, 7, 15)];
+
+  function searches(): number[][] {
+    return starts.map((jd) => [
+      findNextSolarEclipse(jd).maximum,
+      findNextSolarEclipse(jd, undefined, EclipseType.Total, true).maximum,
+      findNextLunarEclipse(jd).maximum,
+      findNextLunarEclipse(jd, undefined, EclipseType.Penumbral).maximum,
+    ]);
+  }
+
+  afterAll(() => {
+    closeEclipseIndex();
+  });
+
+  test('answers searches exactly like the live search', () => {
+    const live = searches();
+
+    openEclipseIndex();
+    const indexed = searches();
+    closeEclipseIndex();
+
+    expect(indexed).toEqual(live);
+  });
+
+  test('lists the eclipses of a range', () => {
+    openEclipseIndex();
+    const totals = findEclipsesInRange('solar', julianDay(2001, 1, 1), julianDay(2101, 1, 1), EclipseType.Total);
+    const lunar = findEclipsesInRange('lunar', julianDay(2025, 1, 1), julianDay(2026, 1, 1));
+    closeEclipseIndex();
+
+    expect(totals).toHaveLength(68);
+    expect(lunar).toHaveLength(2);
+    expect(lunar[0].maximum).toBeCloseTo(2460748.79081, 5); // 2025-03-14
+    expect(lunar[0].type & EclipseType.Total).toBeTruthy();
+
+    // without the index, the range is searched
+    expect(findEclipsesInRange('lunar', julianDay(2025, 1, 1), julianDay(2026, 1, 1))).toEqual(lunar);
+  });
+
+  test('is not used with other ephemeris files', () => {
+    // without the files, the Moshier ephemeris is used instead
+    const empty = mkdtempSync(join(tmpdir(), 'swisseph-nofiles-'));
+    try {
+      setEphemerisPath(empty);
+      const live = searches();
+
+      openEclipseIndex();
+      const indexed = searches();
+      closeEclipseIndex();
+
+      expect(indexed).toEqual(live);
+    } finally {
+      setEphemerisPath(null);
+      rmSync(empty, { recursive: true, force: true });
+    }
+  });
+
+  test('rejects a missing index file', () => {
+    expect(() => openEclipseIndex('/nonexistent/seecl.idx')).toThrow();
+  });
+});
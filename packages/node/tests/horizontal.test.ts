@@ -0,0 +1,68 @@
+import {
+  CoordinateSystem,
+  horizontalCoordinates,
+  horizontalToCoordinates,
+  julianDay,
+  setRefractionTable,
+} from '@swisseph/node';
+
+describe('batch horizontal coordinates', () => {
+  const jd = julianDay(2024, 3, 20, 21.5);
+  const [lon, lat, alt] = [8.55, 47.37, 400];
+  const coordinates = new Float64Array(200);
+  for (let i = 0; i < 100; i++) {
+    coordinates[2 * i] = (5 + i * 37.1) % 360;
+    coordinates[2 * i + 1] = -80 + ((i * 13.7) % 160);
+  }
+
+  test('returns azimuth, true and apparent altitude per object', () => {
+    const horizontal = horizontalCoordinates(jd, coordinates, lon, lat, alt);
+
+    expect(horizontal.length).toBe(300);
+    for (let i = 0; i < 100; i++) {
+      expect(horizontal[3 * i]).toBeGreaterThanOrEqual(0);
+      expect(horizontal[3 * i]).toBeLessThan(360);
+      expect(Math.abs(horizontal[3 * i + 1])).toBeLessThanOrEqual(90);
+      // Refraction only lifts objects
+      expect(horizontal[3 * i + 2]).toBeGreaterThanOrEqual(horizontal[3 * i + 1]);
+    }
+  });
+
+  test.each([CoordinateSystem.Ecliptic, CoordinateSystem.Equatorial])(
+    'round-trips through the reverse transform (system %s)',
+    (system) => {
+      const horizontal = horizontalCoordinates(jd, coordinates, lon, lat, alt, system);
+      const pairs = new Float64Array(200);
+      for (let i = 0; i < 100; i++) {
+        pairs[2 * i] = horizontal[3 * i];
+        pairs[2 * i + 1] = horizontal[3 * i + 1];
+      }
+      const back = horizontalToCoordinates(jd, pairs, lon, lat, alt, system);
+
+      for (let i = 0; i < 200; i++) {
+        expect(back[i]).toBeCloseTo(coordinates[i], 8);
+      }
+    }
+  );
+
+  test('writes into a caller-provided array', () => {
+    const target = new Float64Array(300);
+    expect(horizontalCoordinates(jd, coordinates, lon, lat, alt, CoordinateSystem.Ecliptic, 0, 0, target))
+      .toBe(target);
+    expect(() => horizontalCoordinates(jd, coordinates, lon, lat, alt, CoordinateSystem.Ecliptic, 0, 0, new Float64Array(3)))
+      .toThrow(RangeError);
+  });
+
+  test('table-driven refraction matches the exact formula', () => {
+    const exact = horizontalCoordinates(jd, coordinates, lon, lat, alt);
+    setRefractionTable(true);
+    try {
+      const table = horizontalCoordinates(jd, coordinates, lon, lat, alt);
+      for (let i = 0; i < 300; i++) {
+        expect(table[i]).toBeCloseTo(exact[i], 4);
+      }
+    } finally {
+      setRefractionTable(false);
+    }
+  });
+});
@@ -0,0 +1,57 @@
+import { mkdtempSync, rmSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import {
+  buildLongitudeIndex,
+  calculatePosition,
+  CalculationFlag,
+  closeLongitudeIndexes,
+  findLongitudeCrossings,
+  julianDay,
+  openLongitudeIndex,
+  Planet,
+} from '@swisseph/node';
+
+describe('longitude crossings', () => {
+  const dir = mkdtempSync(join(tmpdir(), 'swisseph-lonidx-'));
+  const saturn = 282 + 34 / 60; // 12°34' Capricorn
+  const start = julianDay(1990, 1, 1);
+  const end = julianDay(2080, 1, 1);
+
+  afterAll(() => {
+    closeLongitudeIndexes();
+    rmSync(dir, { recursive: true, force: true });
+  });
+
+  test('Saturn returns, direct and retrograde', () => {
+    const returns = findLongitudeCrossings(Planet.Saturn, saturn, start, end);
+
+    expect(returns.map((c) => c.retrograde)).toEqual([false, false, true, false, false]);
+    for (const c of returns) {
+      expect(calculatePosition(c.time, Planet.Saturn).longitude).toBeCloseTo(saturn, 7);
+    }
+  });
+
+  test('an index gives the same crossings', () => {
+    const path = join(dir, 'moon.idx');
+    const moonStart = julianDay(2025, 1, 1);
+    const moonEnd = julianDay(2026, 1, 1);
+    const fitted = findLongitudeCrossings(Planet.Moon, 100, moonStart, moonEnd);
+
+    buildLongitudeIndex(path, Planet.Moon, julianDay(2024, 1, 1), julianDay(2027, 1, 1));
+    openLongitudeIndex(path);
+    const indexed = findLongitudeCrossings(Planet.Moon, 100, moonStart, moonEnd);
+
+    expect(fitted).toHaveLength(13);
+    expect(indexed).toHaveLength(13);
+    for (let i = 0; i < 13; i++) {
+      expect(indexed[i].time).toBeCloseTo(fitted[i].time, 8);
+    }
+  });
+
+  test('rejects flags that are not ecliptic longitudes', () => {
+    for (const flags of [CalculationFlag.Topocentric, CalculationFlag.Equatorial]) {
+      expect(() => findLongitudeCrossings(Planet.Mars, 100, start, start + 365, flags)).toThrow(/ecliptic longitudes/);
+    }
+  });
+});
@@ -0,0 +1,55 @@
+import {
+  closeLunationIndex,
+  findLunarApsides,
+  findLunation,
+  findMoonPhases,
+  julianDay,
+  MoonPhase,
+  openLunationIndex,
+} from '@swisseph/node';
+
+describe('lunation catalogue', () => {
+  const dates = [julianDay(1850, 3, 1), julianDay(1923, 1, 20), julianDay(2025, 3, 20), julianDay(2301, 7, 15)];
+
+  afterAll(() => {
+    closeLunationIndex();
+  });
+
+  test('lunation of March 2025', () => {
+    const lunation = findLunation(julianDay(2025, 3, 20));
+
+    expect(lunation.number).toBe(1264);
+    expect(lunation.newMoon).toBeCloseTo(julianDay(2025, 2, 28, 0.747), 3);
+    expect(lunation.fullMoon).toBeCloseTo(julianDay(2025, 3, 14, 6.911), 3);
+    expect(lunation.nextNewMoon).toBeCloseTo(julianDay(2025, 3, 29, 10.964), 3);
+    // Brown lunation 1 began on 1923 January 17
+    expect(findLunation(julianDay(1923, 1, 20)).number).toBe(1);
+  });
+
+  test('the catalogue returns the computed times', () => {
+    const computed = dates.map((jd) => [findLunation(jd), findLunarApsides(jd)]);
+
+    openLunationIndex();
+    const indexed = dates.map((jd) => [findLunation(jd), findLunarApsides(jd)]);
+    closeLunationIndex();
+
+    expect(indexed).toEqual(computed);
+  });
+
+  test('phases and apsides of a range', () => {
+    openLunationIndex();
+    const phases = findMoonPhases(julianDay(2025, 1, 1), julianDay(2026, 1, 1));
+    const apsides = findLunarApsides(julianDay(2025, 3, 20));
+    closeLunationIndex();
+
+    expect(phases).toHaveLength(49);
+    expect(phases[0].phase).toBe(MoonPhase.FirstQuarter);
+    expect(phases.filter((p) => p.phase === MoonPhase.FullMoon)).toHaveLength(12);
+    for (let i = 1; i < phases.length; i++) {
+      expect(phases[i].phase).toBe((phases[i - 1].phase + 1) % 4);
+    }
+    expect(apsides.perigee).toBeCloseTo(julianDay(2025, 3, 30, 5.304), 3);
+    expect(apsides.perigeeDistance * 149597870.7).toBeCloseTo(358135, -1);
+    expect(apsides.apogee).toBeGreaterThan(apsides.perigee);
+  });
+});
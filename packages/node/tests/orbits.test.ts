@@ -0,0 +1,106 @@
+import {
+  calculateNodesApsides,
+  calculateOrbitalElements,
+  calculateOrbitDistances,
+  CalculationFlag,
+  julianDay,
+  NodeMethod,
+  Planet,
+  setOrbitDistanceCache,
+} from '@swisseph/node';
+
+describe('nodes, apsides and orbital elements over time ranges', () => {
+  const j2000 = julianDay(2000, 1, 1, 12);
+  const days = Float64Array.from({ length: 30 }, (_, i) => j2000 + i * 11);
+  const heliocentric =
+    CalculationFlag.SwissEphemeris | CalculationFlag.Speed | CalculationFlag.Heliocentric;
+
+  test('heliocentric nodes and perihelion of Mars at J2000', () => {
+    const mean = calculateNodesApsides([j2000], [Planet.Mars], heliocentric, NodeMethod.Mean);
+    const osculating = calculateNodesApsides([j2000], [Planet.Mars], heliocentric, NodeMethod.Osculating);
+
+    expect(mean.ascendingNode[0]).toBeCloseTo(49.554, 3);
+    expect(mean.perihelion[0]).toBeCloseTo(336.0645, 4);
+    expect(osculating.ascendingNode[0]).toBeCloseTo(49.558, 3);
+    expect(osculating.perihelion[2]).toBeCloseTo(1.3815, 4);
+  });
+
+  test('rows of a body list match one body at a time', () => {
+    const bodies = [Planet.Venus, Planet.Mars, Planet.Saturn];
+    const all = calculateNodesApsides(days, bodies, undefined, NodeMethod.Osculating);
+
+    bodies.forEach((body, b) => {
+      const single = calculateNodesApsides(days, [body], undefined, NodeMethod.Osculating);
+      for (let d = 0; d < days.length; d += 7) {
+        for (let c = 0; c < 6; c++) {
+          expect(all.ascendingNode[all.offset(d, b) + c]).toBe(single.ascendingNode[single.offset(d, 0) + c]);
+          expect(all.aphelion[all.offset(d, b) + c]).toBe(single.aphelion[single.offset(d, 0) + c]);
+        }
+      }
+    });
+  });
+
+  test('orbital elements of Mars', () => {
+    const orbits = calculateOrbitalElements(days, [Planet.Earth, Planet.Mars]);
+    const mars = orbits.get(0, 1);
+
+    expect(mars.semimajorAxis).toBeCloseTo(1.52368, 5);
+    expect(mars.eccentricity).toBeCloseTo(0.093315, 6);
+    expect(mars.inclination).toBeCloseTo(1.8499, 4);
+    expect(mars.perihelionDistance).toBeCloseTo(mars.semimajorAxis * (1 - mars.eccentricity), 12);
+    expect(orbits.element(1, 1)[0]).toBe(mars.eccentricity);
+    expect(orbits.get(29, 0).eccentricity).toBeCloseTo(0.0167, 3);
+  });
+
+  test('rejects a target for other dates or bodies', () => {
+    const target = calculateOrbitalElements(days, [Planet.Mars]);
+    expect(() => calculateOrbitalElements(days, [Planet.Mars, Planet.Venus], undefined, target)).toThrow(
+      RangeError
+    );
+  });
+});
+
+describe('maximum, minimum and true distance', () => {
+  const start = 2460000;
+  const days = Float64Array.from({ length: 20 }, (_, i) => start + i * 2);
+  const bodies = [Planet.Sun, Planet.Venus, Planet.Mars, Planet.Jupiter];
+
+  afterEach(() => setOrbitDistanceCache(0));
+
+  test('distance range of the Sun and Mars', () => {
+    const d = calculateOrbitDistances([start], [Planet.Sun, Planet.Mars]);
+
+    expect(d[0]).toBeCloseTo(1.016677, 6);
+    expect(d[1]).toBeCloseTo(0.983326, 6);
+    expect(d[3]).toBeCloseTo(1.45157, 5);
+    expect(d[4]).toBeCloseTo(0.54899, 5);
+    expect(d[5]).toBeCloseTo(1.311082, 6);
+  });
+
+  test('rows of a body list match one body at a time', () => {
+    const all = calculateOrbitDistances(days, bodies);
+
+    bodies.forEach((body, b) => {
+      const single = calculateOrbitDistances(days, [body]);
+      for (let d = 0; d < days.length; d += 5) {
+        for (let c = 0; c < 3; c++) {
+          expect(all[(d * bodies.length + b) * 3 + c]).toBe(single[d * 3 + c]);
+        }
+      }
+    });
+  });
+
+  test('the cache stays within the accuracy of the full search', () => {
+    const full = calculateOrbitDistances(days, bodies);
+    setOrbitDistanceCache(30);
+    const cached = calculateOrbitDistances(days, bodies);
+
+    for (let i = 0; i < full.length; i++) {
+      expect(Math.abs(cached[i] - full[i])).toBeLessThan(1e-4);
+    }
+  });
+
+  test('rejects a target of another size', () => {
+    expect(() => calculateOrbitDistances(days, bodies, undefined, new Float64Array(3))).toThrow(RangeError);
+  });
+});
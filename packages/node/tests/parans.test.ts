@@ -0,0 +1,39 @@
+import { calculateRiseTransitSet, findParans, julianDay, Planet, RiseTransitFlag } from '@swisseph/node';
+
+describe('parans', () => {
+  const jd = julianDay(2025, 3, 1);
+  const latitudes = Array.from({ length: 121 }, (_, i) => i - 60);
+
+  test('finds planets culminating while Sirius rises', () => {
+    const parans = findParans(jd, [Planet.Sun, Planet.Moon], ['Sirius'], latitudes);
+
+    const sun = parans.filter((p) => p.body === Planet.Sun && p.event === RiseTransitFlag.UpperTransit);
+    expect(sun.map((p) => p.latitude)).toEqual([-57]);
+    expect(sun[0].other).toMatch(/^Sirius/);
+    expect(sun[0].otherEvent).toBe(RiseTransitFlag.Rise);
+
+    const moon = parans.filter((p) => p.body === Planet.Moon && p.event === RiseTransitFlag.UpperTransit);
+    expect(moon.map((p) => p.latitude)).toEqual([-29, -28, -27, -26, -25]);
+
+    // event times agree with the rise/transit search
+    const transit = calculateRiseTransitSet(jd, Planet.Moon, RiseTransitFlag.UpperTransit, 0, -27, 0);
+    expect(Math.abs(moon[2].time - transit.time) * 1440).toBeLessThan(0.5);
+
+    for (const p of parans) {
+      expect(Math.abs(p.time - p.otherTime) * 1440).toBeLessThan(4);
+    }
+  });
+
+  test('gives the same parans in any number of threads', () => {
+    const planets = [Planet.Sun, Planet.Moon, Planet.Mars, Planet.Jupiter];
+    const one = findParans(jd, planets, 'all', latitudes, { threads: 1 });
+    const four = findParans(jd, planets, 'all', latitudes, { threads: 4 });
+
+    expect(one.length).toBeGreaterThan(1000);
+    expect(four).toEqual(one);
+  });
+
+  test('rejects an unknown star', () => {
+    expect(() => findParans(jd, [Planet.Sun], ['NoSuchStar'], [0])).toThrow();
+  });
+});
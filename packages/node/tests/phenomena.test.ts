@@ -0,0 +1,74 @@
+import {
+  calculatePhenomena,
+  calculatePhenomenaSeries,
+  findGreatestBrilliancy,
+  findGreatestElongations,
+  julianDay,
+  PhenomenaSeries,
+  Planet,
+} from '@swisseph/node';
+
+describe('planetary phenomena', () => {
+  const start = julianDay(2025, 1, 1);
+
+  test('series rows match the phenomena of each body at that time', () => {
+    const series = calculatePhenomenaSeries(start, 10, 20, Planet.Venus);
+
+    expect(series.length).toBe(20);
+    for (const i of [0, 7, 19]) {
+      const [venus] = calculatePhenomena(series.julianDays[i], [Planet.Venus]);
+      expect(series.julianDays[i]).toBe(start + 10 * i);
+      expect(series.phaseAngle[i]).toBeCloseTo(venus.phaseAngle, 10);
+      expect(series.elongation[i]).toBeCloseTo(venus.elongation, 10);
+      expect(series.magnitude[i]).toBeCloseTo(venus.magnitude, 10);
+      expect(series.toPhenomena(i).phase).toBe(series.phase[i]);
+    }
+  });
+
+  test('calculates several bodies at one time', () => {
+    const [sun, moon, jupiter] = calculatePhenomena(start, [Planet.Sun, Planet.Moon, Planet.Jupiter]);
+
+    expect(sun.elongation).toBe(0);
+    expect(sun.magnitude).toBeLessThan(-26);
+    expect(moon.horizontalParallax).toBeGreaterThan(0.9);
+    expect(moon.phase).toBeGreaterThanOrEqual(0);
+    expect(moon.phase).toBeLessThanOrEqual(1);
+    expect(jupiter.horizontalParallax).toBe(0);
+    expect(jupiter.magnitude).toBeLessThan(-2);
+  });
+
+  test('rejects a target of another length', () => {
+    expect(() =>
+      calculatePhenomenaSeries(start, 1, 5, Planet.Mars, undefined, new PhenomenaSeries(4))
+    ).toThrow(RangeError);
+  });
+
+  test('finds the greatest elongations of Mercury in 2025', () => {
+    const elongations = findGreatestElongations(start, julianDay(2026, 1, 1), Planet.Mercury);
+    const expected = [
+      [julianDay(2025, 3, 8), 18.2],
+      [julianDay(2025, 4, 21), 27.4],
+      [julianDay(2025, 7, 4), 25.9],
+      [julianDay(2025, 8, 19), 18.6],
+      [julianDay(2025, 10, 29), 23.9],
+      [julianDay(2025, 12, 7), 20.7],
+    ];
+
+    expect(elongations).toHaveLength(expected.length);
+    elongations.forEach((e, k) => {
+      expect(Math.abs(e.time - expected[k][0])).toBeLessThan(1);
+      expect(e.value).toBeCloseTo(expected[k][1], 1);
+    });
+  });
+
+  test('greatest brilliancy is a local minimum of magnitude', () => {
+    const brilliancy = findGreatestBrilliancy(start, julianDay(2025, 6, 1), Planet.Venus);
+    expect(brilliancy.length).toBeGreaterThan(0);
+
+    const { time, value } = brilliancy[0];
+    const around = calculatePhenomenaSeries(time - 0.5, 0.5, 3, Planet.Venus);
+    expect(around.magnitude[1]).toBeCloseTo(value, 8);
+    expect(around.magnitude[0]).toBeGreaterThan(value);
+    expect(around.magnitude[2]).toBeGreaterThan(value);
+  });
+});
@@ -0,0 +1,42 @@
+import {
+  calculatePlanetocentricPositions,
+  calculatePosition,
+  CalculationFlag,
+  Planet,
+} from '@swisseph/node';
+
+describe('positions seen from another planet', () => {
+  const jd = 2460000; // 2023-02-24 12:00 UT
+
+  test('the Sun and the Earth seen from Mars', () => {
+    const [sun, earth] = [0, 6];
+    const fromMars = calculatePlanetocentricPositions(jd, Planet.Mars, [Planet.Sun, Planet.Earth, Planet.Jupiter]);
+    const helio = calculatePosition(jd, Planet.Mars, CalculationFlag.SwissEphemeris | CalculationFlag.Heliocentric);
+    const geo = calculatePosition(jd, Planet.Mars);
+
+    expect(fromMars).toHaveLength(18);
+    expect(fromMars[sun]).toBeCloseTo((helio.longitude + 180) % 360, 4);
+    expect(fromMars[sun + 1]).toBeCloseTo(-helio.latitude, 4);
+    expect(fromMars[sun + 2]).toBeCloseTo(helio.distance, 4);
+    expect(fromMars[earth]).toBeCloseTo((geo.longitude + 180) % 360, 4);
+    expect(fromMars[earth + 1]).toBeCloseTo(-geo.latitude, 4);
+    expect(fromMars[earth + 2]).toBeCloseTo(1.0995758, 6);
+  });
+
+  test('rows do not depend on the other bodies', () => {
+    const all = calculatePlanetocentricPositions(jd, Planet.Jupiter, [Planet.Sun, Planet.Saturn, Planet.Pluto]);
+    const saturn = calculatePlanetocentricPositions(jd, Planet.Jupiter, [Planet.Saturn]);
+
+    for (let c = 0; c < 3; c++) {
+      expect(all[6 + c]).toBe(saturn[c]);
+    }
+    expect(all[9]).toBeCloseTo(saturn[3], 7);
+  });
+
+  test('rejects the centre as a target and a short target array', () => {
+    expect(() => calculatePlanetocentricPositions(jd, Planet.Mars, [Planet.Sun, Planet.Mars])).toThrow();
+    expect(() =>
+      calculatePlanetocentricPositions(jd, Planet.Mars, [Planet.Sun, Planet.Venus], undefined, new Float64Array(6))
+    ).toThrow(RangeError);
+  });
+});
@@ -0,0 +1,59 @@
+import {
+  calculateSpeculum,
+  DirectionKey,
+  findPrimaryDirections,
+  HouseSystem,
+  julianDay,
+  Planet,
+} from '@swisseph/node';
+
+describe('primary directions', () => {
+  const birth = julianDay(1980, 6, 15, 14.5);
+  const speculum = calculateSpeculum(birth, -0.13, 51.5, [Planet.Sun, Planet.Moon, Planet.Mars]);
+
+  test('calculates the speculum of a chart', () => {
+    expect(speculum.rows.map((r) => r.body)).toEqual([Planet.Sun, Planet.Moon, Planet.Mars, 'ASC', 'MC']);
+    expect(speculum.armc).toBeCloseTo(121.394093, 5);
+
+    const sun = speculum.rows[0];
+    expect(sun.declination).toBeCloseTo(23.3301, 4);
+    expect(sun.diurnalSemiArc).toBeCloseTo(122.8341, 4);
+    expect(sun.placidus).toBeCloseTo(27.2973, 4);
+    expect(sun.aboveHorizon).toBe(true);
+
+    expect(speculum.rows[3].placidus).toBe(270);
+    expect(speculum.rows[4].campanus).toBe(0);
+  });
+
+  test('directs the Moon to the Sun', () => {
+    const options = { aspects: [0], key: DirectionKey.Ptolemy };
+    const placidus = findPrimaryDirections(speculum, options);
+    const regio = findPrimaryDirections(speculum, { ...options, method: HouseSystem.Regiomontanus });
+    const campanus = findPrimaryDirections(speculum, { ...options, method: HouseSystem.Campanus });
+
+    const moonSun = (d: { promissor: number; significator: unknown }) =>
+      d.promissor === Planet.Moon && d.significator === Planet.Sun;
+    expect(placidus.find(moonSun)!.arc).toBeCloseTo(34.124041, 5);
+    expect(placidus.find(moonSun)!.years).toBeCloseTo(34.124041, 5);
+
+    // the circles of position of Regiomontanus and Campanus are the same
+    expect(regio.find(moonSun)!.arc).toBeCloseTo(33.600879, 5);
+    expect(campanus.find(moonSun)!.arc).toBeCloseTo(33.600879, 5);
+  });
+
+  test('lists directions by arc within the years of the key', () => {
+    const directions = findPrimaryDirections(speculum, { converse: true, maxYears: 80 });
+
+    expect(directions.length).toBeGreaterThan(20);
+    for (let i = 1; i < directions.length; i++) {
+      expect(directions[i].arc).toBeGreaterThanOrEqual(directions[i - 1].arc);
+    }
+    expect(directions.every((d) => d.years <= 80 && d.significator !== d.promissor)).toBe(true);
+    expect(directions.some((d) => d.converse)).toBe(true);
+    expect(directions[0].julianDay).toBeCloseTo(birth + directions[0].years * 365.24219, 6);
+  });
+
+  test('rejects other house systems', () => {
+    expect(() => findPrimaryDirections(speculum, { method: HouseSystem.Koch })).toThrow();
+  });
+});
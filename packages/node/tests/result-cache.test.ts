@@ -0,0 +1,83 @@
+import { mkdtempSync, readFileSync, rmSync } from 'fs';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import {
+  close,
+  disableResultCache,
+  enableResultCache,
+  findNextLunarEclipse,
+  findNextSolarEclipse,
+  getResultCacheStats,
+  julianDay,
+} from '@swisseph/node';
+
+const describePosix = process.platform === 'win32' ? describe.skip : describe;
+
+describePosix('persistent result cache', () => {
+  const dir = mkdtempSync(join(tmpdir(), 'swisseph-results-'));
+  const path = join(dir, 'results.bin');
+  const start = julianDay(2025, 1, 1);
+
+  function searches(): number[] {
+    const result: number[] = [];
+    for (let i = 0; i < 5; i++) {
+      result.push(findNextLunarEclipse(start + i * 200).maximum);
+      result.push(findNextSolarEclipse(start + i * 200).maximum);
+    }
+    return result;
+  }
+
+  afterAll(() => {
+    disableResultCache();
+    close();
+    rmSync(dir, { recursive: true, force: true });
+  });
+
+  test('stores results and answers repeated searches from the file', () => {
+    const uncached = searches();
+
+    enableResultCache({ path, sizeMB: 1 });
+    const stored = searches();
+    expect(getResultCacheStats().stores).toBe(10);
+
+    // reopening works like a restart of the process
+    enableResultCache({ path });
+    const cached = searches();
+    const stats = getResultCacheStats();
+
+    expect(stats.open).toBe(true);
+    expect(stats.hits).toBe(10);
+    expect(stats.misses).toBe(0);
+    expect(stats.records).toBe(10);
+    expect(stored).toEqual(uncached);
+    expect(cached).toEqual(uncached);
+  });
+
+  test('verify mode recomputes and confirms stored results', () => {
+    enableResultCache({ path, verify: true });
+    searches();
+    const stats = getResultCacheStats();
+
+    expect(stats.hits).toBe(10);
+    expect(stats.mismatches).toBe(0);
+  });
+
+  test('unmaps the file on reopen and close', () => {
+    if (process.platform !== 'linux') return;
+    const mappings = () => readFileSync('/proc/self/maps', 'utf8').split('\n').filter((l) => l.endsWith(path)).length;
+
+    for (let i = 0; i < 20; i++) {
+      enableResultCache({ path });
+      findNextLunarEclipse(start);
+    }
+    expect(mappings()).toBe(1);
+
+    disableResultCache();
+    expect(mappings()).toBe(0);
+  });
+
+  test('reports a closed cache', () => {
+    disableResultCache();
+    expect(getResultCacheStats().open).toBe(false);
+  });
+});
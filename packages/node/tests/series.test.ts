@@ -0,0 +1,72 @@
+import {
+  calculateHouses,
+  calculateHouseSeries,
+  calculatePosition,
+  calculatePositionSeries,
+  HouseSystem,
+  julianDay,
+  Planet,
+  PositionSeries,
+} from '@swisseph/node';
+
+describe('bulk series calculations', () => {
+  const start = julianDay(2024, 1, 1);
+  const days = Float64Array.from({ length: 50 }, (_, i) => start + i * 3.25);
+
+  test('position series matches per-date calculatePosition', () => {
+    const series = calculatePositionSeries(days, Planet.Moon);
+
+    expect(series.length).toBe(days.length);
+    for (let i = 0; i < days.length; i++) {
+      const single = calculatePosition(days[i], Planet.Moon);
+      expect(series.longitude[i]).toBeCloseTo(single.longitude, 10);
+      expect(series.latitude[i]).toBeCloseTo(single.latitude, 10);
+      expect(series.distance[i]).toBeCloseTo(single.distance, 12);
+      expect(series.longitudeSpeed[i]).toBeCloseTo(single.longitudeSpeed, 10);
+      expect(series.flags[i]).toBe(single.flags);
+    }
+  });
+
+  test('row views read from the columns', () => {
+    const series = calculatePositionSeries(days, Planet.Sun);
+    const view = series.at(0);
+
+    expect(view.julianDay).toBe(days[0]);
+    expect(view.longitude).toBe(series.longitude[0]);
+    expect(series.at(7, view)).toBe(view);
+    expect(view.longitude).toBe(series.longitude[7]);
+    expect(series.toPosition(7).longitude).toBe(series.longitude[7]);
+  });
+
+  test('fills a caller-provided series', () => {
+    const target = new PositionSeries(days.length);
+    const result = calculatePositionSeries(days, Planet.Mars, undefined, target);
+
+    expect(result).toBe(target);
+    expect(target.longitude[3]).toBeCloseTo(
+      calculatePosition(days[3], Planet.Mars).longitude,
+      10
+    );
+    expect(() => calculatePositionSeries(days.subarray(1), Planet.Mars, undefined, target))
+      .toThrow(RangeError);
+  });
+
+  test('house series matches per-row calculateHouses', () => {
+    const latitudes = days.map((_, i) => -60 + i * 2.4);
+    const longitudes = days.map((_, i) => -180 + i * 7.2);
+    const series = calculateHouseSeries(days, latitudes, longitudes, HouseSystem.Koch);
+
+    for (let i = 0; i < days.length; i++) {
+      const single = calculateHouses(days[i], latitudes[i], longitudes[i], HouseSystem.Koch);
+      expect(series.ascendant[i]).toBeCloseTo(single.ascendant, 10);
+      expect(series.mc[i]).toBeCloseTo(single.mc, 10);
+      for (let house = 1; house <= 12; house++) {
+        expect(series.cusp(house)[i]).toBeCloseTo(single.cusps[house], 10);
+      }
+    }
+  });
+
+  test('rejects inputs of different lengths', () => {
+    expect(() => calculateHouseSeries(days, [0], [0])).toThrow(RangeError);
+  });
+});
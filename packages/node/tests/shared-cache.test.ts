@@ -0,0 +1,82 @@
+import {
+  calculatePosition,
+  close,
+  disableSharedCache,
+  enableSharedCache,
+  findParans,
+  getSharedCacheStats,
+  julianDay,
+  Planet,
+  removeSharedCache,
+} from '@swisseph/node';
+
+const describePosix = process.platform === 'win32' ? describe.skip : describe;
+
+describePosix('shared ephemeris cache', () => {
+  const name = `/swisseph-test-${process.pid}`;
+  const start = julianDay(1950, 1, 1);
+  const bodies = [Planet.Sun, Planet.Moon, Planet.Mars, Planet.Jupiter];
+
+  function longitudes(): number[] {
+    const result: number[] = [];
+    for (let i = 0; i < 40; i++) {
+      for (const body of bodies) {
+        result.push(calculatePosition(start + i * 97.3, body).longitude);
+      }
+    }
+    return result;
+  }
+
+  afterAll(() => {
+    disableSharedCache();
+    removeSharedCache(name);
+    close();
+  });
+
+  test('reuses decoded segments without changing results', () => {
+    close();
+    const uncached = longitudes();
+
+    enableSharedCache({ name, sizeMB: 8 });
+    close();
+    const stored = longitudes();
+    expect(getSharedCacheStats().segmentStores).toBeGreaterThan(0);
+
+    // After close() this process holds no segments, like a new worker
+    close();
+    const shared = longitudes();
+    const stats = getSharedCacheStats();
+
+    expect(stats.attached).toBe(true);
+    expect(stats.segmentHits).toBeGreaterThan(0);
+    expect(stored).toEqual(uncached);
+    expect(shared).toEqual(uncached);
+  });
+
+  test('keeps shared fixed stars valid after detaching', () => {
+    const sirius = () => findParans(start, [Planet.Sun], ['Sirius'], [0, 30, 60]);
+
+    close();
+    const unshared = sirius();
+
+    enableSharedCache({ name, sizeMB: 8 });
+    close();
+    expect(sirius()).toEqual(unshared);
+    expect(getSharedCacheStats().fixedStarsShared).toBe(true);
+
+    // the star array of this thread still points into the segment
+    disableSharedCache();
+    close();
+    expect(sirius()).toEqual(unshared);
+
+    enableSharedCache({ name, sizeMB: 8 });
+    sirius();
+    enableSharedCache({ name, sizeMB: 8 });
+    close();
+  });
+
+  test('reports a detached cache', () => {
+    disableSharedCache();
+    expect(getSharedCacheStats().attached).toBe(false);
+  });
+});
@@ -0,0 +1,43 @@
+import { calculateEquationOfTime, calculateSiderealTimes, julianDay } from '@swisseph/node';
+
+describe('sidereal time and equation of time for many dates', () => {
+  test('sidereal time at J2000 and six hours later', () => {
+    const [t0, t6] = calculateSiderealTimes([2451545, 2451545.25]);
+
+    expect(t0).toBeCloseTo(18.6971382, 6);
+    // a quarter of a day advances sidereal time by 6h 0m 59s
+    expect(((t6 - t0 + 24) % 24) * 3600).toBeCloseTo(6 * 3600 + 59.14, 1);
+  });
+
+  test('interpolated times match isolated ones', () => {
+    const start = 2460000.3;
+    const days = Float64Array.from({ length: 2000 }, (_, i) => start + i * 0.01);
+    const dense = calculateSiderealTimes(days);
+
+    for (const i of [0, 17, 999, 1999]) {
+      // a single date is computed directly
+      const [single] = calculateSiderealTimes([days[i]]);
+      expect(Math.abs(dense[i] - single) * 3600).toBeLessThan(1e-5);
+    }
+  });
+
+  test('equation of time in February and November', () => {
+    const [february, november] = calculateEquationOfTime([julianDay(2025, 2, 11, 12), julianDay(2025, 11, 3, 12)]);
+
+    expect(february * 1440).toBeCloseTo(-14.19, 2);
+    expect(november * 1440).toBeCloseTo(16.43, 2);
+  });
+
+  test('dense equation of time is smooth and matches single dates', () => {
+    const days = Float64Array.from({ length: 500 }, (_, i) => 2460000 + i * 0.05);
+    const dense = calculateEquationOfTime(days);
+
+    expect(dense[0]).toBeCloseTo(-0.0091670466, 9);
+    const [middle] = calculateEquationOfTime([days[250]]);
+    expect(Math.abs(dense[250] - middle)).toBeLessThan(1e-9);
+  });
+
+  test('rejects a short target', () => {
+    expect(() => calculateSiderealTimes([1, 2, 3], new Float64Array(2))).toThrow(RangeError);
+  });
+});
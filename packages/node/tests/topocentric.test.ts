@@ -0,0 +1,92 @@
+import {
+  calculatePosition,
+  calculateTopocentricPositions,
+  CalculationFlag,
+  julianDay,
+  Planet,
+  setTopocentric,
+} from '@swisseph/node';
+
+describe('topocentric positions for many observers', () => {
+  const jd = julianDay(2025, 3, 14, 6.5);
+  const observers = [
+    -74.006, 40.7128, 10,
+    72.8777, 19.076, 14,
+    151.2093, -33.8688, 58,
+  ];
+
+  test('matches one topocentric calculation per observer', () => {
+    const flags = CalculationFlag.SwissEphemeris | CalculationFlag.Speed;
+    const batch = calculateTopocentricPositions(jd, Planet.Moon, observers, flags);
+
+    expect(batch).toHaveLength(18);
+    for (let k = 0; k < 3; k++) {
+      setTopocentric(observers[3 * k], observers[3 * k + 1], observers[3 * k + 2]);
+      const single = calculatePosition(jd, Planet.Moon, flags | CalculationFlag.Topocentric);
+      expect(batch[6 * k]).toBeCloseTo(single.longitude, 6);
+      expect(batch[6 * k + 1]).toBeCloseTo(single.latitude, 6);
+      expect(batch[6 * k + 2]).toBeCloseTo(single.distance, 10);
+      expect(batch[6 * k + 3]).toBeCloseTo(single.longitudeSpeed, 5);
+    }
+  });
+
+  test('applies the parallax of each observer', () => {
+    const batch = calculateTopocentricPositions(jd, Planet.Moon, observers);
+    const geocentric = calculatePosition(jd, Planet.Moon);
+
+    for (let k = 0; k < 3; k++) {
+      const shift = Math.abs(batch[6 * k] - geocentric.longitude);
+      expect(shift).toBeGreaterThan(0);
+      expect(shift).toBeLessThan(1.1);
+    }
+  });
+
+  test('writes into a reusable target', () => {
+    const target = new Float64Array(18);
+    const result = calculateTopocentricPositions(jd, Planet.Sun, observers, undefined, target);
+    expect(result).toBe(target);
+    expect(() =>
+      calculateTopocentricPositions(jd, Planet.Sun, observers, undefined, new Float64Array(6))
+    ).toThrow(RangeError);
+  });
+});
+
+describe('topocentric speeds', () => {
+  const jd = julianDay(2025, 3, 14, 6.5);
+  const bodies = [
+    Planet.Sun, Planet.Moon, Planet.Mercury, Planet.Venus, Planet.Mars,
+    Planet.Jupiter, Planet.Saturn, Planet.Uranus, Planet.Neptune, Planet.Pluto,
+  ];
+  const topocentric = CalculationFlag.SwissEphemeris | CalculationFlag.Topocentric;
+
+  beforeAll(() => {
+    setTopocentric(151.2093, -33.8688, 58);
+  });
+
+  // Speed is propagated analytically, Speed3 differentiates three positions
+  // and returns the speed at the end of its interval (4 s later for the Moon)
+  test.each(bodies)('analytic and three-point speeds agree for body %i', (body) => {
+    const analytic = calculatePosition(jd, body, topocentric | CalculationFlag.Speed);
+    const threePoint = calculatePosition(jd, body, topocentric | CalculationFlag.Speed3);
+    const tolerance = body === Planet.Moon ? 1e-2 : 5e-5; // degrees per day
+
+    expect(Math.abs(analytic.longitudeSpeed - threePoint.longitudeSpeed)).toBeLessThan(tolerance);
+    expect(Math.abs(analytic.latitudeSpeed - threePoint.latitudeSpeed)).toBeLessThan(tolerance);
+    expect(analytic.longitude).toBeCloseTo(threePoint.longitude, 10);
+  });
+
+  test.each(bodies)('analytic speed matches the change of position for body %i', (body) => {
+    const h = 0.0005;
+    const analytic = calculatePosition(jd, body, topocentric | CalculationFlag.Speed);
+    const before = calculatePosition(jd - h, body, topocentric);
+    const after = calculatePosition(jd + h, body, topocentric);
+    let delta = after.longitude - before.longitude;
+    if (delta > 180) delta -= 360;
+    if (delta < -180) delta += 360;
+
+    // up to 0.83"/day for the Moon and 0.034"/day for the planets
+    // (2000 dates 1900-2100, four observers)
+    const tolerance = body === Planet.Moon ? 2.5e-4 : 1.4e-5; // 0.9"/day, 0.05"/day
+    expect(Math.abs(analytic.longitudeSpeed - delta / (2 * h))).toBeLessThan(tolerance);
+  });
+});